@@ -0,0 +1,129 @@
+#ifndef SIMPLEMINIJAVACOMPILERTOC_PROFILER_H
+#define SIMPLEMINIJAVACOMPILERTOC_PROFILER_H
+
+#include "memory_tracker.h"
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+/**
+ * @brief Timing of the phases of the compiler (`--time-report` and `--trace`).
+ *
+ * The phases are measured by `ScopedTimer`s. Recording is off by default: a disabled timer checks
+ * `profiler::enabled` and does nothing else, it doesn't read the clock or copy a name. The timers are also
+ * the phases of the memory report (see `memory_tracker.h`).
+ */
+namespace profiler {
+    /// Whether the timers record their phases, see `enable`
+    extern bool enabled;
+
+    /// Starts recording the phases, the events recorded so far are dropped.
+    void enable();
+
+    /// Nanoseconds on a monotonic clock.
+    inline uint64_t now() {
+        return (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    /// Records a finished phase, called by `ScopedTimer`.
+    void record(const char *phase, std::string name, std::string method, uint64_t start, uint64_t end);
+
+    /**
+     * @brief Prints the time spent in every phase, and the slowest classes and methods.
+     *
+     * A phase containing other phases (e.g., `semanticAnalysis`) includes their time.
+     * ```
+     * Phase                        Calls    Total (ms)  Average (ms)
+     * tokenize                         2         0.412         0.206
+     * parseClass                      12         1.204         0.100
+     * ```
+     */
+    void print_time_report(std::ostream &out);
+
+    /**
+     * @brief Writes the recorded phases as Chrome trace events, for `chrome://tracing` or Perfetto.
+     *
+     * Every phase is a complete event (`"ph": "X"`) on the thread that ran it, the class (or the file) and
+     * the method are its arguments.
+     *
+     * @param path The JSON file to write.
+     */
+    void write_trace(const std::string &path);
+
+    /// Escapes a string for a JSON string literal (also used by the codegen report).
+    std::string json_escape(const std::string &text);
+}
+
+/**
+ * @class ScopedTimer
+ * @brief Measures a phase of the compiler from its construction to its destruction.
+ *
+ * ```cpp
+ * ScopedTimer timer("semanticAnalysis", clazz->getName(), method.getName());
+ * ```
+ */
+class ScopedTimer {
+private:
+    const char *phase;
+    std::string name;
+    std::string method;
+    uint64_t start = 0;
+    bool tracked;
+
+public:
+    explicit ScopedTimer(const char *phase) : phase(phase), tracked(memory::enabled) {
+        if (profiler::enabled) {
+            start = profiler::now();
+        }
+        if (tracked) {
+            memory::enter(phase, false);
+        }
+    }
+
+    /// A phase of a class, or of a file
+    ScopedTimer(const char *phase, const std::string &name) : phase(phase), tracked(memory::enabled) {
+        if (profiler::enabled) {
+            this->name = name;
+            start = profiler::now();
+        }
+        if (tracked) {
+            memory::enter(phase, false);
+        }
+    }
+
+    ScopedTimer(const char *phase, const std::string &clazz, const std::string &method)
+            : phase(phase), tracked(memory::enabled) {
+        if (profiler::enabled) {
+            name = clazz;
+            this->method = method;
+            start = profiler::now();
+        }
+        if (tracked) {
+            memory::enter(phase, false);
+        }
+    }
+
+    ScopedTimer(const ScopedTimer &) = delete;
+
+    ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+    /// Names the class of the phase once it is known (e.g., after `parseClass` read the name).
+    void describe(const std::string &clazz) {
+        if (start) {
+            name = clazz;
+        }
+    }
+
+    ~ScopedTimer() {
+        if (tracked) {
+            memory::leave(false);
+        }
+        if (start) {
+            profiler::record(phase, std::move(name), std::move(method), start, profiler::now());
+        }
+    }
+};
+
+#endif //SIMPLEMINIJAVACOMPILERTOC_PROFILER_H
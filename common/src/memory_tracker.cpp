@@ -0,0 +1,204 @@
+#include "../include/memory_tracker.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+#ifdef __APPLE__
+#include <malloc/malloc.h>
+#define usable_size malloc_size
+#else
+#include <malloc.h>
+#define usable_size malloc_usable_size
+#endif
+
+namespace memory {
+    bool enabled = false;
+
+    /**
+     * @brief The memory charged to a phase or a category.
+     */
+    struct Usage {
+        const char *name;
+        bool category;
+        size_t calls;
+        size_t allocations;
+        uint64_t allocated;
+        int64_t retained;
+        int64_t peak;
+    };
+
+    /**
+     * @brief The phases or the categories a thread is in, innermost last.
+     *
+     * Plain arrays: the tracker runs inside `operator new`, it must not allocate.
+     */
+    struct Stack {
+        static const int CAPACITY = 32;
+        int usages[CAPACITY];
+        int64_t liveAtEntry[CAPACITY];
+        int depth;
+    };
+
+    const int MAX_USAGES = 128;
+    Usage usages[MAX_USAGES];
+    int usageCount = 0;
+    std::mutex usagesLock;
+
+    std::atomic<int64_t> live{0};
+    std::atomic<int64_t> peak{0};
+    std::atomic<uint64_t> allocations{0};
+
+    thread_local Stack phases;
+    thread_local Stack categories;
+
+    void enable() {
+        std::lock_guard<std::mutex> guard(usagesLock);
+        usageCount = 0;
+        live = 0;
+        peak = 0;
+        allocations = 0;
+        enabled = true;
+    }
+
+    /// Index of the usage of a name, created on first use (called with `usagesLock` held)
+    int find_usage(const char *name, bool category) {
+        for (int i = 0; i < usageCount; i++) {
+            if (usages[i].category == category && (usages[i].name == name || strcmp(usages[i].name, name) == 0)) {
+                return i;
+            }
+        }
+        if (usageCount == MAX_USAGES) {
+            return MAX_USAGES - 1;
+        }
+        usages[usageCount] = {name, category, 0, 0, 0, 0, 0};
+        return usageCount++;
+    }
+
+    void enter(const char *name, bool category) {
+        Stack &stack = category ? categories : phases;
+        std::lock_guard<std::mutex> guard(usagesLock);
+        int usage = find_usage(name, category);
+        usages[usage].calls++;
+        if (stack.depth < Stack::CAPACITY) {
+            stack.usages[stack.depth] = usage;
+            stack.liveAtEntry[stack.depth] = live;
+        }
+        stack.depth++;
+    }
+
+    void leave(bool category) {
+        Stack &stack = category ? categories : phases;
+        if (--stack.depth < Stack::CAPACITY) {
+            std::lock_guard<std::mutex> guard(usagesLock);
+            usages[stack.usages[stack.depth]].retained += live - stack.liveAtEntry[stack.depth];
+        }
+    }
+
+    /// Charges an allocation to the phases and categories the thread is in, "other" if it has no category
+    void charge(size_t bytes) {
+        int64_t now = live += (int64_t) bytes;
+        allocations++;
+        int64_t highest = peak;
+        while (now > highest && !peak.compare_exchange_weak(highest, now)) {
+        }
+
+        std::lock_guard<std::mutex> guard(usagesLock);
+        auto account = [&](int usage) {
+            usages[usage].allocations++;
+            usages[usage].allocated += bytes;
+            usages[usage].peak = std::max(usages[usage].peak, now);
+        };
+        for (int i = 0; i < phases.depth && i < Stack::CAPACITY; i++) {
+            account(phases.usages[i]);
+        }
+        for (int i = 0; i < categories.depth && i < Stack::CAPACITY; i++) {
+            account(categories.usages[i]);
+        }
+        if (categories.depth == 0) {
+            account(find_usage("other", true));
+        }
+    }
+
+    void release(size_t bytes) {
+        live -= (int64_t) bytes;
+    }
+
+    void print_memory_report(std::ostream &out) {
+        std::lock_guard<std::mutex> guard(usagesLock);
+        char line[200];
+        snprintf(line, sizeof(line), "Memory: %.3f MB live, %.3f MB peak, %llu allocations\n",
+                 (double) live / 1e6, (double) peak / 1e6, (unsigned long long) allocations);
+        out << line;
+        for (bool category: {false, true}) {
+            snprintf(line, sizeof(line), "%-24s %8s %12s %15s %14s %11s\n", category ? "Category" : "Phase",
+                     "Calls", "Allocations", "Allocated (KB)", "Retained (KB)", "Peak (KB)");
+            out << "\n" << line;
+            for (int i = 0; i < usageCount; i++) {
+                Usage &usage = usages[i];
+                if (usage.category != category) {
+                    continue;
+                }
+                snprintf(line, sizeof(line), "%-24s %8zu %12zu %15.1f %14.1f %11.1f\n", usage.name, usage.calls,
+                         usage.allocations, (double) usage.allocated / 1e3, (double) usage.retained / 1e3,
+                         (double) usage.peak / 1e3);
+                out << line;
+            }
+        }
+    }
+}
+
+/*
+ * The allocation functions of the compiler. Blocks keep the layout of `malloc`, the counted size is the
+ * usable size of the block, so blocks allocated before tracking was enabled can be freed at any time.
+ */
+
+void *operator new(std::size_t size) {
+    void *block = malloc(size ? size : 1);
+    if (!block) {
+        throw std::bad_alloc();
+    }
+    if (memory::enabled) {
+        memory::charge(usable_size(block));
+    }
+    return block;
+}
+
+void *operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+    void *block = malloc(size ? size : 1);
+    if (block && memory::enabled) {
+        memory::charge(usable_size(block));
+    }
+    return block;
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &tag) noexcept {
+    return operator new(size, tag);
+}
+
+void operator delete(void *block) noexcept {
+    if (block && memory::enabled) {
+        memory::release(usable_size(block));
+    }
+    free(block);
+}
+
+void operator delete[](void *block) noexcept {
+    operator delete(block);
+}
+
+void operator delete(void *block, std::size_t) noexcept {
+    operator delete(block);
+}
+
+void operator delete[](void *block, std::size_t) noexcept {
+    operator delete(block);
+}
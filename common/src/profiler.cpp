@@ -0,0 +1,146 @@
+#include "../include/profiler.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace profiler {
+    bool enabled = false;
+
+    /**
+     * @brief A finished phase.
+     */
+    struct Event {
+        const char *phase;
+        std::string name;
+        std::string method;
+        uint64_t start;
+        uint64_t end;
+        uint32_t thread;
+    };
+
+    std::vector<Event> events;
+    std::mutex eventsLock;
+    uint64_t origin = 0;
+    std::atomic<uint32_t> threads{0};
+
+    /// A small id of the calling thread, 1 for the first thread recording a phase
+    uint32_t thread_id() {
+        thread_local uint32_t id = ++threads;
+        return id;
+    }
+
+    void enable() {
+        std::lock_guard<std::mutex> guard(eventsLock);
+        events.clear();
+        origin = now();
+        enabled = true;
+    }
+
+    void record(const char *phase, std::string name, std::string method, uint64_t start, uint64_t end) {
+        uint32_t thread = thread_id();
+        std::lock_guard<std::mutex> guard(eventsLock);
+        events.push_back({phase, std::move(name), std::move(method), start, end, thread});
+    }
+
+    void print_time_report(std::ostream &out) {
+        std::lock_guard<std::mutex> guard(eventsLock);
+        struct Total {
+            size_t calls = 0;
+            uint64_t time = 0;
+            uint64_t first = UINT64_MAX;
+        };
+        std::map<std::string, Total> totals;
+        uint64_t end = origin;
+        for (auto &event: events) {
+            Total &total = totals[event.phase];
+            total.calls++;
+            total.time += event.end - event.start;
+            total.first = std::min(total.first, event.start);
+            end = std::max(end, event.end);
+        }
+        std::vector<std::pair<std::string, Total>> phases(totals.begin(), totals.end());
+        std::stable_sort(phases.begin(), phases.end(), [](auto &a, auto &b) { return a.second.first < b.second.first; });
+
+        char line[160];
+        snprintf(line, sizeof(line), "%-28s %8s %13s %13s\n", "Phase", "Calls", "Total (ms)", "Average (ms)");
+        out << line;
+        for (auto &phase: phases) {
+            double total = (double) phase.second.time / 1e6;
+            snprintf(line, sizeof(line), "%-28s %8zu %13.3f %13.3f\n", phase.first.c_str(), phase.second.calls,
+                     total, total / (double) phase.second.calls);
+            out << line;
+        }
+        snprintf(line, sizeof(line), "%-28s %8s %13.3f\n", "(wall time)", "", (double) (end - origin) / 1e6);
+        out << line;
+
+        std::vector<const Event *> detailed;
+        for (auto &event: events) {
+            if (!event.name.empty()) {
+                detailed.push_back(&event);
+            }
+        }
+        if (detailed.empty()) {
+            return;
+        }
+        size_t shown = std::min<size_t>(10, detailed.size());
+        std::partial_sort(detailed.begin(), detailed.begin() + (long) shown, detailed.end(),
+                          [](const Event *a, const Event *b) { return a->end - a->start > b->end - b->start; });
+        out << "\nSlowest classes and methods:\n";
+        for (size_t i = 0; i < shown; i++) {
+            const Event *event = detailed[i];
+            std::string name = event->method.empty() ? event->name : event->name + "." + event->method;
+            snprintf(line, sizeof(line), "%-28s %-36s %9.3f ms\n", event->phase, name.c_str(),
+                     (double) (event->end - event->start) / 1e6);
+            out << line;
+        }
+    }
+
+    std::string json_escape(const std::string &text) {
+        std::string result;
+        for (char c: text) {
+            if (c == '"' || c == '\\') {
+                result += '\\';
+                result += c;
+            } else if ((unsigned char) c < 0x20) {
+                char escaped[8];
+                snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                result += escaped;
+            } else {
+                result += c;
+            }
+        }
+        return result;
+    }
+
+    void write_trace(const std::string &path) {
+        std::lock_guard<std::mutex> guard(eventsLock);
+        std::ofstream out(path);
+        if (!out.is_open()) {
+            std::cerr << "Error: Unable to create the trace file '" << path << "'." << std::endl;
+            return;
+        }
+        out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+        out << "{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": 1, \"args\": {\"name\": \"minijava\"}}";
+        for (auto &event: events) {
+            char times[96];
+            snprintf(times, sizeof(times), "\"ts\": %.3f, \"dur\": %.3f", (double) (event.start - origin) / 1e3,
+                     (double) (event.end - event.start) / 1e3);
+            out << ",\n{\"name\": \"" << event.phase << "\", \"cat\": \"compiler\", \"ph\": \"X\", " << times
+                << ", \"pid\": 1, \"tid\": " << event.thread;
+            if (!event.name.empty()) {
+                out << ", \"args\": {\"name\": \"" << json_escape(event.name) << "\"";
+                if (!event.method.empty()) {
+                    out << ", \"method\": \"" << json_escape(event.method) << "\"";
+                }
+                out << "}";
+            }
+            out << "}";
+        }
+        out << "\n]}\n";
+    }
+}
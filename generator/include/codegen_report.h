@@ -0,0 +1,118 @@
+#ifndef SIMPLEMINIJAVACOMPILERTOC_CODEGEN_REPORT_H
+#define SIMPLEMINIJAVACOMPILERTOC_CODEGEN_REPORT_H
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Statistics and optimization remarks of the C code generation (`--codegen-report` and `--remarks`).
+ *
+ * While the report is enabled, the TAC generator of every method counts what it emits and explains the
+ * decisions it takes, in the manner of the `-Rpass` remarks of Clang:
+ * - **passed**: an optimization was applied (e.g., a `switch` lowered to a jump table).
+ * - **missed**: an optimization was not applied, and why (e.g., a call dispatched through `$_function_`).
+ * - **analysis**: a fact about the code that explains its cost (e.g., an array access without bounds check).
+ *
+ * The report is off by default, then the generator only checks `codegen_report::enabled`.
+ */
+namespace codegen_report {
+    /// Whether the statistics and remarks are recorded, see `enable`
+    extern bool enabled;
+
+    /**
+     * @brief An optimization remark at a position of the Mini-Java source.
+     */
+    struct Remark {
+        /// `passed`, `missed` or `analysis`
+        const char *kind;
+        /// The optimization (e.g., `devirtualize`, `inline`, `bounds-check`, `unroll`, `switch`)
+        const char *pass;
+        /// The line in the Mini-Java source, `0` if unknown
+        int line;
+        std::string message;
+    };
+
+    /**
+     * @brief A call site of a profile-guided build guarded by the class of its receiver.
+     */
+    struct Guard {
+        /// The line in the Mini-Java source, `0` if unknown
+        int line;
+        /// The class the receiver is tested for
+        std::string receiver;
+        /// The method called when the guard holds (e.g., `Square.area`)
+        std::string target;
+        /// Whether the target is inlined
+        bool inlined;
+        /// The calls of the site in the profile
+        uint64_t calls;
+        /// The calls of the site in the profile whose receiver was of the class of the guard
+        uint64_t hits;
+    };
+
+    /**
+     * @brief What the TAC generator emitted for a method.
+     */
+    struct MethodStats {
+        std::string clazz;
+        std::string method;
+        /// Lines of TAC emitted (assignments, calls, jumps), labels excluded
+        int instructions = 0;
+        /// `$_t_` temporaries
+        int temps = 0;
+        int labels = 0;
+        /// Calls of a C function by its name (static methods)
+        int directCalls = 0;
+        /// Calls through a `$_function_` pointer or an itable
+        int indirectCalls = 0;
+        /// Methods of `String` and of channels compiled to inline fast paths, and inlined Mini-Java methods
+        int inlinedCalls = 0;
+        /// Calls through a `$_function_` pointer or an itable guarded by the class of their receiver
+        int guardedCalls = 0;
+        /// `new` expressions
+        int allocations = 0;
+        /// Element accesses of `int[]`
+        int arrayAccesses = 0;
+        /// Bytes of C emitted for the method, its outlined functions included
+        size_t bytes = 0;
+        std::vector<Remark> remarks;
+        std::vector<Guard> guards;
+    };
+
+    /// Starts recording, the methods recorded so far are dropped.
+    void enable();
+
+    /// Records the statistics of a generated method, called by `generate_class_source`.
+    void record(MethodStats stats);
+
+    /**
+     * @brief Writes the statistics and remarks of every class and method as JSON.
+     * ```json
+     * {"classes": [{"name": "Merger", "instructions": 61, ..., "methods": [
+     *   {"name": "merge", "instructions": 61, "temps": 27, "labels": 12, "directCalls": 0, "indirectCalls": 0,
+     *    "inlinedCalls": 0, "guardedCalls": 0, "allocations": 1, "arrayAccesses": 9, "bytes": 2048, "remarks": [
+     *     {"kind": "analysis", "pass": "bounds-check", "line": 58, "message": "..."}], "guards": []}]}]}
+     * ```
+     * The guards of a profile-guided build have the hit rate their receivers had in the profile:
+     * ```json
+     * {"line": 12, "receiver": "Square", "target": "Square.area", "inlined": true, "calls": 10000,
+     *  "hits": 9000, "hitRate": 0.9}
+     * ```
+     * @param path The JSON file to write.
+     */
+    void write_report(const std::string &path);
+
+    /**
+     * @brief Prints the remarks, one per line, in the format of Clang.
+     * ```
+     * MergeSort.sort:12: remark: call of MergeSort.sort is not devirtualized, ... [-Rpass-missed=devirtualize]
+     * ```
+     * @param out The stream to print to.
+     * @param passes Comma-separated passes to print (e.g., `inline,devirtualize`), all of them if empty.
+     */
+    void print_remarks(std::ostream &out, const std::string &passes);
+}
+
+#endif //SIMPLEMINIJAVACOMPILERTOC_CODEGEN_REPORT_H
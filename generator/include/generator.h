@@ -3,12 +3,32 @@
 
 #include "../../parser/include/project.h"
 
+/**
+ * @brief Options of the C code generation (see `generate`).
+ */
+struct GenerateOptions {
+    /// Instruments the program with counters of methods, branches and call sites (`--instrument`). The program
+    /// writes its profile when it exits (see `write_profile`).
+    bool instrument = false;
+    /// The profile of a run of an instrumented build (`--profile-use minijava.profile`), empty for none. The
+    /// generator lays out, inlines and places the methods by the counts of the profile (see `read_profile`).
+    std::string profile;
+    /// Emits `#line` directives referring to the Mini-Java source (`--line-directives`), debuggers and profilers
+    /// (e.g., `gdb`, `perf`, `valgrind`) then attribute the code of the methods to its lines.
+    bool lineDirectives = false;
+    /// Writes the lines of the generated C files mapped to the methods and lines of the Mini-Java source as JSON
+    /// (`--source-map map.json`), empty for none (see `write_source_map`).
+    std::string sourceMap;
+    /// The path of the Mini-Java source, named by the `#line` directives and the source map (`--source Main.java`)
+    std::string sourcePath = "Main.java";
+};
+
 /**
  * @brief Main entry point for generating C code from a Mini-Java project.
  *
  * This function coordinates the complete code generation process, including:
  * 1. Generating header and source files for each class
- * 2. Creating support files for arrays
+ * 2. Creating support files for arrays and strings
  * 3. Setting up the build system
  *
  * The generation process creates the following structure:
@@ -17,6 +37,8 @@
  * ├── CMakeLists.txt           // Build system configuration
  * ├── __int_array.h           // Support for int[] operations
  * ├── __int_array.c
+ * ├── __string.h              // Support for String operations and the string constant pool
+ * ├── __string.c
  * ├── ClassA.h                // Generated class headers
  * ├── ClassA.c                // Generated class implementations
  * ├── ClassB.h
@@ -85,6 +107,7 @@
  * ```
  *
  * @param project Pointer to the validated Project AST
+ * @param options Options of the generation (e.g., an instrumented or a profile-guided build)
  *
  * Generation Process:
  * 1. For each class:
@@ -95,9 +118,80 @@
  *      + Generate initialization and functions
  *      + Generate TAC code from AST
  *    - Track included dependencies
- * 2. Generate int array support files
+ * 2. Generate int array and string support files (including the interned string literals)
  * 3. Generate CMake build configuration
  */
-void generate(Project *project);
+void generate(Project *project, const GenerateOptions &options = {});
+
+/**
+ * @brief Generates x86-64 assembly for a Mini-Java project, an alternative to `generate` that doesn't need
+ * a C compiler.
+ *
+ * Every method is lowered from the AST to a three-address code over virtual registers, the virtual
+ * registers are assigned to machine registers by a linear scan allocator, and the code is emitted for the
+ * System V ABI. Objects have the layout of the structs of the C output, virtual calls go through the
+ * `$_function_` pointers of the object. The program is linked with a small runtime using Linux system
+ * calls only (allocation, `int[]` and printing), without the C library.
+ *
+ * The generated files:
+ * ```
+ * compile/
+ * ├── program.s               // The classes of the program
+ * └── __runtime.s             // Entry point, allocation and printing
+ * ```
+ * Build:
+ * ```
+ * as compile/__runtime.s compile/program.s -o program.o && ld program.o -o program
+ * ```
+ *
+ * The backend compiles a subset of the language: `int`, `boolean`, `int[]`, classes, inheritance, static
+ * members and the statements and operators on them. Strings, interfaces, threads, channels, `spawn`,
+ * `synchronized`, exceptions, downcasts and `instanceof` need the C runtime, they are reported as errors.
+ * `@Parallel` loops run sequentially and `@Memoize` methods are not cached.
+ *
+ * @param project Pointer to the validated Project AST
+ */
+void generate_asm(Project *project);
+
+/**
+ * @brief Compiles a Mini-Java project to x86-64 machine code in memory and runs it (the `--run` mode).
+ *
+ * The methods are lowered and allocated as by `generate_asm`, then encoded directly into a buffer by
+ * templates of machine code, one per instruction of the three-address code. The buffer is mapped
+ * executable and `main` is called in the process of the compiler, no file is written and no tool is run.
+ * Allocation, arrays and printing are functions of the compiler itself, the objects of the run are freed
+ * when it ends.
+ *
+ * The language subset is the one of `generate_asm`. With the environment variable `MINIJAVA_JIT_STATS`
+ * set, the compile time and the latency of the first output are printed to `stderr`:
+ * ```
+ * JIT: 12 methods, 4096 bytes of code, compiled in 0.184 ms, first output after 0.201 ms, finished after 3.112 ms
+ * ```
+ *
+ * @param project Pointer to the validated Project AST
+ * @return The exit status of the program
+ */
+int run_jit(Project *project);
+
+/**
+ * @brief Compiles a Mini-Java project to a register-based bytecode and interprets it (the `--interpret` mode).
+ *
+ * For hosts without a C compiler or an executable mapping: the three-address code of `generate_asm` is
+ * translated to bytecode, its virtual registers become the registers of the frame of the method. The
+ * interpreter threads its dispatch through computed gotos. Common pairs run as superinstructions: a
+ * comparison and its branch, `i = i + 1`, an element of an `int[]` field, and the load of a `$_function_`
+ * pointer with the virtual call, which keeps an inline cache of the receiver's class. Allocation, arrays
+ * and printing are shared with `run_jit`.
+ *
+ * The language subset is the one of `generate_asm`. With the environment variable `MINIJAVA_VM_STATS`
+ * set, the statistics of the run are printed to `stderr`:
+ * ```
+ * VM: 12 methods, 301 instructions (64 fused), compiled in 0.121 ms, first output after 0.133 ms, finished after 9.210 ms, 4000 virtual calls (3 inline cache misses)
+ * ```
+ *
+ * @param project Pointer to the validated Project AST
+ * @return The exit status of the program
+ */
+int run_vm(Project *project);
 
 #endif //SIMPLEMINIJAVACOMPILERTOC_GENERATOR_H
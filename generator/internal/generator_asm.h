@@ -0,0 +1,224 @@
+#ifndef SIMPLEMINIJAVACOMPILERTOC_GENERATOR_ASM_H
+#define SIMPLEMINIJAVACOMPILERTOC_GENERATOR_ASM_H
+
+#include "generator_internal.h"
+#include <chrono>
+#include <unordered_map>
+
+/**
+ * @enum AsmOp
+ * @brief The operations of the three-address code lowered to x86-64 (see `generate_asm`).
+ *
+ * Operands are virtual registers, numbered from 0 in every method, assigned to machine registers or
+ * stack slots by `allocate_registers`.
+ */
+enum class AsmOp {
+    Move,           ///< `dst = a`
+    LoadImmediate,  ///< `dst = imm`
+    Binary,         ///< `dst = a <name> b` on 32-bit ints (`+`, `-`, `*`, `/`, `%`, `&`, `|`, `^`, `<<`, `>>`, `>>>`)
+    Compare,        ///< `dst = a <name> b`, 64-bit if `size` is 8 (references)
+    Not,            ///< `dst = !a`
+    BitNot,         ///< `dst = ~a`
+    Load,           ///< `dst = *(a + imm)`, `size` bytes
+    Store,          ///< `*(a + imm) = b`, `size` bytes
+    LoadIndex,      ///< `dst = a->data[b]` of an `int[]`
+    StoreIndex,     ///< `a->data[b] = c` of an `int[]`
+    LoadGlobal,     ///< `dst = <name>`, `size` bytes
+    StoreGlobal,    ///< `<name> = a`, `size` bytes
+    Call,           ///< `dst = <name>(args...)`, `dst` is -1 for `void`
+    CallIndirect,   ///< `dst = (*a)(args...)`
+    Jump,           ///< `goto <name>`
+    JumpIfZero,     ///< `if (!a) goto <name>`
+    Label,          ///< `<name>:`
+    Return,         ///< `return a`, `a` is -1 for `void`
+};
+
+/**
+ * @struct AsmInstruction
+ * @brief An instruction of the three-address code of a method.
+ */
+struct AsmInstruction {
+    AsmOp op;
+    int dst = -1;
+    int a = -1;
+    int b = -1;
+    int c = -1;
+    /// Immediate value or byte offset
+    long long imm = 0;
+    /// Bytes loaded or stored, or compared
+    int size = 4;
+    /// Operator, label or symbol
+    std::string name;
+    /// Arguments of calls, the receiver first
+    std::vector<int> args;
+};
+
+/**
+ * @struct AsmLayout
+ * @brief The layout of the objects of a class, identical to the C struct of the class (see `write_fields`).
+ */
+struct AsmLayout {
+    /// Size of the object in bytes
+    long long size = 0;
+    /// Alignment of the object
+    long long align = 8;
+    /// Offsets of the instance fields, inherited fields included
+    std::unordered_map<Identifier, long long> fields;
+    /// Offsets of the `$_function_` pointers of every class of the hierarchy, with their method
+    std::vector<std::pair<long long, Identifier>> slots;
+    /// Offsets of the `$_function_` pointers called by virtual calls, of the nearest class declaring the method
+    std::unordered_map<Identifier, long long> methods;
+};
+
+/**
+ * @struct AsmLocation
+ * @brief The storage of a value reached by a reference chain, the target of an assignment.
+ */
+struct AsmLocation {
+    enum Kind {
+        Value,      ///< A computed value in `reg`, not assignable
+        Local,      ///< A local variable or parameter in `reg`
+        Field,      ///< `*(reg + offset)`
+        Static,     ///< The global `symbol`
+        Element,    ///< `reg->data[index]`
+        ClassName,  ///< `ClassName.` before a static member
+    } kind = Value;
+    int reg = -1;
+    int index = -1;
+    long long offset = 0;
+    std::string symbol;
+    Identifier type;
+};
+
+/**
+ * @struct AsmGenerator
+ * @brief Lowers the methods of a class to `AsmInstruction`s.
+ *
+ * The lowering follows the C generator (see `ThreeAddressCodeGenerator`): every expression is evaluated
+ * into a new virtual register, locals are virtual registers of their own and the control flow is made of
+ * labels and jumps.
+ */
+struct AsmGenerator {
+    Project *project;
+    Class *clazz;
+    Method *method;
+    /// Layouts of the classes of the program
+    std::map<Identifier, AsmLayout> *layouts;
+    std::vector<AsmInstruction> code;
+    /// Number of virtual registers of the method
+    int registers = 0;
+    /// Virtual register of `this`, -1 in static methods
+    int self = -1;
+    /// Virtual registers of the parameters, in order
+    std::vector<int> params;
+    /// Scopes of the local variables (name → virtual register and type)
+    std::vector<std::unordered_map<Identifier, std::pair<int, Identifier>>> scopes;
+    /// Targets of `break` and `continue`, innermost last (`continue` is empty for a `switch`)
+    std::vector<std::pair<std::string, std::string>> targets;
+    /// Prefix of the labels of the method
+    std::string labelPrefix;
+    int labels = 0;
+
+    int newRegister() {
+        return registers++;
+    }
+
+    std::string newLabel(const std::string &name) {
+        return labelPrefix + name + "_" + std::to_string(labels++);
+    }
+
+    void emit(AsmInstruction instruction) {
+        code.push_back(std::move(instruction));
+    }
+
+    void emitLabel(const std::string &label) {
+        emit({AsmOp::Label, -1, -1, -1, -1, 0, 4, label});
+    }
+
+    void emitJump(AsmOp op, const std::string &label, int condition = -1) {
+        emit({op, -1, condition, -1, -1, 0, 4, label});
+    }
+
+    int lookup(const Identifier &name, Identifier *type = nullptr) {
+        for (auto it = scopes.rbegin(); it != scopes.rend(); it++) {
+            auto found = it->find(name);
+            if (found != it->end()) {
+                if (type) {
+                    *type = found->second.second;
+                }
+                return found->second.first;
+            }
+        }
+        return -1;
+    }
+};
+
+/**
+ * @struct AsmAllocation
+ * @brief The machine location of every virtual register of a method.
+ */
+struct AsmAllocation {
+    /// Machine register of every virtual register (e.g., `rbx`), empty if it is spilled
+    std::vector<std::string> registers;
+    /// Stack slot of every spilled virtual register, -1 if it is in a register
+    std::vector<int> slots;
+    /// Number of stack slots
+    int slotCount = 0;
+    /// Callee-saved registers used by the method, saved by its prologue
+    std::vector<std::string> saved;
+};
+
+AsmLayout &get_asm_layout(Project *project, std::map<Identifier, AsmLayout> &layouts, Class *clazz);
+
+std::vector<Class *> get_asm_classes(Project *project);
+
+void check_asm_type(Project *project, const Identifier &type, Token *token);
+
+[[noreturn]] void asm_unsupported(const std::string &what, Token *token = nullptr);
+
+std::string get_asm_static_name(const Identifier &clazz, const Identifier &field);
+
+int get_asm_size(const Identifier &type);
+
+void lower_method(AsmGenerator &gen);
+
+AsmAllocation allocate_registers(const std::vector<AsmInstruction> &code, int registerCount);
+
+std::string emit_method(
+        const std::string &symbol,
+        const std::vector<AsmInstruction> &code,
+        const std::vector<int> &params,
+        const AsmAllocation &allocation
+);
+
+void write_asm_runtime();
+
+/**
+ * @brief The runtime of the programs run in the process of the compiler, by the JIT and the bytecode VM.
+ *
+ * Objects and arrays have the layout of the C output, they are allocated in an arena freed by `reset`.
+ */
+namespace jit_runtime {
+    /// Time of the first print of the run, if `printed`
+    extern std::chrono::steady_clock::time_point firstOutput;
+    extern bool printed;
+
+    void *alloc(long size);
+
+    void *new_array(int length);
+
+    void *slice(char *array, int from, int to);
+
+    void print_int(int value, int newLine);
+
+    void flush();
+
+    [[noreturn]] void fail(const char *message);
+
+    /// Handler of `SIGSEGV`, reports a `NullPointerException`
+    void null_pointer(int);
+
+    void reset();
+}
+
+#endif //SIMPLEMINIJAVACOMPILERTOC_GENERATOR_ASM_H
@@ -2,21 +2,247 @@
 #define SIMPLEMINIJAVACOMPILERTOC_GENERATOR_INTERNAL_H
 
 #include "../../common/include/error_handler.h"
+#include "../../common/include/profiler.h"
+#include "../include/codegen_report.h"
 #include "../include/generator.h"
 #include "../../lexer/include/lexer.h"
 
+/**
+ * @brief The constant pool of the program, maps each interned string literal to its index in the pool.
+ */
+typedef std::map<std::string, int> StringPool;
+
+/**
+ * @brief A counted point of a method in an instrumented build (`--instrument`, see `write_profile`).
+ */
+struct ProfileSite {
+    /// The method counted
+    Identifier method;
+    /// `entry` (calls of the method), `branch` (a taken and a fall-through counter), `call` (a call site) or
+    /// `receiver` (the calls of the last call site whose receiver is of a class)
+    const char *kind;
+    /// The statement of a branch (e.g., `while`), the called method of a call site (e.g., `Merger.merge`) or the
+    /// class of a receiver
+    std::string detail;
+    /// The line in the Mini-Java source, `0` if unknown
+    int line;
+    /// Index of its first counter in `$_profile_counters`
+    int counter;
+};
+
+/**
+ * @brief The counters of the methods of a class in an instrumented build.
+ */
+struct ProfileSites {
+    std::vector<ProfileSite> sites;
+    /// The number of counters, a branch has two
+    int counters = 0;
+
+    /**
+     * @brief Adds a site and its counters.
+     * @return The index of the first counter of the site
+     */
+    int add(const Identifier &method, const char *kind, const std::string &detail, int line) {
+        sites.push_back({method, kind, detail, line, counters});
+        counters += std::string(kind) == "branch" ? 2 : 1;
+        return sites.back().counter;
+    }
+
+    /// The C expression incrementing a counter (e.g., `$_profile_count($_profile_counters[3])`)
+    static std::string count(int counter) {
+        return "$_profile_count($_profile_counters[" + std::to_string(counter) + "])";
+    }
+
+    /// The C expression incrementing a counter of a site chosen at run time (e.g., by the class of a receiver)
+    static std::string count(int first, const std::string &offset) {
+        return "$_profile_count($_profile_counters[" + std::to_string(first) + " + " + offset + "])";
+    }
+};
+
+/**
+ * @brief The counts of a branch in a profile: the taken edge jumps to the label of the branch.
+ */
+struct BranchCount {
+    int line;
+    uint64_t taken;
+    uint64_t fallthrough;
+};
+
+/**
+ * @brief The counts of a call site in a profile.
+ */
+struct CallCount {
+    int line;
+    uint64_t calls;
+    /// The calls by class of the receiver, for the calls dispatched through `$_function_` or an itable
+    std::map<Identifier, uint64_t> receivers;
+};
+
+/**
+ * @brief The counts of a method in a profile, its sites in the order the instrumented build generated them.
+ *
+ * The generator of a profile-guided build visits the same sites in the same order, it matches them by their
+ * position in the method and checks their line (a site of another line is stale, it is ignored).
+ */
+struct MethodProfile {
+    uint64_t entries = 0;
+    std::vector<BranchCount> branches;
+    std::vector<CallCount> calls;
+};
+
+/**
+ * @brief The profile of a run of an instrumented build (see `read_profile`).
+ */
+struct Profile {
+    /// The methods by class, then by name
+    std::map<Identifier, std::map<Identifier, MethodProfile>> classes;
+    /// The calls of all the methods
+    uint64_t entries = 0;
+    /// The calls of all the call sites
+    uint64_t calls = 0;
+
+    /// The counts of a method, `nullptr` if the method is not in the profile
+    const MethodProfile *find(const Identifier &clazz, const Identifier &method) const {
+        auto it = classes.find(clazz);
+        if (it == classes.end()) {
+            return nullptr;
+        }
+        auto found = it->second.find(method);
+        return found == it->second.end() ? nullptr : &found->second;
+    }
+};
+
+/// A method or a call site is hot from this many calls (and 1% of the calls of the program for a method)
+const uint64_t PGO_HOT_CALLS = 1000;
+
+/// The TAC instructions a method may have to be inlined at a hot call site
+const int PGO_INLINE_BUDGET = 40;
+
+/// The TAC instructions a method may have to be inlined at a call site making 1% of the calls of the program
+const int PGO_INLINE_BUDGET_HOTTEST = 160;
+
+/// A branch is laid out by its counts from this many executions
+const uint64_t PGO_MIN_BRANCHES = 100;
+
+/// The percentage of the calls of a hot call site a class of receivers must have to be guarded for
+const uint64_t PGO_GUARD_PERCENT = 80;
+
+/**
+ * @brief A run of lines of a generated C file coming from one line of the Mini-Java source.
+ */
+struct SourceMapping {
+    /// The first line in the C file
+    int line;
+    /// The number of lines
+    int lines;
+    /// The method of the line (e.g., `MergeSort.sort`), the code of an inlined method belongs to that method
+    std::string method;
+    /// The line in the Mini-Java source
+    int sourceLine;
+};
+
+/**
+ * @brief The lines of the generated C files mapped to the Mini-Java source, by name of file (see `map_source_lines`).
+ */
+typedef std::map<std::string, std::vector<SourceMapping>> SourceMap;
+
 void write_file(const std::string& fileName, const std::string& source);
 
 void write_cmake();
 
 void write_int_array();
 
+void write_string(const StringPool &strings);
+
+std::string get_c_string_literal(const std::string &value);
+
+void write_parallel();
+
+void write_forkjoin();
+
+void write_monitor();
+
+void write_channel();
+
+void write_exception();
+
+void write_null_handler(Project *project);
+
+bool needs_null_check(Project *project, const Identifier &type);
+
+void write_memo();
+
+void write_profile();
+
+std::string generate_profile_table(Class *clazz, const ProfileSites &profile);
+
+Profile read_profile(const std::string &path);
+
+std::string get_inline_method_name(Class *clazz, Method *method);
+
+std::string generate_inline_method(
+        Project *project,
+        Class *clazz,
+        Method *method,
+        std::map<Identifier, bool> *types,
+        StringPool *strings,
+        int budget,
+        bool lines
+);
+
+std::string map_source_lines(
+        const std::string &fileName,
+        const std::string &source,
+        const GenerateOptions &options,
+        SourceMap &sourceMap
+);
+
+void write_source_map(const std::string &path, const GenerateOptions &options, const SourceMap &sourceMap);
+
+std::string get_memo_body_name(Class *clazz, Method *method);
+
+std::string generate_memoized_method(Class *clazz, Method *method, const std::string &sign);
+
+void write_reload(Project *project);
+
+std::string generate_reload_redirects(Class *clazz);
+
+std::string generate_reload_redirect(Class *clazz, Method *method);
+
+std::string generate_reload_module(Class *clazz);
+
+void write_class_table(Project *project);
+
+void number_class(
+        Project *project,
+        Class *clazz,
+        std::map<Identifier, std::vector<Class *>> &subclasses,
+        std::map<Identifier, std::pair<int, int>> &ranges,
+        std::vector<Class *> &order
+);
+
+std::vector<Class *> get_classes_by_id(Project *project, Class *root);
+
 void generate_class_header(Project *project, Class *clazz, std::map<Identifier, bool> &included);
 
-void generate_class_source(Project *project, Class *clazz, std::map<Identifier, bool> &included);
+void generate_class_source(
+        Project *project,
+        Class *clazz,
+        std::map<Identifier, bool> &included,
+        StringPool &strings,
+        const GenerateOptions &options,
+        const Profile &profile,
+        SourceMap &sourceMap
+);
+
+void generate_interface(Project *project, Class *interfaceClass);
 
 std::string get_type(const Identifier &type);
 
 std::string get_type(Field *field);
 
+std::string get_static_field_name(const Identifier &clazz, const Identifier &field);
+
+std::string get_method_reference_name(Project *project, Class *clazz, const Identifier &method);
+
 #endif //SIMPLEMINIJAVACOMPILERTOC_GENERATOR_INTERNAL_H
@@ -92,10 +92,26 @@ struct ThreeAddressCodeGenerator {
     Project *project;
     /// Current class context
     Class *clazz;
+    /// Current method context
+    Method *method;
     /// Generated TAC code
     std::string code;
+    /// Functions outlined from the method (e.g., bodies of `@Parallel` loops), emitted before the method
+    std::string functions;
+    /// True while generating the body of a `@Parallel` loop, nested parallel loops run sequentially
+    bool inParallel = false;
+    /// True if the method spawns calls, it has a fork/join frame (`$_fj_frame`) and syncs before returning
+    bool forkJoin = false;
+    /// The method call being spawned, `emitMethodCall` captures it instead of emitting the call
+    MethodCall *spawnCall = nullptr;
+    /// The C expression of the function of the spawned call
+    std::string spawnFunction;
+    /// The evaluated receiver (unless static) and arguments of the spawned call
+    std::vector<std::string> spawnArguments;
     /// Tracks used types (may need to include header files later)
     std::map<Identifier, bool> *types;
+    /// Interned string literals of the program (shared by all classes)
+    StringPool *strings;
     /// Current block depth
     int depth = -1;
     /// Controls block creation
@@ -104,6 +120,31 @@ struct ThreeAddressCodeGenerator {
     std::vector<std::unordered_map<Identifier, Identifier>> localVariables;
     /// Break/continue labels (pair of <start, end> labels)
     std::stack<std::pair<std::string, std::string>> labelStack;
+    /// Monitors held when each label was pushed (pair of <continue, break> counts), exited by jumps
+    std::stack<std::pair<size_t, size_t>> labelMonitors;
+    /// Objects whose monitors are held by the enclosing `synchronized` blocks and method, innermost last
+    std::vector<std::string> monitors;
+    /// Handlers of the enclosing `try` statements (pair of <label, monitors held>), innermost last
+    std::vector<std::pair<std::string, size_t>> handlers;
+    /// Statistics and optimization remarks of the method, see `codegen_report.h`
+    codegen_report::MethodStats stats;
+    /// Line of the Mini-Java source being generated, the position of the remarks and of the counters
+    int line = 0;
+    /// Marks the lines of the Mini-Java source in the code (`--line-directives`, `--source-map`), see `map_source_lines`
+    bool lines = false;
+    /// The line of the last mark
+    int markedLine = 0;
+    /// The counters of the class in an instrumented build (`--instrument`), `nullptr` otherwise
+    ProfileSites *profile = nullptr;
+    /// The profile of the program in a profile-guided build (`--profile-use`), `nullptr` otherwise
+    const Profile *pgo = nullptr;
+    /// The counts of the method in the profile, `nullptr` if it has none
+    const MethodProfile *pgoMethod = nullptr;
+    /// The branches and the call sites generated so far, the positions of the next ones in the profile
+    size_t branchSites = 0;
+    size_t callSites = 0;
+    /// The methods inlined into the file so far by their copy (see `generate_inline_method`), `false` if they can't be
+    std::map<std::string, bool> *inlined = nullptr;
 
     /**
      * @brief Opens a new scope block.
@@ -152,11 +193,15 @@ struct ThreeAddressCodeGenerator {
 
     /**
      * @brief Pushes labels for break/continue statements.
-     * @param start Label for continue (loop start)
+     * @param start Label for continue (loop start), empty if `continue` is not allowed
      * @param end Label for break (loop end)
+     * @param inheritContinue If true, `continue` jumps out of the monitors of the enclosing loop (e.g., in a `switch`)
      */
-    void pushLabel(const std::string &start, const std::string &end) {
+    void pushLabel(const std::string &start, const std::string &end, bool inheritContinue = false) {
+        size_t continueMonitors = inheritContinue && !labelMonitors.empty() ? labelMonitors.top().first
+                                                                             : monitors.size();
         labelStack.push(std::pair(start, end));
+        labelMonitors.push(std::pair(continueMonitors, monitors.size()));
     }
 
     /**
@@ -164,6 +209,17 @@ struct ThreeAddressCodeGenerator {
      */
     void popLabel() {
         labelStack.pop();
+        labelMonitors.pop();
+    }
+
+    /**
+     * @brief Exits the monitors held by the `synchronized` blocks being left, innermost first.
+     * @param count The number of monitors that stay held
+     */
+    void exitMonitors(size_t count) {
+        for (size_t i = monitors.size(); i > count; i--) {
+            emit("$_monitor_exit(" + monitors[i - 1] + ")");
+        }
     }
 
     /**
@@ -175,6 +231,7 @@ struct ThreeAddressCodeGenerator {
             error("Failed to call break, break statement must be called inside a loop");
         }
 
+        exitMonitors(labelMonitors.top().second);
         emit("goto " + labelStack.top().second);
     }
 
@@ -183,19 +240,139 @@ struct ThreeAddressCodeGenerator {
      * Emits: goto start_label
      */
     void continueNow() {
-        if (labelStack.empty()) {
+        if (labelStack.empty() || labelStack.top().first.empty()) {
             error("Failed to call continue, continue statement must be called inside a loop");
         }
 
+        exitMonitors(labelMonitors.top().first);
         emit("goto " + labelStack.top().first);
     }
 
+    /**
+     * @brief Propagates the pending exception (`$_exception`, see `write_exception`).
+     *
+     * Jumps to the innermost handler of the method, exiting the monitors entered in its `try` block.
+     * Without a handler, `main` reports the uncaught exception and other methods return to their caller
+     * (exiting all monitors and syncing their spawned calls), which tests the exception after the call.
+     */
+    void throwNow() {
+        if (!handlers.empty()) {
+            exitMonitors(handlers.back().second);
+            emit("goto " + handlers.back().first);
+            return;
+        }
+        if (method->isMain()) {
+            emit("$_exception_uncaught()");
+            return;
+        }
+        if (forkJoin) {
+            emit("$_fj_sync(&$_fj_frame)");
+        }
+        exitMonitors(0);
+        const Identifier &type = method->getReturnTypeLexeme();
+        if (type == "void") {
+            emit("return");
+        } else {
+            emit(std::string("return ") + (type == "int" ? "0" : type == "boolean" ? "false" : "NULL"));
+        }
+    }
+
     /**
      * @brief Emits a line of TAC code with proper indentation.
      * @param line The code line to emit
      */
     void emit(const std::string &line) {
         code += std::string(depth, '\t') + line + (line.length() > 1 ? ";\n" : "\n");
+        stats.instructions++;
+    }
+
+    /**
+     * @brief The counts of the next branch in the profile, `nullptr` if it has none (or it moved since).
+     *
+     * The branch is the next one `emitBranch` emits, statements may look it up first to lay out their blocks.
+     */
+    const BranchCount *peekBranch() const {
+        if (!pgoMethod || branchSites >= pgoMethod->branches.size()) {
+            return nullptr;
+        }
+        const BranchCount &counts = pgoMethod->branches[branchSites];
+        return counts.line == line && counts.taken + counts.fallthrough >= PGO_MIN_BRANCHES ? &counts : nullptr;
+    }
+
+    /**
+     * @brief The counts of the next call site in the profile, `nullptr` if it has none (or it moved since).
+     */
+    const CallCount *nextCall() {
+        if (!pgoMethod || callSites >= pgoMethod->calls.size()) {
+            callSites++;
+            return nullptr;
+        }
+        const CallCount &counts = pgoMethod->calls[callSites++];
+        return counts.line == line ? &counts : nullptr;
+    }
+
+    /**
+     * @brief Emits a conditional jump, an instrumented build counts its taken and fall-through edges.
+     *
+     * ```c
+     * if (!$_t_0) { $_profile_count($_profile_counters[4]); goto while_end_1; }
+     * $_profile_count($_profile_counters[5]);
+     * ```
+     * In a profile-guided build, a jump taken (or not taken) in 90% of its executions is hinted to the C
+     * compiler, which moves the unlikely block out of the hot path:
+     * ```c
+     * if (__builtin_expect(!!(!$_t_0), 0)) goto while_end_1;
+     * ```
+     * @param condition The condition of the jump (e.g., `!$_t_0`)
+     * @param label The target of the jump
+     * @param statement The statement of the branch (e.g., `while`), named in the profile
+     * @param inverted If true, the jump is the fall-through edge of the branch (the statement swapped its blocks)
+     */
+    void emitBranch(const std::string &condition, const std::string &label, const char *statement,
+                    bool inverted = false) {
+        const BranchCount *counts = peekBranch();
+        branchSites++;
+        std::string test = condition;
+        if (counts) {
+            uint64_t total = counts->taken + counts->fallthrough;
+            uint64_t taken = inverted ? counts->fallthrough : counts->taken;
+            std::string rate = std::to_string(taken * 100 / total) + "% of " + std::to_string(total);
+            if (taken * 10 >= total * 9) {
+                test = "__builtin_expect(!!(" + condition + "), 1)";
+                remark("passed", "layout", std::string("`") + statement + "` jump is likely, taken in " + rate +
+                                           " executions of the profile");
+            } else if (taken * 10 <= total) {
+                test = "__builtin_expect(!!(" + condition + "), 0)";
+                remark("passed", "layout", std::string("`") + statement + "` jump is unlikely, taken in " + rate +
+                                           " executions of the profile");
+            }
+        }
+        if (!profile) {
+            emit("if (" + test + ") goto " + label);
+            return;
+        }
+        int counter = profile->add(method->getName(), "branch", statement, line);
+        // The first counter is always the jump of the statement as written
+        int taken = inverted ? counter + 1 : counter;
+        emitLine("if (" + test + ") { " + ProfileSites::count(taken) + "; goto " + label + "; }");
+        emit(ProfileSites::count(inverted ? counter : counter + 1));
+    }
+
+    /**
+     * @brief Emits a preprocessor directive, at the start of its line.
+     * @param line The directive (e.g., `#ifndef MINIJAVA_HOT_RELOAD`)
+     */
+    void emitDirective(const std::string &line) {
+        code += line + "\n";
+    }
+
+    /**
+     * @brief Emits a line of C code as it is, without a trailing semicolon.
+     * @param line The code line to emit (e.g., `switch (x) {` or `case 1: goto switch_case_0;`)
+     */
+    void emitLine(const std::string &line) {
+        code += std::string(depth, '\t') + line + "\n";
+        stats.instructions++;
     }
 
     /**
@@ -208,9 +385,49 @@ struct ThreeAddressCodeGenerator {
     /**
      * @brief Emits a label in the TAC code.
      * @param label The label to emit
+     * @param cold If true, the code after the label never ran in the profile, GCC lays it out of the hot path
      */
-    void emitLabel(const std::string &label) {
-        code += std::string(depth, '\t') + label + ":;\n";
+    void emitLabel(const std::string &label, bool cold = false) {
+        code += std::string(depth, '\t') + label + (cold ? ": $_cold_path;\n" : ":;\n");
+        stats.labels++;
+    }
+
+    /**
+     * @brief Moves the position of the remarks to a token of the Mini-Java source.
+     * @param token A token of the node being generated (tokens made by the compiler have no position)
+     */
+    void at(const Token &token) {
+        at(token.position.line);
+    }
+
+    /**
+     * @brief Moves the position of the remarks, and of the code that follows, to a line of the Mini-Java source.
+     *
+     * When the lines are marked, a mark `//@line 12` precedes the code of the line.
+     *
+     * @param sourceLine The line (`0` if unknown, the position doesn't move)
+     */
+    void at(int sourceLine) {
+        if (sourceLine <= 0) {
+            return;
+        }
+        line = sourceLine;
+        if (lines && markedLine != sourceLine) {
+            code += "//@line " + std::to_string(sourceLine) + "\n";
+            markedLine = sourceLine;
+        }
+    }
+
+    /**
+     * @brief Explains an optimization decision at the current line, if the codegen report is enabled.
+     * @param kind `passed`, `missed` or `analysis`
+     * @param pass The optimization (e.g., `devirtualize`)
+     * @param message Why the optimization was or was not applied
+     */
+    void remark(const char *kind, const char *pass, const std::string &message) {
+        if (codegen_report::enabled) {
+            stats.remarks.push_back({kind, pass, line, message});
+        }
     }
 
     /**
@@ -219,7 +436,8 @@ struct ThreeAddressCodeGenerator {
      * @param type Variable type
      */
     void addVariable(const Identifier &name, const Identifier &type) {
-        localVariables.front().insert({name, type});
+        // Sibling blocks (e.g., `catch` clauses) may declare the same name with another type
+        localVariables.front()[name] = type;
         types->insert({type, true});
     }
 
@@ -231,6 +449,16 @@ struct ThreeAddressCodeGenerator {
         types->insert({type, true});
     }
 
+    /**
+     * @brief Interns a string literal into the constant pool of the program.
+     * @param value The decoded content of the literal
+     * @return Reference to the pooled `String` (e.g., `$_string_literal(3)`)
+     */
+    std::string internString(const std::string &value) {
+        auto it = strings->insert({value, (int) strings->size()}).first;
+        return "$_string_literal(" + std::to_string(it->second) + ")";
+    }
+
     /**
      * @brief Looks up variable type in current and parent scopes.
      * @param name Variable name to look up
@@ -246,6 +474,25 @@ struct ThreeAddressCodeGenerator {
         return "";
     }
 
+    /**
+     * @brief Finds the class that declares a field, starting from the current class.
+     * @param name Field name to look up
+     * @return The nearest class in the hierarchy declaring the field, or `nullptr` if not found
+     */
+    Class *lookupFieldOwner(const Identifier &name) {
+        Class *clazz_ = clazz;
+        while (clazz_) {
+            if (clazz_->containsField(name)) {
+                return clazz_;
+            }
+            if (clazz_->getExtends().empty()) {
+                break;
+            }
+            clazz_ = project->getClassByName(clazz_->getExtends());
+        }
+        return nullptr;
+    }
+
     /**
      * @brief Counts inheritance levels to reach field.
      * @param name Field name to look up
@@ -297,4 +544,6 @@ std::string generate(
         ReferenceChain *chain
 );
 
+bool contains_spawn(ASTNode *node);
+
 #endif //SIMPLEMINIJAVACOMPILERTOC_GENERATOR_TAC_H
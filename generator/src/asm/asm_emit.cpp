@@ -0,0 +1,321 @@
+#include "../../internal/generator_asm.h"
+
+/// Registers of the arguments of the System V ABI, in order.
+static const char *const ARGUMENT_REGISTERS[] = {"rdi", "rsi", "rdx", "rcx", "r8", "r9"};
+
+/**
+ * @brief Returns the name of the 32-bit part of a 64-bit register (e.g., `rbx` → `ebx`, `r12` → `r12d`).
+ */
+std::string get_register32(const std::string &reg) {
+    if (reg[1] >= '0' && reg[1] <= '9') {
+        return reg + "d";
+    }
+    return "e" + reg.substr(1);
+}
+
+/**
+ * @brief Emits the x86-64 assembly of a method (AT&T syntax).
+ */
+struct AsmEmitter {
+    const AsmAllocation &allocation;
+    std::string output;
+    std::string returnLabel;
+
+    void line(const std::string &instruction) {
+        output += "\t" + instruction + "\n";
+    }
+
+    bool isRegister(int reg) const {
+        return !allocation.registers[reg].empty();
+    }
+
+    /**
+     * @brief The operand of a virtual register, 64-bit or 32-bit.
+     *
+     * Spilled registers are slots of 8 bytes below the callee-saved registers pushed by the prologue.
+     */
+    std::string operand(int reg, bool wide) const {
+        if (isRegister(reg)) {
+            return "%" + (wide ? allocation.registers[reg] : get_register32(allocation.registers[reg]));
+        }
+        long long offset = 8 * (long long) (allocation.saved.size() + allocation.slots[reg] + 1);
+        return "-" + std::to_string(offset) + "(%rbp)";
+    }
+
+    std::string q(int reg) const {
+        return operand(reg, true);
+    }
+
+    std::string l(int reg) const {
+        return operand(reg, false);
+    }
+
+    /// `dst = %eax` (or `%rax`)
+    void storeResult(int dst, bool wide) {
+        if (dst >= 0) {
+            line(wide ? "movq %rax, " + q(dst) : "movl %eax, " + l(dst));
+        }
+    }
+
+    void move(int dst, int src) {
+        if (dst < 0 || q(dst) == q(src)) {
+            return;
+        }
+        if (isRegister(dst) || isRegister(src)) {
+            line("movq " + q(src) + ", " + q(dst));
+        } else {
+            line("movq " + q(src) + ", %rax");
+            line("movq %rax, " + q(dst));
+        }
+    }
+
+    void binary(const AsmInstruction &instruction) {
+        const std::string &op = instruction.name;
+        if (op == "/" || op == "%") {
+            line("movl " + l(instruction.a) + ", %eax");
+            line("cltd");
+            line("idivl " + l(instruction.b));
+            line(op == "/" ? "movl %eax, " + l(instruction.dst) : "movl %edx, " + l(instruction.dst));
+            return;
+        }
+        if (op == "<<" || op == ">>" || op == ">>>") {
+            line("movl " + l(instruction.b) + ", %ecx");
+            line("movl " + l(instruction.a) + ", %eax");
+            line(std::string(op == "<<" ? "sall" : op == ">>" ? "sarl" : "shrl") + " %cl, %eax");
+            storeResult(instruction.dst, false);
+            return;
+        }
+        static const std::map<std::string, std::string> mnemonics = {
+                {"+", "addl"}, {"-", "subl"}, {"*", "imull"}, {"&", "andl"}, {"|", "orl"}, {"^", "xorl"},
+        };
+        line("movl " + l(instruction.a) + ", %eax");
+        line(mnemonics.at(op) + " " + l(instruction.b) + ", %eax");
+        storeResult(instruction.dst, false);
+    }
+
+    void compare(const AsmInstruction &instruction) {
+        static const std::map<std::string, std::string> conditions = {
+                {"==", "e"}, {"!=", "ne"}, {"<", "l"}, {"<=", "le"}, {">", "g"}, {">=", "ge"},
+        };
+        bool wide = instruction.size == 8;
+        line(wide ? "movq " + q(instruction.a) + ", %rax" : "movl " + l(instruction.a) + ", %eax");
+        line(wide ? "cmpq " + q(instruction.b) + ", %rax" : "cmpl " + l(instruction.b) + ", %eax");
+        line("set" + conditions.at(instruction.name) + " %al");
+        line("movzbl %al, %eax");
+        storeResult(instruction.dst, false);
+    }
+
+    void load(const AsmInstruction &instruction) {
+        std::string address = std::to_string(instruction.imm) + "(%rax)";
+        line("movq " + q(instruction.a) + ", %rax");
+        if (instruction.size == 1) {
+            line("movzbl " + address + ", %eax");
+        } else if (instruction.size == 4) {
+            line("movl " + address + ", %eax");
+        } else {
+            line("movq " + address + ", %rax");
+        }
+        storeResult(instruction.dst, instruction.size == 8);
+    }
+
+    void store(const AsmInstruction &instruction) {
+        std::string address = std::to_string(instruction.imm) + "(%rax)";
+        line("movq " + q(instruction.a) + ", %rax");
+        if (instruction.size == 8) {
+            line("movq " + q(instruction.b) + ", %rcx");
+            line("movq %rcx, " + address);
+        } else {
+            line("movl " + l(instruction.b) + ", %ecx");
+            line(instruction.size == 1 ? "movb %cl, " + address : "movl %ecx, " + address);
+        }
+    }
+
+    void loadGlobal(const AsmInstruction &instruction) {
+        std::string symbol = instruction.name + "(%rip)";
+        if (instruction.size == 1) {
+            line("movzbl " + symbol + ", %eax");
+        } else {
+            line(instruction.size == 8 ? "movq " + symbol + ", %rax" : "movl " + symbol + ", %eax");
+        }
+        storeResult(instruction.dst, instruction.size == 8);
+    }
+
+    void storeGlobal(const AsmInstruction &instruction) {
+        std::string symbol = instruction.name + "(%rip)";
+        if (instruction.size == 8) {
+            line("movq " + q(instruction.a) + ", %rax");
+            line("movq %rax, " + symbol);
+        } else {
+            line("movl " + l(instruction.a) + ", %eax");
+            line(instruction.size == 1 ? "movb %al, " + symbol : "movl %eax, " + symbol);
+        }
+    }
+
+    /**
+     * @brief Emits a call, the arguments are pushed and popped into the argument registers.
+     *
+     * Going through the stack avoids overwriting an argument register that is the location of a later
+     * argument. The values live across the call are in callee-saved registers or in stack slots.
+     */
+    void call(const AsmInstruction &instruction) {
+        for (int argument: instruction.args) {
+            line("pushq " + q(argument));
+        }
+        if (instruction.op == AsmOp::CallIndirect) {
+            line("movq " + q(instruction.a) + ", %r11");
+        }
+        for (size_t i = instruction.args.size(); i-- > 0;) {
+            line("popq %" + std::string(ARGUMENT_REGISTERS[i]));
+        }
+        line(instruction.op == AsmOp::CallIndirect ? "call *%r11" : "call " + instruction.name);
+        storeResult(instruction.dst, true);
+    }
+
+    void emit(const AsmInstruction &instruction) {
+        switch (instruction.op) {
+            case AsmOp::Move:
+                move(instruction.dst, instruction.a);
+                break;
+            case AsmOp::LoadImmediate:
+                line("movl $" + std::to_string(instruction.imm) + ", " + l(instruction.dst));
+                break;
+            case AsmOp::Binary:
+                binary(instruction);
+                break;
+            case AsmOp::Compare:
+                compare(instruction);
+                break;
+            case AsmOp::Not:
+            case AsmOp::BitNot:
+                line("movl " + l(instruction.a) + ", %eax");
+                line(instruction.op == AsmOp::Not ? "xorl $1, %eax" : "notl %eax");
+                storeResult(instruction.dst, false);
+                break;
+            case AsmOp::Load:
+                load(instruction);
+                break;
+            case AsmOp::Store:
+                store(instruction);
+                break;
+            case AsmOp::LoadIndex:
+                line("movq " + q(instruction.a) + ", %rax");
+                line("movslq " + l(instruction.b) + ", %rcx");
+                line("movq 8(%rax), %rax");
+                line("movl (%rax,%rcx,4), %eax");
+                storeResult(instruction.dst, false);
+                break;
+            case AsmOp::StoreIndex:
+                line("movq " + q(instruction.a) + ", %rax");
+                line("movslq " + l(instruction.b) + ", %rcx");
+                line("movq 8(%rax), %rax");
+                line("movl " + l(instruction.c) + ", %edx");
+                line("movl %edx, (%rax,%rcx,4)");
+                break;
+            case AsmOp::LoadGlobal:
+                loadGlobal(instruction);
+                break;
+            case AsmOp::StoreGlobal:
+                storeGlobal(instruction);
+                break;
+            case AsmOp::Call:
+            case AsmOp::CallIndirect:
+                call(instruction);
+                break;
+            case AsmOp::Jump:
+                line("jmp " + instruction.name);
+                break;
+            case AsmOp::JumpIfZero:
+                line("cmpl $0, " + l(instruction.a));
+                line("je " + instruction.name);
+                break;
+            case AsmOp::Label:
+                output += instruction.name + ":\n";
+                break;
+            case AsmOp::Return:
+                if (instruction.a >= 0) {
+                    line("movq " + q(instruction.a) + ", %rax");
+                } else {
+                    line("xorl %eax, %eax");
+                }
+                line("jmp " + returnLabel);
+                break;
+        }
+    }
+};
+
+/**
+ * @brief Emits the assembly of a method, with its prologue and epilogue.
+ *
+ * Frame of a method:
+ * ```
+ * return address
+ * saved %rbp          <- %rbp
+ * callee-saved registers used by the method
+ * stack slots of the spilled virtual registers
+ * (padding to 16 bytes)  <- %rsp
+ * ```
+ * The parameters arrive in the argument registers, they are moved to their locations through the stack
+ * like the arguments of calls.
+ *
+ * @param symbol The symbol of the method (e.g., `Fib_compute`).
+ * @param code The instructions of the method (see `lower_method`).
+ * @param params The virtual registers of the parameters, the receiver first.
+ * @param allocation The locations of the virtual registers (see `allocate_registers`).
+ * @return The assembly of the method.
+ */
+std::string emit_method(
+        const std::string &symbol,
+        const std::vector<AsmInstruction> &code,
+        const std::vector<int> &params,
+        const AsmAllocation &allocation
+) {
+    AsmEmitter emitter{allocation};
+    emitter.returnLabel = ".L_return_" + symbol;
+
+    emitter.output += "\t.p2align 4\n";
+    if (symbol == "main") {
+        emitter.output += "\t.globl main\n";
+    }
+    emitter.output += "\t.type " + symbol + ", @function\n";
+    emitter.output += symbol + ":\n";
+    emitter.line("pushq %rbp");
+    emitter.line("movq %rsp, %rbp");
+    for (auto &reg: allocation.saved) {
+        emitter.line("pushq %" + reg);
+    }
+    long long frame = 8LL * allocation.slotCount;
+    if ((8 * (long long) allocation.saved.size() + frame) % 16 != 0) {
+        frame += 8;
+    }
+    if (frame) {
+        emitter.line("subq $" + std::to_string(frame) + ", %rsp");
+    }
+
+    for (size_t i = 0; i < params.size(); i++) {
+        emitter.line("pushq %" + std::string(ARGUMENT_REGISTERS[i]));
+    }
+    for (size_t i = params.size(); i-- > 0;) {
+        int param = params[i];
+        if (allocation.registers[param].empty() && allocation.slots[param] < 0) {
+            emitter.line("addq $8, %rsp");
+        } else {
+            emitter.line("popq " + emitter.q(param));
+        }
+    }
+
+    for (auto &instruction: code) {
+        emitter.emit(instruction);
+    }
+
+    emitter.output += emitter.returnLabel + ":\n";
+    if (!allocation.saved.empty()) {
+        emitter.line("leaq -" + std::to_string(8 * allocation.saved.size()) + "(%rbp), %rsp");
+    }
+    for (auto it = allocation.saved.rbegin(); it != allocation.saved.rend(); it++) {
+        emitter.line("popq %" + *it);
+    }
+    emitter.line("leave");
+    emitter.line("ret");
+    emitter.output += "\t.size " + symbol + ", .-" + symbol + "\n\n";
+    return emitter.output;
+}
@@ -0,0 +1,670 @@
+#include "../../internal/generator_asm.h"
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/**
+ * @enum X86Register
+ * @brief The general purpose registers of x86-64, by their encoding.
+ */
+enum X86Register {
+    RAX, RCX, RDX, RBX, RSP, RBP, RSI, RDI, R8, R9, R10, R11, R12, R13, R14, R15
+};
+
+/**
+ * @struct X86Operand
+ * @brief A register or a memory operand (`disp(base, index, scale)`) of an instruction.
+ */
+struct X86Operand {
+    bool memory = false;
+    /// The register, or the base register of a memory operand
+    int reg = RAX;
+    int index = -1;
+    int scale = 1;
+    int32_t disp = 0;
+
+    static X86Operand r(int reg) {
+        return {false, reg};
+    }
+
+    static X86Operand m(int base, int32_t disp, int index = -1, int scale = 1) {
+        return {true, base, index, scale, disp};
+    }
+};
+
+/**
+ * @struct X86Assembler
+ * @brief Encodes the x86-64 instructions used by the JIT into a buffer.
+ *
+ * Jumps and calls of the code in the buffer are 32-bit relative, patched when the code is complete. The
+ * addresses of the methods stored in the objects are absolute, patched when the code is placed in memory.
+ */
+struct X86Assembler {
+    std::vector<uint8_t> code;
+    /// Offsets of the labels and of the methods in the buffer
+    std::unordered_map<std::string, size_t> labels;
+    /// 32-bit relative references to labels (offset of the displacement → label)
+    std::vector<std::pair<size_t, std::string>> relatives;
+    /// 64-bit absolute references to labels
+    std::vector<std::pair<size_t, std::string>> absolutes;
+
+    void byte(int value) {
+        code.push_back((uint8_t) value);
+    }
+
+    void int32(int32_t value) {
+        for (int i = 0; i < 4; i++) {
+            byte((int) ((uint32_t) value >> (8 * i)) & 0xFF);
+        }
+    }
+
+    void int64(uint64_t value) {
+        for (int i = 0; i < 8; i++) {
+            byte((int) (value >> (8 * i)) & 0xFF);
+        }
+    }
+
+    void rex(bool wide, int reg, const X86Operand &rm) {
+        int bits = (wide ? 8 : 0) | (reg >> 3 & 1) << 2 | (rm.index >= 0 ? rm.index >> 3 & 1 : 0) << 1 | (rm.reg >> 3 & 1);
+        if (bits) {
+            byte(0x40 | bits);
+        }
+    }
+
+    void modrm(int reg, const X86Operand &rm) {
+        if (!rm.memory) {
+            byte(0xC0 | (reg & 7) << 3 | (rm.reg & 7));
+            return;
+        }
+        int base = rm.reg & 7;
+        bool sib = rm.index >= 0 || base == RSP;
+        int mod = rm.disp == 0 && base != RBP ? 0 : rm.disp >= -128 && rm.disp <= 127 ? 1 : 2;
+        byte(mod << 6 | (reg & 7) << 3 | (sib ? 4 : base));
+        if (sib) {
+            int scale = rm.scale == 8 ? 3 : rm.scale == 4 ? 2 : rm.scale == 2 ? 1 : 0;
+            byte(scale << 6 | (rm.index >= 0 ? rm.index & 7 : 4) << 3 | base);
+        }
+        if (mod == 1) {
+            byte(rm.disp & 0xFF);
+        } else if (mod == 2) {
+            int32(rm.disp);
+        }
+    }
+
+    /// `opcode reg, rm` with an optional 0x0F prefix
+    void op(std::initializer_list<int> opcode, bool wide, int reg, const X86Operand &rm) {
+        rex(wide, reg, rm);
+        for (int b: opcode) {
+            byte(b);
+        }
+        modrm(reg, rm);
+    }
+
+    /// `reg = rm`
+    void load(bool wide, int reg, const X86Operand &rm) {
+        if (!rm.memory && rm.reg == reg) {
+            return;
+        }
+        op({0x8B}, wide, reg, rm);
+    }
+
+    /// `rm = reg`
+    void store(bool wide, const X86Operand &rm, int reg) {
+        if (!rm.memory && rm.reg == reg) {
+            return;
+        }
+        op({0x89}, wide, reg, rm);
+    }
+
+    void moveImmediate(const X86Operand &rm, int32_t value) {
+        op({0xC7}, false, 0, rm);
+        int32(value);
+    }
+
+    void moveAbsolute(int reg, uint64_t value) {
+        byte(0x48 | (reg >> 3 & 1));
+        byte(0xB8 + (reg & 7));
+        int64(value);
+    }
+
+    void push(const X86Operand &rm) {
+        if (rm.memory) {
+            op({0xFF}, false, 6, rm);
+            return;
+        }
+        if (rm.reg >= R8) {
+            byte(0x41);
+        }
+        byte(0x50 + (rm.reg & 7));
+    }
+
+    void pop(const X86Operand &rm) {
+        if (rm.memory) {
+            op({0x8F}, false, 0, rm);
+            return;
+        }
+        if (rm.reg >= R8) {
+            byte(0x41);
+        }
+        byte(0x58 + (rm.reg & 7));
+    }
+
+    void relative(const std::string &label) {
+        relatives.emplace_back(code.size(), label);
+        int32(0);
+    }
+
+    void jump(const std::string &label) {
+        byte(0xE9);
+        relative(label);
+    }
+
+    void callLabel(const std::string &label) {
+        byte(0xE8);
+        relative(label);
+    }
+
+    void callAbsolute(const void *function) {
+        moveAbsolute(R11, (uint64_t) (uintptr_t) function);
+        op({0xFF}, false, 2, X86Operand::r(R11));
+    }
+
+    /// `rsp += value`
+    void addStack(int32_t value) {
+        op({0x81}, true, 0, X86Operand::r(RSP));
+        int32(value);
+    }
+
+    /// Patches the relative references, every label must be defined.
+    void resolve() {
+        for (auto &reference: relatives) {
+            auto target = labels.find(reference.second);
+            if (target == labels.end()) {
+                error("Undefined label '" + reference.second + "' in the JIT");
+            }
+            int32_t displacement = (int32_t) ((long long) target->second - (long long) (reference.first + 4));
+            memcpy(&code[reference.first], &displacement, 4);
+        }
+    }
+};
+
+/**
+ * @brief The runtime of the programs run by the JIT, linked from the compiler itself.
+ *
+ * The objects and arrays of a run are allocated in an arena, freed when the run ends. The output is
+ * buffered and written with `write(2)`, so the handler of `SIGSEGV` can flush it.
+ */
+namespace jit_runtime {
+    std::vector<void *> chunks;
+    char *next = nullptr;
+    char *end = nullptr;
+    char output[4096];
+    size_t outputLength = 0;
+    std::chrono::steady_clock::time_point firstOutput;
+    bool printed = false;
+
+    const size_t CHUNK_SIZE = 1 << 20;
+
+    void flush() {
+        size_t written = 0;
+        while (written < outputLength) {
+            ssize_t n = write(STDOUT_FILENO, output + written, outputLength - written);
+            if (n <= 0) {
+                break;
+            }
+            written += (size_t) n;
+        }
+        outputLength = 0;
+    }
+
+    [[noreturn]] void fail(const char *message) {
+        flush();
+        ssize_t ignored = write(STDERR_FILENO, message, strlen(message));
+        (void) ignored;
+        _exit(1);
+    }
+
+    void *alloc(long size) {
+        size = (size + 15) & ~15L;
+        if (next + size > end) {
+            size_t chunk = std::max((size_t) size, CHUNK_SIZE);
+            next = (char *) calloc(1, chunk);
+            if (!next) {
+                fail("Error: Out of memory\n");
+            }
+            chunks.push_back(next);
+            end = next + chunk;
+        }
+        void *result = next;
+        next += size;
+        return result;
+    }
+
+    /// `__int_array` (see `write_int_array`), the elements follow the header
+    void *new_array(int length) {
+        if (length < 0) {
+            fail("Error: Negative array size\n");
+        }
+        char *array = (char *) alloc(16 + 4L * length);
+        *(int *) array = length;
+        *(char **) (array + 8) = array + 16;
+        return array;
+    }
+
+    void *slice(char *array, int from, int to) {
+        if (from < 0 || to > *(int *) array || from > to) {
+            fail("Error: Slice out of bounds\n");
+        }
+        char *view = (char *) alloc(16);
+        *(int *) view = to - from;
+        *(char **) (view + 8) = *(char **) (array + 8) + 4L * from;
+        return view;
+    }
+
+    void print_int(int value, int newLine) {
+        if (!printed) {
+            printed = true;
+            firstOutput = std::chrono::steady_clock::now();
+        }
+        if (outputLength + 13 > sizeof(output)) {
+            flush();
+        }
+        char digits[12];
+        int count = 0;
+        long long magnitude = value < 0 ? -(long long) value : value;
+        do {
+            digits[count++] = (char) ('0' + magnitude % 10);
+            magnitude /= 10;
+        } while (magnitude);
+        if (value < 0) {
+            output[outputLength++] = '-';
+        }
+        while (count) {
+            output[outputLength++] = digits[--count];
+        }
+        if (newLine) {
+            output[outputLength++] = '\n';
+        }
+    }
+
+    void null_pointer(int) {
+        fail("Exception: NullPointerException\n");
+    }
+
+    void reset() {
+        for (void *chunk: chunks) {
+            free(chunk);
+        }
+        chunks.clear();
+        next = end = nullptr;
+        outputLength = 0;
+        printed = false;
+    }
+}
+
+/**
+ * @brief Encodes the instructions of a method, the machine code counterpart of `emit_method`.
+ *
+ * Every instruction is encoded by the same template as its assembly (see `AsmEmitter`): the operands are
+ * loaded into the scratch registers `rax`, `rcx` and `rdx`, computed and stored to the location of the
+ * result. Calls of the runtime are absolute, calls of the methods and constructors are relative.
+ */
+struct JitEmitter {
+    X86Assembler &assembler;
+    const AsmAllocation &allocation;
+    const std::unordered_map<std::string, const void *> &runtime;
+    const std::unordered_map<std::string, void *> &statics;
+    std::string returnLabel;
+
+    X86Operand operand(int reg) const {
+        static const std::unordered_map<std::string, int> registers = {
+                {"rbx", RBX}, {"r12", R12}, {"r13", R13}, {"r14", R14}, {"r15", R15},
+                {"rsi", RSI}, {"rdi", RDI}, {"r8", R8}, {"r9", R9}, {"r10", R10},
+        };
+        if (!allocation.registers[reg].empty()) {
+            return X86Operand::r(registers.at(allocation.registers[reg]));
+        }
+        return X86Operand::m(RBP, -8 * (int32_t) (allocation.saved.size() + allocation.slots[reg] + 1));
+    }
+
+    void storeResult(int dst, bool wide) {
+        if (dst >= 0) {
+            assembler.store(wide, operand(dst), RAX);
+        }
+    }
+
+    void move(int dst, int src) {
+        X86Operand to = operand(dst);
+        X86Operand from = operand(src);
+        if (!to.memory) {
+            assembler.load(true, to.reg, from);
+        } else if (!from.memory) {
+            assembler.store(true, to, from.reg);
+        } else if (to.disp != from.disp) {
+            assembler.load(true, RAX, from);
+            assembler.store(true, to, RAX);
+        }
+    }
+
+    void binary(const AsmInstruction &instruction) {
+        const std::string &op = instruction.name;
+        assembler.load(false, RAX, operand(instruction.a));
+        if (op == "/" || op == "%") {
+            assembler.byte(0x99);
+            assembler.op({0xF7}, false, 7, operand(instruction.b));
+            assembler.store(false, operand(instruction.dst), op == "/" ? RAX : RDX);
+            return;
+        }
+        if (op == "<<" || op == ">>" || op == ">>>") {
+            assembler.load(false, RCX, operand(instruction.b));
+            assembler.op({0xD3}, false, op == "<<" ? 4 : op == ">>" ? 7 : 5, X86Operand::r(RAX));
+        } else if (op == "*") {
+            assembler.op({0x0F, 0xAF}, false, RAX, operand(instruction.b));
+        } else {
+            static const std::unordered_map<std::string, int> opcodes = {
+                    {"+", 0x03}, {"-", 0x2B}, {"&", 0x23}, {"|", 0x0B}, {"^", 0x33},
+            };
+            assembler.op({opcodes.at(op)}, false, RAX, operand(instruction.b));
+        }
+        storeResult(instruction.dst, false);
+    }
+
+    void compare(const AsmInstruction &instruction) {
+        static const std::unordered_map<std::string, int> conditions = {
+                {"==", 0x94}, {"!=", 0x95}, {"<", 0x9C}, {"<=", 0x9E}, {">", 0x9F}, {">=", 0x9D},
+        };
+        bool wide = instruction.size == 8;
+        assembler.load(wide, RAX, operand(instruction.a));
+        assembler.op({0x3B}, wide, RAX, operand(instruction.b));
+        assembler.op({0x0F, conditions.at(instruction.name)}, false, 0, X86Operand::r(RAX));
+        assembler.op({0x0F, 0xB6}, false, RAX, X86Operand::r(RAX));
+        storeResult(instruction.dst, false);
+    }
+
+    /// `rax = *(rm)` of `size` bytes, zero extended
+    void loadSized(int size, const X86Operand &rm) {
+        if (size == 1) {
+            assembler.op({0x0F, 0xB6}, false, RAX, rm);
+        } else {
+            assembler.load(size == 8, RAX, rm);
+        }
+    }
+
+    /// `*(rm) = reg` of `size` bytes
+    void storeSized(int size, const X86Operand &rm, int reg) {
+        if (size == 1) {
+            assembler.op({0x88}, false, reg, rm);
+        } else {
+            assembler.store(size == 8, rm, reg);
+        }
+    }
+
+    void call(const AsmInstruction &instruction) {
+        static const int arguments[] = {RDI, RSI, RDX, RCX, R8, R9};
+        for (int argument: instruction.args) {
+            assembler.push(operand(argument));
+        }
+        if (instruction.op == AsmOp::CallIndirect) {
+            assembler.load(true, R11, operand(instruction.a));
+        }
+        for (size_t i = instruction.args.size(); i-- > 0;) {
+            assembler.pop(X86Operand::r(arguments[i]));
+        }
+        if (instruction.op == AsmOp::CallIndirect) {
+            assembler.op({0xFF}, false, 2, X86Operand::r(R11));
+        } else if (runtime.count(instruction.name)) {
+            assembler.callAbsolute(runtime.at(instruction.name));
+        } else {
+            assembler.callLabel(instruction.name);
+        }
+        storeResult(instruction.dst, true);
+    }
+
+    void emit(const AsmInstruction &instruction) {
+        switch (instruction.op) {
+            case AsmOp::Move:
+                move(instruction.dst, instruction.a);
+                break;
+            case AsmOp::LoadImmediate:
+                assembler.moveImmediate(operand(instruction.dst), (int32_t) instruction.imm);
+                break;
+            case AsmOp::Binary:
+                binary(instruction);
+                break;
+            case AsmOp::Compare:
+                compare(instruction);
+                break;
+            case AsmOp::Not:
+                assembler.load(false, RAX, operand(instruction.a));
+                assembler.op({0x83}, false, 6, X86Operand::r(RAX));
+                assembler.byte(1);
+                storeResult(instruction.dst, false);
+                break;
+            case AsmOp::BitNot:
+                assembler.load(false, RAX, operand(instruction.a));
+                assembler.op({0xF7}, false, 2, X86Operand::r(RAX));
+                storeResult(instruction.dst, false);
+                break;
+            case AsmOp::Load:
+                assembler.load(true, RAX, operand(instruction.a));
+                loadSized(instruction.size, X86Operand::m(RAX, (int32_t) instruction.imm));
+                storeResult(instruction.dst, instruction.size == 8);
+                break;
+            case AsmOp::Store:
+                assembler.load(true, RAX, operand(instruction.a));
+                assembler.load(instruction.size == 8, RCX, operand(instruction.b));
+                storeSized(instruction.size, X86Operand::m(RAX, (int32_t) instruction.imm), RCX);
+                break;
+            case AsmOp::LoadIndex:
+                assembler.load(true, RAX, operand(instruction.a));
+                assembler.op({0x63}, true, RCX, operand(instruction.b));
+                assembler.load(true, RAX, X86Operand::m(RAX, 8));
+                assembler.load(false, RAX, X86Operand::m(RAX, 0, RCX, 4));
+                storeResult(instruction.dst, false);
+                break;
+            case AsmOp::StoreIndex:
+                assembler.load(true, RAX, operand(instruction.a));
+                assembler.op({0x63}, true, RCX, operand(instruction.b));
+                assembler.load(true, RAX, X86Operand::m(RAX, 8));
+                assembler.load(false, RDX, operand(instruction.c));
+                assembler.store(false, X86Operand::m(RAX, 0, RCX, 4), RDX);
+                break;
+            case AsmOp::LoadGlobal:
+                assembler.moveAbsolute(R11, (uint64_t) (uintptr_t) statics.at(instruction.name));
+                loadSized(instruction.size, X86Operand::m(R11, 0));
+                storeResult(instruction.dst, instruction.size == 8);
+                break;
+            case AsmOp::StoreGlobal:
+                assembler.load(instruction.size == 8, RAX, operand(instruction.a));
+                assembler.moveAbsolute(R11, (uint64_t) (uintptr_t) statics.at(instruction.name));
+                storeSized(instruction.size, X86Operand::m(R11, 0), RAX);
+                break;
+            case AsmOp::Call:
+            case AsmOp::CallIndirect:
+                call(instruction);
+                break;
+            case AsmOp::Jump:
+                assembler.jump(instruction.name);
+                break;
+            case AsmOp::JumpIfZero:
+                assembler.op({0x83}, false, 7, operand(instruction.a));
+                assembler.byte(0);
+                assembler.byte(0x0F);
+                assembler.byte(0x84);
+                assembler.relative(instruction.name);
+                break;
+            case AsmOp::Label:
+                assembler.labels[instruction.name] = assembler.code.size();
+                break;
+            case AsmOp::Return:
+                if (instruction.a >= 0) {
+                    assembler.load(true, RAX, operand(instruction.a));
+                } else {
+                    assembler.op({0x31}, false, RAX, X86Operand::r(RAX));
+                }
+                assembler.jump(returnLabel);
+                break;
+        }
+    }
+
+    /// The frame of `emit_method`
+    void method(const std::string &symbol, const std::vector<AsmInstruction> &code, const std::vector<int> &params) {
+        static const std::unordered_map<std::string, int> saved = {
+                {"rbx", RBX}, {"r12", R12}, {"r13", R13}, {"r14", R14}, {"r15", R15},
+        };
+        static const int arguments[] = {RDI, RSI, RDX, RCX, R8, R9};
+        returnLabel = ".L_return_" + symbol;
+        assembler.labels[symbol] = assembler.code.size();
+        assembler.push(X86Operand::r(RBP));
+        assembler.store(true, X86Operand::r(RBP), RSP);
+        for (auto &reg: allocation.saved) {
+            assembler.push(X86Operand::r(saved.at(reg)));
+        }
+        int32_t frame = 8 * allocation.slotCount;
+        if ((8 * (int32_t) allocation.saved.size() + frame) % 16 != 0) {
+            frame += 8;
+        }
+        if (frame) {
+            assembler.addStack(-frame);
+        }
+        for (size_t i = 0; i < params.size(); i++) {
+            assembler.push(X86Operand::r(arguments[i]));
+        }
+        for (size_t i = params.size(); i-- > 0;) {
+            if (allocation.registers[params[i]].empty() && allocation.slots[params[i]] < 0) {
+                assembler.addStack(8);
+            } else {
+                assembler.pop(operand(params[i]));
+            }
+        }
+
+        for (auto &instruction: code) {
+            emit(instruction);
+        }
+
+        assembler.labels[returnLabel] = assembler.code.size();
+        if (!allocation.saved.empty()) {
+            assembler.op({0x8D}, true, RSP, X86Operand::m(RBP, -8 * (int32_t) allocation.saved.size()));
+        }
+        for (auto it = allocation.saved.rbegin(); it != allocation.saved.rend(); it++) {
+            assembler.pop(X86Operand::r(saved.at(*it)));
+        }
+        assembler.byte(0xC9);
+        assembler.byte(0xC3);
+    }
+};
+
+/**
+ * @brief Encodes the constructor of a class, see `generate_asm_constructor`.
+ */
+void jit_constructor(X86Assembler &assembler, Project *project, std::map<Identifier, AsmLayout> &layouts,
+                     Class *clazz, int id) {
+    AsmLayout &layout = get_asm_layout(project, layouts, clazz);
+    assembler.labels["__mj_new_" + clazz->getName()] = assembler.code.size();
+    assembler.addStack(-8);
+    assembler.moveImmediate(X86Operand::r(RDI), (int32_t) layout.size);
+    assembler.callAbsolute((const void *) jit_runtime::alloc);
+    assembler.moveImmediate(X86Operand::m(RAX, 8), id);
+    for (auto &slot: layout.slots) {
+        assembler.byte(0x48);
+        assembler.byte(0xB8 + RCX);
+        assembler.absolutes.emplace_back(assembler.code.size(), get_method_reference_name(project, clazz, slot.second));
+        assembler.int64(0);
+        assembler.store(true, X86Operand::m(RAX, (int32_t) slot.first), RCX);
+    }
+    assembler.addStack(8);
+    assembler.byte(0xC3);
+}
+
+/**
+ * @brief Compiles a Mini-Java project to machine code in memory and runs it, without writing any file.
+ *
+ * See `run_jit` in `generator.h`.
+ */
+int run_jit(Project *project) {
+    using clock = std::chrono::steady_clock;
+    clock::time_point start = clock::now();
+
+    const std::unordered_map<std::string, const void *> runtime = {
+            {"__mj_new_array", (const void *) jit_runtime::new_array},
+            {"__mj_int_array_slice", (const void *) jit_runtime::slice},
+            {"__mj_print_int", (const void *) jit_runtime::print_int},
+    };
+    std::vector<Class *> order = get_asm_classes(project);
+
+    // Every static field is a zeroed slot of 8 bytes, the storage is not resized once the addresses are taken
+    std::vector<std::string> staticNames;
+    for (Class *clazz: order) {
+        for (auto &field: *clazz->getFields()) {
+            if (field.isStatic()) {
+                staticNames.push_back(get_asm_static_name(clazz->getName(), field.getName()));
+            }
+        }
+    }
+    std::vector<uint64_t> staticStorage(staticNames.size());
+    std::unordered_map<std::string, void *> statics;
+    for (size_t i = 0; i < staticNames.size(); i++) {
+        statics[staticNames[i]] = &staticStorage[i];
+    }
+
+    X86Assembler assembler;
+    std::map<Identifier, AsmLayout> layouts;
+    int methods = 0;
+    for (size_t id = 0; id < order.size(); id++) {
+        Class *clazz = order[id];
+        jit_constructor(assembler, project, layouts, clazz, (int) id);
+        for (auto &method: *clazz->getMethods()) {
+            AsmGenerator gen{project, clazz, &method, &layouts};
+            lower_method(gen);
+            AsmAllocation allocation = allocate_registers(gen.code, gen.registers);
+            std::string symbol = method.isMain() ? "main" : clazz->getName() + "_" + method.getName();
+            JitEmitter emitter{assembler, allocation, runtime, statics};
+            emitter.method(symbol, gen.code, gen.params);
+            methods++;
+        }
+    }
+    if (!assembler.labels.count("main")) {
+        error("The program has no 'main' method");
+    }
+    assembler.resolve();
+
+    size_t size = (assembler.code.size() + 4095) & ~(size_t) 4095;
+    void *memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+        error("The JIT could not map memory for the code");
+    }
+    auto *base = (uint8_t *) memory;
+    memcpy(base, assembler.code.data(), assembler.code.size());
+    for (auto &reference: assembler.absolutes) {
+        uint64_t address = (uint64_t) (uintptr_t) (base + assembler.labels.at(reference.second));
+        memcpy(base + reference.first, &address, 8);
+    }
+    mprotect(memory, size, PROT_READ | PROT_EXEC);
+    clock::time_point compiled = clock::now();
+
+    struct sigaction action{}, previous{};
+    action.sa_handler = jit_runtime::null_pointer;
+    sigaction(SIGSEGV, &action, &previous);
+    auto entry = (void (*)()) (base + assembler.labels.at("main"));
+    entry();
+    jit_runtime::flush();
+    sigaction(SIGSEGV, &previous, nullptr);
+    clock::time_point finished = clock::now();
+
+    if (getenv("MINIJAVA_JIT_STATS")) {
+        auto ms = [&start](clock::time_point time) {
+            return std::chrono::duration<double, std::milli>(time - start).count();
+        };
+        fprintf(stderr, "JIT: %d methods, %zu bytes of code, compiled in %.3f ms, first output after %.3f ms, "
+                        "finished after %.3f ms\n",
+                methods, assembler.code.size(), ms(compiled),
+                jit_runtime::printed ? ms(jit_runtime::firstOutput) : ms(finished), ms(finished));
+    }
+    munmap(memory, size);
+    jit_runtime::reset();
+    return 0;
+}
@@ -0,0 +1,743 @@
+#include "../../internal/generator_asm.h"
+#include <algorithm>
+
+int lower(AsmGenerator &gen, ASTNode *node);
+
+void lower_statement(AsmGenerator &gen, ASTNode *node);
+
+AsmLocation resolve(AsmGenerator &gen, ReferenceChain *reference);
+
+/**
+ * @brief Reports a construct the assembly backend can't compile.
+ *
+ * @param what The construct (e.g., `"strings"`).
+ * @param token The token of the construct, if any.
+ */
+[[noreturn]] void asm_unsupported(const std::string &what, Token *token) {
+    std::string message = "The assembly backend does not support " + what + ", compile the program to C";
+    if (token) {
+        error(message, token);
+    }
+    error(message);
+    throw std::runtime_error(message);
+}
+
+/**
+ * @brief Checks that a type is supported by the assembly backend.
+ *
+ * `int`, `boolean`, `int[]` and the user classes are supported. Strings, channels, interfaces and the
+ * classes of the builtin `Thread` hierarchy need the C runtime.
+ *
+ * @param project The parsed project.
+ * @param type The type to check.
+ * @param token The token reported if the type is not supported.
+ */
+void check_asm_type(Project *project, const Identifier &type, Token *token) {
+    if (type == "int" || type == "boolean" || type == "int[]" || type == "void") {
+        return;
+    }
+    if (type == "String" || SymbolTable::isChannelType(type)) {
+        asm_unsupported("'" + type + "'", token);
+    }
+    if (!project->containsClass(type)) {
+        asm_unsupported("the type '" + type + "'", token);
+    }
+    for (Class *clazz = project->getClassByName(type); clazz;) {
+        if (clazz->isInterface() || clazz->isBuiltin()) {
+            asm_unsupported("the type '" + type + "' (interfaces and threads)", token);
+        }
+        clazz = clazz->getExtends().empty() ? nullptr : project->getClassByName(clazz->getExtends());
+    }
+}
+
+/**
+ * @brief Finds the class of a hierarchy declaring a field.
+ *
+ * @param project The parsed project.
+ * @param clazz The class where the search starts.
+ * @param name The name of the field.
+ * @return The nearest class declaring the field, or `nullptr`.
+ */
+Class *find_asm_field_owner(Project *project, Class *clazz, const Identifier &name) {
+    while (clazz) {
+        if (clazz->containsField(name)) {
+            return clazz;
+        }
+        clazz = clazz->getExtends().empty() ? nullptr : project->getClassByName(clazz->getExtends());
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Finds the class of a hierarchy declaring a method.
+ *
+ * @param project The parsed project.
+ * @param clazz The class where the search starts.
+ * @param name The name of the method.
+ * @return The nearest class declaring the method, or `nullptr`.
+ */
+Class *find_asm_method_owner(Project *project, Class *clazz, const Identifier &name) {
+    while (clazz) {
+        if (clazz->containsMethod(name)) {
+            return clazz;
+        }
+        clazz = clazz->getExtends().empty() ? nullptr : project->getClassByName(clazz->getExtends());
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Returns the size of a value of a type in memory (fields, statics and array elements).
+ */
+int get_asm_size(const Identifier &type) {
+    if (type == "int") {
+        return 4;
+    }
+    if (type == "boolean") {
+        return 1;
+    }
+    return 8;
+}
+
+/**
+ * @brief Returns the symbol of a static field in the assembly output.
+ *
+ * The C names (`$_static_A_count`) can't be used: GNU as reads a leading `$` as an immediate.
+ */
+std::string get_asm_static_name(const Identifier &clazz, const Identifier &field) {
+    return "__mj_static_" + clazz + "_" + field;
+}
+
+/**
+ * @brief Loads the value of a location into a virtual register.
+ */
+int load(AsmGenerator &gen, const AsmLocation &location) {
+    int dst;
+    switch (location.kind) {
+        case AsmLocation::Value:
+        case AsmLocation::Local:
+            return location.reg;
+        case AsmLocation::Field:
+            dst = gen.newRegister();
+            gen.emit({AsmOp::Load, dst, location.reg, -1, -1, location.offset, get_asm_size(location.type)});
+            return dst;
+        case AsmLocation::Static:
+            dst = gen.newRegister();
+            gen.emit({AsmOp::LoadGlobal, dst, -1, -1, -1, 0, get_asm_size(location.type), location.symbol});
+            return dst;
+        case AsmLocation::Element:
+            dst = gen.newRegister();
+            gen.emit({AsmOp::LoadIndex, dst, location.reg, location.index});
+            return dst;
+        default:
+            error("Class '" + location.type + "' is not a value");
+            return -1;
+    }
+}
+
+/**
+ * @brief Stores a virtual register into an assignable location.
+ */
+void store(AsmGenerator &gen, const AsmLocation &location, int value, Token *token) {
+    switch (location.kind) {
+        case AsmLocation::Local:
+            gen.emit({AsmOp::Move, location.reg, value});
+            break;
+        case AsmLocation::Field:
+            gen.emit({AsmOp::Store, -1, location.reg, value, -1, location.offset, get_asm_size(location.type)});
+            break;
+        case AsmLocation::Static:
+            gen.emit({AsmOp::StoreGlobal, -1, value, -1, -1, 0, get_asm_size(location.type), location.symbol});
+            break;
+        case AsmLocation::Element:
+            gen.emit({AsmOp::StoreIndex, -1, location.reg, location.index, value});
+            break;
+        default:
+            error("The left side of the assignment is not assignable", token);
+    }
+}
+
+/**
+ * @brief Loads a constant into a new virtual register.
+ */
+int lower_constant(AsmGenerator &gen, long long value) {
+    int dst = gen.newRegister();
+    gen.emit({AsmOp::LoadImmediate, dst, -1, -1, -1, value});
+    return dst;
+}
+
+/**
+ * @brief Lowers an integer literal, in any of the bases of the lexer (`42`, `0x2A`, `0b101010`, `1_000`).
+ *
+ * The value wraps to 32 bits, as it does in the C output.
+ */
+int lower(AsmGenerator &gen, NumberASTNode *node) {
+    std::string lexeme = node->token.lexeme;
+    lexeme.erase(std::remove(lexeme.begin(), lexeme.end(), '_'), lexeme.end());
+    unsigned long long value;
+    if (lexeme.size() > 2 && lexeme[0] == '0' && (lexeme[1] == 'b' || lexeme[1] == 'B')) {
+        value = std::stoull(lexeme.substr(2), nullptr, 2);
+    } else {
+        value = std::stoull(lexeme, nullptr, 0);
+    }
+    return lower_constant(gen, (int) (unsigned int) value);
+}
+
+/**
+ * @brief Lowers the arguments and the call of a method.
+ *
+ * Static methods are called directly, instance methods through the `$_function_` pointer of the receiver,
+ * at the offset of the nearest class declaring the method (see `get_asm_layout`). The receiver is the
+ * first argument, evaluated before the others.
+ *
+ * @param gen The generator of the method.
+ * @param node The method call.
+ * @param clazz The static type of the receiver, or the class of a `ClassName.method()` call.
+ * @param receiver The virtual register of the receiver, -1 for static calls.
+ * @param token The token of the call.
+ * @return The result of the call, a `Value` location (-1 for `void`).
+ */
+AsmLocation lower_call(AsmGenerator &gen, MethodCall *node, Class *clazz, int receiver, Token *token) {
+    Class *owner = find_asm_method_owner(gen.project, clazz, node->methodName);
+    if (!owner) {
+        error("Method '" + node->methodName + "' not found in class hierarchy.", token);
+    }
+    Method *method = nullptr;
+    for (auto &m: *owner->getMethods()) {
+        if (m.getName() == node->methodName) {
+            method = &m;
+        }
+    }
+    if (node->arguments.size() + (method->isStatic() ? 0 : 1) > 6) {
+        asm_unsupported("calls with more than 6 arguments (the receiver included)", token);
+    }
+
+    AsmInstruction call{method->isStatic() ? AsmOp::Call : AsmOp::CallIndirect};
+    if (method->isStatic()) {
+        call.name = owner->getName() + "_" + method->getName();
+    } else {
+        if (receiver < 0) {
+            error("Non-static method '" + node->methodName + "' can not be called from a static context", token);
+        }
+        call.args.push_back(receiver);
+    }
+    for (auto &argument: node->arguments) {
+        call.args.push_back(lower(gen, argument.get()));
+    }
+    if (!method->isStatic()) {
+        call.a = gen.newRegister();
+        long long slot = get_asm_layout(gen.project, *gen.layouts, clazz).methods.at(node->methodName);
+        gen.emit({AsmOp::Load, call.a, receiver, -1, -1, slot, 8});
+    }
+    if (node->type != "void") {
+        check_asm_type(gen.project, node->type, token);
+        call.dst = gen.newRegister();
+    }
+    AsmLocation result;
+    result.reg = call.dst;
+    result.type = node->type;
+    gen.emit(call);
+    return result;
+}
+
+/**
+ * @brief Lowers `System.out.print`, `println` and `printf` of an `int` to the runtime (`__mj_print_int`).
+ *
+ * @return true if the chain is a print, false otherwise.
+ */
+bool lower_print(AsmGenerator &gen, ReferenceChain *reference) {
+    if (reference->chain.size() != 3 ||
+        reference->chain[0].first.lexeme != "System" ||
+        reference->chain[1].first.lexeme != "out" ||
+        !reference->chain[2].second ||
+        reference->chain[2].second->getType() != ASTType::AST_MethodCall) {
+        return false;
+    }
+    Token &name = reference->chain[2].first;
+    if (name.lexeme != "print" && name.lexeme != "printf" && name.lexeme != "println") {
+        return false;
+    }
+    MethodCall *mc = ((MethodCall *) reference->chain[2].second.get());
+    if (mc->arguments.size() != 1 || mc->arguments[0]->type != "int") {
+        asm_unsupported("printing values of type '" +
+                        (mc->arguments.empty() ? std::string("void") : mc->arguments[0]->type) + "'", &name);
+    }
+    int value = lower(gen, mc->arguments[0].get());
+    int newLine = lower_constant(gen, name.lexeme == "println" ? 1 : 0);
+    gen.emit({AsmOp::Call, -1, -1, -1, -1, 0, 4, "__mj_print_int", {value, newLine}});
+    return true;
+}
+
+/**
+ * @brief Lowers the creation of an object or an array.
+ *
+ * Objects are created by their `__mj_new_ClassName` function (see `generate_asm`), arrays by the runtime
+ * (`__mj_new_array`).
+ */
+int lower(AsmGenerator &gen, NewObject *node) {
+    int dst = gen.newRegister();
+    if (node->classType.lexeme == "int" && node->arraySize) {
+        int size = lower(gen, node->arraySize.get());
+        gen.emit({AsmOp::Call, dst, -1, -1, -1, 0, 4, "__mj_new_array", {size}});
+    } else {
+        check_asm_type(gen.project, node->classType.lexeme, &node->classType);
+        gen.emit({AsmOp::Call, dst, -1, -1, -1, 0, 4, "__mj_new_" + node->classType.lexeme});
+    }
+    return dst;
+}
+
+/**
+ * @brief Makes the element of an array the current location of a chain (`arr[index]`).
+ */
+AsmLocation lower_element(AsmGenerator &gen, const AsmLocation &array, ArrayCall *node) {
+    AsmLocation element;
+    element.kind = AsmLocation::Element;
+    element.reg = load(gen, array);
+    element.index = lower(gen, node->bracket.get());
+    element.type = "int";
+    return element;
+}
+
+/**
+ * @brief Resolves a reference chain to the location it denotes, lowering the calls and loads on the way.
+ *
+ * The resolution follows the C generator (see `generate(ThreeAddressCodeGenerator&, ReferenceChain*)`):
+ * the first entry is `this`, a local variable, a field of the class (`this` implied), a static field, a
+ * class name before a static member, a method of the class or a new object. Every following entry is a
+ * member of the value of the previous one. Since the layout of every class is known, an inherited field is
+ * a single load at its offset instead of a chain of `super` members.
+ *
+ * @param gen The generator of the method.
+ * @param reference The reference chain.
+ * @return The location of the last entry, assignable unless it is a `Value`.
+ */
+AsmLocation resolve(AsmGenerator &gen, ReferenceChain *reference) {
+    AsmLocation current;
+    if (lower_print(gen, reference)) {
+        return current;
+    }
+
+    for (size_t i = 0; i < reference->chain.size(); i++) {
+        Token *token = &reference->chain[i].first;
+        const Identifier &name = token->lexeme;
+        ASTNode *node = reference->chain[i].second.get();
+
+        if (i == 0) {
+            if (name == "this" && !node) {
+                current.kind = AsmLocation::Value;
+                current.reg = gen.self;
+                current.type = gen.clazz->getName();
+                continue;
+            }
+            if (node && node->getType() == ASTType::AST_NewObject) {
+                current.kind = AsmLocation::Value;
+                current.reg = lower(gen, (NewObject *) node);
+                current.type = node->type;
+                continue;
+            }
+            if (node && node->getType() == ASTType::AST_MethodCall) {
+                current = lower_call(gen, (MethodCall *) node, gen.clazz, gen.self, token);
+                continue;
+            }
+
+            Identifier localType;
+            int local = gen.lookup(name, &localType);
+            Class *owner = local < 0 ? find_asm_field_owner(gen.project, gen.clazz, name) : nullptr;
+            if (local >= 0) {
+                current.kind = AsmLocation::Local;
+                current.reg = local;
+                current.type = localType;
+            } else if (owner && owner->getField(name)->isStatic()) {
+                current.kind = AsmLocation::Static;
+                current.symbol = get_asm_static_name(owner->getName(), name);
+                current.type = owner->getField(name)->getTypeLexeme();
+            } else if (owner) {
+                if (gen.self < 0) {
+                    error("Non-static field '" + name + "' can not be referenced from a static context", token);
+                }
+                current.kind = AsmLocation::Field;
+                current.reg = gen.self;
+                current.offset = get_asm_layout(gen.project, *gen.layouts, gen.clazz).fields.at(name);
+                current.type = owner->getField(name)->getTypeLexeme();
+            } else if (!node && gen.project->containsClass(name)) {
+                current.kind = AsmLocation::ClassName;
+                current.type = name;
+                continue;
+            } else {
+                error("Undefined reference '" + name + "'", token);
+            }
+            if (node && node->getType() == ASTType::AST_ArrayCall) {
+                current = lower_element(gen, current, (ArrayCall *) node);
+            }
+            continue;
+        }
+
+        if (current.kind == AsmLocation::ClassName) {
+            Class *clazz = gen.project->getClassByName(current.type);
+            if (node && node->getType() == ASTType::AST_MethodCall) {
+                current = lower_call(gen, (MethodCall *) node, clazz, -1, token);
+                continue;
+            }
+            Class *owner = find_asm_field_owner(gen.project, clazz, name);
+            if (!owner || !owner->getField(name)->isStatic()) {
+                error("Static field '" + name + "' not found in class '" + current.type + "'", token);
+            }
+            current.kind = AsmLocation::Static;
+            current.symbol = get_asm_static_name(owner->getName(), name);
+            current.type = owner->getField(name)->getTypeLexeme();
+            if (node && node->getType() == ASTType::AST_ArrayCall) {
+                current = lower_element(gen, current, (ArrayCall *) node);
+            }
+            continue;
+        }
+
+        if (current.type == "int[]") {
+            if (node && node->getType() == ASTType::AST_MethodCall) {
+                // `slice(from, to)`, a view of the array (see `write_int_array`)
+                auto *mc = (MethodCall *) node;
+                int array = load(gen, current);
+                int from = lower(gen, mc->arguments[0].get());
+                int to = lower(gen, mc->arguments[1].get());
+                current.kind = AsmLocation::Value;
+                current.reg = gen.newRegister();
+                gen.emit({AsmOp::Call, current.reg, -1, -1, -1, 0, 4, "__mj_int_array_slice", {array, from, to}});
+                continue;
+            }
+            current.reg = load(gen, current);
+            current.kind = AsmLocation::Field;
+            current.offset = 0;
+            current.type = "int";
+            continue;
+        }
+
+        check_asm_type(gen.project, current.type, token);
+        Class *clazz = gen.project->getClassByName(current.type);
+        int object = load(gen, current);
+        if (node && node->getType() == ASTType::AST_MethodCall) {
+            current = lower_call(gen, (MethodCall *) node, clazz, object, token);
+            continue;
+        }
+
+        Class *owner = find_asm_field_owner(gen.project, clazz, name);
+        if (!owner) {
+            error("Field '" + name + "' not found in class hierarchy.", token);
+        }
+        Field *field = owner->getField(name);
+        if (field->isStatic()) {
+            current.kind = AsmLocation::Static;
+            current.symbol = get_asm_static_name(owner->getName(), name);
+        } else {
+            current.kind = AsmLocation::Field;
+            current.reg = object;
+            current.offset = get_asm_layout(gen.project, *gen.layouts, clazz).fields.at(name);
+        }
+        current.type = field->getTypeLexeme();
+        if (node && node->getType() == ASTType::AST_ArrayCall) {
+            current = lower_element(gen, current, (ArrayCall *) node);
+        }
+    }
+    return current;
+}
+
+/**
+ * @brief Lowers a binary expression.
+ *
+ * Both operands are evaluated, as in the C output (`&&` and `||` included, on booleans they are `&` and
+ * `|`). Comparisons of references compare the 64-bit pointers.
+ */
+int lower(AsmGenerator &gen, BinaryExpression *node) {
+    if (node->type == "String") {
+        asm_unsupported("strings", &node->op);
+    }
+    int left = lower(gen, node->left.get());
+    int right = lower(gen, node->right.get());
+    int dst = gen.newRegister();
+    const std::string &op = node->op.lexeme;
+    if (op == "==" || op == "!=" || op == "<" || op == "<=" || op == ">" || op == ">=") {
+        const Identifier &type = node->left->type;
+        int size = type == "int" || type == "boolean" ? 4 : 8;
+        gen.emit({AsmOp::Compare, dst, left, right, -1, 0, size, op});
+    } else if (op == "&&" || op == "||") {
+        gen.emit({AsmOp::Binary, dst, left, right, -1, 0, 4, op == "&&" ? "&" : "|"});
+    } else {
+        gen.emit({AsmOp::Binary, dst, left, right, -1, 0, 4, op});
+    }
+    return dst;
+}
+
+/**
+ * @brief Lowers `cond ? a : b` to branches assigning the same virtual register.
+ */
+int lower(AsmGenerator &gen, ConditionalExpression *node) {
+    int dst = gen.newRegister();
+    std::string elseLabel = gen.newLabel("cond_else");
+    std::string endLabel = gen.newLabel("cond_end");
+    gen.emitJump(AsmOp::JumpIfZero, elseLabel, lower(gen, node->condition.get()));
+    gen.emit({AsmOp::Move, dst, lower(gen, node->thenExpr.get())});
+    gen.emitJump(AsmOp::Jump, endLabel);
+    gen.emitLabel(elseLabel);
+    gen.emit({AsmOp::Move, dst, lower(gen, node->elseExpr.get())});
+    gen.emitLabel(endLabel);
+    return dst;
+}
+
+/**
+ * @brief Lowers an assignment, compound assignments (`+=`, `<<=`, ...) load the location first.
+ */
+void lower(AsmGenerator &gen, Assignment *node) {
+    int value = lower(gen, node->expression.get());
+    AsmLocation location = resolve(gen, &node->reference);
+    const std::string &op = node->assignmentToken.lexeme;
+    if (op != "=") {
+        if (location.type == "String") {
+            asm_unsupported("strings", &node->assignmentToken);
+        }
+        int current = load(gen, location);
+        int result = gen.newRegister();
+        gen.emit({AsmOp::Binary, result, current, value, -1, 0, 4, op.substr(0, op.size() - 1)});
+        value = result;
+    }
+    store(gen, location, value, &node->assignmentToken);
+}
+
+/**
+ * @brief Lowers an expression into a virtual register.
+ *
+ * @return The virtual register of the value, -1 for `void` calls.
+ */
+int lower(AsmGenerator &gen, ASTNode *node) {
+    switch (node->getType()) {
+        case ASTType::AST_NumberASTNode:
+            return lower(gen, (NumberASTNode *) node);
+        case ASTType::AST_BooleanASTNode:
+            return lower_constant(gen, ((BooleanASTNode *) node)->token.lexeme == "true" ? 1 : 0);
+        case ASTType::AST_StringASTNode:
+            asm_unsupported("strings", &((StringASTNode *) node)->token);
+        case ASTType::AST_BinaryExpression:
+            return lower(gen, (BinaryExpression *) node);
+        case ASTType::AST_NotExpression: {
+            auto *not_ = (NotExpression *) node;
+            int dst = gen.newRegister();
+            int value = lower(gen, not_->expr.get());
+            gen.emit({not_->op.lexeme == "~" ? AsmOp::BitNot : AsmOp::Not, dst, value});
+            return dst;
+        }
+        case ASTType::AST_CastExpression: {
+            auto *cast = (CastExpression *) node;
+            if (!SymbolTable::canCast(cast->expr->type, cast->type)) {
+                asm_unsupported("checked casts", &cast->cast);
+            }
+            return lower(gen, cast->expr.get());
+        }
+        case ASTType::AST_ConditionalExpression:
+            return lower(gen, (ConditionalExpression *) node);
+        case ASTType::AST_InstanceOfExpression:
+            asm_unsupported("'instanceof'", &((InstanceOfExpression *) node)->op);
+        case ASTType::AST_NewObject:
+            return lower(gen, (NewObject *) node);
+        case ASTType::AST_ReferenceASTNode:
+            return load(gen, resolve(gen, &((ReferenceASTNode *) node)->reference));
+        default:
+            error("Unexpected expression in the assembly backend");
+            return -1;
+    }
+}
+
+/**
+ * @brief Lowers the statements of a block in a scope of its own.
+ */
+void lower(AsmGenerator &gen, CodeBlock *block) {
+    gen.scopes.emplace_back();
+    for (auto &code: block->codes) {
+        lower_statement(gen, code.get());
+    }
+    gen.scopes.pop_back();
+}
+
+void lower(AsmGenerator &gen, IfStatement *node) {
+    std::string elseLabel = gen.newLabel("if_else");
+    std::string endLabel = gen.newLabel("if_end");
+    gen.emitJump(AsmOp::JumpIfZero, elseLabel, lower(gen, node->condition.get()));
+    lower(gen, node->body.get());
+    if (node->elseBody) {
+        gen.emitJump(AsmOp::Jump, endLabel);
+    }
+    gen.emitLabel(elseLabel);
+    if (node->elseBody) {
+        lower_statement(gen, node->elseBody.get());
+        gen.emitLabel(endLabel);
+    }
+}
+
+/**
+ * @brief Lowers `while` and `do-while` loops, `continue` jumps to the condition.
+ */
+void lower(AsmGenerator &gen, WhileStatement *node) {
+    std::string startLabel = gen.newLabel("while_start");
+    std::string conditionLabel = gen.newLabel("while_condition");
+    std::string endLabel = gen.newLabel("while_end");
+    gen.targets.emplace_back(conditionLabel, endLabel);
+    if (node->isDoWhile) {
+        gen.emitLabel(startLabel);
+        lower(gen, node->body.get());
+        gen.emitLabel(conditionLabel);
+        int condition = lower(gen, node->condition.get());
+        gen.emitJump(AsmOp::JumpIfZero, endLabel, condition);
+        gen.emitJump(AsmOp::Jump, startLabel);
+    } else {
+        gen.emitLabel(conditionLabel);
+        gen.emitJump(AsmOp::JumpIfZero, endLabel, lower(gen, node->condition.get()));
+        lower(gen, node->body.get());
+        gen.emitJump(AsmOp::Jump, conditionLabel);
+    }
+    gen.emitLabel(endLabel);
+    gen.targets.pop_back();
+}
+
+/**
+ * @brief Lowers a `for` loop, `continue` jumps to the update.
+ *
+ * A `@Parallel` loop runs sequentially, the annotation only allows its iterations to run in any order.
+ */
+void lower(AsmGenerator &gen, ForStatement *node) {
+    std::string conditionLabel = gen.newLabel("for_condition");
+    std::string updateLabel = gen.newLabel("for_update");
+    std::string endLabel = gen.newLabel("for_end");
+    gen.scopes.emplace_back();
+    if (node->initialization) {
+        for (auto &code: node->initialization->codes) {
+            lower_statement(gen, code.get());
+        }
+    }
+    gen.emitLabel(conditionLabel);
+    if (node->condition) {
+        gen.emitJump(AsmOp::JumpIfZero, endLabel, lower(gen, node->condition.get()));
+    }
+    gen.targets.emplace_back(updateLabel, endLabel);
+    lower(gen, node->body.get());
+    gen.targets.pop_back();
+    gen.emitLabel(updateLabel);
+    if (node->update) {
+        lower(gen, node->update.get());
+    }
+    gen.emitJump(AsmOp::Jump, conditionLabel);
+    gen.emitLabel(endLabel);
+    gen.scopes.pop_back();
+}
+
+/**
+ * @brief Lowers a `switch` to a chain of comparisons, the bodies follow each other (fall through).
+ */
+void lower(AsmGenerator &gen, SwitchStatement *node) {
+    int value = lower(gen, node->condition.get());
+    std::string endLabel = gen.newLabel("switch_end");
+    std::string defaultLabel = endLabel;
+    std::vector<std::string> labels;
+    for (auto &switchCase: node->cases) {
+        labels.push_back(gen.newLabel(switchCase.isDefault ? "switch_default" : "switch_case"));
+        if (switchCase.isDefault) {
+            defaultLabel = labels.back();
+            continue;
+        }
+        int differs = gen.newRegister();
+        gen.emit({AsmOp::Compare, differs, value, lower_constant(gen, switchCase.value), -1, 0, 4, "!="});
+        gen.emitJump(AsmOp::JumpIfZero, labels.back(), differs);
+    }
+    gen.emitJump(AsmOp::Jump, defaultLabel);
+
+    gen.targets.emplace_back(gen.targets.empty() ? "" : gen.targets.back().first, endLabel);
+    for (size_t i = 0; i < node->cases.size(); i++) {
+        gen.emitLabel(labels[i]);
+        lower(gen, node->cases[i].body.get());
+    }
+    gen.emitLabel(endLabel);
+    gen.targets.pop_back();
+}
+
+/**
+ * @brief Lowers a statement.
+ */
+void lower_statement(AsmGenerator &gen, ASTNode *node) {
+    switch (node->getType()) {
+        case ASTType::AST_CodeBlock:
+            lower(gen, (CodeBlock *) node);
+            break;
+        case ASTType::AST_LocalVariableASTNode: {
+            Field &field = ((LocalVariableASTNode *) node)->field;
+            check_asm_type(gen.project, field.getTypeLexeme(), nullptr);
+            gen.scopes.back()[field.getName()] = {gen.newRegister(), field.getTypeLexeme()};
+            break;
+        }
+        case ASTType::AST_Assignment:
+            lower(gen, (Assignment *) node);
+            break;
+        case ASTType::AST_IfStatement:
+            lower(gen, (IfStatement *) node);
+            break;
+        case ASTType::AST_WhileStatement:
+            lower(gen, (WhileStatement *) node);
+            break;
+        case ASTType::AST_ForStatement:
+            lower(gen, (ForStatement *) node);
+            break;
+        case ASTType::AST_SwitchStatement:
+            lower(gen, (SwitchStatement *) node);
+            break;
+        case ASTType::AST_ReturnStatement: {
+            auto *ret = (ReturnStatement *) node;
+            gen.emit({AsmOp::Return, -1, ret->expr ? lower(gen, ret->expr.get()) : -1});
+            break;
+        }
+        case ASTType::AST_BreakStatement:
+            if (gen.targets.empty()) {
+                error("'break' outside of a loop or a switch");
+            }
+            gen.emitJump(AsmOp::Jump, gen.targets.back().second);
+            break;
+        case ASTType::AST_ContinueStatement:
+            if (gen.targets.empty() || gen.targets.back().first.empty()) {
+                error("'continue' outside of a loop");
+            }
+            gen.emitJump(AsmOp::Jump, gen.targets.back().first);
+            break;
+        case ASTType::AST_SpawnStatement:
+            asm_unsupported("'spawn'", &((SpawnStatement *) node)->spawnToken);
+        case ASTType::AST_SyncStatement:
+            asm_unsupported("'sync'");
+        case ASTType::AST_SynchronizedStatement:
+            asm_unsupported("'synchronized'", &((SynchronizedStatement *) node)->keyword);
+        case ASTType::AST_TryStatement:
+            asm_unsupported("exceptions", &((TryStatement *) node)->keyword);
+        case ASTType::AST_ThrowStatement:
+            asm_unsupported("exceptions", &((ThrowStatement *) node)->keyword);
+        default:
+            lower(gen, node);
+            break;
+    }
+}
+
+/**
+ * @brief Lowers the body of `gen.method` to `gen.code`.
+ *
+ * The receiver (`this`) is the first parameter of instance methods, `main` has no parameters.
+ *
+ * @param gen The generator, with the project, the class, the method and the layouts set.
+ */
+void lower_method(AsmGenerator &gen) {
+    gen.labelPrefix = ".L_" + gen.clazz->getName() + "_" + gen.method->getName() + "_";
+    gen.scopes.emplace_back();
+    if (!gen.method->isStatic() && !gen.method->isMain()) {
+        gen.self = gen.newRegister();
+        gen.params.push_back(gen.self);
+    }
+    if (!gen.method->isMain()) {
+        for (auto &param: *gen.method->getParams()) {
+            int reg = gen.newRegister();
+            gen.scopes.back()[param.getName()] = {reg, param.getTypeLexeme()};
+            gen.params.push_back(reg);
+        }
+    }
+    lower(gen, gen.method->getCodeBlock());
+    gen.emit({AsmOp::Return});
+    gen.scopes.pop_back();
+}
@@ -0,0 +1,244 @@
+#include "../../internal/generator_asm.h"
+#include <algorithm>
+#include <climits>
+
+/// Registers kept across calls by the System V ABI, for the values live across a call.
+static const std::vector<std::string> CALLEE_SAVED = {"rbx", "r12", "r13", "r14", "r15"};
+
+/// Registers clobbered by calls. `rax`, `rcx`, `rdx` and `r11` are not allocated, they are the scratch
+/// registers of the emitted instructions (see `emit_method`).
+static const std::vector<std::string> CALLER_SAVED = {"rsi", "rdi", "r8", "r9", "r10"};
+
+/**
+ * @brief Collects the virtual registers read and written by an instruction.
+ */
+void get_uses_and_def(const AsmInstruction &instruction, std::vector<int> &uses, int &def) {
+    uses.clear();
+    def = instruction.dst;
+    for (int operand: {instruction.a, instruction.b, instruction.c}) {
+        if (operand >= 0) {
+            uses.push_back(operand);
+        }
+    }
+    uses.insert(uses.end(), instruction.args.begin(), instruction.args.end());
+}
+
+bool is_call(const AsmInstruction &instruction) {
+    return instruction.op == AsmOp::Call || instruction.op == AsmOp::CallIndirect;
+}
+
+/**
+ * @brief Assigns a machine register or a stack slot to every virtual register of a method.
+ *
+ * A linear scan register allocator (Poletto and Sarkar):
+ * 1. The code is split into basic blocks at the labels and after the jumps and returns, the live
+ *    variables of each block are computed by the usual backward dataflow to a fixed point.
+ * 2. Every virtual register gets a live interval, from its first to its last position where it is live.
+ *    The parameters are live from the entry.
+ * 3. The intervals are scanned in the order of their start. The interval of a value live across a call
+ *    only gets a callee-saved register, the others prefer a caller-saved one. When no register is free,
+ *    the interval ending last (the current one or an active one) is spilled to a stack slot.
+ *
+ * @param code The instructions of the method.
+ * @param registerCount The number of virtual registers.
+ * @return The location of every virtual register.
+ */
+AsmAllocation allocate_registers(const std::vector<AsmInstruction> &code, int registerCount) {
+    size_t n = code.size();
+
+    // Basic blocks
+    std::vector<size_t> starts;
+    std::map<std::string, size_t> blockOfLabel;
+    for (size_t i = 0; i < n; i++) {
+        bool leader = i == 0 || code[i].op == AsmOp::Label;
+        if (i > 0) {
+            AsmOp previous = code[i - 1].op;
+            leader = leader || previous == AsmOp::Jump || previous == AsmOp::JumpIfZero || previous == AsmOp::Return;
+        }
+        if (leader) {
+            starts.push_back(i);
+        }
+        if (code[i].op == AsmOp::Label) {
+            blockOfLabel[code[i].name] = starts.size() - 1;
+        }
+    }
+    size_t blocks = starts.size();
+    std::vector<std::vector<size_t>> successors(blocks);
+    for (size_t b = 0; b < blocks; b++) {
+        size_t end = b + 1 < blocks ? starts[b + 1] : n;
+        const AsmInstruction &last = code[end - 1];
+        if (last.op == AsmOp::Jump || last.op == AsmOp::JumpIfZero) {
+            successors[b].push_back(blockOfLabel.at(last.name));
+        }
+        if (last.op != AsmOp::Jump && last.op != AsmOp::Return && b + 1 < blocks) {
+            successors[b].push_back(b + 1);
+        }
+    }
+
+    // Liveness, the sets are bitsets of the virtual registers
+    size_t words = (registerCount + 63) / 64;
+    std::vector<std::vector<uint64_t>> liveIn(blocks, std::vector<uint64_t>(words));
+    std::vector<std::vector<uint64_t>> uses(blocks, std::vector<uint64_t>(words));
+    std::vector<std::vector<uint64_t>> defs(blocks, std::vector<uint64_t>(words));
+    std::vector<int> instructionUses;
+    int def;
+    for (size_t b = 0; b < blocks; b++) {
+        size_t end = b + 1 < blocks ? starts[b + 1] : n;
+        for (size_t i = starts[b]; i < end; i++) {
+            get_uses_and_def(code[i], instructionUses, def);
+            for (int use: instructionUses) {
+                if (!(defs[b][use / 64] >> (use % 64) & 1)) {
+                    uses[b][use / 64] |= 1ULL << (use % 64);
+                }
+            }
+            if (def >= 0) {
+                defs[b][def / 64] |= 1ULL << (def % 64);
+            }
+        }
+    }
+    std::vector<std::vector<uint64_t>> liveOut(blocks, std::vector<uint64_t>(words));
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (size_t b = blocks; b-- > 0;) {
+            for (size_t w = 0; w < words; w++) {
+                uint64_t out = 0;
+                for (size_t successor: successors[b]) {
+                    out |= liveIn[successor][w];
+                }
+                uint64_t in = uses[b][w] | (out & ~defs[b][w]);
+                if (out != liveOut[b][w] || in != liveIn[b][w]) {
+                    liveOut[b][w] = out;
+                    liveIn[b][w] = in;
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    // Live intervals
+    std::vector<long long> start(registerCount, LLONG_MAX);
+    std::vector<long long> end(registerCount, -2);
+    auto extend = [&](int reg, long long position) {
+        start[reg] = std::min(start[reg], position);
+        end[reg] = std::max(end[reg], position);
+    };
+    std::vector<long long> calls;
+    for (size_t b = 0; b < blocks; b++) {
+        size_t blockEnd = b + 1 < blocks ? starts[b + 1] : n;
+        std::vector<uint64_t> live = liveOut[b];
+        for (size_t i = blockEnd; i-- > starts[b];) {
+            for (size_t w = 0; w < words; w++) {
+                for (uint64_t bits = live[w]; bits; bits &= bits - 1) {
+                    extend((int) (w * 64 + __builtin_ctzll(bits)), (long long) i);
+                }
+            }
+            get_uses_and_def(code[i], instructionUses, def);
+            if (def >= 0) {
+                extend(def, (long long) i);
+                live[def / 64] &= ~(1ULL << (def % 64));
+            }
+            for (int use: instructionUses) {
+                extend(use, (long long) i);
+                live[use / 64] |= 1ULL << (use % 64);
+            }
+            if (is_call(code[i])) {
+                calls.push_back((long long) i);
+            }
+        }
+        if (b == 0) {
+            for (size_t w = 0; w < words; w++) {
+                for (uint64_t bits = live[w]; bits; bits &= bits - 1) {
+                    extend((int) (w * 64 + __builtin_ctzll(bits)), -1);
+                }
+            }
+        }
+    }
+    std::sort(calls.begin(), calls.end());
+    std::vector<bool> crossesCall(registerCount);
+    for (int reg = 0; reg < registerCount; reg++) {
+        auto call = std::upper_bound(calls.begin(), calls.end(), start[reg]);
+        crossesCall[reg] = call != calls.end() && *call < end[reg];
+    }
+
+    // Linear scan
+    AsmAllocation allocation;
+    allocation.registers.resize(registerCount);
+    allocation.slots.assign(registerCount, -1);
+    std::vector<int> order;
+    for (int reg = 0; reg < registerCount; reg++) {
+        if (end[reg] >= -1) {
+            order.push_back(reg);
+        }
+    }
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return start[a] < start[b]; });
+
+    std::vector<int> active;
+    std::vector<std::string> freeCallee(CALLEE_SAVED.rbegin(), CALLEE_SAVED.rend());
+    std::vector<std::string> freeCaller(CALLER_SAVED.rbegin(), CALLER_SAVED.rend());
+    std::vector<bool> usedCallee(CALLEE_SAVED.size());
+    auto isCallee = [](const std::string &name) {
+        return std::find(CALLEE_SAVED.begin(), CALLEE_SAVED.end(), name) != CALLEE_SAVED.end();
+    };
+    auto spill = [&](int reg) {
+        allocation.registers[reg].clear();
+        allocation.slots[reg] = allocation.slotCount++;
+    };
+
+    for (int reg: order) {
+        for (size_t i = 0; i < active.size();) {
+            int other = active[i];
+            if (end[other] < start[reg]) {
+                const std::string &name = allocation.registers[other];
+                (isCallee(name) ? freeCallee : freeCaller).push_back(name);
+                active.erase(active.begin() + (long) i);
+            } else {
+                i++;
+            }
+        }
+
+        std::vector<std::string> *pool = nullptr;
+        if (!crossesCall[reg] && !freeCaller.empty()) {
+            pool = &freeCaller;
+        } else if (!freeCallee.empty()) {
+            pool = &freeCallee;
+        }
+        if (pool) {
+            allocation.registers[reg] = pool->back();
+            pool->pop_back();
+            active.push_back(reg);
+            continue;
+        }
+
+        int victim = -1;
+        for (int other: active) {
+            if (crossesCall[reg] && !isCallee(allocation.registers[other])) {
+                continue;
+            }
+            if (victim < 0 || end[other] > end[victim]) {
+                victim = other;
+            }
+        }
+        if (victim >= 0 && end[victim] > end[reg]) {
+            allocation.registers[reg] = allocation.registers[victim];
+            spill(victim);
+            active.erase(std::find(active.begin(), active.end(), victim));
+            active.push_back(reg);
+        } else {
+            spill(reg);
+        }
+    }
+
+    for (int reg = 0; reg < registerCount; reg++) {
+        for (size_t i = 0; i < CALLEE_SAVED.size(); i++) {
+            if (allocation.registers[reg] == CALLEE_SAVED[i]) {
+                usedCallee[i] = true;
+            }
+        }
+    }
+    for (size_t i = 0; i < CALLEE_SAVED.size(); i++) {
+        if (usedCallee[i]) {
+            allocation.saved.push_back(CALLEE_SAVED[i]);
+        }
+    }
+    return allocation;
+}
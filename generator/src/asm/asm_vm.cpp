@@ -0,0 +1,732 @@
+#include "../../internal/generator_asm.h"
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+
+/**
+ * @brief The operations of the bytecode, the handlers of `vm_execute` in the same order.
+ *
+ * Registers are 64-bit, `int` and `boolean` values are kept sign extended from 32 bits. The superinstructions
+ * are `AddImmediate`, the `BranchIf*` compare-and-branch, `LoadFieldIndex`/`StoreFieldIndex` (an `int[]`
+ * field and its element) and `CallVirtual` (the `$_function_` load and the call, with an inline cache).
+ */
+#define VM_OPS(X) \
+    X(Move) X(LoadImmediate) X(AddImmediate) \
+    X(Add) X(Sub) X(Mul) X(Div) X(Rem) X(And) X(Or) X(Xor) X(Shl) X(Shr) X(Ushr) \
+    X(Equal) X(NotEqual) X(Less) X(LessEqual) X(Greater) X(GreaterEqual) X(EqualRef) X(NotEqualRef) \
+    X(Not) X(BitNot) \
+    X(Load1) X(Load4) X(Load8) X(Store1) X(Store4) X(Store8) \
+    X(LoadIndex) X(StoreIndex) X(LoadFieldIndex) X(StoreFieldIndex) X(LoadGlobal) X(StoreGlobal) \
+    X(Jump) X(JumpIfZero) \
+    X(BranchIfEqual) X(BranchIfNotEqual) X(BranchIfLess) X(BranchIfLessEqual) X(BranchIfGreater) X(BranchIfGreaterEqual) \
+    X(Call) X(CallVirtual) X(CallIndirect) X(Return) X(ReturnVoid) \
+    X(New) X(NewArray) X(Slice) X(Print)
+
+enum class VmOp {
+#define VM_ENUM(name) name,
+    VM_OPS(VM_ENUM)
+#undef VM_ENUM
+};
+
+struct VmMethod;
+
+/**
+ * @struct VmInstruction
+ * @brief An instruction of the register-based bytecode, threaded by the address of its handler.
+ */
+struct VmInstruction {
+    /// Address of the handler in `vm_execute`
+    const void *handler = nullptr;
+    VmOp op;
+    int32_t dst = -1;
+    int32_t a = -1;
+    int32_t b = -1;
+    int32_t c = -1;
+    /// Immediate value, byte offset, or the frame size of the method for calls
+    int64_t imm = 0;
+    /// Target of jumps and branches
+    const VmInstruction *jump = nullptr;
+    /// Called method, class of `New`, slot of a static field, or the cached method of `CallVirtual`
+    void *target = nullptr;
+    /// Class id of the receiver cached by `CallVirtual`, -1 before the first call
+    int32_t cachedClass = -1;
+    int32_t argCount = 0;
+    const int32_t *args = nullptr;
+};
+
+/**
+ * @struct VmMethod
+ * @brief The bytecode of a method. The parameters (the receiver first) are its registers 0 to n-1.
+ */
+struct VmMethod {
+    std::vector<VmInstruction> code;
+    /// Registers of the arguments of the calls of the method
+    std::vector<int32_t> arguments;
+    int32_t registers = 0;
+};
+
+/**
+ * @struct VmClass
+ * @brief What `New` needs to create an object, see `generate_asm_constructor`.
+ */
+struct VmClass {
+    int64_t size = 0;
+    int32_t id = 0;
+    /// `$_function_` pointers of the object, they point to the `VmMethod`
+    std::vector<std::pair<int64_t, VmMethod *>> slots;
+};
+
+/**
+ * @struct VmFrame
+ * @brief A call in progress, restored by `Return`.
+ */
+struct VmFrame {
+    const VmInstruction *pc;
+    int64_t *registers;
+    int32_t dst;
+};
+
+/**
+ * @struct VmState
+ * @brief The stacks of a run and its counters.
+ */
+struct VmState {
+    int64_t *stack = nullptr;
+    int64_t *stackEnd = nullptr;
+    VmFrame *frames = nullptr;
+    size_t maxDepth = 0;
+    const void *const *handlers = nullptr;
+    uint64_t virtualCalls = 0;
+    uint64_t cacheMisses = 0;
+};
+
+/// Registers of the stack of a run, the pages are only touched when they are used
+static const size_t VM_STACK_REGISTERS = 1 << 22;
+static const size_t VM_MAX_DEPTH = 1 << 20;
+
+/**
+ * @brief Runs bytecode from `pc` until the outermost method returns.
+ *
+ * Dispatch is threaded: every handler ends with an indirect jump to the handler of the next instruction
+ * (`goto *pc->handler`, GCC's labels as values), there is no central `switch` and every handler has a
+ * branch of its own for the predictor. Called with a null `pc`, it only fills `state.handlers`.
+ */
+void vm_execute(VmInstruction *pc, VmState &state) {
+    static const void *const handlers[] = {
+#define VM_LABEL(name) &&op_##name,
+            VM_OPS(VM_LABEL)
+#undef VM_LABEL
+    };
+    if (!pc) {
+        state.handlers = handlers;
+        return;
+    }
+
+#define NEXT() goto *pc->handler
+#define R(operand) r[pc->operand]
+#define I(operand) ((int32_t) r[pc->operand])
+#define U(operand) ((uint32_t) r[pc->operand])
+#define ADDRESS(operand) ((char *) r[pc->operand] + pc->imm)
+#define INT_OP(name, expression) op_##name: R(dst) = (int32_t) (expression); pc++; NEXT();
+#define BRANCH_OP(name, condition) op_##name: pc = (condition) ? (VmInstruction *) pc->jump : pc + 1; NEXT();
+
+    int64_t *r = state.stack;
+    size_t depth = 0;
+    VmMethod *callee;
+    int64_t *frame;
+    NEXT();
+
+    op_Move:
+    R(dst) = R(a);
+    pc++;
+    NEXT();
+    op_LoadImmediate:
+    R(dst) = pc->imm;
+    pc++;
+    NEXT();
+    INT_OP(AddImmediate, U(a) + (uint32_t) pc->imm)
+    INT_OP(Add, U(a) + U(b))
+    INT_OP(Sub, U(a) - U(b))
+    INT_OP(Mul, U(a) * U(b))
+    INT_OP(Div, I(a) / I(b))
+    INT_OP(Rem, I(a) % I(b))
+    INT_OP(And, U(a) & U(b))
+    INT_OP(Or, U(a) | U(b))
+    INT_OP(Xor, U(a) ^ U(b))
+    INT_OP(Shl, U(a) << (U(b) & 31))
+    INT_OP(Shr, I(a) >> (U(b) & 31))
+    INT_OP(Ushr, U(a) >> (U(b) & 31))
+    INT_OP(Equal, I(a) == I(b))
+    INT_OP(NotEqual, I(a) != I(b))
+    INT_OP(Less, I(a) < I(b))
+    INT_OP(LessEqual, I(a) <= I(b))
+    INT_OP(Greater, I(a) > I(b))
+    INT_OP(GreaterEqual, I(a) >= I(b))
+    INT_OP(EqualRef, R(a) == R(b))
+    INT_OP(NotEqualRef, R(a) != R(b))
+    INT_OP(Not, R(a) ^ 1)
+    INT_OP(BitNot, ~U(a))
+
+    op_Load1:
+    R(dst) = *(uint8_t *) ADDRESS(a);
+    pc++;
+    NEXT();
+    op_Load4:
+    R(dst) = *(int32_t *) ADDRESS(a);
+    pc++;
+    NEXT();
+    op_Load8:
+    R(dst) = *(int64_t *) ADDRESS(a);
+    pc++;
+    NEXT();
+    op_Store1:
+    *(uint8_t *) ADDRESS(a) = (uint8_t) R(b);
+    pc++;
+    NEXT();
+    op_Store4:
+    *(int32_t *) ADDRESS(a) = I(b);
+    pc++;
+    NEXT();
+    op_Store8:
+    *(int64_t *) ADDRESS(a) = R(b);
+    pc++;
+    NEXT();
+
+    op_LoadIndex:
+    R(dst) = (*(int32_t **) ((char *) R(a) + 8))[I(b)];
+    pc++;
+    NEXT();
+    op_StoreIndex:
+    (*(int32_t **) ((char *) R(a) + 8))[I(b)] = I(c);
+    pc++;
+    NEXT();
+    op_LoadFieldIndex:
+    R(dst) = (*(int32_t **) (*(char **) ADDRESS(a) + 8))[I(b)];
+    pc++;
+    NEXT();
+    op_StoreFieldIndex:
+    (*(int32_t **) (*(char **) ADDRESS(a) + 8))[I(b)] = I(c);
+    pc++;
+    NEXT();
+    op_LoadGlobal:
+    R(dst) = *(int64_t *) pc->target;
+    pc++;
+    NEXT();
+    op_StoreGlobal:
+    *(int64_t *) pc->target = R(a);
+    pc++;
+    NEXT();
+
+    op_Jump:
+    pc = (VmInstruction *) pc->jump;
+    NEXT();
+    BRANCH_OP(JumpIfZero, !R(a))
+    BRANCH_OP(BranchIfEqual, I(a) == I(b))
+    BRANCH_OP(BranchIfNotEqual, I(a) != I(b))
+    BRANCH_OP(BranchIfLess, I(a) < I(b))
+    BRANCH_OP(BranchIfLessEqual, I(a) <= I(b))
+    BRANCH_OP(BranchIfGreater, I(a) > I(b))
+    BRANCH_OP(BranchIfGreaterEqual, I(a) >= I(b))
+
+    op_Call:
+    callee = (VmMethod *) pc->target;
+    goto invoke;
+    op_CallVirtual: {
+        // The class id of the header (see `generate_asm_constructor`), a null receiver faults here
+        char *receiver = (char *) r[pc->args[0]];
+        int32_t id = *(int32_t *) (receiver + 8);
+        state.virtualCalls++;
+        if (id != pc->cachedClass) {
+            state.cacheMisses++;
+            pc->cachedClass = id;
+            pc->target = *(VmMethod **) (receiver + pc->b);
+        }
+        callee = (VmMethod *) pc->target;
+        goto invoke;
+    }
+    op_CallIndirect:
+    callee = (VmMethod *) R(a);
+    invoke:
+    frame = r + pc->imm;
+    if (frame + callee->registers > state.stackEnd || depth == state.maxDepth) {
+        jit_runtime::fail("Error: Stack overflow\n");
+    }
+    for (int32_t i = 0; i < pc->argCount; i++) {
+        frame[i] = r[pc->args[i]];
+    }
+    state.frames[depth++] = {pc + 1, r, pc->dst};
+    r = frame;
+    pc = callee->code.data();
+    NEXT();
+    op_Return: {
+        int64_t value = R(a);
+        if (depth == 0) {
+            return;
+        }
+        VmFrame &caller = state.frames[--depth];
+        r = caller.registers;
+        if (caller.dst >= 0) {
+            r[caller.dst] = value;
+        }
+        pc = (VmInstruction *) caller.pc;
+        NEXT();
+    }
+    op_ReturnVoid: {
+        if (depth == 0) {
+            return;
+        }
+        VmFrame &caller = state.frames[--depth];
+        r = caller.registers;
+        pc = (VmInstruction *) caller.pc;
+        NEXT();
+    }
+
+    op_New: {
+        auto *clazz = (VmClass *) pc->target;
+        auto *object = (char *) jit_runtime::alloc((long) clazz->size);
+        *(int32_t *) (object + 8) = clazz->id;
+        for (auto &slot: clazz->slots) {
+            *(VmMethod **) (object + slot.first) = slot.second;
+        }
+        R(dst) = (int64_t) object;
+        pc++;
+        NEXT();
+    }
+    op_NewArray:
+    R(dst) = (int64_t) jit_runtime::new_array(I(a));
+    pc++;
+    NEXT();
+    op_Slice:
+    R(dst) = (int64_t) jit_runtime::slice((char *) R(a), I(b), I(c));
+    pc++;
+    NEXT();
+    op_Print:
+    jit_runtime::print_int(I(a), I(b));
+    pc++;
+    NEXT();
+
+#undef NEXT
+#undef R
+#undef I
+#undef U
+#undef ADDRESS
+#undef INT_OP
+#undef BRANCH_OP
+}
+
+/**
+ * @brief Translates the three-address code of a method (see `lower_method`) to bytecode.
+ *
+ * The virtual registers become the registers of the frame, the parameters first. Adjacent instructions
+ * are fused into superinstructions when the value passed between them has no other use, and a value moved
+ * to a local right after it is computed is computed into the local directly.
+ */
+struct VmTranslator {
+    const std::vector<AsmInstruction> &code;
+    VmMethod &method;
+    const std::unordered_map<std::string, VmMethod *> &methods;
+    const std::unordered_map<std::string, VmClass *> &classes;
+    const std::unordered_map<std::string, int64_t *> &statics;
+    /// Register of the frame of every virtual register
+    std::vector<int32_t> number;
+    /// Number of reads of every virtual register
+    std::vector<int> uses;
+    /// Loads of an `int[]` field merged into a later element access (load → access)
+    std::unordered_map<size_t, size_t> fieldArrays;
+    /// Merged accesses of `int[]` fields, emitted at the position of the access
+    std::unordered_map<size_t, VmInstruction> pendingAccesses;
+    std::unordered_map<std::string, size_t> labels;
+    std::vector<std::pair<size_t, std::string>> jumps;
+    std::vector<std::pair<size_t, size_t>> arguments;
+    int fused = 0;
+
+    void countUses() {
+        uses.assign(method.registers, 0);
+        for (auto &instruction: code) {
+            for (int operand: {instruction.a, instruction.b, instruction.c}) {
+                if (operand >= 0) {
+                    uses[operand]++;
+                }
+            }
+            for (int argument: instruction.args) {
+                uses[argument]++;
+            }
+        }
+    }
+
+    bool usedOnce(int reg) const {
+        return reg >= 0 && uses[reg] == 1;
+    }
+
+    /**
+     * @brief Finds the element accesses of `int[]` fields whose array load can be merged into them.
+     *
+     * The index is evaluated between the load of the field and the access (`this.arr[i + 1]`), the load
+     * moves to the access when the instructions in between can't write memory or leave the block.
+     */
+    void findFieldArrays() {
+        for (size_t i = 0; i < code.size(); i++) {
+            const AsmInstruction &load = code[i];
+            if (load.op != AsmOp::Load || load.size != 8 || !usedOnce(load.dst)) {
+                continue;
+            }
+            for (size_t j = i + 1; j < code.size(); j++) {
+                const AsmInstruction &next = code[j];
+                if ((next.op == AsmOp::LoadIndex || next.op == AsmOp::StoreIndex) && next.a == load.dst) {
+                    fieldArrays[i] = j;
+                    break;
+                }
+                bool pure = next.op == AsmOp::Move || next.op == AsmOp::LoadImmediate ||
+                            next.op == AsmOp::Compare || next.op == AsmOp::Not || next.op == AsmOp::BitNot ||
+                            next.op == AsmOp::Load || next.op == AsmOp::LoadIndex ||
+                            (next.op == AsmOp::Binary && next.name != "/" && next.name != "%");
+                if (!pure || next.dst == load.a) {
+                    break;
+                }
+            }
+        }
+    }
+
+    VmInstruction make(VmOp op, const AsmInstruction &from) const {
+        VmInstruction instruction;
+        instruction.op = op;
+        instruction.dst = from.dst >= 0 ? number[from.dst] : -1;
+        instruction.a = from.a >= 0 ? number[from.a] : -1;
+        instruction.b = from.b >= 0 ? number[from.b] : -1;
+        instruction.c = from.c >= 0 ? number[from.c] : -1;
+        instruction.imm = from.imm;
+        return instruction;
+    }
+
+    VmInstruction &emit(VmOp op, const AsmInstruction &from) {
+        method.code.push_back(make(op, from));
+        return method.code.back();
+    }
+
+    void jumpTo(const std::string &label) {
+        jumps.emplace_back(method.code.size() - 1, label);
+    }
+
+    void setArguments(VmInstruction &instruction, const std::vector<int> &args) {
+        arguments.emplace_back(method.code.size() - 1, method.arguments.size());
+        instruction.argCount = (int32_t) args.size();
+        for (int argument: args) {
+            method.arguments.push_back(number[argument]);
+        }
+    }
+
+    VmOp binaryOp(const std::string &op) const {
+        static const std::unordered_map<std::string, VmOp> ops = {
+                {"+", VmOp::Add}, {"-", VmOp::Sub}, {"*", VmOp::Mul}, {"/", VmOp::Div}, {"%", VmOp::Rem},
+                {"&", VmOp::And}, {"|", VmOp::Or}, {"^", VmOp::Xor},
+                {"<<", VmOp::Shl}, {">>", VmOp::Shr}, {">>>", VmOp::Ushr},
+        };
+        return ops.at(op);
+    }
+
+    /// The compare-and-branch taken when the comparison is false, the branch of `JumpIfZero`
+    VmOp branchOp(const std::string &op) const {
+        static const std::unordered_map<std::string, VmOp> ops = {
+                {"==", VmOp::BranchIfNotEqual}, {"!=", VmOp::BranchIfEqual},
+                {"<", VmOp::BranchIfGreaterEqual}, {"<=", VmOp::BranchIfGreater},
+                {">", VmOp::BranchIfLessEqual}, {">=", VmOp::BranchIfLess},
+        };
+        return ops.at(op);
+    }
+
+    VmOp compareOp(const std::string &op, bool references) const {
+        static const std::unordered_map<std::string, VmOp> ops = {
+                {"==", VmOp::Equal}, {"!=", VmOp::NotEqual}, {"<", VmOp::Less}, {"<=", VmOp::LessEqual},
+                {">", VmOp::Greater}, {">=", VmOp::GreaterEqual},
+        };
+        if (references) {
+            return op == "==" ? VmOp::EqualRef : VmOp::NotEqualRef;
+        }
+        return ops.at(op);
+    }
+
+    void call(const AsmInstruction &instruction) {
+        const std::string &name = instruction.name;
+        if (name == "__mj_print_int") {
+            VmInstruction &print = emit(VmOp::Print, instruction);
+            print.a = number[instruction.args[0]];
+            print.b = number[instruction.args[1]];
+        } else if (name == "__mj_new_array") {
+            emit(VmOp::NewArray, instruction).a = number[instruction.args[0]];
+        } else if (name == "__mj_int_array_slice") {
+            VmInstruction &slice = emit(VmOp::Slice, instruction);
+            slice.a = number[instruction.args[0]];
+            slice.b = number[instruction.args[1]];
+            slice.c = number[instruction.args[2]];
+        } else if (classes.count(name)) {
+            emit(VmOp::New, instruction).target = classes.at(name);
+        } else {
+            VmInstruction &invoke = emit(VmOp::Call, instruction);
+            invoke.target = methods.at(name);
+            invoke.imm = method.registers;
+            setArguments(invoke, instruction.args);
+        }
+    }
+
+    /**
+     * @brief Translates the code into `method`, counting the fused instructions in `fused`.
+     *
+     * @param params The virtual registers of the parameters, the receiver first.
+     */
+    void translate(const std::vector<int> &params) {
+        number.assign(method.registers, -1);
+        int32_t next = 0;
+        for (int param: params) {
+            number[param] = next++;
+        }
+        for (auto &reg: number) {
+            if (reg < 0) {
+                reg = next++;
+            }
+        }
+        countUses();
+        findFieldArrays();
+
+        std::vector<bool> skipped(code.size());
+        for (size_t i = 0; i < code.size(); i++) {
+            if (skipped[i]) {
+                continue;
+            }
+            const AsmInstruction &instruction = code[i];
+            const AsmInstruction *following = i + 1 < code.size() ? &code[i + 1] : nullptr;
+            size_t count = method.code.size();
+
+            switch (instruction.op) {
+                case AsmOp::Label:
+                    labels[instruction.name] = method.code.size();
+                    break;
+                case AsmOp::Move:
+                    if (number[instruction.dst] != number[instruction.a]) {
+                        emit(VmOp::Move, instruction);
+                    }
+                    break;
+                case AsmOp::LoadImmediate:
+                    if (following && following->op == AsmOp::Binary && following->b == instruction.dst &&
+                        following->a != instruction.dst && usedOnce(instruction.dst) &&
+                        (following->name == "+" || following->name == "-")) {
+                        VmInstruction &add = emit(VmOp::AddImmediate, *following);
+                        add.imm = following->name == "+" ? instruction.imm : -instruction.imm;
+                        skipped[++i] = true;
+                        fused++;
+                    } else {
+                        emit(VmOp::LoadImmediate, instruction);
+                    }
+                    break;
+                case AsmOp::Binary:
+                    emit(binaryOp(instruction.name), instruction);
+                    break;
+                case AsmOp::Compare:
+                    if (following && following->op == AsmOp::JumpIfZero && following->a == instruction.dst &&
+                        instruction.size == 4 && usedOnce(instruction.dst)) {
+                        VmInstruction &branch = emit(branchOp(instruction.name), instruction);
+                        branch.dst = -1;
+                        jumpTo(following->name);
+                        skipped[++i] = true;
+                        fused++;
+                    } else {
+                        emit(compareOp(instruction.name, instruction.size == 8), instruction);
+                    }
+                    break;
+                case AsmOp::Not:
+                    emit(VmOp::Not, instruction);
+                    break;
+                case AsmOp::BitNot:
+                    emit(VmOp::BitNot, instruction);
+                    break;
+                case AsmOp::Load:
+                    if (fieldArrays.count(i)) {
+                        size_t access = fieldArrays.at(i);
+                        const AsmInstruction &element = code[access];
+                        // The index is computed first, the merged access takes the place of the second one
+                        VmInstruction merged = make(element.op == AsmOp::LoadIndex ? VmOp::LoadFieldIndex
+                                                                                   : VmOp::StoreFieldIndex, element);
+                        merged.a = number[instruction.a];
+                        merged.imm = instruction.imm;
+                        pendingAccesses[access] = merged;
+                        fused++;
+                    } else if (following && following->op == AsmOp::CallIndirect && following->a == instruction.dst &&
+                               usedOnce(instruction.dst)) {
+                        VmInstruction &invoke = emit(VmOp::CallVirtual, *following);
+                        invoke.a = -1;
+                        invoke.b = (int32_t) instruction.imm;
+                        invoke.imm = method.registers;
+                        setArguments(invoke, following->args);
+                        skipped[++i] = true;
+                        fused++;
+                    } else {
+                        emit(instruction.size == 1 ? VmOp::Load1 : instruction.size == 4 ? VmOp::Load4 : VmOp::Load8,
+                             instruction);
+                    }
+                    break;
+                case AsmOp::Store:
+                    emit(instruction.size == 1 ? VmOp::Store1 : instruction.size == 4 ? VmOp::Store4 : VmOp::Store8,
+                         instruction);
+                    break;
+                case AsmOp::LoadIndex:
+                case AsmOp::StoreIndex:
+                    if (pendingAccesses.count(i)) {
+                        method.code.push_back(pendingAccesses.at(i));
+                    } else {
+                        emit(instruction.op == AsmOp::LoadIndex ? VmOp::LoadIndex : VmOp::StoreIndex, instruction);
+                    }
+                    break;
+                case AsmOp::LoadGlobal:
+                    emit(VmOp::LoadGlobal, instruction).target = statics.at(instruction.name);
+                    break;
+                case AsmOp::StoreGlobal:
+                    emit(VmOp::StoreGlobal, instruction).target = statics.at(instruction.name);
+                    break;
+                case AsmOp::Call:
+                    call(instruction);
+                    break;
+                case AsmOp::CallIndirect: {
+                    VmInstruction &invoke = emit(VmOp::CallIndirect, instruction);
+                    invoke.imm = method.registers;
+                    setArguments(invoke, instruction.args);
+                    break;
+                }
+                case AsmOp::Jump:
+                    emit(VmOp::Jump, instruction);
+                    jumpTo(instruction.name);
+                    break;
+                case AsmOp::JumpIfZero:
+                    emit(VmOp::JumpIfZero, instruction);
+                    jumpTo(instruction.name);
+                    break;
+                case AsmOp::Return:
+                    emit(instruction.a >= 0 ? VmOp::Return : VmOp::ReturnVoid, instruction);
+                    break;
+            }
+
+            // A temporary moved to its destination right away is computed there (`i = i + 1` is one
+            // `AddImmediate`), `i` is the last instruction translated
+            int result = code[i].dst;
+            if (method.code.size() == count + 1 && method.code.back().dst >= 0 && i + 1 < code.size() &&
+                code[i + 1].op == AsmOp::Move && code[i + 1].a == result && usedOnce(result)) {
+                method.code.back().dst = number[code[i + 1].dst];
+                skipped[i + 1] = true;
+                fused++;
+            }
+        }
+
+        for (auto &jump: jumps) {
+            method.code[jump.first].jump = &method.code[labels.at(jump.second)];
+        }
+        for (auto &argument: arguments) {
+            method.code[argument.first].args = &method.arguments[argument.second];
+        }
+    }
+
+};
+
+/**
+ * @brief Compiles a Mini-Java project to bytecode and interprets it, without writing any file.
+ *
+ * See `run_vm` in `generator.h`.
+ */
+int run_vm(Project *project) {
+    using clock = std::chrono::steady_clock;
+    clock::time_point start = clock::now();
+
+    VmState state;
+    vm_execute(nullptr, state);
+    std::vector<Class *> order = get_asm_classes(project);
+
+    // Every static field is a zeroed register-sized slot
+    std::vector<std::string> staticNames;
+    for (Class *clazz: order) {
+        for (auto &field: *clazz->getFields()) {
+            if (field.isStatic()) {
+                staticNames.push_back(get_asm_static_name(clazz->getName(), field.getName()));
+            }
+        }
+    }
+    std::vector<int64_t> staticStorage(staticNames.size());
+    std::unordered_map<std::string, int64_t *> statics;
+    for (size_t i = 0; i < staticNames.size(); i++) {
+        statics[staticNames[i]] = &staticStorage[i];
+    }
+
+    // The methods and classes are created first, calls and objects point to them
+    std::deque<VmMethod> methodStorage;
+    std::deque<VmClass> classStorage;
+    std::unordered_map<std::string, VmMethod *> methods;
+    std::unordered_map<std::string, VmClass *> classes;
+    for (Class *clazz: order) {
+        for (auto &method: *clazz->getMethods()) {
+            methods[method.isMain() ? "main" : clazz->getName() + "_" + method.getName()] = &methodStorage.emplace_back();
+        }
+    }
+    std::map<Identifier, AsmLayout> layouts;
+    for (size_t id = 0; id < order.size(); id++) {
+        AsmLayout &layout = get_asm_layout(project, layouts, order[id]);
+        VmClass &clazz = classStorage.emplace_back();
+        clazz.size = layout.size;
+        clazz.id = (int32_t) id;
+        for (auto &slot: layout.slots) {
+            clazz.slots.emplace_back(slot.first, methods.at(get_method_reference_name(project, order[id], slot.second)));
+        }
+        classes["__mj_new_" + order[id]->getName()] = &clazz;
+    }
+
+    size_t instructions = 0;
+    int fused = 0;
+    for (Class *clazz: order) {
+        for (auto &method: *clazz->getMethods()) {
+            AsmGenerator gen{project, clazz, &method, &layouts};
+            lower_method(gen);
+            VmMethod &vm = *methods.at(method.isMain() ? "main" : clazz->getName() + "_" + method.getName());
+            vm.registers = gen.registers;
+            VmTranslator translator{gen.code, vm, methods, classes, statics};
+            translator.translate(gen.params);
+            for (auto &instruction: vm.code) {
+                instruction.handler = state.handlers[(int) instruction.op];
+            }
+            instructions += vm.code.size();
+            fused += translator.fused;
+        }
+    }
+    if (!methods.count("main")) {
+        error("The program has no 'main' method");
+    }
+    clock::time_point compiled = clock::now();
+
+    state.stack = (int64_t *) calloc(VM_STACK_REGISTERS, sizeof(int64_t));
+    state.frames = (VmFrame *) calloc(VM_MAX_DEPTH, sizeof(VmFrame));
+    if (!state.stack || !state.frames) {
+        error("The VM could not allocate its stack");
+    }
+    state.stackEnd = state.stack + VM_STACK_REGISTERS;
+    state.maxDepth = VM_MAX_DEPTH;
+
+    struct sigaction action{}, previous{};
+    action.sa_handler = jit_runtime::null_pointer;
+    sigaction(SIGSEGV, &action, &previous);
+    vm_execute(methods.at("main")->code.data(), state);
+    jit_runtime::flush();
+    sigaction(SIGSEGV, &previous, nullptr);
+    clock::time_point finished = clock::now();
+
+    if (getenv("MINIJAVA_VM_STATS")) {
+        auto ms = [&start](clock::time_point time) {
+            return std::chrono::duration<double, std::milli>(time - start).count();
+        };
+        fprintf(stderr, "VM: %zu methods, %zu instructions (%d fused), compiled in %.3f ms, "
+                        "first output after %.3f ms, finished after %.3f ms, %llu virtual calls "
+                        "(%llu inline cache misses)\n",
+                methods.size(), instructions, fused, ms(compiled),
+                jit_runtime::printed ? ms(jit_runtime::firstOutput) : ms(finished), ms(finished),
+                (unsigned long long) state.virtualCalls, (unsigned long long) state.cacheMisses);
+    }
+    free(state.stack);
+    free(state.frames);
+    jit_runtime::reset();
+    return 0;
+}
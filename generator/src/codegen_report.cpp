@@ -0,0 +1,113 @@
+#include "../include/codegen_report.h"
+#include "../../common/include/profiler.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace codegen_report {
+    bool enabled = false;
+
+    /// The generated methods, in the order of generation (classes are generated one after another)
+    std::vector<MethodStats> methods;
+
+    void enable() {
+        methods.clear();
+        enabled = true;
+    }
+
+    void record(MethodStats stats) {
+        methods.push_back(std::move(stats));
+    }
+
+    /// Writes the counters of a method, or the sums of the methods of a class.
+    void write_counters(std::ostream &out, const MethodStats &stats) {
+        out << "\"instructions\": " << stats.instructions
+            << ", \"temps\": " << stats.temps
+            << ", \"labels\": " << stats.labels
+            << ", \"directCalls\": " << stats.directCalls
+            << ", \"indirectCalls\": " << stats.indirectCalls
+            << ", \"inlinedCalls\": " << stats.inlinedCalls
+            << ", \"guardedCalls\": " << stats.guardedCalls
+            << ", \"allocations\": " << stats.allocations
+            << ", \"arrayAccesses\": " << stats.arrayAccesses
+            << ", \"bytes\": " << stats.bytes;
+    }
+
+    void write_report(const std::string &path) {
+        std::ofstream out(path);
+        if (!out.is_open()) {
+            std::cerr << "Error: Unable to create the codegen report '" << path << "'." << std::endl;
+            return;
+        }
+        out << "{\"classes\": [";
+        for (size_t begin = 0, end; begin < methods.size(); begin = end) {
+            MethodStats total;
+            for (end = begin; end < methods.size() && methods[end].clazz == methods[begin].clazz; end++) {
+                const MethodStats &method = methods[end];
+                total.instructions += method.instructions;
+                total.temps += method.temps;
+                total.labels += method.labels;
+                total.directCalls += method.directCalls;
+                total.indirectCalls += method.indirectCalls;
+                total.inlinedCalls += method.inlinedCalls;
+                total.guardedCalls += method.guardedCalls;
+                total.allocations += method.allocations;
+                total.arrayAccesses += method.arrayAccesses;
+                total.bytes += method.bytes;
+            }
+
+            out << (begin ? ",\n" : "\n") << "{\"name\": \"" << profiler::json_escape(methods[begin].clazz) << "\", ";
+            write_counters(out, total);
+            out << ", \"methods\": [";
+            for (size_t i = begin; i < end; i++) {
+                const MethodStats &method = methods[i];
+                out << (i > begin ? ",\n" : "\n") << "  {\"name\": \"" << profiler::json_escape(method.method)
+                    << "\", ";
+                write_counters(out, method);
+                out << ", \"remarks\": [";
+                for (size_t r = 0; r < method.remarks.size(); r++) {
+                    const Remark &remark = method.remarks[r];
+                    out << (r ? "," : "") << "\n    {\"kind\": \"" << remark.kind << "\", \"pass\": \""
+                        << remark.pass << "\", \"line\": " << remark.line << ", \"message\": \""
+                        << profiler::json_escape(remark.message) << "\"}";
+                }
+                out << "], \"guards\": [";
+                for (size_t g = 0; g < method.guards.size(); g++) {
+                    const Guard &guard = method.guards[g];
+                    out << (g ? "," : "") << "\n    {\"line\": " << guard.line << ", \"receiver\": \""
+                        << profiler::json_escape(guard.receiver) << "\", \"target\": \""
+                        << profiler::json_escape(guard.target) << "\", \"inlined\": "
+                        << (guard.inlined ? "true" : "false") << ", \"calls\": " << guard.calls
+                        << ", \"hits\": " << guard.hits << ", \"hitRate\": "
+                        << (guard.calls ? (double) guard.hits / (double) guard.calls : 0.0) << "}";
+                }
+                out << "]}";
+            }
+            out << "]}";
+        }
+        out << "\n]}\n";
+    }
+
+    void print_remarks(std::ostream &out, const std::string &passes) {
+        std::vector<std::string> selected;
+        std::stringstream list(passes);
+        for (std::string pass; std::getline(list, pass, ',');) {
+            selected.push_back(pass);
+        }
+        for (auto &method: methods) {
+            for (auto &remark: method.remarks) {
+                if (!selected.empty() && std::find(selected.begin(), selected.end(), remark.pass) == selected.end()) {
+                    continue;
+                }
+                std::string flag = std::string(remark.kind) == "passed" ? "-Rpass" :
+                                   std::string(remark.kind) == "missed" ? "-Rpass-missed" : "-Rpass-analysis";
+                out << method.clazz << "." << method.method;
+                if (remark.line > 0) {
+                    out << ":" << remark.line;
+                }
+                out << ": remark: " << remark.message << " [" << flag << "=" << remark.pass << "]\n";
+            }
+        }
+    }
+}
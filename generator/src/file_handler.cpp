@@ -50,6 +50,7 @@
  * ```
  */
 void write_file(const std::string &fileName, const std::string &source) {
+    ScopedTimer timer("write_file", fileName);
     std::string dirName = "compile";
     try {
         std::filesystem::create_directory(dirName);
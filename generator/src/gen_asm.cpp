@@ -0,0 +1,465 @@
+#include "../internal/generator_asm.h"
+
+/**
+ * @brief Computes the layout of the objects of a class, the layout of the C struct of the class.
+ *
+ * The struct of a root class starts with the header (`__monitor $monitor` at 0, `int $class` at 8), the
+ * struct of a subclass with the struct of its superclass (`super`). The instance fields and the
+ * `$_function_` pointers of the methods of the class follow, each aligned to its size, and the size is
+ * rounded up to the alignment of the struct (8, the alignment of the monitor).
+ *
+ * @param project The parsed project.
+ * @param layouts The computed layouts, by class name.
+ * @param clazz The class.
+ * @return The layout of the class.
+ */
+AsmLayout &get_asm_layout(Project *project, std::map<Identifier, AsmLayout> &layouts, Class *clazz) {
+    auto found = layouts.find(clazz->getName());
+    if (found != layouts.end()) {
+        return found->second;
+    }
+    AsmLayout layout;
+    if (!clazz->getExtends().empty()) {
+        layout = get_asm_layout(project, layouts, project->getClassByName(clazz->getExtends()));
+    } else {
+        layout.size = 12;
+    }
+
+    auto place = [&layout](long long size) {
+        layout.size = (layout.size + size - 1) / size * size;
+        long long offset = layout.size;
+        layout.size += size;
+        return offset;
+    };
+    for (auto &field: *clazz->getFields()) {
+        if (!field.isStatic()) {
+            layout.fields[field.getName()] = place(get_asm_size(field.getTypeLexeme()));
+        }
+    }
+    for (auto &method: *clazz->getMethods()) {
+        if (!method.isStatic()) {
+            long long offset = place(8);
+            layout.slots.emplace_back(offset, method.getName());
+            layout.methods[method.getName()] = offset;
+        }
+    }
+    layout.size = (layout.size + layout.align - 1) / layout.align * layout.align;
+    return layouts[clazz->getName()] = layout;
+}
+
+/**
+ * @brief Checks the declarations of a class against the subset of the assembly backend.
+ */
+void check_asm_class(Project *project, Class *clazz) {
+    if (clazz->isBuiltin() || !clazz->getInterfaces()->empty()) {
+        asm_unsupported("threads and interfaces (class '" + clazz->getName() + "')", nullptr);
+    }
+    for (auto &field: *clazz->getFields()) {
+        check_asm_type(project, field.getTypeLexeme(), nullptr);
+    }
+    for (auto &method: *clazz->getMethods()) {
+        std::string name = "'" + clazz->getName() + "." + method.getName() + "'";
+        if (method.isSynchronized()) {
+            asm_unsupported("synchronized methods (" + name + ")", nullptr);
+        }
+        if (method.canThrow()) {
+            asm_unsupported("exceptions (" + name + ")", nullptr);
+        }
+        if (method.isMain()) {
+            continue;
+        }
+        if (method.getParams()->size() + (method.isStatic() ? 0 : 1) > 6) {
+            asm_unsupported("methods with more than 6 parameters (" + name + ")", nullptr);
+        }
+        check_asm_type(project, method.getReturnTypeLexeme(), nullptr);
+        for (auto &param: *method.getParams()) {
+            check_asm_type(project, param.getTypeLexeme(), nullptr);
+        }
+    }
+}
+
+/**
+ * @brief Returns the classes compiled by the assembly backend, in the order of their class ids.
+ *
+ * The classes are numbered as `write_class_table` numbers them and checked against the subset of the
+ * backend (see `check_asm_class`).
+ *
+ * @param project The parsed project.
+ * @return The classes, the index of a class is its id.
+ */
+std::vector<Class *> get_asm_classes(Project *project) {
+    std::map<Identifier, std::vector<Class *>> subclasses;
+    for (auto &clazz: *project->getClasses()) {
+        if (!clazz.getExtends().empty()) {
+            subclasses[clazz.getExtends()].push_back(&clazz);
+        }
+    }
+    std::map<Identifier, std::pair<int, int>> ranges;
+    std::vector<Class *> order;
+    for (auto &clazz: *project->getClasses()) {
+        if (clazz.getExtends().empty() && !clazz.isInterface()) {
+            number_class(project, &clazz, subclasses, ranges, order);
+        }
+    }
+    for (Class *clazz: order) {
+        check_asm_class(project, clazz);
+    }
+    return order;
+}
+
+/**
+ * @brief Generates the constructor of a class, `__mj_new_ClassName`.
+ *
+ * The memory of the runtime is zeroed, so the constructor only stores the class id and the
+ * `$_function_` pointers of the hierarchy, as `$_new_ClassName` does in the C output.
+ *
+ * Example Output:
+ * ```asm
+ * __mj_new_Circle:
+ *     subq $8, %rsp
+ *     movl $24, %edi
+ *     call __mj_alloc
+ *     movl $1, 8(%rax)
+ *     leaq Circle_area(%rip), %rcx
+ *     movq %rcx, 16(%rax)
+ *     addq $8, %rsp
+ *     ret
+ * ```
+ */
+std::string generate_asm_constructor(Project *project, std::map<Identifier, AsmLayout> &layouts, Class *clazz,
+                                     int id) {
+    AsmLayout &layout = get_asm_layout(project, layouts, clazz);
+    std::string symbol = "__mj_new_" + clazz->getName();
+    std::string output = "\t.p2align 4\n"
+                         "\t.type " + symbol + ", @function\n" +
+                         symbol + ":\n"
+                                  "\tsubq $8, %rsp\n"
+                                  "\tmovl $" + std::to_string(layout.size) + ", %edi\n"
+                                  "\tcall __mj_alloc\n"
+                                  "\tmovl $" + std::to_string(id) + ", 8(%rax)\n";
+    for (auto &slot: layout.slots) {
+        output += "\tleaq " + get_method_reference_name(project, clazz, slot.second) + "(%rip), %rcx\n";
+        output += "\tmovq %rcx, " + std::to_string(slot.first) + "(%rax)\n";
+    }
+    output += "\taddq $8, %rsp\n"
+              "\tret\n"
+              "\t.size " + symbol + ", .-" + symbol + "\n\n";
+    return output;
+}
+
+/**
+ * @brief Generates x86-64 assembly for a Mini-Java project, without going through a C compiler.
+ *
+ * See `generate_asm` in `generator.h`.
+ */
+void generate_asm(Project *project) {
+    ScopedTimer timer("generate_asm");
+    MemoryCategory category("generated source");
+    std::vector<Class *> order = get_asm_classes(project);
+    std::map<Identifier, AsmLayout> layouts;
+    std::string text;
+    std::string bss;
+    for (size_t id = 0; id < order.size(); id++) {
+        Class *clazz = order[id];
+        text += generate_asm_constructor(project, layouts, clazz, (int) id);
+
+        for (auto &field: *clazz->getFields()) {
+            if (field.isStatic()) {
+                int size = get_asm_size(field.getTypeLexeme());
+                bss += "\t.p2align " + std::to_string(size == 8 ? 3 : size == 4 ? 2 : 0) + "\n";
+                bss += get_asm_static_name(clazz->getName(), field.getName()) + ":\n";
+                bss += "\t.zero " + std::to_string(size) + "\n";
+            }
+        }
+
+        for (auto &method: *clazz->getMethods()) {
+            AsmGenerator gen{project, clazz, &method, &layouts};
+            AsmAllocation allocation;
+            {
+                ScopedTimer lowerTimer("lower_method", clazz->getName(), method.getName());
+                lower_method(gen);
+            }
+            {
+                ScopedTimer allocateTimer("allocate_registers", clazz->getName(), method.getName());
+                allocation = allocate_registers(gen.code, gen.registers);
+            }
+            ScopedTimer emitTimer("emit_method", clazz->getName(), method.getName());
+            std::string symbol = method.isMain() ? "main" : clazz->getName() + "_" + method.getName();
+            text += emit_method(symbol, gen.code, gen.params, allocation);
+        }
+    }
+
+    write_file("program.s", "\t.text\n\n" +
+                            text +
+                            "\t.bss\n" +
+                            bss +
+                            "\n"
+                            "\t.section .note.GNU-stack,\"\",@progbits\n");
+    write_asm_runtime();
+}
+
+/**
+ * @brief Writes the runtime of the programs compiled to assembly, `__runtime.s`.
+ *
+ * The runtime only uses Linux system calls, the program is linked without the C library:
+ * - `_start` installs the handler of `SIGSEGV`, calls `main`, flushes the output and exits. There are no
+ *   explicit checks of `null`, a dereference faults and the handler reports a `NullPointerException` (as
+ *   `write_null_handler` does, without the stack trace).
+ * - `__mj_alloc(size)` returns zeroed memory, bump allocated in chunks of 64 MB mapped by `mmap` (the
+ *   objects are never freed, as in the C output).
+ * - `__mj_new_array(length)` creates an `int[]` with the layout of `__int_array` (`length` at 0, `data` at
+ *   8), the elements follow the header.
+ * - `__mj_int_array_slice(arr, from, to)` creates a view of an `int[]` (see `write_int_array`).
+ * - `__mj_print_int(value, newLine)` formats an `int` into an output buffer of 4 KB, written by
+ *   `__mj_flush` when it is full and at the exit.
+ */
+void write_asm_runtime() {
+    write_file("__runtime.s", R"(	.text
+
+	.globl _start
+	.type _start, @function
+_start:
+	xorl %ebp, %ebp
+	andq $-16, %rsp
+	subq $32, %rsp
+	leaq __mj_null_pointer(%rip), %rax
+	movq %rax, (%rsp)
+	movq $0x04000000, 8(%rsp)
+	leaq __mj_signal_return(%rip), %rax
+	movq %rax, 16(%rsp)
+	movq $0, 24(%rsp)
+	movl $13, %eax
+	movl $11, %edi
+	movq %rsp, %rsi
+	xorl %edx, %edx
+	movl $8, %r10d
+	syscall
+	addq $32, %rsp
+	call main
+	call __mj_flush
+	movl $231, %eax
+	xorl %edi, %edi
+	syscall
+
+	.globl __mj_alloc
+	.type __mj_alloc, @function
+__mj_alloc:
+	addq $15, %rdi
+	andq $-16, %rdi
+	movq __mj_heap_next(%rip), %rax
+	leaq (%rax,%rdi), %rdx
+	cmpq __mj_heap_end(%rip), %rdx
+	ja 1f
+	movq %rdx, __mj_heap_next(%rip)
+	ret
+1:
+	pushq %rdi
+	movl $67108864, %esi
+	cmpq %rsi, %rdi
+	cmovaq %rdi, %rsi
+	pushq %rsi
+	xorl %edi, %edi
+	movl $3, %edx
+	movl $34, %r10d
+	movq $-1, %r8
+	xorl %r9d, %r9d
+	movl $9, %eax
+	syscall
+	popq %rsi
+	popq %rdi
+	cmpq $-4096, %rax
+	ja __mj_out_of_memory
+	leaq (%rax,%rsi), %rdx
+	movq %rdx, __mj_heap_end(%rip)
+	leaq (%rax,%rdi), %rdx
+	movq %rdx, __mj_heap_next(%rip)
+	ret
+
+	.globl __mj_new_array
+	.type __mj_new_array, @function
+__mj_new_array:
+	pushq %rbx
+	movslq %edi, %rbx
+	testq %rbx, %rbx
+	js __mj_negative_size
+	leaq 16(,%rbx,4), %rdi
+	call __mj_alloc
+	movl %ebx, (%rax)
+	leaq 16(%rax), %rdx
+	movq %rdx, 8(%rax)
+	popq %rbx
+	ret
+
+	.globl __mj_int_array_slice
+	.type __mj_int_array_slice, @function
+__mj_int_array_slice:
+	testl %esi, %esi
+	js __mj_slice_out_of_bounds
+	cmpl %esi, %edx
+	jl __mj_slice_out_of_bounds
+	cmpl (%rdi), %edx
+	jg __mj_slice_out_of_bounds
+	pushq %rbx
+	pushq %r12
+	pushq %r13
+	movq %rdi, %rbx
+	movslq %esi, %r12
+	movl %edx, %r13d
+	movl $16, %edi
+	call __mj_alloc
+	subl %r12d, %r13d
+	movl %r13d, (%rax)
+	movq 8(%rbx), %rdx
+	leaq (%rdx,%r12,4), %rdx
+	movq %rdx, 8(%rax)
+	popq %r13
+	popq %r12
+	popq %rbx
+	ret
+
+	.globl __mj_print_int
+	.type __mj_print_int, @function
+__mj_print_int:
+	pushq %rbx
+	pushq %r12
+	pushq %r13
+	subq $32, %rsp
+	movl %esi, %r13d
+	movslq %edi, %rax
+	movq %rax, %r8
+	leaq 32(%rsp), %rbx
+	testq %rax, %rax
+	jns 1f
+	negq %rax
+1:
+	movl $10, %ecx
+2:
+	xorl %edx, %edx
+	divq %rcx
+	addl $48, %edx
+	decq %rbx
+	movb %dl, (%rbx)
+	testq %rax, %rax
+	jnz 2b
+	testq %r8, %r8
+	jns 3f
+	decq %rbx
+	movb $45, (%rbx)
+3:
+	leaq 32(%rsp), %r12
+	subq %rbx, %r12
+	movq __mj_out_length(%rip), %rax
+	leaq 1(%rax,%r12), %rdx
+	cmpq $4096, %rdx
+	jbe 4f
+	call __mj_flush
+4:
+	movq __mj_out_length(%rip), %rdi
+	leaq __mj_out(%rip), %rdx
+	xorl %ecx, %ecx
+5:
+	movb (%rbx,%rcx), %al
+	movb %al, (%rdx,%rdi)
+	incq %rdi
+	incq %rcx
+	cmpq %r12, %rcx
+	jb 5b
+	testl %r13d, %r13d
+	jz 6f
+	movb $10, (%rdx,%rdi)
+	incq %rdi
+6:
+	movq %rdi, __mj_out_length(%rip)
+	addq $32, %rsp
+	popq %r13
+	popq %r12
+	popq %rbx
+	ret
+
+	.globl __mj_flush
+	.type __mj_flush, @function
+__mj_flush:
+	leaq __mj_out(%rip), %rsi
+	movq __mj_out_length(%rip), %rdx
+1:
+	testq %rdx, %rdx
+	jz 2f
+	movl $1, %edi
+	movl $1, %eax
+	syscall
+	testq %rax, %rax
+	jle 2f
+	addq %rax, %rsi
+	subq %rax, %rdx
+	jmp 1b
+2:
+	movq $0, __mj_out_length(%rip)
+	ret
+
+__mj_out_of_memory:
+	leaq __mj_out_of_memory_message(%rip), %rsi
+	movl $__mj_out_of_memory_length, %edx
+	jmp __mj_fail
+
+__mj_negative_size:
+	leaq __mj_negative_size_message(%rip), %rsi
+	movl $__mj_negative_size_length, %edx
+	jmp __mj_fail
+
+__mj_slice_out_of_bounds:
+	leaq __mj_slice_out_of_bounds_message(%rip), %rsi
+	movl $__mj_slice_out_of_bounds_length, %edx
+	jmp __mj_fail
+
+__mj_null_pointer:
+	leaq __mj_null_pointer_message(%rip), %rsi
+	movl $__mj_null_pointer_length, %edx
+	jmp __mj_fail
+
+__mj_signal_return:
+	movl $15, %eax
+	syscall
+
+__mj_fail:
+	movq %rsi, %rbx
+	movq %rdx, %r12
+	andq $-16, %rsp
+	call __mj_flush
+	movq %rbx, %rsi
+	movq %r12, %rdx
+	movl $2, %edi
+	movl $1, %eax
+	syscall
+	movl $231, %eax
+	movl $1, %edi
+	syscall
+
+	.section .rodata
+__mj_out_of_memory_message:
+	.ascii "Error: Out of memory\n"
+	.set __mj_out_of_memory_length, . - __mj_out_of_memory_message
+__mj_negative_size_message:
+	.ascii "Error: Negative array size\n"
+	.set __mj_negative_size_length, . - __mj_negative_size_message
+
+__mj_slice_out_of_bounds_message:
+	.ascii "Error: Slice out of bounds\n"
+	.set __mj_slice_out_of_bounds_length, . - __mj_slice_out_of_bounds_message
+__mj_null_pointer_message:
+	.ascii "Exception: NullPointerException\n"
+	.set __mj_null_pointer_length, . - __mj_null_pointer_message
+
+	.bss
+	.p2align 4
+__mj_heap_next:
+	.zero 8
+__mj_heap_end:
+	.zero 8
+__mj_out_length:
+	.zero 8
+__mj_out:
+	.zero 4096
+
+	.section .note.GNU-stack,"",@progbits
+)");
+}
@@ -0,0 +1,235 @@
+#include "../internal/generator_internal.h"
+
+/**
+ * @brief Writes the runtime of the built-in `Channel` and `SpscChannel` types.
+ *
+ * A channel is a bounded ring buffer of `int`, its capacity is rounded up to a power of two. The head
+ * (receiving side) and the tail (sending side) are on separate cache lines, so producers and consumers
+ * don't share a written line unless the channel is empty or full.
+ *
+ * - **`SpscChannel`**: A single-producer single-consumer ring buffer (Lamport). The sender and the receiver
+ *   only write their own index and keep a cached copy of the other one, refreshed when the buffer looks
+ *   full (or empty), so most operations don't touch the cache line of the other side.
+ * - **`Channel`**: A multi-producer multi-consumer ring buffer (Vyukov's bounded queue). Every slot has a
+ *   sequence number telling if it's ready to be written or read in the current lap, a sender or a receiver
+ *   claims a position with a single CAS on the tail or the head.
+ *
+ * Sending to a full channel or receiving from an empty channel spins for a while, then sleeps on a futex
+ * (see `$_futex_wait`). Sleeping threads are counted so `send` and `recv` only wake up threads (a system
+ * call) when some thread is actually sleeping on the other side.
+ *
+ * It writes two supporting files:
+ *
+ * - **`__channel.h`**: Declares the channel type and the inlined `send`/`recv` fast paths.
+ * - **`__channel.c`**: Implements the creation of channels and the blocking slow paths.
+ */
+void write_channel() {
+    write_file("__channel.h", "#ifndef __CHANNEL_H\n"
+                              "#define __CHANNEL_H\n"
+                              "\n"
+                              "#include <stdatomic.h>\n"
+                              "#include <stdbool.h>\n"
+                              "#include <stddef.h>\n"
+                              "\n"
+                              "typedef struct __channel_slot {\n"
+                              "    atomic_size_t sequence;\n"
+                              "    int value;\n"
+                              "} __channel_slot;\n"
+                              "\n"
+                              "typedef struct __channel {\n"
+                              "    __channel_slot *slots;\n"
+                              "    size_t mask;\n"
+                              "    bool spsc;\n"
+                              "    char padding0[64];\n"
+                              "    atomic_size_t tail;\n"
+                              "    size_t headCache;\n"
+                              "    char padding1[64 - 2 * sizeof(size_t)];\n"
+                              "    atomic_size_t head;\n"
+                              "    size_t tailCache;\n"
+                              "    char padding2[64 - 2 * sizeof(size_t)];\n"
+                              "    atomic_int sent;\n"
+                              "    atomic_int receivers;\n"
+                              "    atomic_int received;\n"
+                              "    atomic_int senders;\n"
+                              "} __channel;\n"
+                              "\n"
+                              "__channel *$_new___channel(int capacity, bool spsc);\n"
+                              "\n"
+                              "void $_channel_send_slow(__channel *channel, int value);\n"
+                              "\n"
+                              "int $_channel_recv_slow(__channel *channel);\n"
+                              "\n"
+                              "void $_channel_wake(atomic_int *event);\n"
+                              "\n"
+                              "static inline bool $_channel_try_send(__channel *channel, int value) {\n"
+                              "    if (channel->spsc) {\n"
+                              "        size_t tail = atomic_load_explicit(&channel->tail, memory_order_relaxed);\n"
+                              "        if (tail - channel->headCache > channel->mask) {\n"
+                              "            channel->headCache = atomic_load_explicit(&channel->head, memory_order_acquire);\n"
+                              "            if (tail - channel->headCache > channel->mask) return false;\n"
+                              "        }\n"
+                              "        channel->slots[tail & channel->mask].value = value;\n"
+                              "        atomic_store_explicit(&channel->tail, tail + 1, memory_order_release);\n"
+                              "        return true;\n"
+                              "    }\n"
+                              "    size_t position = atomic_load_explicit(&channel->tail, memory_order_relaxed);\n"
+                              "    while (1) {\n"
+                              "        __channel_slot *slot = &channel->slots[position & channel->mask];\n"
+                              "        size_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);\n"
+                              "        ptrdiff_t difference = (ptrdiff_t) (sequence - position);\n"
+                              "        if (difference == 0) {\n"
+                              "            if (atomic_compare_exchange_weak_explicit(&channel->tail, &position, position + 1,\n"
+                              "                                                      memory_order_relaxed,\n"
+                              "                                                      memory_order_relaxed)) {\n"
+                              "                slot->value = value;\n"
+                              "                atomic_store_explicit(&slot->sequence, position + 1, memory_order_release);\n"
+                              "                return true;\n"
+                              "            }\n"
+                              "        } else if (difference < 0) {\n"
+                              "            return false;\n"
+                              "        } else {\n"
+                              "            position = atomic_load_explicit(&channel->tail, memory_order_relaxed);\n"
+                              "        }\n"
+                              "    }\n"
+                              "}\n"
+                              "\n"
+                              "static inline bool $_channel_try_recv(__channel *channel, int *value) {\n"
+                              "    if (channel->spsc) {\n"
+                              "        size_t head = atomic_load_explicit(&channel->head, memory_order_relaxed);\n"
+                              "        if (head == channel->tailCache) {\n"
+                              "            channel->tailCache = atomic_load_explicit(&channel->tail, memory_order_acquire);\n"
+                              "            if (head == channel->tailCache) return false;\n"
+                              "        }\n"
+                              "        *value = channel->slots[head & channel->mask].value;\n"
+                              "        atomic_store_explicit(&channel->head, head + 1, memory_order_release);\n"
+                              "        return true;\n"
+                              "    }\n"
+                              "    size_t position = atomic_load_explicit(&channel->head, memory_order_relaxed);\n"
+                              "    while (1) {\n"
+                              "        __channel_slot *slot = &channel->slots[position & channel->mask];\n"
+                              "        size_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);\n"
+                              "        ptrdiff_t difference = (ptrdiff_t) (sequence - (position + 1));\n"
+                              "        if (difference == 0) {\n"
+                              "            if (atomic_compare_exchange_weak_explicit(&channel->head, &position, position + 1,\n"
+                              "                                                      memory_order_relaxed,\n"
+                              "                                                      memory_order_relaxed)) {\n"
+                              "                *value = slot->value;\n"
+                              "                atomic_store_explicit(&slot->sequence, position + channel->mask + 1,\n"
+                              "                                      memory_order_release);\n"
+                              "                return true;\n"
+                              "            }\n"
+                              "        } else if (difference < 0) {\n"
+                              "            return false;\n"
+                              "        } else {\n"
+                              "            position = atomic_load_explicit(&channel->head, memory_order_relaxed);\n"
+                              "        }\n"
+                              "    }\n"
+                              "}\n"
+                              "\n"
+                              "// Pairs with the fence of a thread going to sleep, it either sees the change or is woken up\n"
+                              "static inline void $_channel_notify(atomic_int *sleepers, atomic_int *event) {\n"
+                              "    atomic_thread_fence(memory_order_seq_cst);\n"
+                              "    if (atomic_load_explicit(sleepers, memory_order_relaxed) > 0) {\n"
+                              "        $_channel_wake(event);\n"
+                              "    }\n"
+                              "}\n"
+                              "\n"
+                              "static inline void $_channel_send(__channel *channel, int value) {\n"
+                              "    if ($_channel_try_send(channel, value)) {\n"
+                              "        $_channel_notify(&channel->receivers, &channel->sent);\n"
+                              "    } else {\n"
+                              "        $_channel_send_slow(channel, value);\n"
+                              "    }\n"
+                              "}\n"
+                              "\n"
+                              "static inline int $_channel_recv(__channel *channel) {\n"
+                              "    int value;\n"
+                              "    if ($_channel_try_recv(channel, &value)) {\n"
+                              "        $_channel_notify(&channel->senders, &channel->received);\n"
+                              "        return value;\n"
+                              "    }\n"
+                              "    return $_channel_recv_slow(channel);\n"
+                              "}\n"
+                              "\n"
+                              "#endif //__CHANNEL_H\n");
+
+    write_file("__channel.c", "#include \"__channel.h\"\n"
+                              "#include \"__monitor.h\"\n"
+                              "\n"
+                              "#include <sched.h>\n"
+                              "#include <stdio.h>\n"
+                              "#include <stdlib.h>\n"
+                              "\n"
+                              "#define $_CHANNEL_SPINS 64\n"
+                              "\n"
+                              "__channel *$_new___channel(int capacity, bool spsc) {\n"
+                              "    if (capacity <= 0) {\n"
+                              "        fprintf(stderr, \"Exception: Channel capacity must be positive, but got %d\\n\", capacity);\n"
+                              "        exit(1);\n"
+                              "    }\n"
+                              "    size_t size = 2;\n"
+                              "    while (size < (size_t) capacity) {\n"
+                              "        size <<= 1;\n"
+                              "    }\n"
+                              "    __channel *channel = (__channel *) calloc(1, sizeof(__channel));\n"
+                              "    channel->slots = (__channel_slot *) malloc(size * sizeof(__channel_slot));\n"
+                              "    for (size_t i = 0; i < size; i++) {\n"
+                              "        atomic_init(&channel->slots[i].sequence, i);\n"
+                              "    }\n"
+                              "    channel->mask = size - 1;\n"
+                              "    channel->spsc = spsc;\n"
+                              "    atomic_init(&channel->tail, 0);\n"
+                              "    atomic_init(&channel->head, 0);\n"
+                              "    atomic_init(&channel->sent, 0);\n"
+                              "    atomic_init(&channel->receivers, 0);\n"
+                              "    atomic_init(&channel->received, 0);\n"
+                              "    atomic_init(&channel->senders, 0);\n"
+                              "    return channel;\n"
+                              "}\n"
+                              "\n"
+                              "void $_channel_wake(atomic_int *event) {\n"
+                              "    atomic_fetch_add_explicit(event, 1, memory_order_release);\n"
+                              "    $_futex_wake(event);\n"
+                              "}\n"
+                              "\n"
+                              "void $_channel_send_slow(__channel *channel, int value) {\n"
+                              "    bool sent = false;\n"
+                              "    for (int spins = 0; spins < $_CHANNEL_SPINS && !sent; spins++) {\n"
+                              "        sched_yield();\n"
+                              "        sent = $_channel_try_send(channel, value);\n"
+                              "    }\n"
+                              "    while (!sent) {\n"
+                              "        // Reads the event before checking the channel again, so a receive in between isn't missed\n"
+                              "        int received = atomic_load_explicit(&channel->received, memory_order_acquire);\n"
+                              "        atomic_fetch_add_explicit(&channel->senders, 1, memory_order_relaxed);\n"
+                              "        atomic_thread_fence(memory_order_seq_cst);\n"
+                              "        sent = $_channel_try_send(channel, value);\n"
+                              "        if (!sent) {\n"
+                              "            $_futex_wait(&channel->received, received);\n"
+                              "        }\n"
+                              "        atomic_fetch_sub_explicit(&channel->senders, 1, memory_order_relaxed);\n"
+                              "    }\n"
+                              "    $_channel_notify(&channel->receivers, &channel->sent);\n"
+                              "}\n"
+                              "\n"
+                              "int $_channel_recv_slow(__channel *channel) {\n"
+                              "    int value;\n"
+                              "    bool received = false;\n"
+                              "    for (int spins = 0; spins < $_CHANNEL_SPINS && !received; spins++) {\n"
+                              "        sched_yield();\n"
+                              "        received = $_channel_try_recv(channel, &value);\n"
+                              "    }\n"
+                              "    while (!received) {\n"
+                              "        int sent = atomic_load_explicit(&channel->sent, memory_order_acquire);\n"
+                              "        atomic_fetch_add_explicit(&channel->receivers, 1, memory_order_relaxed);\n"
+                              "        atomic_thread_fence(memory_order_seq_cst);\n"
+                              "        received = $_channel_try_recv(channel, &value);\n"
+                              "        if (!received) {\n"
+                              "            $_futex_wait(&channel->sent, sent);\n"
+                              "        }\n"
+                              "        atomic_fetch_sub_explicit(&channel->receivers, 1, memory_order_relaxed);\n"
+                              "    }\n"
+                              "    $_channel_notify(&channel->senders, &channel->received);\n"
+                              "    return value;\n"
+                              "}\n");
+}
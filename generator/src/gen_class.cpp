@@ -5,7 +5,7 @@
 /**
  * @brief Determines whether a type requires an additional header file inclusion.
  *
- * Basic types such as `int`, `boolean`, `int[]`, and `void` are excluded, as they do not require custom headers.
+ * Basic types such as `int`, `boolean`, `int[]`, `String`, and `void` are excluded, as they do not require custom headers.
  * Custom class types are included based on their names.
  *
  * @param type The type identifier to check.
@@ -20,13 +20,15 @@ bool should_include_header(const Identifier &type) {
            type != "boolean" &&
            type != "bool" &&
            type != "int[]" &&
-           type != "void";
+           type != "String" &&
+           type != "void" &&
+           !SymbolTable::isChannelType(type);
 }
 
 /**
  * @brief Translates Mini-Java type identifiers to corresponding C types.
  *
- * This function maps Mini-Java types like `int`, `boolean`, `void`, and `int[]` to their
+ * This function maps Mini-Java types like `int`, `boolean`, `void`, `int[]`, and `String` to their
  * respective C representations. Additional logic is used for custom class types (pointers).
  *
  * @param type The Mini-Java type identifier (e.g., `int`, `boolean`).
@@ -36,6 +38,8 @@ bool should_include_header(const Identifier &type) {
  * - `int` → `"int "`
  * - `boolean` → `"bool "`
  * - `int[]` → `"__int_array *"`
+ * - `String` → `"__string *"`
+ * - `Channel`, `SpscChannel` → `"__channel *"`
  * - `MyClass` → `"MyClass *"`
  */
 std::string get_type(const Identifier &type) {
@@ -43,6 +47,10 @@ std::string get_type(const Identifier &type) {
         return "bool ";
     } else if (type == "int[]") {
         return "__int_array *";
+    } else if (type == "String") {
+        return "__string *";
+    } else if (SymbolTable::isChannelType(type)) {
+        return "__channel *";
     } else if (type == "int") {
         return "int ";
     } else if (type == "void") {
@@ -64,13 +72,15 @@ std::string get_type(const Identifier &type) {
  */
 std::string get_type(MiniJavaType type, const Identifier &lexeme) {
     if (type == MiniJavaType::MiniJavaType_CLASS) {
-        return lexeme + " *";
+        return get_type(lexeme);
     } else if (type == MiniJavaType::MiniJavaType_BOOLEAN) {
         return "bool ";
     } else if (type == MiniJavaType::MiniJavaType_INT) {
         return "int ";
     } else if (type == MiniJavaType::MiniJavaType_INT_ARRAY) {
         return "__int_array *";
+    } else if (type == MiniJavaType::MiniJavaType_STRING) {
+        return "__string *";
     } else if (type == MiniJavaType::MiniJavaType_VOID) {
         return "void ";
     }
@@ -85,15 +95,30 @@ std::string get_type(Method *method) {
     return get_type(method->getReturnType(), method->getReturnTypeLexeme());
 }
 
+/**
+ * @brief Generates the name of the C global that stores a static field.
+ *
+ * Example:
+ * - `static int count;` in class `Counter` → `$_static_Counter_count`
+ *
+ * @param clazz The name of the class declaring the field.
+ * @param field The name of the static field.
+ * @return The name of the global variable.
+ */
+std::string get_static_field_name(const Identifier &clazz, const Identifier &field) {
+    return "$_static_" + clazz + "_" + field;
+}
+
 /**
  * @brief Generates the full signature of a method as a C function.
  *
  * Handles method names, return types, and parameter lists. The `$this` pointer is included in
- * all non-static methods to maintain object context.
+ * all non-static methods to maintain object context, static methods are plain C functions.
  *
  * Example Output:
  * ```c
  * int MyClass_myMethod(void *$this, int param1, bool param2);
+ * int MyClass_myStaticMethod(int param1);
  * ```
  *
  * @param method The method definition.
@@ -111,7 +136,9 @@ std::string get_method_sign(Method *method, Class *clazz, std::map<Identifier, b
     sign += get_type(method);
     unsigned long paramLen = method->getParams()->size();
     sign += clazz->getName() + "_" + method->getName();
-    if (paramLen == 0) {
+    if (method->isStatic()) {
+        sign += paramLen == 0 ? "(void)" : "(\n\t";
+    } else if (paramLen == 0) {
         sign += "(\n\tvoid *$this\n)";
     } else {
         sign += "(\n\tvoid *$this,\n\t";
@@ -182,6 +209,12 @@ std::string get_method_as_param_sign(Method *method, Class *clazz, std::map<Iden
  * - Instance variables (e.g., `int x`).
  * - Function pointers for method dispatch (e.g., method overriding support).
  * - A `super` pointer if the class extends another class.
+ * - The header of the object if the class doesn't extend another class: its monitor (`$monitor`) and
+ *   the id of its class (`$class`, see `write_class_table`). The header is always at the start of the object,
+ *   so `synchronized`, casts and `instanceof` work on any object without knowing its class.
+ * - The native thread handle (`$thread`) of the built-in `Thread` class.
+ *
+ * Static fields and static methods are not part of the struct.
  *
  * Example Output:
  * ```c
@@ -201,9 +234,18 @@ void write_fields(std::string &hSource, Class *clazz, std::map<Identifier, bool>
     if (!clazz->getExtends().empty()) {
         hSource += "\t" + clazz->getExtends() + " super;\n";
         included.insert({clazz->getExtends(), true});
+    } else {
+        hSource += "\t__monitor $monitor;\n";
+        hSource += "\tint $class;\n";
+    }
+    if (clazz->isBuiltin() && clazz->getName() == "Thread") {
+        hSource += "\tvoid *$thread;\n";
     }
 
     for (auto &field: *clazz->getFields()) {
+        if (field.isStatic()) {
+            continue;
+        }
         if (field.getTypeLexeme() == clazz->getName()) {
             hSource += "\tstruct " + clazz->getName() + " *" + field.getName() + ";\n";
         } else {
@@ -218,7 +260,7 @@ void write_fields(std::string &hSource, Class *clazz, std::map<Identifier, bool>
     hSource += "\n";
 
     for (auto &method: *clazz->getMethods()) {
-        if (method.isMain()) continue;
+        if (method.isStatic()) continue;
         hSource += get_method_as_param_sign(&method, clazz, included) + ";\n";
     }
 }
@@ -233,6 +275,14 @@ void write_fields(std::string &hSource, Class *clazz, std::map<Identifier, bool>
  *
  * #include <stdbool.h>
  * #include "__int_array.h"
+ * #include "__string.h"
+ * #include "__monitor.h"
+ * #include "__channel.h"
+ * #include "__exception.h"
+ * #include "__null.h"
+ * #include "__memo.h"
+ * #include "__reload.h"
+ * #include "__class.h"
  *
  * struct MyClass {
  *     int x;
@@ -242,6 +292,8 @@ void write_fields(std::string &hSource, Class *clazz, std::map<Identifier, bool>
  *
  * typedef struct MyClass MyClass;
  *
+ * extern int $_static_MyClass_count;
+ *
  * MyClass *$_new_MyClass();
  * int MyClass_myMethod(void *$this, int param);
  *
@@ -258,6 +310,14 @@ void generate_class_header(Project *project, Class *clazz, std::map<Identifier,
 
     hSource += "#include <stdbool.h>\n";
     hSource += "#include \"__int_array.h\"\n";
+    hSource += "#include \"__string.h\"\n";
+    hSource += "#include \"__monitor.h\"\n";
+    hSource += "#include \"__channel.h\"\n";
+    hSource += "#include \"__exception.h\"\n";
+    hSource += "#include \"__null.h\"\n";
+    hSource += "#include \"__memo.h\"\n";
+    hSource += "#include \"__reload.h\"\n";
+    hSource += "#include \"__class.h\"\n";
     unsigned long include_start = hSource.length();
 
     hSource += "struct " + clazz->getName() + " {\n";
@@ -266,6 +326,14 @@ void generate_class_header(Project *project, Class *clazz, std::map<Identifier,
 
     hSource += "typedef struct " + clazz->getName() + " " + clazz->getName() + ";\n\n";
 
+    for (auto &field: *clazz->getFields()) {
+        if (!field.isStatic()) continue;
+        hSource += "extern " + get_type(&field) + get_static_field_name(clazz->getName(), field.getName()) + ";\n\n";
+        if (field.getType() == MiniJavaType::MiniJavaType_CLASS) {
+            included.insert({field.getTypeLexeme(), true});
+        }
+    }
+
     for (auto &method: *clazz->getMethods()) {
         if (method.isMain()) continue;
         hSource += get_method_sign(&method, clazz, included) + ";\n\n";
@@ -319,7 +387,7 @@ void generate_new_object_function_initialization_source(
         Class *root
 ) {
     for (auto &method: *clazz->getMethods()) {
-        if (method.isMain()) continue;
+        if (method.isStatic()) continue;
         source += "\t" + starter + "$_function_" + method.getName() + " = " +
                   get_method_reference_name(project, root, method.getName()) + ";\n";
     }
@@ -335,7 +403,11 @@ void generate_new_object_fields_initialization_source(
         Project *project,
         Class *clazz
 ) {
+    if (clazz->isBuiltin() && clazz->getName() == "Thread") {
+        source += "\t" + starter + "$thread = NULL;\n";
+    }
     for (auto &field: *clazz->getFields()) {
+        if (field.isStatic()) continue;
         source += "\t" + starter + field.getName() + " = " +
                   get_field_default_value(&field) + ";\n";
     }
@@ -355,6 +427,8 @@ void generate_new_object_fields_initialization_source(
  * ```c
  * MyClass *$_new_MyClass() {
  *     MyClass *self = (MyClass *) malloc(sizeof(MyClass));
+ *     $_object_init(self, $_class_MyClass);
+ *
  *     self->x = 0;
  *     self->$_function_myMethod = MyClass_myMethod;
  *     return self;
@@ -368,47 +442,260 @@ void generate_new_object_fields_initialization_source(
 void generate_new_object_source(std::string &source, Project *project, Class *clazz) {
     source += clazz->getName() + " *$_new_" + clazz->getName() + "() {\n";
     source += "\t" + clazz->getName() + " *self = (" + clazz->getName() +
-              " *) malloc(sizeof(" + clazz->getName() + "));\n\n";
+              " *) malloc(sizeof(" + clazz->getName() + "));\n";
+    source += "\t$_object_init(self, $_class_" + clazz->getName() + ");\n\n";
     generate_new_object_fields_initialization_source(source, "self->", project, clazz);
     source += "\n";
     generate_new_object_function_initialization_source(source, "self->", project, clazz, clazz);
+    source += "\t$_reload_track(self);\n";
     source += "\treturn self;\n";
     source += "}\n\n";
 }
 
+/**
+ * @brief Generates the native body of a method of a built-in class.
+ *
+ * - `Thread.start()`: Starts a native thread running the `run` method of the object.
+ * - `Thread.join()`: Waits for the thread started by the object to finish.
+ *
+ * @param clazz The built-in class.
+ * @param method The method of the built-in class.
+ * @return The C body of the method, or an empty string if the method has no native body.
+ */
+std::string get_builtin_method_body(Class *clazz, Method *method) {
+    if (clazz->getName() == "Thread" && method->getName() == "start") {
+        return "\t$_thread_start(&super->$thread, $this, super->$_function_run);\n";
+    } else if (clazz->getName() == "Thread" && method->getName() == "join") {
+        return "\t$_thread_join(&super->$thread);\n";
+    }
+    return "";
+}
+
+/**
+ * @brief Generates the name of the copy of a method inlined at hot call sites (see `generate_inline_method`).
+ *
+ * Example:
+ * - `fib` of class `Fib` → `$_inline_Fib_fib`
+ */
+std::string get_inline_method_name(Class *clazz, Method *method) {
+    return "$_inline_" + clazz->getName() + "_" + method->getName();
+}
+
+/**
+ * @brief Generates a copy of a method, inlined at the hot call sites of a profile-guided build.
+ *
+ * The methods of a class are defined in its own file, the C compiler can't inline them into the methods of
+ * other classes (and a call through `$_function_` into none). The copy is defined in the file of the caller
+ * and is always inlined. It is generated without a profile, so the calls in its body keep their dispatch.
+ *
+ * Methods whose prologue is more than their body are not copied: `main`, `@Memoize` and `synchronized`
+ * methods, methods spawning calls or running `@Parallel` loops, and the methods of built-in classes.
+ *
+ * Example Output:
+ * ```c
+ * static inline __attribute__((always_inline)) int $_inline_Counter_next(
+ *     void *$this
+ * ) {
+ *     Counter *super = (Counter *) $this;
+ *     ...
+ * }
+ * ```
+ *
+ * @param project The project containing the source.
+ * @param clazz The class declaring the method.
+ * @param method The method to copy.
+ * @param types The types used by the file of the caller, those of the copy are added.
+ * @param strings The constant pool of the program.
+ * @param budget The most TAC instructions the copy may have.
+ * @param lines Whether the lines of the source are marked in the copy (see `map_source_lines`).
+ * @return The C function, or an empty string if the method is not copied.
+ */
+std::string generate_inline_method(
+        Project *project,
+        Class *clazz,
+        Method *method,
+        std::map<Identifier, bool> *types,
+        StringPool *strings,
+        int budget,
+        bool lines
+) {
+    if (clazz->isBuiltin() || method->isMain() || method->isMemoized() || method->isSynchronized() ||
+        contains_spawn(method->getCodeBlock())) {
+        return "";
+    }
+
+    auto t = ThreeAddressCodeGenerator{};
+    t.types = types;
+    t.strings = strings;
+    t.project = project;
+    t.clazz = clazz;
+    t.method = method;
+    t.lines = lines;
+    t.openBlock();
+    for (auto &param: *method->getParams()) {
+        t.addVariable(param.getName(), param.getTypeLexeme());
+    }
+    generate(t, method->getCodeBlock());
+    t.closeBlock();
+    if (!t.functions.empty() || t.stats.instructions > budget) {
+        return "";
+    }
+
+    std::map<Identifier, bool> signTypes;
+    std::string sign = get_method_sign(method, clazz, signTypes);
+    types->insert(signTypes.begin(), signTypes.end());
+    std::string name = clazz->getName() + "_" + method->getName() + "(";
+    sign.replace(sign.find(name), name.size(), get_inline_method_name(clazz, method) + "(");
+
+    std::string source = "static inline __attribute__((always_inline)) " + sign + " {\n";
+    if (!method->isStatic()) {
+        source += "\t" + clazz->getName() + " *super = (" + clazz->getName() + " *) $this;\n\n";
+    }
+    if (lines) {
+        std::string mark = "//@method " + clazz->getName() + "." + method->getName() + " " +
+                           std::to_string(method->getLine()) + "\n";
+        return mark + source + t.code + "}\n//@end\n\n";
+    }
+    return source + t.code + "}\n\n";
+}
+
 /**
  * @brief Generates the full source file for a given class, including its methods and constructor.
  *
  * This function generates a `.c` file that includes:
+ * - The definitions of static fields as C globals.
  * - The `new` function for object instantiation.
  * - Method implementation for the class.
  * - Inclusion of necessary headers.
  *
+ * A `synchronized` method enters the monitor of `$this` (or of the class, if the method is static)
+ * before its body and exits it before every `return`.
+ *
+ * `main` installs the handler reporting dereferences of `null` (see `write_null_handler`) and, in the
+ * development build, starts watching for reloaded classes (see `write_reload`).
+ *
+ * In an instrumented build, every method counts its calls, its branches and its call sites in the counters
+ * of the class (see `generate_profile_table`).
+ *
+ * In a profile-guided build, the methods called in 1% of the calls of the profile are hot (`$_method_hot`) and
+ * those never called are cold (`$_method_cold`): the linker groups the hot methods of all the classes apart
+ * from the others, and the cold ones away from both (see `write_null_handler`). The branches and the call
+ * sites of the methods are laid out, devirtualized and inlined by their counts (see `emitMethodCall`).
+ *
+ * With `--line-directives` or `--source-map`, the lines of the Mini-Java source are marked in the code of the
+ * methods, the marks become `#line` directives and the source map once the file is complete (see
+ * `map_source_lines`).
+ *
  * @param project The project containing the source.
  * @param clazz The class for which the source file is generated.
  * @param included A map tracking dependencies to include.
+ * @param strings The constant pool of the program, string literals of the class are interned into it.
+ * @param options The options of the generation.
+ * @param profile The profile of a profile-guided build, empty otherwise.
+ * @param sourceMap The lines of the file are added to it, with `--line-directives` or `--source-map`.
  */
-void generate_class_source(Project *project, Class *clazz, std::map<Identifier, bool> &included) {
+void generate_class_source(
+        Project *project,
+        Class *clazz,
+        std::map<Identifier, bool> &included,
+        StringPool &strings,
+        const GenerateOptions &options,
+        const Profile &profile,
+        SourceMap &sourceMap
+) {
     std::string source = "#include <stdlib.h>\n"
                          "#include <stdio.h>\n"
                          "#include \"" + clazz->getName() + ".h\"\n";
     unsigned long include_start = source.size();
     source += "\n";
 
+    // A reloaded class shares the static state of the running program (see `write_reload`)
+    std::string state;
+    for (auto &field: *clazz->getFields()) {
+        if (!field.isStatic()) continue;
+        state += get_type(&field) + get_static_field_name(clazz->getName(), field.getName()) + " = " +
+                 get_field_default_value(&field) + ";\n\n";
+    }
+
+    std::string classMonitor = "$_monitor_" + clazz->getName();
+    std::string sharedMonitor;
+    for (auto &method: *clazz->getMethods()) {
+        if (method.isStatic() && method.isSynchronized()) {
+            state += "__monitor " + classMonitor + ";\n\n";
+            sharedMonitor = "extern __monitor " + classMonitor + ";\n\n";
+            break;
+        }
+    }
+    if (!state.empty()) {
+        source += "#ifndef MINIJAVA_RELOAD_MODULE\n" + state + "#else\n" + sharedMonitor + "#endif\n\n";
+    }
+    source += generate_reload_redirects(clazz);
+
     generate_new_object_source(source, project, clazz);
 
     std::map<Identifier, bool> typesUsed;
+    ProfileSites counters;
+    std::map<std::string, bool> inlined;
 
     for (auto &method: *clazz->getMethods()) {
-        source += get_method_sign(&method, clazz, included) + " {\n";
-        if (!method.isMain()) {
-            source += "\t" + clazz->getName() + " *super = (" + clazz->getName() + " *) $this;\n\n";
+        // Methods are in their own section, the handler of faults maps their PCs (see `write_null_handler`)
+        std::string sign = get_method_sign(&method, clazz, included);
+        const MethodProfile *methodProfile = profile.find(clazz->getName(), method.getName());
+        std::string placement = "$_method";
+        if (methodProfile && methodProfile->entries >= PGO_HOT_CALLS &&
+            methodProfile->entries * 100 >= profile.entries) {
+            placement = "$_method_hot";
+        } else if (methodProfile && methodProfile->entries == 0 && !method.isMain()) {
+            placement = "$_method_cold";
+        }
+        std::string methodSource = placement + " " + sign + " {\n" + generate_reload_redirect(clazz, &method);
+        if (method.isMemoized()) {
+            // The body runs on misses of the cache, the method itself looks the arguments up (see `write_memo`)
+            std::string name = clazz->getName() + "_" + method.getName() + "(";
+            std::string bodySign = sign;
+            bodySign.replace(bodySign.find(name), name.size(), get_memo_body_name(clazz, &method) + "(");
+            methodSource = "static " + bodySign + " {\n";
+        }
+        if (!method.isStatic()) {
+            methodSource += "\t" + clazz->getName() + " *super = (" + clazz->getName() + " *) $this;\n\n";
         }
 
+        if (clazz->isBuiltin()) {
+            methodSource += get_builtin_method_body(clazz, &method) + "}\n\n";
+            source += methodSource;
+            continue;
+        }
+
+        ScopedTimer timer("TAC generation", clazz->getName(), method.getName());
+        std::string monitor = method.isStatic() ? "&" + classMonitor : "$this";
         auto t = ThreeAddressCodeGenerator{};
         t.types = &typesUsed;
+        t.strings = &strings;
         t.project = project;
         t.clazz = clazz;
+        t.method = &method;
+        t.forkJoin = contains_spawn(method.getCodeBlock());
+        t.lines = options.lineDirectives || !options.sourceMap.empty();
+        int entryCounter = 0;
+        if (options.instrument) {
+            t.profile = &counters;
+            entryCounter = counters.add(method.getName(), "entry", "", method.getLine());
+        }
+        if (!options.profile.empty()) {
+            t.pgo = &profile;
+            t.pgoMethod = methodProfile;
+            t.inlined = &inlined;
+            if (placement != "$_method") {
+                t.line = method.getLine();
+                t.remark("passed", "hot-cold", "method is " + std::string(placement == "$_method_hot" ? "hot" : "cold") +
+                                               ", called " + std::to_string(methodProfile->entries) +
+                                               " times in the profile");
+                t.line = 0;
+            }
+        }
+        if (method.isSynchronized()) {
+            t.monitors.push_back(monitor);
+        }
         t.openBlock();
         if (!method.isMain()) {
             for (auto &param: *method.getParams()) {
@@ -417,8 +704,56 @@ void generate_class_source(Project *project, Class *clazz, std::map<Identifier,
         }
         generate(t, method.getCodeBlock());
         t.closeBlock();
-        source += t.code;
-        source += "}\n\n";
+        if (options.instrument) {
+            methodSource += "\t" + ProfileSites::count(entryCounter) + ";\n\n";
+        }
+        if (t.forkJoin) {
+            // Counts the pending spawned calls of the invocation, the method waits for them before it ends
+            methodSource += "\t__fj_frame $_fj_frame = {0};\n\n";
+        }
+        if (method.isMain()) {
+            methodSource += "\t$_null_handler_install();\n";
+            methodSource += "\t$_reload_start();\n\n";
+        }
+        if (method.isSynchronized()) {
+            methodSource += "\t$_monitor_enter(" + monitor + ");\n\n";
+        }
+        methodSource += t.code;
+        if (t.forkJoin) {
+            methodSource += "\n\t$_fj_sync(&$_fj_frame);\n";
+        }
+        if (method.isSynchronized()) {
+            methodSource += "\n\t$_monitor_exit(" + monitor + ");\n";
+        }
+        methodSource += "}\n\n";
+        if (method.isMemoized()) {
+            if (t.lines) {
+                methodSource += "//@line " + std::to_string(method.getLine()) + "\n";
+            }
+            methodSource += generate_memoized_method(clazz, &method, sign);
+        }
+        if (t.lines) {
+            // The outlined functions come before the signature, its line is marked again
+            std::string mark = std::to_string(method.getLine()) + "\n";
+            source += "//@method " + clazz->getName() + "." + method.getName() + " " + mark + t.functions +
+                      "//@line " + mark + methodSource + "//@end\n";
+        } else {
+            source += t.functions + methodSource;
+        }
+
+        if (codegen_report::enabled) {
+            t.stats.clazz = clazz->getName();
+            t.stats.method = method.getName();
+            t.stats.temps = t.tempGen.counter;
+            t.stats.bytes = t.functions.size() + methodSource.size();
+            codegen_report::record(std::move(t.stats));
+        }
+    }
+
+    source += generate_reload_module(clazz);
+
+    if (!counters.sites.empty()) {
+        source.insert(include_start, "\n" + generate_profile_table(clazz, counters));
     }
 
     if (!typesUsed.empty()) {
@@ -436,5 +771,8 @@ void generate_class_source(Project *project, Class *clazz, std::map<Identifier,
         source.insert(include_start, include_headers);
     }
 
+    if (options.lineDirectives || !options.sourceMap.empty()) {
+        source = map_source_lines(clazz->getName() + ".c", source, options, sourceMap);
+    }
     write_file(clazz->getName() + ".c", source);
 }
\ No newline at end of file
@@ -0,0 +1,164 @@
+#include "../internal/generator_internal.h"
+
+/**
+ * @brief Numbers a class and its subclasses in preorder.
+ *
+ * @param project The parsed project.
+ * @param clazz The class to number.
+ * @param subclasses The direct subclasses of every class, in the order of the program.
+ * @param ranges The ranges of ids `[first, last]` of the numbered classes, `first` is the id of the class.
+ * @param order The numbered classes, in the order of their ids.
+ */
+void number_class(
+        Project *project,
+        Class *clazz,
+        std::map<Identifier, std::vector<Class *>> &subclasses,
+        std::map<Identifier, std::pair<int, int>> &ranges,
+        std::vector<Class *> &order
+) {
+    int first = (int) order.size();
+    order.push_back(clazz);
+    for (Class *subclass: subclasses[clazz->getName()]) {
+        number_class(project, subclass, subclasses, ranges, order);
+    }
+    ranges[clazz->getName()] = {first, (int) order.size() - 1};
+}
+
+/**
+ * @brief Lists classes in the order of their ids (see `write_class_table`).
+ *
+ * @param project The parsed project.
+ * @param root A class, or `nullptr` for all the classes of the program.
+ * @return The class and its subclasses (their ids are consecutive), or all the classes, by increasing id.
+ */
+std::vector<Class *> get_classes_by_id(Project *project, Class *root) {
+    std::map<Identifier, std::vector<Class *>> subclasses;
+    for (auto &clazz: *project->getClasses()) {
+        if (!clazz.getExtends().empty()) {
+            subclasses[clazz.getExtends()].push_back(&clazz);
+        }
+    }
+    std::map<Identifier, std::pair<int, int>> ranges;
+    std::vector<Class *> order;
+    if (root) {
+        number_class(project, root, subclasses, ranges, order);
+        return order;
+    }
+    for (auto &clazz: *project->getClasses()) {
+        if (clazz.getExtends().empty() && !clazz.isInterface()) {
+            number_class(project, &clazz, subclasses, ranges, order);
+        }
+    }
+    return order;
+}
+
+/**
+ * @brief Writes the class ids of the program and the runtime of casts and `instanceof`.
+ *
+ * Every object stores the id of its class in its header (`$class`, see `write_fields`). Classes are numbered
+ * by a preorder traversal of the hierarchy, so the subclasses of a class have the ids right after it: an
+ * object is an instance of `C` if its id is in the range `[first, last]` of `C`. A type test is one load and
+ * two compares with constants, whatever the depth of the hierarchy.
+ *
+ * Example:
+ * ```
+ * class Shape {}                  // 0, [0, 2]
+ * class Circle extends Shape {}   // 1, [1, 1]
+ * class Square extends Shape {}   // 2, [2, 2]
+ * class Main {}                   // 3, [3, 3]
+ * ```
+ *
+ * Downcasts are checked by `$_cast`, casting an object to a class it is not an instance of prints a
+ * `ClassCastException` and exits the program. Upcasts are proven statically and never checked.
+ *
+ * Interfaces have no class id, `$_CLASS_COUNT` is the size of their itables (see `generate_interface`).
+ *
+ * It writes two supporting files:
+ *
+ * - **`__class.h`**: Declares the object header, the class ids and their ranges, and the inlined type tests.
+ * - **`__class.c`**: Implements the error of failed casts.
+ *
+ * @param project The parsed project.
+ */
+void write_class_table(Project *project) {
+    std::map<Identifier, std::vector<Class *>> subclasses;
+    for (auto &clazz: *project->getClasses()) {
+        if (!clazz.getExtends().empty()) {
+            subclasses[clazz.getExtends()].push_back(&clazz);
+        }
+    }
+    std::map<Identifier, std::pair<int, int>> ranges;
+    std::vector<Class *> order;
+    for (auto &clazz: *project->getClasses()) {
+        if (clazz.getExtends().empty() && !clazz.isInterface()) {
+            number_class(project, &clazz, subclasses, ranges, order);
+        }
+    }
+
+    std::string ids;
+    std::string table;
+    for (size_t i = 0; i < order.size(); i++) {
+        const Identifier &name = order[i]->getName();
+        ids += "    $_class_" + name + " = " + std::to_string(i) + ",\n";
+        table += "        {" + std::to_string(ranges[name].first) + ", " + std::to_string(ranges[name].second) +
+                 ", \"" + name + "\"},\n";
+    }
+
+    write_file("__class.h", "#ifndef __CLASS_H\n"
+                            "#define __CLASS_H\n"
+                            "\n"
+                            "#include <stdbool.h>\n"
+                            "#include <stddef.h>\n"
+                            "#include \"__monitor.h\"\n"
+                            "\n"
+                            "typedef struct __object {\n"
+                            "    __monitor $monitor;\n"
+                            "    int $class;\n"
+                            "} __object;\n"
+                            "\n"
+                            "typedef struct __class {\n"
+                            "    int first;\n"
+                            "    int last;\n"
+                            "    const char *name;\n"
+                            "} __class;\n"
+                            "\n"
+                            "enum {\n" + ids +
+                            "    $_CLASS_COUNT = " + std::to_string(order.size()) + "\n"
+                            "};\n"
+                            "\n"
+                            "static const __class $_classes[] = {\n" + table +
+                            "};\n"
+                            "\n"
+                            "void $_cast_error(void *object, const char *type);\n"
+                            "\n"
+                            "static inline void $_object_init(void *object, int id) {\n"
+                            "    $_monitor_init(object);\n"
+                            "    ((__object *) object)->$class = id;\n"
+                            "}\n"
+                            "\n"
+                            "static inline bool $_instanceof(void *object, int id) {\n"
+                            "    if (object == NULL) return false;\n"
+                            "    int actual = ((__object *) object)->$class;\n"
+                            "    return actual >= $_classes[id].first && actual <= $_classes[id].last;\n"
+                            "}\n"
+                            "\n"
+                            "static inline void *$_cast(void *object, int id) {\n"
+                            "    if (object != NULL && !$_instanceof(object, id)) {\n"
+                            "        $_cast_error(object, $_classes[id].name);\n"
+                            "    }\n"
+                            "    return object;\n"
+                            "}\n"
+                            "\n"
+                            "#endif //__CLASS_H\n");
+
+    write_file("__class.c", "#include \"__class.h\"\n"
+                            "\n"
+                            "#include <stdio.h>\n"
+                            "#include <stdlib.h>\n"
+                            "\n"
+                            "void $_cast_error(void *object, const char *type) {\n"
+                            "    fprintf(stderr, \"Exception: ClassCastException: %s cannot be cast to %s\\n\",\n"
+                            "            $_classes[((__object *) object)->$class].name, type);\n"
+                            "    exit(1);\n"
+                            "}\n");
+}
@@ -7,7 +7,10 @@
  * generated project with CMake. The generated build system ensures:
  * - All `.c` and `.h` files in the project directory are included in the build process.
  * - Filters out temporary or irrelevant files (like those in `CMakeFiles/`) from the source list.
- * - Configures the project to be built with C99 standard compliance.
+ * - Configures the project to be built with C11 standard compliance (atomics of the fork/join runtime).
+ * - Links pthreads, used by the runtime of threads, `spawn` and `@Parallel` loops, and OpenMP if it is available.
+ * - With `-DMINIJAVA_HOT_RELOAD=ON`, builds every class into its own shared object in `reload/` as well, the running
+ *   program reloads the ones rebuilt while it runs (see `write_reload`).
  *
  * @note This function writes the `CMakeLists.txt` file directly to disk.
  */
@@ -16,7 +19,7 @@ void write_cmake() {
                  "\n"
                  "project(CompiledProject LANGUAGES C)\n"
                  "\n"
-                 "set(CMAKE_C_STANDARD 99)\n"
+                 "set(CMAKE_C_STANDARD 11)\n"
                  "\n"
                  "file(GLOB_RECURSE SOURCES ${CMAKE_SOURCE_DIR}/*.c ${CMAKE_SOURCE_DIR}/*.h)\n"
                  "set(FILTERED_SOURCES)\n"
@@ -28,6 +31,39 @@ void write_cmake() {
                  "    endif ()\n"
                  "endforeach ()\n"
                  "\n"
-                 "add_executable(${PROJECT_NAME} ${FILTERED_SOURCES})";
+                 "add_executable(${PROJECT_NAME} ${FILTERED_SOURCES})\n"
+                 "\n"
+                 "find_package(Threads REQUIRED)\n"
+                 "target_link_libraries(${PROJECT_NAME} Threads::Threads)\n"
+                 "\n"
+                 "find_package(OpenMP)\n"
+                 "if (OpenMP_C_FOUND)\n"
+                 "    target_link_libraries(${PROJECT_NAME} OpenMP::OpenMP_C)\n"
+                 "endif ()\n"
+                 "\n"
+                 "option(MINIJAVA_HOT_RELOAD \"Build every class as a shared object reloaded by the running program\" OFF)\n"
+                 "if (MINIJAVA_HOT_RELOAD)\n"
+                 "    set(RELOAD_DIR ${CMAKE_BINARY_DIR}/reload)\n"
+                 "    target_compile_definitions(${PROJECT_NAME} PRIVATE MINIJAVA_HOT_RELOAD MINIJAVA_RELOAD_DIR=\"${RELOAD_DIR}\")\n"
+                 "    set_target_properties(${PROJECT_NAME} PROPERTIES ENABLE_EXPORTS ON)\n"
+                 "    target_link_libraries(${PROJECT_NAME} ${CMAKE_DL_LIBS})\n"
+                 "\n"
+                 "    foreach (SOURCE_FILE ${FILTERED_SOURCES})\n"
+                 "        get_filename_component(CLASS_NAME ${SOURCE_FILE} NAME_WE)\n"
+                 "        get_filename_component(EXTENSION ${SOURCE_FILE} EXT)\n"
+                 "        if (EXTENSION STREQUAL \".c\" AND NOT CLASS_NAME MATCHES \"^__\")\n"
+                 "            # Literals are indexed in the pool of the program they were compiled with\n"
+                 "            add_library(${CLASS_NAME} MODULE ${SOURCE_FILE} ${CMAKE_SOURCE_DIR}/__string.c)\n"
+                 "            target_compile_definitions(${CLASS_NAME} PRIVATE MINIJAVA_HOT_RELOAD MINIJAVA_RELOAD_MODULE)\n"
+                 "            set_target_properties(${CLASS_NAME} PROPERTIES PREFIX \"\" LIBRARY_OUTPUT_DIRECTORY ${RELOAD_DIR})\n"
+                 "            # The methods of the class call its new implementations, everything else is the program's\n"
+                 "            target_link_options(${CLASS_NAME} PRIVATE LINKER:-Bsymbolic)\n"
+                 "            target_link_libraries(${CLASS_NAME} Threads::Threads)\n"
+                 "            if (OpenMP_C_FOUND)\n"
+                 "                target_link_libraries(${CLASS_NAME} OpenMP::OpenMP_C)\n"
+                 "            endif ()\n"
+                 "        endif ()\n"
+                 "    endforeach ()\n"
+                 "endif ()";
     write_file("CMakeLists.txt", cmake);
 }
\ No newline at end of file
@@ -0,0 +1,62 @@
+#include "../internal/generator_internal.h"
+
+/**
+ * @brief Writes the runtime of exceptions (`try`, `catch` and `throw`).
+ *
+ * The thrown object is stored in `$_exception`, a thread-local pointer that is `NULL` while no exception
+ * is pending. Exceptions cost nothing on the path that doesn't throw: there is no `setjmp`, no handler
+ * registration and no unwinding table, only the calls the semantic analysis marks as able to throw (the
+ * callee declares `throws`) are followed by a test of the flag, predicted not taken:
+ *
+ * ```c
+ * int $_t_0 = Parser_parse(super, input);
+ * if ($_exception_pending()) goto try_handler_0;
+ * ```
+ *
+ * The handlers (`catch` clauses) are labels of the generated C, a `throw` or a pending exception jumps to
+ * the innermost handler of the method, or returns to the caller which tests the flag after the call (see
+ * `ThreeAddressCodeGenerator::throwNow`). A handler clears the flag once a clause catches the exception.
+ *
+ * An exception leaving `main` prints its class and exits the program.
+ *
+ * It writes two supporting files:
+ *
+ * - **`__exception.h`**: Declares the pending exception, its test and `$_throw`.
+ * - **`__exception.c`**: Implements `$_throw` and the error of uncaught exceptions.
+ */
+void write_exception() {
+    write_file("__exception.h", "#ifndef __EXCEPTION_H\n"
+                                "#define __EXCEPTION_H\n"
+                                "\n"
+                                "extern _Thread_local void *$_exception;\n"
+                                "\n"
+                                "#define $_exception_pending() __builtin_expect($_exception != 0, 0)\n"
+                                "\n"
+                                "void $_throw(void *exception);\n"
+                                "\n"
+                                "void $_exception_uncaught(void);\n"
+                                "\n"
+                                "#endif //__EXCEPTION_H\n");
+
+    write_file("__exception.c", "#include \"__exception.h\"\n"
+                                "#include \"__class.h\"\n"
+                                "\n"
+                                "#include <stdio.h>\n"
+                                "#include <stdlib.h>\n"
+                                "\n"
+                                "_Thread_local void *$_exception = NULL;\n"
+                                "\n"
+                                "void $_throw(void *exception) {\n"
+                                "    if (exception == NULL) {\n"
+                                "        fprintf(stderr, \"Exception: NullPointerException: throw null\\n\");\n"
+                                "        exit(1);\n"
+                                "    }\n"
+                                "    $_exception = exception;\n"
+                                "}\n"
+                                "\n"
+                                "void $_exception_uncaught(void) {\n"
+                                "    fprintf(stderr, \"Exception in thread \\\"main\\\" %s\\n\",\n"
+                                "            $_classes[((__object *) $_exception)->$class].name);\n"
+                                "    exit(1);\n"
+                                "}\n");
+}
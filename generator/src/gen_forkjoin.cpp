@@ -0,0 +1,234 @@
+#include "../internal/generator_internal.h"
+
+/**
+ * @brief Writes the work-stealing runtime of `spawn` and `sync`.
+ *
+ * Every worker owns a Chase-Lev deque of tasks (lock-free, C11 atomics). A spawned call is pushed to the
+ * bottom of the deque of its worker, the owner pops tasks from the bottom (LIFO, the most recent and smallest
+ * tasks, which are hot in the cache) and idle workers steal from the top of a random victim (FIFO, the oldest
+ * and largest tasks). The memory orders follow "Correct and Efficient Work-Stealing for Weak Memory Models"
+ * (Lê et al., 2013).
+ *
+ * - **Workers**: Started the first time a call is spawned, the spawning thread (usually the main thread)
+ *   becomes worker 0. The number of workers is the value of the `MINIJAVA_THREADS` environment variable,
+ *   or the number of available processors (see `$_parallel_threads`). Threads that are not workers run
+ *   spawned calls immediately.
+ * - **Sequential cutoff**: A call is spawned only while the deque of the worker has less than
+ *   `$_FJ_CUTOFF` queued tasks, otherwise it runs as a normal call. Tasks are only created when there is
+ *   parallelism to feed, so deep recursions do not pay a task per call, and the deque never overflows.
+ * - **Frames**: Each method invocation spawning calls has a `__fj_frame` counting its pending tasks.
+ *   `$_fj_sync` runs the tasks of its own deque, or steals tasks, until the count drops to zero.
+ * - **Idle workers**: A worker failing to steal for a while sleeps on a condition variable, it is woken up
+ *   when a task is spawned (or after a short timeout).
+ *
+ * It writes two supporting files:
+ *
+ * - **`__forkjoin.h`**: Declares the task and frame types and the runtime functions.
+ * - **`__forkjoin.c`**: Implements the deques, the workers and spawning and syncing.
+ */
+void write_forkjoin() {
+    write_file("__forkjoin.h", "#ifndef __FORKJOIN_H\n"
+                               "#define __FORKJOIN_H\n"
+                               "\n"
+                               "#include <stdatomic.h>\n"
+                               "#include <stdbool.h>\n"
+                               "\n"
+                               "typedef struct __fj_frame {\n"
+                               "    atomic_int pending;\n"
+                               "} __fj_frame;\n"
+                               "\n"
+                               "typedef struct __fj_task {\n"
+                               "    void (*run)(struct __fj_task *task);\n"
+                               "    __fj_frame *frame;\n"
+                               "} __fj_task;\n"
+                               "\n"
+                               "bool $_fj_should_spawn(void);\n"
+                               "\n"
+                               "void $_fj_spawn(__fj_frame *frame, __fj_task *task, void (*run)(__fj_task *task));\n"
+                               "\n"
+                               "void $_fj_sync(__fj_frame *frame);\n"
+                               "\n"
+                               "#endif //__FORKJOIN_H\n");
+
+    write_file("__forkjoin.c", "#include \"__forkjoin.h\"\n"
+                               "#include \"__parallel.h\"\n"
+                               "\n"
+                               "#include <pthread.h>\n"
+                               "#include <sched.h>\n"
+                               "#include <stdlib.h>\n"
+                               "#include <sys/time.h>\n"
+                               "#include <time.h>\n"
+                               "\n"
+                               "#define $_FJ_MAX_WORKERS 256\n"
+                               "#define $_FJ_DEQUE_SIZE 64\n"
+                               "#define $_FJ_CUTOFF 16\n"
+                               "#define $_FJ_STEAL_ATTEMPTS 128\n"
+                               "\n"
+                               "typedef struct {\n"
+                               "    atomic_long top;\n"
+                               "    char padding[64 - sizeof(atomic_long)];\n"
+                               "    atomic_long bottom;\n"
+                               "    _Atomic(__fj_task *) tasks[$_FJ_DEQUE_SIZE];\n"
+                               "} $_fj_deque;\n"
+                               "\n"
+                               "static $_fj_deque $_fj_deques[$_FJ_MAX_WORKERS];\n"
+                               "static int $_fj_workers = 1;\n"
+                               "static pthread_once_t $_fj_once = PTHREAD_ONCE_INIT;\n"
+                               "static _Thread_local int $_fj_self = -1;\n"
+                               "static _Thread_local unsigned int $_fj_seed = 1;\n"
+                               "\n"
+                               "static pthread_mutex_t $_fj_lock = PTHREAD_MUTEX_INITIALIZER;\n"
+                               "static pthread_cond_t $_fj_wake = PTHREAD_COND_INITIALIZER;\n"
+                               "static atomic_int $_fj_sleeping;\n"
+                               "\n"
+                               "// Owner only, pushes a task to the bottom of the deque\n"
+                               "static void $_fj_push($_fj_deque *deque, __fj_task *task) {\n"
+                               "    long bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);\n"
+                               "    atomic_store_explicit(&deque->tasks[bottom & ($_FJ_DEQUE_SIZE - 1)], task,\n"
+                               "                          memory_order_relaxed);\n"
+                               "    atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_release);\n"
+                               "}\n"
+                               "\n"
+                               "// Owner only, pops a task from the bottom of the deque, races with thieves for the last one\n"
+                               "static __fj_task *$_fj_take($_fj_deque *deque) {\n"
+                               "    long bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed) - 1;\n"
+                               "    atomic_store_explicit(&deque->bottom, bottom, memory_order_relaxed);\n"
+                               "    atomic_thread_fence(memory_order_seq_cst);\n"
+                               "    long top = atomic_load_explicit(&deque->top, memory_order_relaxed);\n"
+                               "\n"
+                               "    if (top > bottom) {\n"
+                               "        atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);\n"
+                               "        return NULL;\n"
+                               "    }\n"
+                               "    __fj_task *task = atomic_load_explicit(&deque->tasks[bottom & ($_FJ_DEQUE_SIZE - 1)],\n"
+                               "                                           memory_order_relaxed);\n"
+                               "    if (top == bottom) {\n"
+                               "        if (!atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1,\n"
+                               "                                                     memory_order_seq_cst,\n"
+                               "                                                     memory_order_relaxed)) {\n"
+                               "            task = NULL;\n"
+                               "        }\n"
+                               "        atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);\n"
+                               "    }\n"
+                               "    return task;\n"
+                               "}\n"
+                               "\n"
+                               "// Any thread, steals a task from the top of the deque\n"
+                               "static __fj_task *$_fj_steal($_fj_deque *deque) {\n"
+                               "    long top = atomic_load_explicit(&deque->top, memory_order_acquire);\n"
+                               "    atomic_thread_fence(memory_order_seq_cst);\n"
+                               "    long bottom = atomic_load_explicit(&deque->bottom, memory_order_acquire);\n"
+                               "    if (top >= bottom) {\n"
+                               "        return NULL;\n"
+                               "    }\n"
+                               "\n"
+                               "    __fj_task *task = atomic_load_explicit(&deque->tasks[top & ($_FJ_DEQUE_SIZE - 1)],\n"
+                               "                                           memory_order_relaxed);\n"
+                               "    if (!atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1,\n"
+                               "                                                 memory_order_seq_cst, memory_order_relaxed)) {\n"
+                               "        return NULL;\n"
+                               "    }\n"
+                               "    return task;\n"
+                               "}\n"
+                               "\n"
+                               "// Tries to steal a task from the other workers, starting from a random victim\n"
+                               "static __fj_task *$_fj_steal_any(void) {\n"
+                               "    $_fj_seed ^= $_fj_seed << 13;\n"
+                               "    $_fj_seed ^= $_fj_seed >> 17;\n"
+                               "    $_fj_seed ^= $_fj_seed << 5;\n"
+                               "    int start = (int) ($_fj_seed % (unsigned int) $_fj_workers);\n"
+                               "    for (int i = 0; i < $_fj_workers; i++) {\n"
+                               "        int victim = (start + i) % $_fj_workers;\n"
+                               "        if (victim == $_fj_self) continue;\n"
+                               "        __fj_task *task = $_fj_steal(&$_fj_deques[victim]);\n"
+                               "        if (task) return task;\n"
+                               "    }\n"
+                               "    return NULL;\n"
+                               "}\n"
+                               "\n"
+                               "// Runs a task, the result of the call is published by the release of the pending count\n"
+                               "static void $_fj_run(__fj_task *task) {\n"
+                               "    __fj_frame *frame = task->frame;\n"
+                               "    task->run(task);\n"
+                               "    free(task);\n"
+                               "    atomic_fetch_sub_explicit(&frame->pending, 1, memory_order_release);\n"
+                               "}\n"
+                               "\n"
+                               "static void *$_fj_worker(void *argument) {\n"
+                               "    $_fj_self = (int) (long) argument;\n"
+                               "    $_fj_seed = 2654435761u * (unsigned int) ($_fj_self + 1);\n"
+                               "    int failures = 0;\n"
+                               "    while (1) {\n"
+                               "        __fj_task *task = $_fj_steal_any();\n"
+                               "        if (task) {\n"
+                               "            $_fj_run(task);\n"
+                               "            failures = 0;\n"
+                               "        } else if (++failures < $_FJ_STEAL_ATTEMPTS) {\n"
+                               "            sched_yield();\n"
+                               "        } else {\n"
+                               "            // Sleeps until a task is spawned, the timeout covers a wake-up racing with sleeping\n"
+                               "            struct timeval now;\n"
+                               "            gettimeofday(&now, NULL);\n"
+                               "            long nanoseconds = now.tv_usec * 1000L + 1000000L;\n"
+                               "            struct timespec deadline = {now.tv_sec + nanoseconds / 1000000000L,\n"
+                               "                                        nanoseconds % 1000000000L};\n"
+                               "            pthread_mutex_lock(&$_fj_lock);\n"
+                               "            atomic_fetch_add(&$_fj_sleeping, 1);\n"
+                               "            pthread_cond_timedwait(&$_fj_wake, &$_fj_lock, &deadline);\n"
+                               "            atomic_fetch_sub(&$_fj_sleeping, 1);\n"
+                               "            pthread_mutex_unlock(&$_fj_lock);\n"
+                               "            failures = 0;\n"
+                               "        }\n"
+                               "    }\n"
+                               "    return NULL;\n"
+                               "}\n"
+                               "\n"
+                               "// Called once, by the first thread spawning a call, which becomes worker 0\n"
+                               "static void $_fj_start(void) {\n"
+                               "    int threads = $_parallel_threads();\n"
+                               "    $_fj_self = 0;\n"
+                               "    $_fj_workers = threads < $_FJ_MAX_WORKERS ? threads : $_FJ_MAX_WORKERS;\n"
+                               "    for (int i = 1; i < $_fj_workers; i++) {\n"
+                               "        pthread_t thread;\n"
+                               "        if (pthread_create(&thread, NULL, $_fj_worker, (void *) (long) i) == 0) {\n"
+                               "            pthread_detach(thread);\n"
+                               "        }\n"
+                               "    }\n"
+                               "}\n"
+                               "\n"
+                               "bool $_fj_should_spawn(void) {\n"
+                               "    pthread_once(&$_fj_once, $_fj_start);\n"
+                               "    if ($_fj_self < 0 || $_fj_workers == 1) {\n"
+                               "        return false;\n"
+                               "    }\n"
+                               "    $_fj_deque *deque = &$_fj_deques[$_fj_self];\n"
+                               "    long size = atomic_load_explicit(&deque->bottom, memory_order_relaxed) -\n"
+                               "                atomic_load_explicit(&deque->top, memory_order_relaxed);\n"
+                               "    return size < $_FJ_CUTOFF;\n"
+                               "}\n"
+                               "\n"
+                               "void $_fj_spawn(__fj_frame *frame, __fj_task *task, void (*run)(__fj_task *task)) {\n"
+                               "    task->run = run;\n"
+                               "    task->frame = frame;\n"
+                               "    atomic_fetch_add_explicit(&frame->pending, 1, memory_order_relaxed);\n"
+                               "    $_fj_push(&$_fj_deques[$_fj_self], task);\n"
+                               "    if (atomic_load(&$_fj_sleeping) > 0) {\n"
+                               "        pthread_mutex_lock(&$_fj_lock);\n"
+                               "        pthread_cond_signal(&$_fj_wake);\n"
+                               "        pthread_mutex_unlock(&$_fj_lock);\n"
+                               "    }\n"
+                               "}\n"
+                               "\n"
+                               "void $_fj_sync(__fj_frame *frame) {\n"
+                               "    while (atomic_load_explicit(&frame->pending, memory_order_acquire) > 0) {\n"
+                               "        // Own tasks are on top of the deque, stolen ones are awaited by helping the thieves\n"
+                               "        __fj_task *task = $_fj_take(&$_fj_deques[$_fj_self]);\n"
+                               "        if (!task) task = $_fj_steal_any();\n"
+                               "        if (task) {\n"
+                               "            $_fj_run(task);\n"
+                               "        } else {\n"
+                               "            sched_yield();\n"
+                               "        }\n"
+                               "    }\n"
+                               "}\n");
+}
@@ -12,6 +12,8 @@
  *     - `length`: Stores the size of the array.
  *     - `data`: A pointer to the dynamically-allocated array data.
  *   - Declares a function `$_new___int_array`, which constructs instances of the struct.
+ *   - Declares a function `$_int_array_slice`, which constructs views of an array (`arr.slice(from, to)`).
+ *   - Declares a function `$_int_array_overlap`, which checks if two arrays share elements.
  *
  * - **`__int_array.c`**:
  *   - Implements the `$_new___int_array(int size)` function for allocating and initializing an array.
@@ -19,6 +21,17 @@
  *     - Allocation of memory for the struct (`__int_array`).
  *     - Initialization of the `length` field with the specified size.
  *     - Allocation and zero-initialization of the `data` array.
+ *   - Implements the `$_int_array_slice(__int_array *arr, int from, int to)` function for creating views.
+ *   - Implements the `$_int_array_overlap(__int_array *a, __int_array *b, int aligned)` function, used by
+ *     `@Parallel` loops to run serially when their arrays share storage (see `ParallelOverlap`).
+ *
+ * **Views:**
+ * - A view shares the storage of its parent, its `data` points to the element at the offset `from`
+ *   of the parent and its `length` is `to - from`. Creating a view is O(1) and copies no elements.
+ * - Since the offset is folded into `data`, views and plain arrays have the same layout, so indexing
+ *   and `length` work on both without any extra cost (`arr->data[i]`), and views of views compose.
+ * - Two arrays share elements if their ranges of `data` overlap. With `aligned`, arrays starting at the
+ *   same element do not count, an element at the same index of both is the same element.
  *
  * **Usage in Generated C Code:**
  * - This implementation allows the generated C code to use `int[]` transparently by calling `$_new___int_array(size)`.
@@ -49,6 +62,10 @@ void write_int_array() {
                                 "\n"
                                 "__int_array *$_new___int_array(int size);\n"
                                 "\n"
+                                "__int_array *$_int_array_slice(__int_array *arr, int from, int to);\n"
+                                "\n"
+                                "int $_int_array_overlap(__int_array *a, __int_array *b, int aligned);\n"
+                                "\n"
                                 "#endif //__INT_ARRAY_H\n");
 
     write_file("__int_array.c", "#include \"__int_array.h\"\n"
@@ -61,5 +78,23 @@ void write_int_array() {
                                 "    arr->length = size;\n"
                                 "    arr->data = (int *) calloc(size, sizeof(int));\n"
                                 "    return arr;\n"
+                                "}\n"
+                                "\n"
+                                "__int_array *$_int_array_slice(__int_array *arr, int from, int to) {\n"
+                                "    if (from < 0 || to > arr->length || from > to) {\n"
+                                "        fprintf(stderr, \"Slice [%d, %d) out of bounds for length %d\\n\", from, to, arr->length);\n"
+                                "        exit(1);\n"
+                                "    }\n"
+                                "    __int_array *view = (__int_array *) malloc(sizeof(__int_array));\n"
+                                "    view->length = to - from;\n"
+                                "    view->data = arr->data + from;\n"
+                                "    return view;\n"
+                                "}\n"
+                                "\n"
+                                "int $_int_array_overlap(__int_array *a, __int_array *b, int aligned) {\n"
+                                "    if (!a || !b || (aligned && a->data == b->data)) {\n"
+                                "        return 0;\n"
+                                "    }\n"
+                                "    return a->data < b->data + b->length && b->data < a->data + a->length;\n"
                                 "}\n");
 }
\ No newline at end of file
@@ -0,0 +1,171 @@
+#include "../internal/generator_internal.h"
+#include <set>
+
+/**
+ * @brief Generates the signature of a method of an interface as a member of its itable.
+ *
+ * Example Output:
+ * ```c
+ * int (*scale)(void *, int);
+ * ```
+ *
+ * @param method The method declaration.
+ * @param types The object types used by the signature, they are declared before the itable.
+ * @return The C declaration of the function pointer.
+ */
+std::string get_interface_method_sign(Method *method, std::set<Identifier> &types) {
+    std::string sign = "\t" + get_type(method->getReturnTypeLexeme()) + "(*" + method->getName() + ")(void *";
+    types.insert(method->getReturnTypeLexeme());
+    for (auto &param: *method->getParams()) {
+        sign += ", " + get_type(&param);
+        types.insert(param.getTypeLexeme());
+    }
+    return sign + ");\n";
+}
+
+/**
+ * @brief Generates the header and the source file of an interface.
+ *
+ * A value of an interface type is a pointer to any object implementing it (`typedef void Shape;`).
+ * Every class implementing the interface, directly or through a superclass, has an itable: a static
+ * struct of pointers to its implementations of the methods of the interface, in the order of their
+ * declaration. The itables are indexed by the class id stored in the header of every object (see
+ * `write_class_table`), so an interface call is two dependent loads and an indirect call, the same cost
+ * for any number of interfaces and classes, without searching or caching:
+ *
+ * ```c
+ * int $_t_0 = $_itable_of_Shape(shape)->area(shape);
+ * ```
+ *
+ * The entry of a class that doesn't implement the interface is `NULL`, which is also the runtime test of
+ * `instanceof` and of the casts to the interface.
+ *
+ * The itables are constant, except in the development build where reloaded classes rebind them (see
+ * `write_reload`).
+ *
+ * Example Header Output:
+ * ```c
+ * typedef void Shape;
+ *
+ * typedef struct $_itable_Shape {
+ *     int (*area)(void *);
+ *     int (*scale)(void *, int);
+ * } $_itable_Shape;
+ *
+ * extern const $_itable_Shape *const $_itables_Shape[$_CLASS_COUNT];
+ *
+ * static inline const $_itable_Shape *$_itable_of_Shape(void *object) {
+ *     return $_itables_Shape[((__object *) object)->$class];
+ * }
+ * ```
+ *
+ * Example Source Output:
+ * ```c
+ * static $_ITABLE_CONST $_itable_Shape $_itable_Shape_Circle = {
+ *     Circle_area,
+ *     Circle_scale,
+ * };
+ *
+ * const $_itable_Shape *const $_itables_Shape[$_CLASS_COUNT] = {
+ *     [$_class_Circle] = &$_itable_Shape_Circle,
+ * };
+ * ```
+ *
+ * @param project The parsed project.
+ * @param interfaceClass The interface.
+ */
+void generate_interface(Project *project, Class *interfaceClass) {
+    const Identifier &name = interfaceClass->getName();
+    std::string itable = "$_itable_" + name;
+    std::string itables = "$_itables_" + name;
+
+    std::set<Identifier> types;
+    std::string members;
+    for (auto &method: *interfaceClass->getMethods()) {
+        members += get_interface_method_sign(&method, types);
+    }
+    if (members.empty()) {
+        // C structs can't be empty, the itable of an interface without methods only marks its classes
+        members = "\tvoid (*$marker)(void);\n";
+    }
+
+    std::string declarations;
+    for (auto &type: types) {
+        if (type == name || !SymbolTable::isObjectType(type)) {
+            continue;
+        }
+        if (SymbolTable::isInterfaceType(type)) {
+            declarations += "typedef void " + type + ";\n";
+        } else {
+            declarations += "typedef struct " + type + " " + type + ";\n";
+        }
+    }
+
+    std::string hKey = "COMPILED_" + name + "_H";
+    write_file(name + ".h", "#ifndef " + hKey + "\n"
+                            "#define " + hKey + "\n"
+                            "\n"
+                            "#include <stdbool.h>\n"
+                            "#include \"__int_array.h\"\n"
+                            "#include \"__string.h\"\n"
+                            "#include \"__monitor.h\"\n"
+                            "#include \"__channel.h\"\n"
+                            "#include \"__class.h\"\n"
+                            "#include \"__reload.h\"\n"
+                            "\n" +
+                            declarations +
+                            "typedef void " + name + ";\n"
+                            "\n"
+                            "typedef struct " + itable + " {\n" +
+                            members +
+                            "} " + itable + ";\n"
+                            "\n"
+                            "extern const " + itable + " *const " + itables + "[$_CLASS_COUNT];\n"
+                            "\n"
+                            "static inline const " + itable + " *$_itable_of_" + name + "(void *object) {\n"
+                            "    return " + itables + "[((__object *) object)->$class];\n"
+                            "}\n"
+                            "\n"
+                            "static inline bool $_instanceof_" + name + "(void *object) {\n"
+                            "    return object != NULL && $_itable_of_" + name + "(object) != NULL;\n"
+                            "}\n"
+                            "\n"
+                            "static inline void *$_cast_to_" + name + "(void *object) {\n"
+                            "    if (object != NULL && $_itable_of_" + name + "(object) == NULL) {\n"
+                            "        $_cast_error(object, \"" + name + "\");\n"
+                            "    }\n"
+                            "    return object;\n"
+                            "}\n"
+                            "\n"
+                            "#endif //" + hKey + "\n");
+
+    std::string includes;
+    std::string tables;
+    std::string entries;
+    for (auto &clazz: *project->getClasses()) {
+        if (clazz.isInterface() || !SymbolTable::canCast(clazz.getName(), name)) {
+            continue;
+        }
+        includes += "#include \"" + clazz.getName() + ".h\"\n";
+        tables += "static $_ITABLE_CONST " + itable + " " + itable + "_" + clazz.getName() + " = {\n";
+        for (auto &method: *interfaceClass->getMethods()) {
+            tables += "\t" + get_method_reference_name(project, &clazz, method.getName()) + ",\n";
+        }
+        if (interfaceClass->getMethods()->empty()) {
+            tables += "\tNULL,\n";
+        }
+        tables += "};\n\n";
+        entries += "\t[$_class_" + clazz.getName() + "] = &" + itable + "_" + clazz.getName() + ",\n";
+    }
+    if (entries.empty()) {
+        entries = "\tNULL,\n";
+    }
+
+    write_file(name + ".c", "#include \"" + name + ".h\"\n" +
+                            includes +
+                            "\n" +
+                            tables +
+                            "const " + itable + " *const " + itables + "[$_CLASS_COUNT] = {\n" +
+                            entries +
+                            "};\n");
+}
@@ -0,0 +1,261 @@
+#include "../internal/generator_internal.h"
+
+/**
+ * @brief Returns the name of the C function running the body of a `@Memoize` method.
+ *
+ * Example:
+ * - `fib` in class `Fib` → `$_memo_body_Fib_fib`
+ */
+std::string get_memo_body_name(Class *clazz, Method *method) {
+    return "$_memo_body_" + clazz->getName() + "_" + method->getName();
+}
+
+/**
+ * @brief Generates the cache of a `@Memoize` method and the function looking its results up.
+ *
+ * The body of the method is generated as a static function (see `get_memo_body_name`), the method itself
+ * looks the arguments up in its cache and only runs the body on a miss. Recursive calls go through the
+ * method, so every result is computed once.
+ *
+ * Example Output:
+ * ```c
+ * static __memo $_memo_Fib_fib = {"Fib.fib", 1};
+ *
+ * $_method int Fib_fib(void *$this, int n) {
+ *     int $_memo_key[] = {n};
+ *     int $_memo_value;
+ *     if (!$_memo_get(&$_memo_Fib_fib, $_memo_key, &$_memo_value)) {
+ *         $_memo_value = $_memo_body_Fib_fib($this, n);
+ *         $_memo_put(&$_memo_Fib_fib, $_memo_key, $_memo_value);
+ *     }
+ *     return $_memo_value;
+ * }
+ * ```
+ *
+ * @param clazz The class declaring the method.
+ * @param method The `@Memoize` method.
+ * @param sign The C signature of the method (see `get_method_sign`).
+ * @return The C source of the cache and of the method.
+ */
+std::string generate_memoized_method(Class *clazz, Method *method, const std::string &sign) {
+    std::string name = clazz->getName() + "_" + method->getName();
+    std::string memo = "$_memo_" + name;
+    std::string key;
+    std::string arguments = method->isStatic() ? "" : "$this";
+    for (auto &param: *method->getParams()) {
+        key += std::string(key.empty() ? "" : ", ") + param.getName();
+        arguments += std::string(arguments.empty() ? "" : ", ") + param.getName();
+    }
+
+    return "static __memo " + memo + " = {\"" + clazz->getName() + "." + method->getName() + "\", " +
+           std::to_string(method->getParams()->size()) + "};\n\n" +
+           "$_method " + sign + " {\n" +
+           generate_reload_redirect(clazz, method) +
+           "\tint $_memo_key[] = {" + key + "};\n"
+           "\tint $_memo_value;\n"
+           "\tif (!$_memo_get(&" + memo + ", $_memo_key, &$_memo_value)) {\n"
+           "\t\t$_memo_value = " + get_memo_body_name(clazz, method) + "(" + arguments + ");\n"
+           "\t\t$_memo_put(&" + memo + ", $_memo_key, $_memo_value);\n"
+           "\t}\n"
+           "\treturn $_memo_value;\n"
+           "}\n\n";
+}
+
+/**
+ * @brief Writes the runtime of the caches of `@Memoize` methods.
+ *
+ * Every `@Memoize` method has a cache of its results keyed by its `int` arguments:
+ *
+ * - **Dense**: A method with a single argument stores the results of the arguments in
+ *   `[0, $_MEMO_DENSE)` in an array indexed by the argument, the common case of recursions on `n`.
+ * - **Hashed**: Other arguments are stored in an open-addressing hash table with linear probing, keyed by
+ *   all the arguments, grown to keep it at most half full.
+ *
+ * A cache is guarded by a monitor (see `write_monitor`), the method may be called by several threads,
+ * the lock is not held while the body runs. Results are `int`s, `boolean` results are stored as `0`/`1`.
+ *
+ * Setting the environment variable `MINIJAVA_MEMO_STATS` prints the hits and misses of every cache used
+ * by the program when it exits:
+ *
+ * ```
+ * @Memoize Fib.fib: 29 hits, 31 misses, 31 entries
+ * ```
+ *
+ * It writes two supporting files:
+ *
+ * - **`__memo.h`**: Declares the cache type and its `get`/`put` functions.
+ * - **`__memo.c`**: Implements the caches and the statistics.
+ */
+void write_memo() {
+    write_file("__memo.h", "#ifndef __MEMO_H\n"
+                           "#define __MEMO_H\n"
+                           "\n"
+                           "#include <stdbool.h>\n"
+                           "#include <stddef.h>\n"
+                           "#include \"__monitor.h\"\n"
+                           "\n"
+                           "#define $_MEMO_DENSE 4096\n"
+                           "\n"
+                           "typedef struct __memo {\n"
+                           "    const char *name;\n"
+                           "    int arity;\n"
+                           "    __monitor monitor;\n"
+                           "    int *dense;\n"
+                           "    unsigned char *filled;\n"
+                           "    int *keys;\n"
+                           "    int *values;\n"
+                           "    unsigned char *used;\n"
+                           "    size_t capacity;\n"
+                           "    size_t count;\n"
+                           "    long hits;\n"
+                           "    long misses;\n"
+                           "    bool registered;\n"
+                           "    struct __memo *next;\n"
+                           "} __memo;\n"
+                           "\n"
+                           "bool $_memo_get(__memo *memo, const int *key, int *value);\n"
+                           "\n"
+                           "void $_memo_put(__memo *memo, const int *key, int value);\n"
+                           "\n"
+                           "#endif //__MEMO_H\n");
+
+    write_file("__memo.c", "#include \"__memo.h\"\n"
+                           "\n"
+                           "#include <stdint.h>\n"
+                           "#include <stdio.h>\n"
+                           "#include <stdlib.h>\n"
+                           "#include <string.h>\n"
+                           "\n"
+                           "#define $_MEMO_INITIAL_CAPACITY 64\n"
+                           "\n"
+                           "static __monitor $_memo_registry_monitor;\n"
+                           "static __memo *$_memo_registry = NULL;\n"
+                           "\n"
+                           "static void $_memo_print_stats(void) {\n"
+                           "    for (__memo *memo = $_memo_registry; memo != NULL; memo = memo->next) {\n"
+                           "        fprintf(stderr, \"@Memoize %s: %ld hits, %ld misses, %zu entries\\n\",\n"
+                           "                memo->name, memo->hits, memo->misses, memo->count);\n"
+                           "    }\n"
+                           "}\n"
+                           "\n"
+                           "// Adds the cache to the statistics, the first time it's used\n"
+                           "static void $_memo_register(__memo *memo) {\n"
+                           "    memo->registered = true;\n"
+                           "    if (getenv(\"MINIJAVA_MEMO_STATS\") == NULL) {\n"
+                           "        return;\n"
+                           "    }\n"
+                           "    $_monitor_enter(&$_memo_registry_monitor);\n"
+                           "    if ($_memo_registry == NULL) {\n"
+                           "        atexit($_memo_print_stats);\n"
+                           "    }\n"
+                           "    memo->next = $_memo_registry;\n"
+                           "    $_memo_registry = memo;\n"
+                           "    $_monitor_exit(&$_memo_registry_monitor);\n"
+                           "}\n"
+                           "\n"
+                           "static inline bool $_memo_is_dense(__memo *memo, const int *key) {\n"
+                           "    return memo->arity == 1 && key[0] >= 0 && key[0] < $_MEMO_DENSE;\n"
+                           "}\n"
+                           "\n"
+                           "static size_t $_memo_hash(const int *key, int arity) {\n"
+                           "    uint64_t hash = 0x9E3779B97F4A7C15ULL;\n"
+                           "    for (int i = 0; i < arity; i++) {\n"
+                           "        hash = (hash ^ (uint32_t) key[i]) * 0xFF51AFD7ED558CCDULL;\n"
+                           "        hash ^= hash >> 32;\n"
+                           "    }\n"
+                           "    return (size_t) hash;\n"
+                           "}\n"
+                           "\n"
+                           "// The slot of the key, or the empty slot where it would be inserted\n"
+                           "static size_t $_memo_find(__memo *memo, const int *key) {\n"
+                           "    size_t mask = memo->capacity - 1;\n"
+                           "    size_t slot = $_memo_hash(key, memo->arity) & mask;\n"
+                           "    while (memo->used[slot] &&\n"
+                           "           memcmp(&memo->keys[slot * memo->arity], key, sizeof(int) * memo->arity) != 0) {\n"
+                           "        slot = (slot + 1) & mask;\n"
+                           "    }\n"
+                           "    return slot;\n"
+                           "}\n"
+                           "\n"
+                           "static void $_memo_grow(__memo *memo) {\n"
+                           "    __memo old = *memo;\n"
+                           "    memo->capacity = old.capacity ? old.capacity * 2 : $_MEMO_INITIAL_CAPACITY;\n"
+                           "    memo->keys = (int *) malloc(sizeof(int) * memo->arity * memo->capacity);\n"
+                           "    memo->values = (int *) malloc(sizeof(int) * memo->capacity);\n"
+                           "    memo->used = (unsigned char *) calloc(memo->capacity, 1);\n"
+                           "    if (!memo->keys || !memo->values || !memo->used) {\n"
+                           "        fprintf(stderr, \"Error: Out of memory for the cache of %s\\n\", memo->name);\n"
+                           "        exit(1);\n"
+                           "    }\n"
+                           "    for (size_t i = 0; i < old.capacity; i++) {\n"
+                           "        if (old.used[i]) {\n"
+                           "            size_t slot = $_memo_find(memo, &old.keys[i * memo->arity]);\n"
+                           "            memcpy(&memo->keys[slot * memo->arity], &old.keys[i * memo->arity],\n"
+                           "                   sizeof(int) * memo->arity);\n"
+                           "            memo->values[slot] = old.values[i];\n"
+                           "            memo->used[slot] = 1;\n"
+                           "        }\n"
+                           "    }\n"
+                           "    free(old.keys);\n"
+                           "    free(old.values);\n"
+                           "    free(old.used);\n"
+                           "}\n"
+                           "\n"
+                           "bool $_memo_get(__memo *memo, const int *key, int *value) {\n"
+                           "    bool found = false;\n"
+                           "    $_monitor_enter(&memo->monitor);\n"
+                           "    if (!memo->registered) {\n"
+                           "        $_memo_register(memo);\n"
+                           "    }\n"
+                           "    if ($_memo_is_dense(memo, key)) {\n"
+                           "        if (memo->filled && memo->filled[key[0]]) {\n"
+                           "            *value = memo->dense[key[0]];\n"
+                           "            found = true;\n"
+                           "        }\n"
+                           "    } else if (memo->capacity) {\n"
+                           "        size_t slot = $_memo_find(memo, key);\n"
+                           "        if (memo->used[slot]) {\n"
+                           "            *value = memo->values[slot];\n"
+                           "            found = true;\n"
+                           "        }\n"
+                           "    }\n"
+                           "    if (found) {\n"
+                           "        memo->hits++;\n"
+                           "    } else {\n"
+                           "        memo->misses++;\n"
+                           "    }\n"
+                           "    $_monitor_exit(&memo->monitor);\n"
+                           "    return found;\n"
+                           "}\n"
+                           "\n"
+                           "void $_memo_put(__memo *memo, const int *key, int value) {\n"
+                           "    $_monitor_enter(&memo->monitor);\n"
+                           "    if ($_memo_is_dense(memo, key)) {\n"
+                           "        if (!memo->dense) {\n"
+                           "            memo->dense = (int *) malloc(sizeof(int) * $_MEMO_DENSE);\n"
+                           "            memo->filled = (unsigned char *) calloc($_MEMO_DENSE, 1);\n"
+                           "            if (!memo->dense || !memo->filled) {\n"
+                           "                fprintf(stderr, \"Error: Out of memory for the cache of %s\\n\", memo->name);\n"
+                           "                exit(1);\n"
+                           "            }\n"
+                           "        }\n"
+                           "        if (!memo->filled[key[0]]) {\n"
+                           "            memo->filled[key[0]] = 1;\n"
+                           "            memo->count++;\n"
+                           "        }\n"
+                           "        memo->dense[key[0]] = value;\n"
+                           "    } else {\n"
+                           "        if ((memo->count + 1) * 2 > memo->capacity) {\n"
+                           "            $_memo_grow(memo);\n"
+                           "        }\n"
+                           "        size_t slot = $_memo_find(memo, key);\n"
+                           "        if (!memo->used[slot]) {\n"
+                           "            memcpy(&memo->keys[slot * memo->arity], key, sizeof(int) * memo->arity);\n"
+                           "            memo->used[slot] = 1;\n"
+                           "            memo->count++;\n"
+                           "        }\n"
+                           "        memo->values[slot] = value;\n"
+                           "    }\n"
+                           "    $_monitor_exit(&memo->monitor);\n"
+                           "}\n");
+}
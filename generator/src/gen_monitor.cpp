@@ -0,0 +1,281 @@
+#include "../internal/generator_internal.h"
+
+/**
+ * @brief Writes the runtime of monitors (`synchronized`) and of the built-in `Thread` class.
+ *
+ * Every object starts with a `__monitor`, a single lock word (see `write_fields`). Monitors are thin locks
+ * ("Thin Locks: Featherweight Synchronization for Java", Bacon et al., 1998):
+ *
+ * - **Unlocked**: The word is `0`.
+ * - **Thin**: The word holds the id of the owner thread (`id << 8`) and the recursion count (bits 1 to 7).
+ *   Entering an unlocked monitor is a single CAS, exiting a monitor entered once is a plain release store,
+ *   both are inlined in the generated code.
+ * - **Inflated**: The word holds a pointer to a fat lock with the bit 0 set. A fat lock is a futex-based
+ *   mutex ("Futexes Are Tricky", Drepper) with an owner and a recursion count, contended threads sleep in
+ *   the kernel instead of spinning. Fat locks are never deflated.
+ *
+ * A thread finding a monitor thin-locked by another thread spins (then yields) until the monitor is
+ * released, and inflates it once it acquires it, so the next contended threads sleep on the fat lock.
+ * The recursion count overflowing also inflates the monitor.
+ *
+ * Threads get their id the first time they enter a monitor. Exiting a monitor not owned by the current
+ * thread prints an error and exits the program.
+ *
+ * It writes two supporting files:
+ *
+ * - **`__monitor.h`**: Declares the monitor type, the inlined fast paths, the futex wrappers (also used by
+ *   channels, see `write_channel`) and the thread functions.
+ * - **`__monitor.c`**: Implements the slow paths, fat locks and `$_thread_start`/`$_thread_join`.
+ */
+void write_monitor() {
+    write_file("__monitor.h", "#ifndef __MONITOR_H\n"
+                              "#define __MONITOR_H\n"
+                              "\n"
+                              "#include <stdatomic.h>\n"
+                              "#include <stdint.h>\n"
+                              "\n"
+                              "typedef struct __monitor {\n"
+                              "    atomic_uintptr_t word;\n"
+                              "} __monitor;\n"
+                              "\n"
+                              "extern _Thread_local uintptr_t $_monitor_self;\n"
+                              "\n"
+                              "uintptr_t $_monitor_register(void);\n"
+                              "\n"
+                              "void $_monitor_enter_slow(__monitor *monitor, uintptr_t self);\n"
+                              "\n"
+                              "void $_monitor_exit_slow(__monitor *monitor, uintptr_t self);\n"
+                              "\n"
+                              "void $_futex_wait(atomic_int *address, int value);\n"
+                              "\n"
+                              "void $_futex_wake(atomic_int *address);\n"
+                              "\n"
+                              "static inline void $_monitor_init(void *object) {\n"
+                              "    atomic_init(&((__monitor *) object)->word, 0);\n"
+                              "}\n"
+                              "\n"
+                              "static inline void $_monitor_enter(void *object) {\n"
+                              "    __monitor *monitor = (__monitor *) object;\n"
+                              "    uintptr_t self = $_monitor_self ? $_monitor_self : $_monitor_register();\n"
+                              "    uintptr_t expected = 0;\n"
+                              "    if (!atomic_compare_exchange_strong_explicit(&monitor->word, &expected, self,\n"
+                              "                                                 memory_order_acquire,\n"
+                              "                                                 memory_order_relaxed)) {\n"
+                              "        $_monitor_enter_slow(monitor, self);\n"
+                              "    }\n"
+                              "}\n"
+                              "\n"
+                              "static inline void $_monitor_exit(void *object) {\n"
+                              "    __monitor *monitor = (__monitor *) object;\n"
+                              "    uintptr_t self = $_monitor_self;\n"
+                              "    if (self != 0 && atomic_load_explicit(&monitor->word, memory_order_relaxed) == self) {\n"
+                              "        atomic_store_explicit(&monitor->word, 0, memory_order_release);\n"
+                              "    } else {\n"
+                              "        $_monitor_exit_slow(monitor, self);\n"
+                              "    }\n"
+                              "}\n"
+                              "\n"
+                              "void $_thread_start(void **handle, void *object, void (*run)(void *));\n"
+                              "\n"
+                              "void $_thread_join(void **handle);\n"
+                              "\n"
+                              "#endif //__MONITOR_H\n");
+
+    write_file("__monitor.c", "#define _GNU_SOURCE\n"
+                              "#include \"__monitor.h\"\n"
+                              "\n"
+                              "#include <pthread.h>\n"
+                              "#include <sched.h>\n"
+                              "#include <stdbool.h>\n"
+                              "#include <stdio.h>\n"
+                              "#include <stdlib.h>\n"
+                              "\n"
+                              "#ifdef __linux__\n"
+                              "#include <linux/futex.h>\n"
+                              "#include <sys/syscall.h>\n"
+                              "#include <unistd.h>\n"
+                              "#endif\n"
+                              "\n"
+                              "#define $_MONITOR_INFLATED ((uintptr_t) 1)\n"
+                              "#define $_MONITOR_COUNT_UNIT ((uintptr_t) 2)\n"
+                              "#define $_MONITOR_COUNT_MASK ((uintptr_t) 0xFE)\n"
+                              "#define $_MONITOR_OWNER_SHIFT 8\n"
+                              "#define $_MONITOR_SPINS 64\n"
+                              "\n"
+                              "typedef struct {\n"
+                              "    atomic_int state; // 0: unlocked, 1: locked, 2: locked with sleeping threads\n"
+                              "    atomic_uintptr_t owner;\n"
+                              "    unsigned long count;\n"
+                              "} $_fat_lock;\n"
+                              "\n"
+                              "_Thread_local uintptr_t $_monitor_self = 0;\n"
+                              "static atomic_uintptr_t $_monitor_threads = 0;\n"
+                              "\n"
+                              "uintptr_t $_monitor_register(void) {\n"
+                              "    uintptr_t id = atomic_fetch_add_explicit(&$_monitor_threads, 1, memory_order_relaxed) + 1;\n"
+                              "    $_monitor_self = id << $_MONITOR_OWNER_SHIFT;\n"
+                              "    return $_monitor_self;\n"
+                              "}\n"
+                              "\n"
+                              "#ifdef __linux__\n"
+                              "void $_futex_wait(atomic_int *address, int value) {\n"
+                              "    syscall(SYS_futex, (int *) address, FUTEX_WAIT_PRIVATE, value, NULL, NULL, 0);\n"
+                              "}\n"
+                              "\n"
+                              "void $_futex_wake(atomic_int *address) {\n"
+                              "    syscall(SYS_futex, (int *) address, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);\n"
+                              "}\n"
+                              "#else\n"
+                              "void $_futex_wait(atomic_int *address, int value) {\n"
+                              "    (void) address;\n"
+                              "    (void) value;\n"
+                              "    sched_yield();\n"
+                              "}\n"
+                              "\n"
+                              "void $_futex_wake(atomic_int *address) {\n"
+                              "    (void) address;\n"
+                              "}\n"
+                              "#endif\n"
+                              "\n"
+                              "static void $_fat_enter($_fat_lock *lock, uintptr_t self) {\n"
+                              "    if (atomic_load_explicit(&lock->owner, memory_order_relaxed) == self) {\n"
+                              "        lock->count++;\n"
+                              "        return;\n"
+                              "    }\n"
+                              "    int state = 0;\n"
+                              "    if (!atomic_compare_exchange_strong_explicit(&lock->state, &state, 1,\n"
+                              "                                                 memory_order_acquire,\n"
+                              "                                                 memory_order_relaxed)) {\n"
+                              "        if (state != 2) {\n"
+                              "            state = atomic_exchange_explicit(&lock->state, 2, memory_order_acquire);\n"
+                              "        }\n"
+                              "        while (state != 0) {\n"
+                              "            $_futex_wait(&lock->state, 2);\n"
+                              "            state = atomic_exchange_explicit(&lock->state, 2, memory_order_acquire);\n"
+                              "        }\n"
+                              "    }\n"
+                              "    atomic_store_explicit(&lock->owner, self, memory_order_relaxed);\n"
+                              "}\n"
+                              "\n"
+                              "static void $_fat_exit($_fat_lock *lock, uintptr_t self) {\n"
+                              "    if (atomic_load_explicit(&lock->owner, memory_order_relaxed) != self) {\n"
+                              "        fprintf(stderr, \"Exception: Current thread is not the owner of the monitor\\n\");\n"
+                              "        exit(1);\n"
+                              "    }\n"
+                              "    if (lock->count > 0) {\n"
+                              "        lock->count--;\n"
+                              "        return;\n"
+                              "    }\n"
+                              "    atomic_store_explicit(&lock->owner, 0, memory_order_relaxed);\n"
+                              "    if (atomic_fetch_sub_explicit(&lock->state, 1, memory_order_release) != 1) {\n"
+                              "        atomic_store_explicit(&lock->state, 0, memory_order_release);\n"
+                              "        $_futex_wake(&lock->state);\n"
+                              "    }\n"
+                              "}\n"
+                              "\n"
+                              "// Replaces the thin lock held by the current thread with a fat lock, entered `count` more times\n"
+                              "static void $_monitor_inflate(__monitor *monitor, uintptr_t self, unsigned long count) {\n"
+                              "    $_fat_lock *lock = ($_fat_lock *) malloc(sizeof($_fat_lock));\n"
+                              "    atomic_init(&lock->state, 1);\n"
+                              "    atomic_init(&lock->owner, self);\n"
+                              "    lock->count = count;\n"
+                              "    atomic_store_explicit(&monitor->word, (uintptr_t) lock | $_MONITOR_INFLATED, memory_order_release);\n"
+                              "}\n"
+                              "\n"
+                              "void $_monitor_enter_slow(__monitor *monitor, uintptr_t self) {\n"
+                              "    int spins = 0;\n"
+                              "    while (1) {\n"
+                              "        uintptr_t word = atomic_load_explicit(&monitor->word, memory_order_acquire);\n"
+                              "        if (word & $_MONITOR_INFLATED) {\n"
+                              "            $_fat_enter(($_fat_lock *) (word & ~$_MONITOR_INFLATED), self);\n"
+                              "            return;\n"
+                              "        }\n"
+                              "        if (word == 0) {\n"
+                              "            if (atomic_compare_exchange_weak_explicit(&monitor->word, &word, self,\n"
+                              "                                                      memory_order_acquire,\n"
+                              "                                                      memory_order_relaxed)) {\n"
+                              "                if (spins > 0) {\n"
+                              "                    // The monitor is contended, the next threads sleep instead of spinning\n"
+                              "                    $_monitor_inflate(monitor, self, 0);\n"
+                              "                }\n"
+                              "                return;\n"
+                              "            }\n"
+                              "            continue;\n"
+                              "        }\n"
+                              "        if ((word & ~$_MONITOR_COUNT_MASK) == self) {\n"
+                              "            if ((word & $_MONITOR_COUNT_MASK) != $_MONITOR_COUNT_MASK) {\n"
+                              "                atomic_store_explicit(&monitor->word, word + $_MONITOR_COUNT_UNIT, memory_order_relaxed);\n"
+                              "            } else {\n"
+                              "                $_monitor_inflate(monitor, self, ($_MONITOR_COUNT_MASK >> 1) + 1);\n"
+                              "            }\n"
+                              "            return;\n"
+                              "        }\n"
+                              "        // Thin-locked by another thread, waits until it's released or inflated\n"
+                              "        if (++spins > $_MONITOR_SPINS) {\n"
+                              "            sched_yield();\n"
+                              "        }\n"
+                              "    }\n"
+                              "}\n"
+                              "\n"
+                              "void $_monitor_exit_slow(__monitor *monitor, uintptr_t self) {\n"
+                              "    uintptr_t word = atomic_load_explicit(&monitor->word, memory_order_relaxed);\n"
+                              "    if (word & $_MONITOR_INFLATED) {\n"
+                              "        $_fat_exit(($_fat_lock *) (word & ~$_MONITOR_INFLATED), self);\n"
+                              "        return;\n"
+                              "    }\n"
+                              "    if (self == 0 || (word & ~$_MONITOR_COUNT_MASK) != self) {\n"
+                              "        fprintf(stderr, \"Exception: Current thread is not the owner of the monitor\\n\");\n"
+                              "        exit(1);\n"
+                              "    }\n"
+                              "    atomic_store_explicit(&monitor->word, word - $_MONITOR_COUNT_UNIT, memory_order_relaxed);\n"
+                              "}\n"
+                              "\n"
+                              "typedef struct {\n"
+                              "    void *object;\n"
+                              "    void (*run)(void *);\n"
+                              "    pthread_mutex_t lock;\n"
+                              "    pthread_cond_t done;\n"
+                              "    bool finished;\n"
+                              "} $_thread;\n"
+                              "\n"
+                              "static void *$_thread_main(void *argument) {\n"
+                              "    $_thread *thread = ($_thread *) argument;\n"
+                              "    thread->run(thread->object);\n"
+                              "    pthread_mutex_lock(&thread->lock);\n"
+                              "    thread->finished = true;\n"
+                              "    pthread_cond_broadcast(&thread->done);\n"
+                              "    pthread_mutex_unlock(&thread->lock);\n"
+                              "    return NULL;\n"
+                              "}\n"
+                              "\n"
+                              "void $_thread_start(void **handle, void *object, void (*run)(void *)) {\n"
+                              "    if (*handle != NULL) {\n"
+                              "        fprintf(stderr, \"Exception: Thread is already started\\n\");\n"
+                              "        exit(1);\n"
+                              "    }\n"
+                              "    $_thread *thread = ($_thread *) malloc(sizeof($_thread));\n"
+                              "    thread->object = object;\n"
+                              "    thread->run = run;\n"
+                              "    pthread_mutex_init(&thread->lock, NULL);\n"
+                              "    pthread_cond_init(&thread->done, NULL);\n"
+                              "    thread->finished = false;\n"
+                              "    *handle = thread;\n"
+                              "\n"
+                              "    pthread_t id;\n"
+                              "    if (pthread_create(&id, NULL, $_thread_main, thread) != 0) {\n"
+                              "        fprintf(stderr, \"Exception: Failed to start thread\\n\");\n"
+                              "        exit(1);\n"
+                              "    }\n"
+                              "    pthread_detach(id);\n"
+                              "}\n"
+                              "\n"
+                              "void $_thread_join(void **handle) {\n"
+                              "    $_thread *thread = ($_thread *) *handle;\n"
+                              "    if (thread == NULL) return;\n"
+                              "    pthread_mutex_lock(&thread->lock);\n"
+                              "    while (!thread->finished) {\n"
+                              "        pthread_cond_wait(&thread->done, &thread->lock);\n"
+                              "    }\n"
+                              "    pthread_mutex_unlock(&thread->lock);\n"
+                              "}\n");
+}
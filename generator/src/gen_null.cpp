@@ -0,0 +1,256 @@
+#include "../internal/generator_internal.h"
+
+/// Faults below this address are dereferences of `null`, the first page is never mapped.
+const int NULL_GUARD_SIZE = 4096;
+
+/**
+ * @brief Checks if a member of an object of the given class may be beyond the guard page.
+ *
+ * The size of the struct is bounded by 8 bytes per field and method of the class and its superclasses,
+ * plus the header of the object at each level. Accessing a member of `null` faults at the offset of the
+ * member, only classes whose members may be past `NULL_GUARD_SIZE` need an explicit check.
+ *
+ * @param project The parsed project.
+ * @param type The class of the object.
+ * @return `true` if accessing a member of the object must check for `null` with `$_null_check`.
+ */
+bool needs_null_check(Project *project, const Identifier &type) {
+    Class *clazz = project->getClassByName(type);
+    if (!clazz || clazz->isInterface()) {
+        return false;
+    }
+    int size = 0;
+    while (clazz) {
+        size += 16 + 8 * (int) (clazz->getFields()->size() + clazz->getMethods()->size());
+        if (clazz->getExtends().empty()) {
+            break;
+        }
+        clazz = project->getClassByName(clazz->getExtends());
+    }
+    return size >= NULL_GUARD_SIZE;
+}
+
+/**
+ * @brief Writes the runtime reporting dereferences of `null` (`NullPointerException`).
+ *
+ * Fields, methods and array elements are accessed without comparing the object to `NULL`: a `null`
+ * object (the default value of fields, see `get_field_default_value`) faults on the first page, which is
+ * never mapped. `main` installs a `SIGSEGV` handler, a fault at an address below the guard page prints a
+ * `NullPointerException` and the MiniJava stack, then exits the program. Other faults (e.g., a stack
+ * overflow) crash the program as without the handler. The path that doesn't fault costs nothing.
+ *
+ * Every method is defined in the `minijava_methods` section (`$_method`), the handler maps the PC of the
+ * fault and the return addresses of the stack to the methods with a table of their addresses. A profile-guided
+ * build moves the hot and the cold methods to sections of their own (`$_method_hot`, `$_method_cold`), the
+ * linker groups each section across the files of the program:
+ *
+ * ```
+ * Exception: NullPointerException
+ *     at Node.sum (line 14)
+ *     at Main.main (line 3)
+ * ```
+ *
+ * Only the objects of classes too large for the guard page are compared explicitly before accessing their
+ * members (`$_null_check`, see `needs_null_check`).
+ *
+ * It writes two supporting files:
+ *
+ * - **`__null.h`**: Declares the sections of methods, the installation of the handler and the explicit check.
+ * - **`__null.c`**: Implements the handler and the table of methods.
+ *
+ * @param project The parsed project.
+ */
+void write_null_handler(Project *project) {
+    std::string includes;
+    std::string methods;
+    for (auto &clazz: *project->getClasses()) {
+        if (clazz.isInterface()) {
+            continue;
+        }
+        includes += "#include \"" + clazz.getName() + ".h\"\n";
+        for (auto &method: *clazz.getMethods()) {
+            std::string function = method.isMain() ? "main" : clazz.getName() + "_" + method.getName();
+            int line = clazz.isBuiltin() ? 0 : method.getLine();
+            methods += "        {(uintptr_t) " + function + ", \"" + clazz.getName() + "\", \"" +
+                       method.getName() + "\", " + std::to_string(line) + "},\n";
+        }
+    }
+    if (methods.empty()) {
+        methods = "        {0, \"\", \"\", 0},\n";
+    }
+
+    write_file("__null.h", "#ifndef __NULL_H\n"
+                           "#define __NULL_H\n"
+                           "\n"
+                           "#include <stddef.h>\n"
+                           "\n"
+                           "#define $_NULL_GUARD " + std::to_string(NULL_GUARD_SIZE) + "\n"
+                           "\n"
+                           "#if defined(__GNUC__) && defined(__ELF__)\n"
+                           "#define $_method __attribute__((section(\"minijava_methods\")))\n"
+                           "#define $_method_hot __attribute__((hot, section(\"minijava_methods_hot\")))\n"
+                           "#define $_method_cold __attribute__((cold, section(\"minijava_methods_cold\")))\n"
+                           "#else\n"
+                           "#define $_method\n"
+                           "#define $_method_hot\n"
+                           "#define $_method_cold\n"
+                           "#endif\n"
+                           "\n"
+                           "// Code after a label that never ran in the profile (a label attribute of GCC)\n"
+                           "#if defined(__GNUC__) && !defined(__clang__)\n"
+                           "#define $_cold_path __attribute__((cold))\n"
+                           "#else\n"
+                           "#define $_cold_path\n"
+                           "#endif\n"
+                           "\n"
+                           "void $_null_handler_install(void);\n"
+                           "\n"
+                           "void $_null_error(void);\n"
+                           "\n"
+                           "static inline void *$_null_check(void *object) {\n"
+                           "    if (__builtin_expect(object == NULL, 0)) {\n"
+                           "        $_null_error();\n"
+                           "    }\n"
+                           "    return object;\n"
+                           "}\n"
+                           "\n"
+                           "#endif //__NULL_H\n");
+
+    write_file("__null.c", "#define _GNU_SOURCE\n"
+                           "\n"
+                           "#include \"__null.h\"\n" +
+                           includes +
+                           "\n"
+                           "#include <execinfo.h>\n"
+                           "#include <signal.h>\n"
+                           "#include <stdint.h>\n"
+                           "#include <stdio.h>\n"
+                           "#include <stdlib.h>\n"
+                           "#include <string.h>\n"
+                           "#include <ucontext.h>\n"
+                           "#include <unistd.h>\n"
+                           "\n"
+                           "#define MAX_FRAMES 64\n"
+                           "\n"
+                           "typedef struct __method_info {\n"
+                           "    uintptr_t start;\n"
+                           "    const char *clazz;\n"
+                           "    const char *name;\n"
+                           "    int line;\n"
+                           "} __method_info;\n"
+                           "\n"
+                           "int main();\n"
+                           "\n"
+                           "static __method_info $_methods[] = {\n" +
+                           methods +
+                           "};\n"
+                           "\n"
+                           "#define METHOD_COUNT (sizeof($_methods) / sizeof($_methods[0]))\n"
+                           "\n"
+                           "extern const char __start_minijava_methods[] __attribute__((weak));\n"
+                           "extern const char __stop_minijava_methods[] __attribute__((weak));\n"
+                           "extern const char __start_minijava_methods_hot[] __attribute__((weak));\n"
+                           "extern const char __stop_minijava_methods_hot[] __attribute__((weak));\n"
+                           "extern const char __start_minijava_methods_cold[] __attribute__((weak));\n"
+                           "extern const char __stop_minijava_methods_cold[] __attribute__((weak));\n"
+                           "\n"
+                           "static int $_in_section(uintptr_t address, const char *start, const char *stop) {\n"
+                           "    return start && address >= (uintptr_t) start && address < (uintptr_t) stop;\n"
+                           "}\n"
+                           "\n"
+                           "static int $_method_compare(const void *a, const void *b) {\n"
+                           "    uintptr_t x = ((const __method_info *) a)->start;\n"
+                           "    uintptr_t y = ((const __method_info *) b)->start;\n"
+                           "    return x < y ? -1 : x > y;\n"
+                           "}\n"
+                           "\n"
+                           "// The method containing the address, methods are sorted and alone in their sections\n"
+                           "static const __method_info *$_method_at(uintptr_t address) {\n"
+                           "    if (!$_in_section(address, __start_minijava_methods, __stop_minijava_methods) &&\n"
+                           "        !$_in_section(address, __start_minijava_methods_hot, __stop_minijava_methods_hot) &&\n"
+                           "        !$_in_section(address, __start_minijava_methods_cold, __stop_minijava_methods_cold)) {\n"
+                           "        return NULL;\n"
+                           "    }\n"
+                           "    const __method_info *found = NULL;\n"
+                           "    for (size_t i = 0; i < METHOD_COUNT && $_methods[i].start <= address; i++) {\n"
+                           "        found = &$_methods[i];\n"
+                           "    }\n"
+                           "    return found;\n"
+                           "}\n"
+                           "\n"
+                           "static void $_print_frame(uintptr_t address) {\n"
+                           "    const __method_info *method = $_method_at(address);\n"
+                           "    if (method == NULL) {\n"
+                           "        return;\n"
+                           "    }\n"
+                           "    if (method->line > 0) {\n"
+                           "        fprintf(stderr, \"    at %s.%s (line %d)\\n\", method->clazz, method->name, method->line);\n"
+                           "    } else {\n"
+                           "        fprintf(stderr, \"    at %s.%s\\n\", method->clazz, method->name);\n"
+                           "    }\n"
+                           "}\n"
+                           "\n"
+                           "// Prints the methods of the stack, from the faulting PC (0 if unknown) to `main`\n"
+                           "static void $_print_stack(uintptr_t pc) {\n"
+                           "    fflush(stdout);\n"
+                           "    fprintf(stderr, \"Exception: NullPointerException\\n\");\n"
+                           "    void *frames[MAX_FRAMES];\n"
+                           "    int count = backtrace(frames, MAX_FRAMES);\n"
+                           "    int first = 0;\n"
+                           "    if (pc != 0) {\n"
+                           "        $_print_frame(pc);\n"
+                           "        // The frames of the handler come first, the stack of the program starts after the PC\n"
+                           "        first = count;\n"
+                           "        for (int i = 0; i < count; i++) {\n"
+                           "            if ((uintptr_t) frames[i] == pc) {\n"
+                           "                first = i + 1;\n"
+                           "                break;\n"
+                           "            }\n"
+                           "        }\n"
+                           "    }\n"
+                           "    for (int i = first; i < count; i++) {\n"
+                           "        // Return addresses point after the call\n"
+                           "        $_print_frame((uintptr_t) frames[i] - 1);\n"
+                           "    }\n"
+                           "}\n"
+                           "\n"
+                           "static uintptr_t $_fault_pc(void *context) {\n"
+                           "#if defined(__x86_64__)\n"
+                           "    return (uintptr_t) ((ucontext_t *) context)->uc_mcontext.gregs[REG_RIP];\n"
+                           "#elif defined(__aarch64__)\n"
+                           "    return (uintptr_t) ((ucontext_t *) context)->uc_mcontext.pc;\n"
+                           "#else\n"
+                           "    return 0;\n"
+                           "#endif\n"
+                           "}\n"
+                           "\n"
+                           "static void $_null_fault(int signal_, siginfo_t *info, void *context) {\n"
+                           "    if ((uintptr_t) info->si_addr >= $_NULL_GUARD) {\n"
+                           "        // Not a dereference of null, the fault happens again without the handler\n"
+                           "        signal(signal_, SIG_DFL);\n"
+                           "        return;\n"
+                           "    }\n"
+                           "    $_print_stack($_fault_pc(context));\n"
+                           "    _exit(1);\n"
+                           "}\n"
+                           "\n"
+                           "void $_null_handler_install(void) {\n"
+                           "    qsort($_methods, METHOD_COUNT, sizeof($_methods[0]), $_method_compare);\n"
+                           "    // Loads the unwinder now, it can't be loaded safely in the handler\n"
+                           "    void *frames[1];\n"
+                           "    backtrace(frames, 1);\n"
+                           "\n"
+                           "    struct sigaction action;\n"
+                           "    memset(&action, 0, sizeof(action));\n"
+                           "    action.sa_sigaction = $_null_fault;\n"
+                           "    action.sa_flags = SA_SIGINFO;\n"
+                           "    sigemptyset(&action.sa_mask);\n"
+                           "    sigaction(SIGSEGV, &action, NULL);\n"
+                           "    sigaction(SIGBUS, &action, NULL);\n"
+                           "}\n"
+                           "\n"
+                           "void $_null_error(void) {\n"
+                           "    $_print_stack(0);\n"
+                           "    exit(1);\n"
+                           "}\n");
+}
@@ -0,0 +1,195 @@
+#include "../internal/generator_internal.h"
+
+/**
+ * @brief Writes the runtime of `@Parallel` loops.
+ *
+ * The body of a parallel loop is outlined into a function running a chunk `[from, to)` of the iterations
+ * (see `generate(ForStatement*)`). `$_parallel_for` splits the iteration space into chunks and runs them on
+ * the threads:
+ *
+ * - **OpenMP**: If the program is compiled with OpenMP (`_OPENMP`), the chunks are distributed by an OpenMP
+ *   parallel for.
+ * - **Thread pool**: Otherwise, the chunks are claimed dynamically by a pool of pthreads, started the first time
+ *   a parallel loop runs. The calling thread takes part in running the chunks.
+ *
+ * The number of threads is the value of the `MINIJAVA_THREADS` environment variable, or the number of available
+ * processors. Loops started while the pool is busy (e.g., from another thread) run sequentially.
+ *
+ * Reductions are computed privately by each chunk and combined into the shared local at the end of the chunk
+ * with `$_parallel_reduce_add`, `$_parallel_reduce_min` or `$_parallel_reduce_max`.
+ *
+ * It writes two supporting files:
+ *
+ * - **`__parallel.h`**: Declares the runtime functions.
+ * - **`__parallel.c`**: Implements the OpenMP and the thread pool versions of `$_parallel_for`.
+ */
+void write_parallel() {
+    write_file("__parallel.h", "#ifndef __PARALLEL_H\n"
+                               "#define __PARALLEL_H\n"
+                               "\n"
+                               "#include <limits.h>\n"
+                               "\n"
+                               "typedef void (*$_parallel_body)(void *context, int from, int to);\n"
+                               "\n"
+                               "int $_parallel_threads(void);\n"
+                               "\n"
+                               "void $_parallel_for($_parallel_body body, void *context, int count);\n"
+                               "\n"
+                               "void $_parallel_reduce_add(int *target, int value);\n"
+                               "\n"
+                               "void $_parallel_reduce_min(int *target, int value);\n"
+                               "\n"
+                               "void $_parallel_reduce_max(int *target, int value);\n"
+                               "\n"
+                               "#endif //__PARALLEL_H\n");
+
+    write_file("__parallel.c", "#include \"__parallel.h\"\n"
+                               "\n"
+                               "#include <pthread.h>\n"
+                               "#include <stdlib.h>\n"
+                               "#include <unistd.h>\n"
+                               "\n"
+                               "#define $_PARALLEL_MAX_THREADS 256\n"
+                               "#define $_PARALLEL_CHUNKS_PER_THREAD 4\n"
+                               "\n"
+                               "static pthread_mutex_t $_parallel_reduce_lock = PTHREAD_MUTEX_INITIALIZER;\n"
+                               "\n"
+                               "// The count is computed once, threads racing on the first call store the same value\n"
+                               "int $_parallel_threads(void) {\n"
+                               "    static int cached = 0;\n"
+                               "    int threads = __atomic_load_n(&cached, __ATOMIC_RELAXED);\n"
+                               "    if (threads == 0) {\n"
+                               "        const char *env = getenv(\"MINIJAVA_THREADS\");\n"
+                               "        int count = env ? atoi(env) : 0;\n"
+                               "        if (count <= 0) {\n"
+                               "            long processors = sysconf(_SC_NPROCESSORS_ONLN);\n"
+                               "            count = processors > 0 ? (int) processors : 1;\n"
+                               "        }\n"
+                               "        threads = count > $_PARALLEL_MAX_THREADS ? $_PARALLEL_MAX_THREADS : count;\n"
+                               "        __atomic_store_n(&cached, threads, __ATOMIC_RELAXED);\n"
+                               "    }\n"
+                               "    return threads;\n"
+                               "}\n"
+                               "\n"
+                               "static int $_parallel_chunk_start(int count, int chunks, int chunk) {\n"
+                               "    return (int) ((long long) count * chunk / chunks);\n"
+                               "}\n"
+                               "\n"
+                               "#ifdef _OPENMP\n"
+                               "#include <omp.h>\n"
+                               "\n"
+                               "void $_parallel_for($_parallel_body body, void *context, int count) {\n"
+                               "    int threads = $_parallel_threads();\n"
+                               "    if (count <= 0) return;\n"
+                               "    if (threads == 1 || count == 1 || omp_in_parallel()) {\n"
+                               "        body(context, 0, count);\n"
+                               "        return;\n"
+                               "    }\n"
+                               "    int chunks = count < threads ? count : threads;\n"
+                               "    #pragma omp parallel for num_threads(threads) schedule(static)\n"
+                               "    for (int chunk = 0; chunk < chunks; chunk++) {\n"
+                               "        body(context, $_parallel_chunk_start(count, chunks, chunk),\n"
+                               "             $_parallel_chunk_start(count, chunks, chunk + 1));\n"
+                               "    }\n"
+                               "}\n"
+                               "#else\n"
+                               "static struct {\n"
+                               "    pthread_mutex_t busy;\n"
+                               "    pthread_mutex_t lock;\n"
+                               "    pthread_cond_t start;\n"
+                               "    pthread_cond_t done;\n"
+                               "    int workers;\n"
+                               "    unsigned long generation;\n"
+                               "    $_parallel_body body;\n"
+                               "    void *context;\n"
+                               "    int count;\n"
+                               "    int chunks;\n"
+                               "    int next;\n"
+                               "    int pending;\n"
+                               "} $_pool = {PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER,\n"
+                               "            PTHREAD_COND_INITIALIZER, PTHREAD_COND_INITIALIZER,\n"
+                               "            0, 0, NULL, NULL, 0, 0, 0, 0};\n"
+                               "\n"
+                               "// Runs the chunks of the current loop until none is left, called with the lock held\n"
+                               "static void $_pool_run_chunks(void) {\n"
+                               "    while ($_pool.next < $_pool.chunks) {\n"
+                               "        int chunk = $_pool.next++;\n"
+                               "        $_parallel_body body = $_pool.body;\n"
+                               "        void *context = $_pool.context;\n"
+                               "        int from = $_parallel_chunk_start($_pool.count, $_pool.chunks, chunk);\n"
+                               "        int to = $_parallel_chunk_start($_pool.count, $_pool.chunks, chunk + 1);\n"
+                               "        pthread_mutex_unlock(&$_pool.lock);\n"
+                               "        body(context, from, to);\n"
+                               "        pthread_mutex_lock(&$_pool.lock);\n"
+                               "        if (--$_pool.pending == 0) {\n"
+                               "            pthread_cond_broadcast(&$_pool.done);\n"
+                               "        }\n"
+                               "    }\n"
+                               "}\n"
+                               "\n"
+                               "static void *$_pool_worker(void *argument) {\n"
+                               "    (void) argument;\n"
+                               "    unsigned long seen = 0;\n"
+                               "    pthread_mutex_lock(&$_pool.lock);\n"
+                               "    while (1) {\n"
+                               "        while ($_pool.generation == seen) {\n"
+                               "            pthread_cond_wait(&$_pool.start, &$_pool.lock);\n"
+                               "        }\n"
+                               "        seen = $_pool.generation;\n"
+                               "        $_pool_run_chunks();\n"
+                               "    }\n"
+                               "    return NULL;\n"
+                               "}\n"
+                               "\n"
+                               "void $_parallel_for($_parallel_body body, void *context, int count) {\n"
+                               "    int threads = $_parallel_threads();\n"
+                               "    if (count <= 0) return;\n"
+                               "    if (threads == 1 || count == 1 || pthread_mutex_trylock(&$_pool.busy) != 0) {\n"
+                               "        body(context, 0, count);\n"
+                               "        return;\n"
+                               "    }\n"
+                               "\n"
+                               "    pthread_mutex_lock(&$_pool.lock);\n"
+                               "    while ($_pool.workers < threads - 1) {\n"
+                               "        pthread_t thread;\n"
+                               "        if (pthread_create(&thread, NULL, $_pool_worker, NULL) != 0) break;\n"
+                               "        pthread_detach(thread);\n"
+                               "        $_pool.workers++;\n"
+                               "    }\n"
+                               "    int chunks = threads * $_PARALLEL_CHUNKS_PER_THREAD;\n"
+                               "    $_pool.body = body;\n"
+                               "    $_pool.context = context;\n"
+                               "    $_pool.count = count;\n"
+                               "    $_pool.chunks = count < chunks ? count : chunks;\n"
+                               "    $_pool.next = 0;\n"
+                               "    $_pool.pending = $_pool.chunks;\n"
+                               "    $_pool.generation++;\n"
+                               "    pthread_cond_broadcast(&$_pool.start);\n"
+                               "\n"
+                               "    $_pool_run_chunks();\n"
+                               "    while ($_pool.pending > 0) {\n"
+                               "        pthread_cond_wait(&$_pool.done, &$_pool.lock);\n"
+                               "    }\n"
+                               "    pthread_mutex_unlock(&$_pool.lock);\n"
+                               "    pthread_mutex_unlock(&$_pool.busy);\n"
+                               "}\n"
+                               "#endif\n"
+                               "\n"
+                               "void $_parallel_reduce_add(int *target, int value) {\n"
+                               "    pthread_mutex_lock(&$_parallel_reduce_lock);\n"
+                               "    *target = (int) ((unsigned int) *target + (unsigned int) value);\n"
+                               "    pthread_mutex_unlock(&$_parallel_reduce_lock);\n"
+                               "}\n"
+                               "\n"
+                               "void $_parallel_reduce_min(int *target, int value) {\n"
+                               "    pthread_mutex_lock(&$_parallel_reduce_lock);\n"
+                               "    if (value < *target) *target = value;\n"
+                               "    pthread_mutex_unlock(&$_parallel_reduce_lock);\n"
+                               "}\n"
+                               "\n"
+                               "void $_parallel_reduce_max(int *target, int value) {\n"
+                               "    pthread_mutex_lock(&$_parallel_reduce_lock);\n"
+                               "    if (value > *target) *target = value;\n"
+                               "    pthread_mutex_unlock(&$_parallel_reduce_lock);\n"
+                               "}\n");
+}
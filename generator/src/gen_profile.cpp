@@ -0,0 +1,396 @@
+#include "../internal/generator_internal.h"
+#include <fstream>
+#include <iterator>
+
+/**
+ * @brief Generates the counters of a class of an instrumented build and the table describing them.
+ *
+ * The counters are incremented by the methods (`$_profile_count`), the table maps every counter back to its
+ * method, kind and line. The table is registered before `main` runs, the profile is written when the program
+ * exits (see `write_profile`).
+ *
+ * Example Output:
+ * ```c
+ * #include "__profile.h"
+ *
+ * static uint64_t $_profile_counters[4];
+ *
+ * static const __profile_site $_profile_sites[] = {
+ *     {"sort", $_PROFILE_ENTRY, "", 92, 0},
+ *     {"sort", $_PROFILE_BRANCH, "if", 93, 1},
+ *     {"sort", $_PROFILE_CALL, "MergeSort.merge", 110, 3},
+ * };
+ *
+ * static __profile_table $_profile_table = {"MergeSort", 3, $_profile_sites, 4, $_profile_counters, NULL};
+ *
+ * __attribute__((constructor)) static void $_profile_init(void) {
+ *     $_profile_register(&$_profile_table);
+ * }
+ * ```
+ *
+ * @param clazz The class of the counters.
+ * @param profile The sites counted by its methods.
+ * @return The C source, inserted before the methods of the class.
+ */
+std::string generate_profile_table(Class *clazz, const ProfileSites &profile) {
+    std::string sites;
+    for (auto &site: profile.sites) {
+        std::string kind = std::string(site.kind) == "entry" ? "$_PROFILE_ENTRY" :
+                           std::string(site.kind) == "branch" ? "$_PROFILE_BRANCH" :
+                           std::string(site.kind) == "call" ? "$_PROFILE_CALL" : "$_PROFILE_RECEIVER";
+        sites += "\t{" + get_c_string_literal(site.method) + ", " + kind + ", " +
+                 get_c_string_literal(site.detail) + ", " + std::to_string(site.line) + ", " +
+                 std::to_string(site.counter) + "},\n";
+    }
+    std::string counters = std::to_string(profile.counters);
+    return "#include \"__profile.h\"\n\n"
+           "static uint64_t $_profile_counters[" + counters + "];\n\n"
+           "static const __profile_site $_profile_sites[] = {\n" + sites + "};\n\n"
+           "static __profile_table $_profile_table = {" + get_c_string_literal(clazz->getName()) + ", " +
+           std::to_string(profile.sites.size()) + ", $_profile_sites, " + counters + ", $_profile_counters, NULL};\n\n"
+           "// A reloaded class counts into its own copy of the counters, they are not written\n"
+           "#ifndef MINIJAVA_RELOAD_MODULE\n"
+           "__attribute__((constructor)) static void $_profile_init(void) {\n"
+           "\t$_profile_register(&$_profile_table);\n"
+           "}\n"
+           "#endif\n\n";
+}
+
+/**
+ * @brief Writes the runtime of an instrumented build (`--instrument`).
+ *
+ * Every method of an instrumented program counts:
+ * - **entry**: the calls of the method (for a `@Memoize` method, the runs of its body on misses of the cache).
+ * - **branch**: the taken and fall-through edges of every conditional jump of `if`, `while`, `for`, `do` and
+ *   `?:`, so the trip counts of the loops and the probabilities of the branches are known.
+ * - **call**: the calls made at every call site of a Mini-Java method.
+ * - **receiver**: the calls of every call site dispatched through `$_function_` or an itable, by class of the
+ *   receiver. A site has a counter per class its receiver may be of, indexed by the class id in the header of
+ *   the receiver (see `write_class_table`).
+ *
+ * A counter is incremented by a relaxed atomic load and store: no lock prefix and no ordering, the program runs
+ * about 1.5 times slower (a locked add is closer to 10 times on tight loops). Threads incrementing the same
+ * counter at the same time may lose counts, compiling with `-DMINIJAVA_PROFILE_EXACT` makes the increment a
+ * relaxed atomic add that loses none.
+ *
+ * When the program exits, it writes its profile to the path in the environment variable `MINIJAVA_PROFILE`
+ * (`minijava.profile` by default) and a text report next to it (`minijava.profile.txt`):
+ * ```
+ * Methods (calls):
+ *        1023  MergeSort.sort (line 92)
+ * Branches (taken / fall-through):
+ *   MergeSort.sort:93    if     512 / 511 (50.0% taken)
+ * Call sites (calls):
+ *        1022  MergeSort.sort:100 -> MergeSort.sort
+ * Receivers (calls):
+ *        1022  MergeSort.sort:100  MergeSort
+ * ```
+ *
+ * The binary profile is compact, integers are unsigned LEB128 varints and strings are a varint length and
+ * their bytes:
+ * ```
+ * "MJPROF" 0 1                 // magic and version
+ * varint tables
+ *   string class, varint sites
+ *     string method, byte kind (0 entry, 1 branch, 2 call, 3 receiver), string detail, varint line
+ *     varint count             // a branch has two: taken, then fall-through
+ * ```
+ *
+ * It writes two supporting files:
+ *
+ * - **`__profile.h`**: Declares the tables of counters and `$_profile_count`.
+ * - **`__profile.c`**: Registers the tables and writes the profile at exit.
+ */
+void write_profile() {
+    write_file("__profile.h", "#ifndef __PROFILE_H\n"
+                              "#define __PROFILE_H\n"
+                              "\n"
+                              "#include <stdint.h>\n"
+                              "#include <stddef.h>\n"
+                              "\n"
+                              "#define $_PROFILE_ENTRY 0\n"
+                              "#define $_PROFILE_BRANCH 1\n"
+                              "#define $_PROFILE_CALL 2\n"
+                              "#define $_PROFILE_RECEIVER 3\n"
+                              "\n"
+                              "#ifdef MINIJAVA_PROFILE_EXACT\n"
+                              "#define $_profile_count(counter) __atomic_fetch_add(&(counter), 1, __ATOMIC_RELAXED)\n"
+                              "#else\n"
+                              "#define $_profile_count(counter) \\\n"
+                              "    __atomic_store_n(&(counter), __atomic_load_n(&(counter), __ATOMIC_RELAXED) + 1, __ATOMIC_RELAXED)\n"
+                              "#endif\n"
+                              "\n"
+                              "typedef struct {\n"
+                              "    const char *method;\n"
+                              "    int kind;\n"
+                              "    const char *detail;\n"
+                              "    int line;\n"
+                              "    int counter;\n"
+                              "} __profile_site;\n"
+                              "\n"
+                              "typedef struct __profile_table {\n"
+                              "    const char *clazz;\n"
+                              "    size_t siteCount;\n"
+                              "    const __profile_site *sites;\n"
+                              "    size_t counterCount;\n"
+                              "    uint64_t *counters;\n"
+                              "    struct __profile_table *next;\n"
+                              "} __profile_table;\n"
+                              "\n"
+                              "void $_profile_register(__profile_table *table);\n"
+                              "\n"
+                              "#endif //__PROFILE_H\n");
+
+    write_file("__profile.c", "#include \"__profile.h\"\n"
+                              "\n"
+                              "#include <stdio.h>\n"
+                              "#include <stdlib.h>\n"
+                              "#include <string.h>\n"
+                              "\n"
+                              "// Registered by the constructors of the classes, before `main` runs\n"
+                              "static __profile_table *$_profile_tables = NULL;\n"
+                              "\n"
+                              "typedef struct {\n"
+                              "    const __profile_table *table;\n"
+                              "    const __profile_site *site;\n"
+                              "    uint64_t count;\n"
+                              "} __profile_entry;\n"
+                              "\n"
+                              "static void $_profile_write_varint(FILE *file, uint64_t value) {\n"
+                              "    while (value >= 0x80) {\n"
+                              "        fputc((int) (value & 0x7F) | 0x80, file);\n"
+                              "        value >>= 7;\n"
+                              "    }\n"
+                              "    fputc((int) value, file);\n"
+                              "}\n"
+                              "\n"
+                              "static void $_profile_write_string(FILE *file, const char *text) {\n"
+                              "    size_t length = strlen(text);\n"
+                              "    $_profile_write_varint(file, length);\n"
+                              "    fwrite(text, 1, length, file);\n"
+                              "}\n"
+                              "\n"
+                              "static void $_profile_write_binary(const char *path) {\n"
+                              "    FILE *file = fopen(path, \"wb\");\n"
+                              "    if (file == NULL) {\n"
+                              "        fprintf(stderr, \"Error: Unable to write the profile '%s'\\n\", path);\n"
+                              "        return;\n"
+                              "    }\n"
+                              "    fwrite(\"MJPROF\\0\\1\", 1, 8, file);\n"
+                              "    size_t tables = 0;\n"
+                              "    for (__profile_table *table = $_profile_tables; table != NULL; table = table->next) {\n"
+                              "        tables++;\n"
+                              "    }\n"
+                              "    $_profile_write_varint(file, tables);\n"
+                              "    for (__profile_table *table = $_profile_tables; table != NULL; table = table->next) {\n"
+                              "        $_profile_write_string(file, table->clazz);\n"
+                              "        $_profile_write_varint(file, table->siteCount);\n"
+                              "        for (size_t i = 0; i < table->siteCount; i++) {\n"
+                              "            const __profile_site *site = &table->sites[i];\n"
+                              "            $_profile_write_string(file, site->method);\n"
+                              "            fputc(site->kind, file);\n"
+                              "            $_profile_write_string(file, site->detail);\n"
+                              "            $_profile_write_varint(file, (uint64_t) site->line);\n"
+                              "            $_profile_write_varint(file, table->counters[site->counter]);\n"
+                              "            if (site->kind == $_PROFILE_BRANCH) {\n"
+                              "                $_profile_write_varint(file, table->counters[site->counter + 1]);\n"
+                              "            }\n"
+                              "        }\n"
+                              "    }\n"
+                              "    fclose(file);\n"
+                              "}\n"
+                              "\n"
+                              "static int $_profile_compare(const void *a, const void *b) {\n"
+                              "    uint64_t left = ((const __profile_entry *) a)->count;\n"
+                              "    uint64_t right = ((const __profile_entry *) b)->count;\n"
+                              "    return left < right ? 1 : left > right ? -1 : 0;\n"
+                              "}\n"
+                              "\n"
+                              "// The sites of a kind, the most frequent first\n"
+                              "static size_t $_profile_collect(int kind, __profile_entry *entries) {\n"
+                              "    size_t count = 0;\n"
+                              "    for (__profile_table *table = $_profile_tables; table != NULL; table = table->next) {\n"
+                              "        for (size_t i = 0; i < table->siteCount; i++) {\n"
+                              "            const __profile_site *site = &table->sites[i];\n"
+                              "            if (site->kind == kind) {\n"
+                              "                entries[count].table = table;\n"
+                              "                entries[count].site = site;\n"
+                              "                entries[count].count = table->counters[site->counter];\n"
+                              "                count++;\n"
+                              "            }\n"
+                              "        }\n"
+                              "    }\n"
+                              "    qsort(entries, count, sizeof(__profile_entry), $_profile_compare);\n"
+                              "    return count;\n"
+                              "}\n"
+                              "\n"
+                              "static void $_profile_write_report(const char *path) {\n"
+                              "    FILE *file = fopen(path, \"w\");\n"
+                              "    if (file == NULL) {\n"
+                              "        fprintf(stderr, \"Error: Unable to write the profile report '%s'\\n\", path);\n"
+                              "        return;\n"
+                              "    }\n"
+                              "    size_t sites = 0;\n"
+                              "    for (__profile_table *table = $_profile_tables; table != NULL; table = table->next) {\n"
+                              "        sites += table->siteCount;\n"
+                              "    }\n"
+                              "    __profile_entry *entries = (__profile_entry *) malloc(sizeof(__profile_entry) * (sites + 1));\n"
+                              "    if (entries == NULL) {\n"
+                              "        fclose(file);\n"
+                              "        return;\n"
+                              "    }\n"
+                              "\n"
+                              "    fprintf(file, \"Methods (calls):\\n\");\n"
+                              "    size_t count = $_profile_collect($_PROFILE_ENTRY, entries);\n"
+                              "    for (size_t i = 0; i < count; i++) {\n"
+                              "        fprintf(file, \"%12llu  %s.%s (line %d)\\n\", (unsigned long long) entries[i].count,\n"
+                              "                entries[i].table->clazz, entries[i].site->method, entries[i].site->line);\n"
+                              "    }\n"
+                              "\n"
+                              "    fprintf(file, \"Branches (taken / fall-through):\\n\");\n"
+                              "    for (__profile_table *table = $_profile_tables; table != NULL; table = table->next) {\n"
+                              "        for (size_t i = 0; i < table->siteCount; i++) {\n"
+                              "            const __profile_site *site = &table->sites[i];\n"
+                              "            if (site->kind != $_PROFILE_BRANCH) {\n"
+                              "                continue;\n"
+                              "            }\n"
+                              "            uint64_t taken = table->counters[site->counter];\n"
+                              "            uint64_t fallThrough = table->counters[site->counter + 1];\n"
+                              "            uint64_t total = taken + fallThrough;\n"
+                              "            fprintf(file, \"  %s.%s:%d  %-6s %llu / %llu (%.1f%% taken)\\n\", table->clazz, site->method,\n"
+                              "                    site->line, site->detail, (unsigned long long) taken, (unsigned long long) fallThrough,\n"
+                              "                    total ? 100.0 * (double) taken / (double) total : 0.0);\n"
+                              "        }\n"
+                              "    }\n"
+                              "\n"
+                              "    fprintf(file, \"Call sites (calls):\\n\");\n"
+                              "    count = $_profile_collect($_PROFILE_CALL, entries);\n"
+                              "    for (size_t i = 0; i < count; i++) {\n"
+                              "        fprintf(file, \"%12llu  %s.%s:%d -> %s\\n\", (unsigned long long) entries[i].count,\n"
+                              "                entries[i].table->clazz, entries[i].site->method, entries[i].site->line,\n"
+                              "                entries[i].site->detail);\n"
+                              "    }\n"
+                              "\n"
+                              "    fprintf(file, \"Receivers (calls):\\n\");\n"
+                              "    count = $_profile_collect($_PROFILE_RECEIVER, entries);\n"
+                              "    for (size_t i = 0; i < count && entries[i].count > 0; i++) {\n"
+                              "        fprintf(file, \"%12llu  %s.%s:%d  %s\\n\", (unsigned long long) entries[i].count,\n"
+                              "                entries[i].table->clazz, entries[i].site->method, entries[i].site->line,\n"
+                              "                entries[i].site->detail);\n"
+                              "    }\n"
+                              "    free(entries);\n"
+                              "    fclose(file);\n"
+                              "}\n"
+                              "\n"
+                              "static void $_profile_write(void) {\n"
+                              "    const char *path = getenv(\"MINIJAVA_PROFILE\");\n"
+                              "    if (path == NULL || path[0] == '\\0') {\n"
+                              "        path = \"minijava.profile\";\n"
+                              "    }\n"
+                              "    $_profile_write_binary(path);\n"
+                              "    char *report = (char *) malloc(strlen(path) + 5);\n"
+                              "    if (report != NULL) {\n"
+                              "        strcpy(report, path);\n"
+                              "        strcat(report, \".txt\");\n"
+                              "        $_profile_write_report(report);\n"
+                              "        free(report);\n"
+                              "    }\n"
+                              "}\n"
+                              "\n"
+                              "void $_profile_register(__profile_table *table) {\n"
+                              "    if ($_profile_tables == NULL) {\n"
+                              "        atexit($_profile_write);\n"
+                              "    }\n"
+                              "    table->next = $_profile_tables;\n"
+                              "    $_profile_tables = table;\n"
+                              "}\n");
+}
+
+/**
+ * @brief Reads the profile written by a run of an instrumented build (see `write_profile`).
+ *
+ * A profile of another version of the program still reads, the generator ignores the sites that moved (see
+ * `MethodProfile`).
+ *
+ * @param path The binary profile (e.g., `minijava.profile`).
+ * @return The counts of the methods, their branches and their call sites.
+ */
+Profile read_profile(const std::string &path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        error("Unable to read the profile '" + path + "'.");
+    }
+    std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    size_t position = 0;
+
+    auto readVarint = [&]() {
+        uint64_t value = 0;
+        for (int shift = 0;; shift += 7) {
+            if (position >= data.size() || shift > 63) {
+                error("The profile '" + path + "' is truncated.");
+            }
+            auto byte = (unsigned char) data[position++];
+            value |= (uint64_t) (byte & 0x7F) << shift;
+            if (!(byte & 0x80)) {
+                return value;
+            }
+        }
+    };
+    auto readString = [&]() {
+        uint64_t length = readVarint();
+        if (length > data.size() - position) {
+            error("The profile '" + path + "' is truncated.");
+        }
+        std::string text = data.substr(position, length);
+        position += length;
+        return text;
+    };
+
+    if (data.compare(0, 8, std::string("MJPROF\0\1", 8)) != 0) {
+        error("'" + path + "' is not a profile of this compiler, run a build generated with --instrument.");
+    }
+    position = 8;
+
+    Profile profile;
+    for (uint64_t tables = readVarint(); tables > 0; tables--) {
+        auto &methods = profile.classes[readString()];
+        std::map<Identifier, size_t> branches, calls;
+        for (uint64_t sites = readVarint(); sites > 0; sites--) {
+            std::string method = readString();
+            if (position >= data.size()) {
+                error("The profile '" + path + "' is truncated.");
+            }
+            int kind = data[position++];
+            std::string detail = readString();
+            int line = (int) readVarint();
+            uint64_t count = readVarint();
+
+            MethodProfile &counts = methods[method];
+            if (kind == 0) {
+                counts.entries += count;
+                profile.entries += count;
+            } else if (kind == 1) {
+                uint64_t fallthrough = readVarint();
+                size_t index = branches[method]++;
+                if (index == counts.branches.size()) {
+                    counts.branches.push_back({line, 0, 0});
+                }
+                counts.branches[index].taken += count;
+                counts.branches[index].fallthrough += fallthrough;
+            } else if (kind == 3) {
+                // The receivers of the call site read last
+                if (!counts.calls.empty() && calls[method] > 0) {
+                    counts.calls[calls[method] - 1].receivers[detail] += count;
+                }
+            } else {
+                size_t index = calls[method]++;
+                if (index == counts.calls.size()) {
+                    counts.calls.push_back({line, 0});
+                }
+                counts.calls[index].calls += count;
+                profile.calls += count;
+            }
+        }
+    }
+    return profile;
+}
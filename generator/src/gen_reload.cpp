@@ -0,0 +1,559 @@
+#include "../internal/generator_internal.h"
+
+/**
+ * @brief Returns whether the class can be reloaded into a running program (see `write_reload`).
+ *
+ * Interfaces have no code and built-in classes can't be edited.
+ */
+bool is_reloadable(Class *clazz) {
+    return !clazz->isInterface() && !clazz->isBuiltin();
+}
+
+/**
+ * @brief Returns the redirection of a static method to its last reloaded implementation.
+ *
+ * Example:
+ * - `paths` in class `Grid` → `$_reload_Grid_paths`
+ */
+std::string get_reload_redirect_name(Class *clazz, Method *method) {
+    return "$_reload_" + clazz->getName() + "_" + method->getName();
+}
+
+/**
+ * @brief Computes the layout of the program, a hash of everything but the bodies of the methods.
+ *
+ * A reloaded class must be compiled from a program with the same classes, fields and signatures as the
+ * running one, its objects and the code calling it are not rebuilt.
+ *
+ * @param project The parsed project.
+ * @return The FNV-1a hash of the declarations of the program.
+ */
+unsigned long long get_program_layout(Project *project) {
+    std::string layout;
+    for (auto &clazz: *project->getClasses()) {
+        layout += (clazz.isInterface() ? "interface " : "class ") + clazz.getName() + ":" + clazz.getExtends();
+        for (auto &interface: *clazz.getInterfaces()) {
+            layout += "," + interface;
+        }
+        layout += "{";
+        for (auto &field: *clazz.getFields()) {
+            layout += std::string(field.isStatic() ? "static " : "") + field.getTypeLexeme() + " " +
+                      field.getName() + ";";
+        }
+        for (auto &method: *clazz.getMethods()) {
+            layout += std::string(method.isStatic() ? "static " : "") + method.getReturnTypeLexeme() + " " +
+                      method.getName() + "(";
+            for (auto &param: *method.getParams()) {
+                layout += param.getTypeLexeme() + ",";
+            }
+            layout += ");";
+        }
+        layout += "}";
+    }
+
+    unsigned long long hash = 0xCBF29CE484222325ULL;
+    for (unsigned char c: layout) {
+        hash = (hash ^ c) * 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+/**
+ * @brief Generates the redirections of the static methods of a class, defined by the running program.
+ *
+ * Example Output:
+ * ```c
+ * #ifdef MINIJAVA_RELOAD_HOST
+ * void *$_reload_Grid_paths;
+ * #endif
+ * ```
+ *
+ * @param clazz The class.
+ * @return The C definitions, or an empty string if the class has no static methods to redirect.
+ */
+std::string generate_reload_redirects(Class *clazz) {
+    std::string redirects;
+    for (auto &method: *clazz->getMethods()) {
+        if (method.isStatic() && !method.isMain()) {
+            redirects += "void *" + get_reload_redirect_name(clazz, &method) + ";\n";
+        }
+    }
+    if (redirects.empty() || !is_reloadable(clazz)) {
+        return "";
+    }
+    return "#ifdef MINIJAVA_RELOAD_HOST\n" + redirects + "#endif\n\n";
+}
+
+/**
+ * @brief Generates the start of a static method of the running program, calling the reloaded method instead.
+ *
+ * Virtual methods are rebound in the objects, static methods are called directly, so the implementation
+ * of the running program forwards to the last reloaded one.
+ *
+ * Example Output:
+ * ```c
+ * #ifdef MINIJAVA_RELOAD_HOST
+ *     void *$_reloaded = __atomic_load_n(&$_reload_Grid_paths, __ATOMIC_ACQUIRE);
+ *     if ($_reloaded) return ((__typeof__(&Grid_paths)) $_reloaded)(r, c);
+ * #endif
+ * ```
+ *
+ * @param clazz The class declaring the method.
+ * @param method The method.
+ * @return The C statements, or an empty string if the method is not static.
+ */
+std::string generate_reload_redirect(Class *clazz, Method *method) {
+    if (!method->isStatic() || method->isMain() || !is_reloadable(clazz)) {
+        return "";
+    }
+    std::string arguments;
+    for (auto &param: *method->getParams()) {
+        arguments += std::string(arguments.empty() ? "" : ", ") + param.getName();
+    }
+    std::string call = "((__typeof__(&" + clazz->getName() + "_" + method->getName() + ")) $_reloaded)(" +
+                       arguments + ")";
+    return "#ifdef MINIJAVA_RELOAD_HOST\n"
+           "\tvoid *$_reloaded = __atomic_load_n(&" + get_reload_redirect_name(clazz, method) +
+           ", __ATOMIC_ACQUIRE);\n" +
+           (method->getReturnType() == MiniJavaType::MiniJavaType_VOID
+            ? "\tif ($_reloaded) {\n\t\t" + call + ";\n\t\treturn;\n\t}\n"
+            : "\tif ($_reloaded) return " + call + ";\n") +
+           "#endif\n";
+}
+
+/**
+ * @brief Generates the description of a class exported by its shared object.
+ *
+ * Example Output:
+ * ```c
+ * #ifdef MINIJAVA_RELOAD_MODULE
+ * const __reload_module $_reload_module = {
+ *     "Fib",
+ *     $_RELOAD_LAYOUT,
+ *     2,
+ *     (void *const []) {(void *) Fib_fib, (void *) Fib_even},
+ * };
+ * #endif
+ * ```
+ *
+ * @param clazz The class.
+ * @return The C definition, or an empty string if the class can't be reloaded.
+ */
+std::string generate_reload_module(Class *clazz) {
+    if (!is_reloadable(clazz)) {
+        return "";
+    }
+    std::string methods;
+    int count = 0;
+    for (auto &method: *clazz->getMethods()) {
+        if (method.isMain()) continue;
+        methods += std::string(methods.empty() ? "" : ", ") + "(void *) " + clazz->getName() + "_" +
+                   method.getName();
+        count++;
+    }
+    return "#ifdef MINIJAVA_RELOAD_MODULE\n"
+           "const __reload_module $_reload_module = {\n"
+           "\t\"" + clazz->getName() + "\",\n"
+           "\t$_RELOAD_LAYOUT,\n"
+           "\t" + std::to_string(count) + ",\n" +
+           (count ? "\t(void *const []) {" + methods + "},\n" : "\tNULL,\n") +
+           "};\n"
+           "#endif\n";
+}
+
+/**
+ * @brief Collects the offsets of the method pointers of an object, in its class and its superclasses.
+ */
+void get_reload_slots(Project *project, Class *clazz, const std::string &starter, std::vector<std::string> &slots) {
+    for (auto &method: *clazz->getMethods()) {
+        if (!method.isStatic()) {
+            slots.push_back(starter + "$_function_" + method.getName());
+        }
+    }
+    if (!clazz->getExtends().empty()) {
+        get_reload_slots(project, project->getClassByName(clazz->getExtends()), starter + "super.", slots);
+    }
+}
+
+/**
+ * @brief Writes the runtime reloading edited classes into the running program.
+ *
+ * In the development build (`cmake -DMINIJAVA_HOT_RELOAD=ON`, see `write_cmake`), every class is also compiled
+ * into its own shared object, `reload/Fib.so` in the build directory. The program polls that directory and
+ * loads the shared objects rebuilt while it runs (`cmake --build build --target Fib`), the edited methods run
+ * within a fraction of a second of the build:
+ *
+ * - **Objects**: The program tracks its objects, the method pointers of the live objects of every class are
+ *   rebound from the old implementations to the reloaded ones (inherited methods included), as are the
+ *   itables of interfaces. Objects created later are rebound when they are tracked.
+ * - **Static methods**: They are called directly, the implementation of the running program forwards to the
+ *   reloaded one (see `generate_reload_redirect`).
+ * - **State**: The shared object uses the static fields and monitors of the running program, only its caches
+ *   of `@Memoize` methods start empty.
+ *
+ * A class is only reloaded if the program it was compiled from has the same layout: the same classes, fields
+ * and method signatures (see `get_program_layout`). Otherwise the running program keeps its code and reports
+ * that it must be restarted. Old implementations are never unloaded, threads may still run them.
+ *
+ * `MINIJAVA_RELOAD_DIR` overrides the watched directory. Without `MINIJAVA_HOT_RELOAD` none of this is compiled.
+ *
+ * It writes two supporting files:
+ *
+ * - **`__reload.h`**: Declares the layout of the program, the description of a class and the tracking of objects.
+ * - **`__reload.c`**: Implements the watcher, the loading of shared objects and the rebinding of methods.
+ *
+ * @param project The parsed project.
+ */
+void write_reload(Project *project) {
+    char layout[32];
+    snprintf(layout, sizeof(layout), "0x%016llXULL", get_program_layout(project));
+
+    write_file("__reload.h", "#ifndef __RELOAD_H\n"
+                             "#define __RELOAD_H\n"
+                             "\n"
+                             "#if defined(MINIJAVA_HOT_RELOAD) && !defined(MINIJAVA_RELOAD_MODULE)\n"
+                             "#define MINIJAVA_RELOAD_HOST\n"
+                             "#endif\n"
+                             "\n"
+                             "#define $_RELOAD_LAYOUT " + std::string(layout) + "\n"
+                             "\n"
+                             "typedef struct __reload_module {\n"
+                             "    const char *name;\n"
+                             "    unsigned long long layout;\n"
+                             "    int methodCount;\n"
+                             "    void *const *methods;\n"
+                             "} __reload_module;\n"
+                             "\n"
+                             "#ifdef MINIJAVA_HOT_RELOAD\n"
+                             "void $_reload_start(void);\n"
+                             "\n"
+                             "void $_reload_track(void *object);\n"
+                             "#else\n"
+                             "#define $_reload_start() ((void) 0)\n"
+                             "#define $_reload_track(object) ((void) 0)\n"
+                             "#endif\n"
+                             "\n"
+                             "// The itables of the running program are rebound to the reloaded methods\n"
+                             "#ifdef MINIJAVA_RELOAD_HOST\n"
+                             "#define $_ITABLE_CONST\n"
+                             "#else\n"
+                             "#define $_ITABLE_CONST const\n"
+                             "#endif\n"
+                             "\n"
+                             "#endif //__RELOAD_H\n");
+
+    std::string includes;
+    std::string redirects;
+    std::string slots;
+    std::string slotEntries;
+    std::string itables;
+    std::string classes;
+    for (auto &clazz: *project->getClasses()) {
+        includes += "#include \"" + clazz.getName() + ".h\"\n";
+        if (clazz.isInterface()) {
+            itables += "        {(void *const *) $_itables_" + clazz.getName() + ", sizeof($_itable_" +
+                       clazz.getName() + ") / sizeof(void *)},\n";
+            continue;
+        }
+
+        std::vector<std::string> offsets;
+        get_reload_slots(project, &clazz, "", offsets);
+        if (!offsets.empty()) {
+            slots += "static const size_t $_reload_slots_" + clazz.getName() + "[] = {\n";
+            for (auto &offset: offsets) {
+                slots += "        offsetof(" + clazz.getName() + ", " + offset + "),\n";
+            }
+            slots += "};\n\n";
+            slotEntries += "        [$_class_" + clazz.getName() + "] = {$_reload_slots_" + clazz.getName() + ", " +
+                           std::to_string(offsets.size()) + "},\n";
+        }
+
+        if (!is_reloadable(&clazz)) {
+            continue;
+        }
+        std::string methods;
+        std::string statics;
+        int count = 0;
+        for (auto &method: *clazz.getMethods()) {
+            if (method.isMain()) continue;
+            methods += std::string(methods.empty() ? "" : ", ") + "(void *) " + clazz.getName() + "_" +
+                       method.getName();
+            if (method.isStatic()) {
+                redirects += "extern void *" + get_reload_redirect_name(&clazz, &method) + ";\n";
+                statics += std::string(statics.empty() ? "" : ", ") + "&" +
+                           get_reload_redirect_name(&clazz, &method);
+            } else {
+                statics += std::string(statics.empty() ? "" : ", ") + "NULL";
+            }
+            count++;
+        }
+        classes += "        {\"" + clazz.getName() + "\", " + std::to_string(count) + ", " +
+                   (count ? "(void *[]) {" + methods + "}, (void **[]) {" + statics + "}" : "NULL, NULL") + "},\n";
+    }
+    if (slotEntries.empty()) {
+        slotEntries = "        {NULL, 0},\n";
+    }
+    if (itables.empty()) {
+        itables = "        {NULL, 0},\n";
+    }
+
+    write_file("__reload.c", "#define _GNU_SOURCE\n"
+                             "\n"
+                             "#include \"__reload.h\"\n"
+                             "\n"
+                             "#ifdef MINIJAVA_RELOAD_HOST\n"
+                             "\n" +
+                             includes +
+                             "\n"
+                             "#include <dlfcn.h>\n"
+                             "#include <fcntl.h>\n"
+                             "#include <pthread.h>\n"
+                             "#include <stddef.h>\n"
+                             "#include <stdio.h>\n"
+                             "#include <stdlib.h>\n"
+                             "#include <string.h>\n"
+                             "#include <sys/stat.h>\n"
+                             "#include <time.h>\n"
+                             "#include <unistd.h>\n"
+                             "\n"
+                             "#ifndef MINIJAVA_RELOAD_DIR\n"
+                             "#define MINIJAVA_RELOAD_DIR \"reload\"\n"
+                             "#endif\n"
+                             "\n"
+                             "#define $_RELOAD_INTERVAL_NS 50000000L\n"
+                             "\n"
+                             "typedef struct __reload_slots {\n"
+                             "    const size_t *offsets;\n"
+                             "    size_t count;\n"
+                             "} __reload_slots;\n"
+                             "\n"
+                             "typedef struct __reload_itables {\n"
+                             "    void *const *tables;\n"
+                             "    size_t methods;\n"
+                             "} __reload_itables;\n"
+                             "\n"
+                             "typedef struct __reload_file {\n"
+                             "    long long modified;\n"
+                             "    long long size;\n"
+                             "} __reload_file;\n"
+                             "\n"
+                             "typedef struct __reload_binding {\n"
+                             "    void *from;\n"
+                             "    void *to;\n"
+                             "} __reload_binding;\n"
+                             "\n" +
+                             redirects +
+                             "\n" +
+                             slots +
+                             "static const __reload_slots $_reload_slots[$_CLASS_COUNT] = {\n" +
+                             slotEntries +
+                             "};\n"
+                             "\n"
+                             "static const __reload_itables $_reload_itables[] = {\n" +
+                             itables +
+                             "};\n"
+                             "\n"
+                             "// The current implementations of the methods of every class, and the redirections of static methods\n"
+                             "static struct {\n"
+                             "    const char *name;\n"
+                             "    int methodCount;\n"
+                             "    void **current;\n"
+                             "    void ***redirects;\n"
+                             "} $_reload_classes[] = {\n" +
+                             classes +
+                             "        {NULL, 0, NULL, NULL},\n"
+                             "};\n"
+                             "\n"
+                             "static pthread_mutex_t $_reload_lock = PTHREAD_MUTEX_INITIALIZER;\n"
+                             "static void **$_reload_objects = NULL;\n"
+                             "static size_t $_reload_object_count = 0;\n"
+                             "static size_t $_reload_object_capacity = 0;\n"
+                             "static __reload_binding *$_reload_bindings = NULL;\n"
+                             "static size_t $_reload_binding_count = 0;\n"
+                             "static size_t $_reload_binding_capacity = 0;\n"
+                             "\n"
+                             "static void *$_reload_grow(void *array, size_t *capacity, size_t size) {\n"
+                             "    *capacity = *capacity ? *capacity * 2 : 256;\n"
+                             "    array = realloc(array, *capacity * size);\n"
+                             "    if (!array) {\n"
+                             "        fprintf(stderr, \"Error: Out of memory for hot reload\\n\");\n"
+                             "        exit(1);\n"
+                             "    }\n"
+                             "    return array;\n"
+                             "}\n"
+                             "\n"
+                             "// Every implementation that was ever bound to a method is rebound to the last one\n"
+                             "static void $_reload_bind(void *from, void *to) {\n"
+                             "    for (size_t i = 0; i < $_reload_binding_count; i++) {\n"
+                             "        if ($_reload_bindings[i].to == from) {\n"
+                             "            $_reload_bindings[i].to = to;\n"
+                             "        }\n"
+                             "    }\n"
+                             "    if ($_reload_binding_count == $_reload_binding_capacity) {\n"
+                             "        $_reload_bindings = (__reload_binding *) $_reload_grow(\n"
+                             "                $_reload_bindings, &$_reload_binding_capacity, sizeof(__reload_binding));\n"
+                             "    }\n"
+                             "    $_reload_bindings[$_reload_binding_count++] = (__reload_binding) {from, to};\n"
+                             "}\n"
+                             "\n"
+                             "static size_t $_reload_rebind(void **slot) {\n"
+                             "    void *method = __atomic_load_n(slot, __ATOMIC_RELAXED);\n"
+                             "    for (size_t i = 0; i < $_reload_binding_count; i++) {\n"
+                             "        if ($_reload_bindings[i].from == method) {\n"
+                             "            __atomic_store_n(slot, $_reload_bindings[i].to, __ATOMIC_RELEASE);\n"
+                             "            return 1;\n"
+                             "        }\n"
+                             "    }\n"
+                             "    return 0;\n"
+                             "}\n"
+                             "\n"
+                             "static size_t $_reload_rebind_object(void *object) {\n"
+                             "    const __reload_slots *slots = &$_reload_slots[((__object *) object)->$class];\n"
+                             "    size_t rebound = 0;\n"
+                             "    for (size_t i = 0; i < slots->count; i++) {\n"
+                             "        rebound += $_reload_rebind((void **) ((char *) object + slots->offsets[i]));\n"
+                             "    }\n"
+                             "    return rebound;\n"
+                             "}\n"
+                             "\n"
+                             "void $_reload_track(void *object) {\n"
+                             "    pthread_mutex_lock(&$_reload_lock);\n"
+                             "    if ($_reload_object_count == $_reload_object_capacity) {\n"
+                             "        $_reload_objects = (void **) $_reload_grow(\n"
+                             "                $_reload_objects, &$_reload_object_capacity, sizeof(void *));\n"
+                             "    }\n"
+                             "    $_reload_objects[$_reload_object_count++] = object;\n"
+                             "    $_reload_rebind_object(object);\n"
+                             "    pthread_mutex_unlock(&$_reload_lock);\n"
+                             "}\n"
+                             "\n"
+                             "static const char *$_reload_dir(void) {\n"
+                             "    const char *dir = getenv(\"MINIJAVA_RELOAD_DIR\");\n"
+                             "    return dir ? dir : MINIJAVA_RELOAD_DIR;\n"
+                             "}\n"
+                             "\n"
+                             "static __reload_file $_reload_stat(const char *path) {\n"
+                             "    struct stat info;\n"
+                             "    if (stat(path, &info) != 0) {\n"
+                             "        return (__reload_file) {0, -1};\n"
+                             "    }\n"
+                             "    return (__reload_file) {(long long) info.st_mtim.tv_sec * 1000000000LL + info.st_mtim.tv_nsec,\n"
+                             "                            (long long) info.st_size};\n"
+                             "}\n"
+                             "\n"
+                             "// dlopen returns the loaded object again for the same path, every version is loaded from a copy\n"
+                             "static bool $_reload_copy(const char *from, const char *to) {\n"
+                             "    int in = open(from, O_RDONLY);\n"
+                             "    if (in < 0) return false;\n"
+                             "    int out = open(to, O_WRONLY | O_CREAT | O_TRUNC, 0700);\n"
+                             "    if (out < 0) {\n"
+                             "        close(in);\n"
+                             "        return false;\n"
+                             "    }\n"
+                             "    char buffer[65536];\n"
+                             "    ssize_t n;\n"
+                             "    bool copied = true;\n"
+                             "    while ((n = read(in, buffer, sizeof(buffer))) > 0) {\n"
+                             "        if (write(out, buffer, (size_t) n) != n) {\n"
+                             "            copied = false;\n"
+                             "            break;\n"
+                             "        }\n"
+                             "    }\n"
+                             "    close(in);\n"
+                             "    close(out);\n"
+                             "    return copied && n == 0;\n"
+                             "}\n"
+                             "\n"
+                             "static void $_reload_load(int index, const char *path, int version) {\n"
+                             "    const char *name = $_reload_classes[index].name;\n"
+                             "    char copy[4096];\n"
+                             "    snprintf(copy, sizeof(copy), \"%s/.%s.%d.%d.so\", $_reload_dir(), name, (int) getpid(), version);\n"
+                             "    if (!$_reload_copy(path, copy)) {\n"
+                             "        fprintf(stderr, \"hot reload: can not copy %s\\n\", path);\n"
+                             "        unlink(copy);\n"
+                             "        return;\n"
+                             "    }\n"
+                             "    void *handle = dlopen(copy, RTLD_NOW | RTLD_LOCAL);\n"
+                             "    unlink(copy);\n"
+                             "    if (!handle) {\n"
+                             "        fprintf(stderr, \"hot reload: %s\\n\", dlerror());\n"
+                             "        return;\n"
+                             "    }\n"
+                             "    const __reload_module *module = (const __reload_module *) dlsym(handle, \"$_reload_module\");\n"
+                             "    if (!module || strcmp(module->name, name) != 0 ||\n"
+                             "        module->methodCount != $_reload_classes[index].methodCount) {\n"
+                             "        fprintf(stderr, \"hot reload: %s is not the shared object of class %s\\n\", path, name);\n"
+                             "        dlclose(handle);\n"
+                             "        return;\n"
+                             "    }\n"
+                             "    if (module->layout != $_RELOAD_LAYOUT) {\n"
+                             "        fprintf(stderr, \"hot reload: the classes, fields or method signatures of the program changed, \"\n"
+                             "                        \"%s is not reloaded (restart the program)\\n\", name);\n"
+                             "        dlclose(handle);\n"
+                             "        return;\n"
+                             "    }\n"
+                             "\n"
+                             "    pthread_mutex_lock(&$_reload_lock);\n"
+                             "    void **current = $_reload_classes[index].current;\n"
+                             "    for (int i = 0; i < module->methodCount; i++) {\n"
+                             "        $_reload_bind(current[i], module->methods[i]);\n"
+                             "        current[i] = module->methods[i];\n"
+                             "        if ($_reload_classes[index].redirects[i]) {\n"
+                             "            __atomic_store_n($_reload_classes[index].redirects[i], current[i], __ATOMIC_RELEASE);\n"
+                             "        }\n"
+                             "    }\n"
+                             "    size_t rebound = 0;\n"
+                             "    for (size_t i = 0; i < $_reload_object_count; i++) {\n"
+                             "        rebound += $_reload_rebind_object($_reload_objects[i]);\n"
+                             "    }\n"
+                             "    for (size_t i = 0; i < sizeof($_reload_itables) / sizeof($_reload_itables[0]); i++) {\n"
+                             "        for (int id = 0; $_reload_itables[i].tables && id < $_CLASS_COUNT; id++) {\n"
+                             "            void **table = (void **) $_reload_itables[i].tables[id];\n"
+                             "            for (size_t m = 0; table && m < $_reload_itables[i].methods; m++) {\n"
+                             "                rebound += $_reload_rebind(&table[m]);\n"
+                             "            }\n"
+                             "        }\n"
+                             "    }\n"
+                             "    pthread_mutex_unlock(&$_reload_lock);\n"
+                             "    fprintf(stderr, \"hot reload: reloaded %s, %zu method pointers rebound\\n\", name, rebound);\n"
+                             "}\n"
+                             "\n"
+                             "// A rebuilt shared object is loaded once its file stopped changing for a poll\n"
+                             "static void *$_reload_watch(void *argument) {\n"
+                             "    (void) argument;\n"
+                             "    size_t count = sizeof($_reload_classes) / sizeof($_reload_classes[0]) - 1;\n"
+                             "    __reload_file *loaded = (__reload_file *) calloc(count + 1, sizeof(__reload_file));\n"
+                             "    __reload_file *pending = (__reload_file *) calloc(count + 1, sizeof(__reload_file));\n"
+                             "    char path[4096];\n"
+                             "    for (size_t i = 0; i < count; i++) {\n"
+                             "        snprintf(path, sizeof(path), \"%s/%s.so\", $_reload_dir(), $_reload_classes[i].name);\n"
+                             "        loaded[i] = pending[i] = $_reload_stat(path);\n"
+                             "    }\n"
+                             "    struct timespec interval = {0, $_RELOAD_INTERVAL_NS};\n"
+                             "    for (int version = 0;; version++) {\n"
+                             "        nanosleep(&interval, NULL);\n"
+                             "        for (size_t i = 0; i < count; i++) {\n"
+                             "            snprintf(path, sizeof(path), \"%s/%s.so\", $_reload_dir(), $_reload_classes[i].name);\n"
+                             "            __reload_file file = $_reload_stat(path);\n"
+                             "            bool stable = file.modified == pending[i].modified && file.size == pending[i].size;\n"
+                             "            pending[i] = file;\n"
+                             "            if (stable && file.size > 0 &&\n"
+                             "                (file.modified != loaded[i].modified || file.size != loaded[i].size)) {\n"
+                             "                loaded[i] = file;\n"
+                             "                $_reload_load((int) i, path, version);\n"
+                             "            }\n"
+                             "        }\n"
+                             "    }\n"
+                             "    return NULL;\n"
+                             "}\n"
+                             "\n"
+                             "void $_reload_start(void) {\n"
+                             "    pthread_t watcher;\n"
+                             "    if (pthread_create(&watcher, NULL, $_reload_watch, NULL) == 0) {\n"
+                             "        pthread_detach(watcher);\n"
+                             "        fprintf(stderr, \"hot reload: watching %s\\n\", $_reload_dir());\n"
+                             "    }\n"
+                             "}\n"
+                             "\n"
+                             "#endif\n");
+}
@@ -0,0 +1,161 @@
+#include "../internal/generator_internal.h"
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+/**
+ * @brief Maps the lines of a generated C file to the Mini-Java source, by the marks of its methods.
+ *
+ * With `--line-directives` or `--source-map`, the generator marks the lines of the source in the code of the
+ * methods (see `ThreeAddressCodeGenerator::at`), and brackets every method, with its outlined functions and
+ * the methods inlined into it, by the method it comes from:
+ * ```c
+ * //@method MergeSort.sort 92
+ * $_method int *MergeSort_sort(void *$this, int *arr) {
+ * //@line 93
+ *     $_t_0 = arr->length <= 1;
+ * //@end
+ * ```
+ * The marks are comments, they are replaced once the file is complete and the C lines are known. With
+ * `--line-directives`, a `#line` directive precedes every line of a method the compiler would attribute to
+ * another line of the source, and the lines after the method are attributed back to the C file:
+ * ```c
+ * #line 92 "/home/user/Main.java"
+ * $_method int *MergeSort_sort(void *$this, int *arr) {
+ * #line 93
+ *     $_t_0 = arr->length <= 1;
+ * #line 40 "MergeSort.c"
+ * ```
+ * Preprocessor conditionals (e.g., of the reload build) may skip directives, the line after one of them
+ * always gets its directive.
+ *
+ * @param fileName The name of the C file in `compile`.
+ * @param source The C source with the marks.
+ * @param options The options of the generation.
+ * @param sourceMap The runs of lines of the file are added to it.
+ * @return The C source without the marks.
+ */
+std::string map_source_lines(
+        const std::string &fileName,
+        const std::string &source,
+        const GenerateOptions &options,
+        SourceMap &sourceMap
+) {
+    std::string sourcePath = get_c_string_literal(
+            std::filesystem::absolute(options.sourcePath).lexically_normal().string());
+    std::vector<SourceMapping> &mappings = sourceMap[fileName];
+    // The enclosing methods and their lines, a method inlined into another is nested in it
+    std::vector<std::pair<std::string, int>> methods;
+    std::string method;
+    int sourceLine = 0;
+    // Whether the last directive names the Mini-Java source, and the line it gives to the next line (-1 unknown)
+    bool inSource = false;
+    int nextLine = -1;
+    // Whether the last run of the map may go on with the next line
+    bool continued = false;
+
+    std::string result;
+    result.reserve(source.size());
+    int written = 0;
+    auto write = [&](const std::string &line) {
+        result += line;
+        result += '\n';
+        written++;
+    };
+
+    std::istringstream lines(source);
+    for (std::string line; std::getline(lines, line);) {
+        if (line.rfind("//@method ", 0) == 0) {
+            methods.emplace_back(method, sourceLine);
+            size_t space = line.rfind(' ');
+            method = line.substr(10, space - 10);
+            sourceLine = std::stoi(line.substr(space + 1));
+            continue;
+        }
+        if (line.rfind("//@line ", 0) == 0) {
+            if (!method.empty()) {
+                sourceLine = std::stoi(line.substr(8));
+            }
+            continue;
+        }
+        if (line == "//@end") {
+            method = methods.back().first;
+            sourceLine = methods.back().second;
+            methods.pop_back();
+            continue;
+        }
+
+        bool blank = line.find_first_not_of(" \t") == std::string::npos;
+        bool directive = !blank && line[line.find_first_not_of(" \t")] == '#';
+        if (options.lineDirectives) {
+            if (sourceLine > 0 && !blank && !directive && (!inSource || nextLine != sourceLine)) {
+                write("#line " + std::to_string(sourceLine) + (inSource ? "" : " " + sourcePath));
+                inSource = true;
+                nextLine = sourceLine;
+            } else if (sourceLine == 0 && inSource) {
+                // The directive is the next line, the line after it is its own
+                write("#line " + std::to_string(written + 2) + " " + get_c_string_literal(fileName));
+                inSource = false;
+            }
+        }
+        write(line);
+        if (inSource) {
+            nextLine = directive ? -1 : nextLine + 1;
+        }
+
+        // A run goes on over the blank lines and the directives in between, not over the lines of C
+        if (sourceLine == 0) {
+            continued = false;
+        } else if (!blank && !directive) {
+            if (continued && mappings.back().sourceLine == sourceLine && mappings.back().method == method) {
+                mappings.back().lines = written - mappings.back().line + 1;
+            } else {
+                mappings.push_back({written, 1, method, sourceLine});
+                continued = true;
+            }
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Writes the source map of the generated C files (`--source-map`).
+ *
+ * Every run of lines of a C file coming from one line of the source has its first line, its number of lines,
+ * the method and the line of the source. A sample of a profiler at `MergeSort.c:41` belongs to the run whose
+ * lines contain 41, the samples can be summed by method or by line of the source:
+ * ```json
+ * {"source": "/home/user/Main.java", "files": [
+ *   {"name": "MergeSort.c", "mappings": [
+ *     {"line": 40, "lines": 3, "method": "MergeSort.sort", "sourceLine": 93}]}]}
+ * ```
+ * The lines are those of the files as written, with or without `#line` directives.
+ *
+ * @param path The JSON file to write.
+ * @param options The options of the generation.
+ * @param sourceMap The runs of lines of the files.
+ */
+void write_source_map(const std::string &path, const GenerateOptions &options, const SourceMap &sourceMap) {
+    std::ofstream out(path);
+    if (!out.is_open()) {
+        std::cerr << "Error: Unable to create the source map '" << path << "'." << std::endl;
+        return;
+    }
+    std::string sourcePath = std::filesystem::absolute(options.sourcePath).lexically_normal().string();
+    out << "{\"source\": \"" << profiler::json_escape(sourcePath) << "\", \"files\": [";
+    bool firstFile = true;
+    for (auto &file: sourceMap) {
+        out << (firstFile ? "\n" : ",\n") << "  {\"name\": \"" << profiler::json_escape(file.first)
+            << "\", \"mappings\": [";
+        firstFile = false;
+        for (size_t i = 0; i < file.second.size(); i++) {
+            const SourceMapping &mapping = file.second[i];
+            out << (i ? "," : "") << "\n    {\"line\": " << mapping.line << ", \"lines\": " << mapping.lines
+                << ", \"method\": \"" << profiler::json_escape(mapping.method) << "\", \"sourceLine\": "
+                << mapping.sourceLine << "}";
+        }
+        out << "]}";
+    }
+    out << "\n]}\n";
+}
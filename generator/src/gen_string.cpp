@@ -0,0 +1,258 @@
+#include "../internal/generator_internal.h"
+
+/**
+ * @brief Escapes a decoded string literal so it can be written as a C string literal.
+ *
+ * Printable characters are written as they are, quotes, backslashes and question marks
+ * (to avoid trigraphs) are escaped and everything else is written as an octal escape.
+ *
+ * @param value The decoded content of the literal.
+ * @return The C string literal, including quotes.
+ */
+std::string get_c_string_literal(const std::string &value) {
+    std::string literal = "\"";
+    for (unsigned char c: value) {
+        if (c == '"' || c == '\\' || c == '?') {
+            literal += '\\';
+            literal += (char) c;
+        } else if (c >= 0x20 && c < 0x7f) {
+            literal += (char) c;
+        } else {
+            literal += '\\';
+            literal += (char) ('0' + ((c >> 6) & 7));
+            literal += (char) ('0' + ((c >> 3) & 7));
+            literal += (char) ('0' + (c & 7));
+        }
+    }
+    return literal + "\"";
+}
+
+/**
+ * @brief Writes the runtime of the `String` type and the string constant pool of the program.
+ *
+ * Strings are immutable, so a `String` is either a flat string or a rope:
+ *
+ * - **Flat**: `data` points to `length` characters. String literals are flat strings that live in
+ *   the read-only constant pool `$_string_pool`, each distinct literal of the program is emitted once
+ *   and referenced with `$_string_literal(index)`.
+ * - **Rope**: `data` is `NULL` and the string is the concatenation of `left` and `right`.
+ *
+ * `$_string_concat` never copies its operands (except for short flat strings), it creates a rope node
+ * in O(1), so building a string with `+` in a loop is linear instead of quadratic. A rope is flattened
+ * (iteratively, the ropes built by loops are deep) the first time its characters are needed by `charAt`,
+ * the flat copy is cached in the node. `$_string_print` writes the leaves of a rope directly to `stdout`
+ * without flattening or copying it.
+ *
+ * A string may be shared by threads (`spawn`, `@Parallel`, channels), so the cached copy is published
+ * with a release store once it is filled and `data` is always read with an acquire load. The children of
+ * a flattened node are kept, a thread still walking the rope never finds them cleared; if two threads
+ * flatten the same node, the first copy is kept and the other one is freed.
+ *
+ * It writes two supporting files:
+ *
+ * - **`__string.h`**:
+ *   - Defines the struct (`__string`) representing the `String` type.
+ *   - Declares the constant pool and the runtime functions.
+ *   - Defines the inline fast paths of `charAt`, the flat data of a string is used directly.
+ *
+ * - **`__string.c`**:
+ *   - Implements concatenation, flattening, conversion of `int`/`boolean` and printing.
+ *   - Defines the constant pool with all the interned literals of the program.
+ *
+ * Example:
+ * ```java
+ * String s = "Hi ";
+ * s = s + 42;
+ * System.out.println(s);
+ * ```
+ * Translated to C:
+ * ```c
+ * __string *s = $_string_literal(0);
+ * __string *$_t_0 = $_string_concat(s, $_string_from_int(42));
+ * s = $_t_0;
+ * $_string_print(s, true);
+ * ```
+ *
+ * @param strings The interned string literals of the program.
+ */
+void write_string(const StringPool &strings) {
+    write_file("__string.h", "#ifndef __STRING_H\n"
+                             "#define __STRING_H\n"
+                             "\n"
+                             "#include <stdbool.h>\n"
+                             "\n"
+                             "typedef struct __string {\n"
+                             "    int length;\n"
+                             "    const char *data;\n"
+                             "    struct __string *left;\n"
+                             "    struct __string *right;\n"
+                             "} __string;\n"
+                             "\n"
+                             "extern const __string $_string_pool[];\n"
+                             "\n"
+                             "#define $_string_literal(index) ((__string *) &$_string_pool[index])\n"
+                             "\n"
+                             "__string *$_string_concat(__string *left, __string *right);\n"
+                             "\n"
+                             "__string *$_string_from_int(int value);\n"
+                             "\n"
+                             "__string *$_string_from_bool(bool value);\n"
+                             "\n"
+                             "const char *$_string_flatten(__string *str);\n"
+                             "\n"
+                             "void $_string_print(__string *str, bool newline);\n"
+                             "\n"
+                             "static inline const char *$_string_load_data(__string *str) {\n"
+                             "    return __atomic_load_n(&str->data, __ATOMIC_ACQUIRE);\n"
+                             "}\n"
+                             "\n"
+                             "static inline const char *$_string_data(__string *str) {\n"
+                             "    const char *data = $_string_load_data(str);\n"
+                             "    return data ? data : $_string_flatten(str);\n"
+                             "}\n"
+                             "\n"
+                             "static inline int $_string_char_at(__string *str, int index) {\n"
+                             "    return (unsigned char) $_string_data(str)[index];\n"
+                             "}\n"
+                             "\n"
+                             "#endif //__STRING_H\n");
+
+    std::vector<const std::string *> pool(strings.size());
+    for (auto &entry: strings) {
+        pool[entry.second] = &entry.first;
+    }
+
+    std::string source = "#include \"__string.h\"\n"
+                         "\n"
+                         "#include <stdio.h>\n"
+                         "#include <stdlib.h>\n"
+                         "#include <string.h>\n"
+                         "\n"
+                         "#define $_STRING_FLAT_MAX 32\n"
+                         "\n"
+                         "static __string $_string_null = {4, \"null\", NULL, NULL};\n"
+                         "static __string $_string_true = {4, \"true\", NULL, NULL};\n"
+                         "static __string $_string_false = {5, \"false\", NULL, NULL};\n"
+                         "\n";
+
+    if (!pool.empty()) {
+        source += "const __string $_string_pool[] = {\n";
+        for (auto value: pool) {
+            source += "    {" + std::to_string(value->size()) + ", " +
+                      get_c_string_literal(*value) + ", NULL, NULL},\n";
+        }
+        source += "};\n\n";
+    }
+
+    source += "static __string **$_string_push(__string **stack, int size, int *capacity, __string *str) {\n"
+              "    if (size == *capacity) {\n"
+              "        *capacity *= 2;\n"
+              "        stack = (__string **) realloc(stack, *capacity * sizeof(__string *));\n"
+              "    }\n"
+              "    stack[size] = str;\n"
+              "    return stack;\n"
+              "}\n"
+              "\n"
+              "__string *$_string_concat(__string *left, __string *right) {\n"
+              "    if (!left) left = &$_string_null;\n"
+              "    if (!right) right = &$_string_null;\n"
+              "    if (left->length == 0) return right;\n"
+              "    if (right->length == 0) return left;\n"
+              "\n"
+              "    __string *str = (__string *) malloc(sizeof(__string));\n"
+              "    str->length = left->length + right->length;\n"
+              "    const char *leftData = $_string_load_data(left);\n"
+              "    const char *rightData = $_string_load_data(right);\n"
+              "    if (leftData && rightData && str->length <= $_STRING_FLAT_MAX) {\n"
+              "        char *data = (char *) malloc(str->length + 1);\n"
+              "        memcpy(data, leftData, left->length);\n"
+              "        memcpy(data + left->length, rightData, right->length);\n"
+              "        data[str->length] = '\\0';\n"
+              "        str->data = data;\n"
+              "        str->left = str->right = NULL;\n"
+              "    } else {\n"
+              "        str->data = NULL;\n"
+              "        str->left = left;\n"
+              "        str->right = right;\n"
+              "    }\n"
+              "    return str;\n"
+              "}\n"
+              "\n"
+              "__string *$_string_from_int(int value) {\n"
+              "    char buffer[16];\n"
+              "    int length = sprintf(buffer, \"%d\", value);\n"
+              "    char *data = (char *) malloc(length + 1);\n"
+              "    memcpy(data, buffer, length + 1);\n"
+              "\n"
+              "    __string *str = (__string *) malloc(sizeof(__string));\n"
+              "    str->length = length;\n"
+              "    str->data = data;\n"
+              "    str->left = str->right = NULL;\n"
+              "    return str;\n"
+              "}\n"
+              "\n"
+              "__string *$_string_from_bool(bool value) {\n"
+              "    return value ? &$_string_true : &$_string_false;\n"
+              "}\n"
+              "\n"
+              "const char *$_string_flatten(__string *str) {\n"
+              "    char *data = (char *) malloc(str->length + 1);\n"
+              "    int capacity = 16, size = 0, end = str->length;\n"
+              "    __string **stack = (__string **) malloc(capacity * sizeof(__string *));\n"
+              "    stack[size++] = str;\n"
+              "\n"
+              "    // Fills the buffer from the end, the right child is visited first\n"
+              "    while (size > 0) {\n"
+              "        __string *node = stack[--size];\n"
+              "        const char *nodeData = $_string_load_data(node);\n"
+              "        if (nodeData) {\n"
+              "            end -= node->length;\n"
+              "            memcpy(data + end, nodeData, node->length);\n"
+              "        } else {\n"
+              "            stack = $_string_push(stack, size++, &capacity, node->left);\n"
+              "            stack = $_string_push(stack, size++, &capacity, node->right);\n"
+              "        }\n"
+              "    }\n"
+              "    free(stack);\n"
+              "\n"
+              "    data[str->length] = '\\0';\n"
+              "\n"
+              "    // Publishes the filled copy, the children stay valid for the threads still walking them\n"
+              "    const char *expected = NULL;\n"
+              "    if (!__atomic_compare_exchange_n(&str->data, &expected, data, false,\n"
+              "                                     __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {\n"
+              "        free(data);\n"
+              "        return expected;\n"
+              "    }\n"
+              "    return data;\n"
+              "}\n"
+              "\n"
+              "void $_string_print(__string *str, bool newline) {\n"
+              "    if (!str) str = &$_string_null;\n"
+              "    const char *data = $_string_load_data(str);\n"
+              "    if (data) {\n"
+              "        fwrite(data, 1, str->length, stdout);\n"
+              "    } else {\n"
+              "        int capacity = 16, size = 0;\n"
+              "        __string **stack = (__string **) malloc(capacity * sizeof(__string *));\n"
+              "        stack[size++] = str;\n"
+              "\n"
+              "        // Writes the leaves in order, the left child is visited first\n"
+              "        while (size > 0) {\n"
+              "            __string *node = stack[--size];\n"
+              "            const char *nodeData = $_string_load_data(node);\n"
+              "            if (nodeData) {\n"
+              "                fwrite(nodeData, 1, node->length, stdout);\n"
+              "            } else {\n"
+              "                stack = $_string_push(stack, size++, &capacity, node->right);\n"
+              "                stack = $_string_push(stack, size++, &capacity, node->left);\n"
+              "            }\n"
+              "        }\n"
+              "        free(stack);\n"
+              "    }\n"
+              "    if (newline) {\n"
+              "        putchar('\\n');\n"
+              "    }\n"
+              "}\n";
+    write_file("__string.c", source);
+}
@@ -1,12 +1,45 @@
 #include "../internal/generator_internal.h"
 
-void generate(Project *project) {
+void generate(Project *project, const GenerateOptions &options) {
+    ScopedTimer timer("generate");
+    MemoryCategory category("generated source");
+    StringPool strings;
+    Profile profile;
+    if (!options.profile.empty()) {
+        profile = read_profile(options.profile);
+    }
+    SourceMap sourceMap;
     for (auto &clazz: *project->getClasses()) {
+        if (clazz.isInterface()) {
+            ScopedTimer interfaceTimer("generate_interface", clazz.getName());
+            generate_interface(project, &clazz);
+            continue;
+        }
         std::map<Identifier, bool> included;
-        generate_class_header(project, &clazz, included);
-        generate_class_source(project, &clazz, included);
+        {
+            ScopedTimer headerTimer("generate_class_header", clazz.getName());
+            generate_class_header(project, &clazz, included);
+        }
+        ScopedTimer sourceTimer("generate_class_source", clazz.getName());
+        generate_class_source(project, &clazz, included, strings, options, profile, sourceMap);
     }
 
     write_cmake();
     write_int_array();
+    write_string(strings);
+    write_parallel();
+    write_forkjoin();
+    write_monitor();
+    write_channel();
+    write_exception();
+    write_null_handler(project);
+    write_memo();
+    write_reload(project);
+    write_class_table(project);
+    if (options.instrument) {
+        write_profile();
+    }
+    if (!options.sourceMap.empty()) {
+        write_source_map(options.sourceMap, options, sourceMap);
+    }
 }
@@ -7,16 +7,19 @@
  * Handles both class instantiation and array creation:
  * - Regular objects: `new ClassName()`
  * - Integer arrays: `new int[size]`
+ * - Channels: `new Channel(capacity)`
  *
  * Example:
  * ```java
  * new MyClass()     // Creates object
  * new int[24]       // Creates integer array
+ * new SpscChannel(8) // Creates single-producer single-consumer channel
  * ```
  * Generated TAC:
  * ```java
  * $_new_MyClass()
  * $_new___int_array(24)
+ * $_new___channel(8, true)
  * ```
  *
  * @param gen TAC generator context
@@ -24,10 +27,16 @@
  * @return Temporary variable containing the new object reference
  */
 std::string generateNewObject(ThreeAddressCodeGenerator &gen, NewObject *node) {
+    gen.at(node->classType);
+    gen.stats.allocations++;
     std::string tmp = gen.tempGen.newTemp();
     if (node->classType.lexeme == "int" && node->arraySize) {
         std::string value = generate(gen, &node->arraySize);
         gen.emit("__int_array *" + tmp + " = $_new___int_array(" + value + ")");
+    } else if (SymbolTable::isChannelType(node->classType.lexeme)) {
+        std::string capacity = generate(gen, &node->capacity);
+        std::string spsc = node->classType.lexeme == "SpscChannel" ? "true" : "false";
+        gen.emit("__channel *" + tmp + " = $_new___channel(" + capacity + ", " + spsc + ")");
     } else {
         gen.newObject(node->classType.lexeme);
         gen.emit(node->classType.lexeme + " *" + tmp + " = $_new_" + node->classType.lexeme + "()");
@@ -53,16 +62,414 @@ std::string generateNewObject(ThreeAddressCodeGenerator &gen, NewObject *node) {
  *
  * @param gen TAC generator context
  * @param node ArrayCall AST node
- * @param caller The array reference expression
+ * @param array The C expression of the array (e.g., `super->arr` or `$_static_A_arr`)
  * @return Generated array access expression
  */
 std::string generateArrayCall(
         ThreeAddressCodeGenerator &gen,
         ArrayCall *node,
-        const std::string &caller
+        const std::string &array
 ) {
     std::string argTemp = generate(gen, node->bracket.get());
-    return caller + node->arrayName + "->data[" + argTemp + "]";
+    gen.stats.arrayAccesses++;
+    gen.remark("analysis", "bounds-check", "element access of `" + node->arrayName +
+                                           "` has no bounds check, `int[]` elements are plain loads and stores");
+    return array + "->data[" + argTemp + "]";
+}
+
+/**
+ * @brief Finds the method a call binds to in a class or its superclasses.
+ * @param project The project being generated
+ * @param className The class to start from
+ * @param name The name of the method
+ * @return The nearest declaration of the method, or `nullptr` if not found
+ */
+Method *find_called_method(Project *project, const Identifier &className, const Identifier &name) {
+    Class *clazz = project->getClassByName(className);
+    while (clazz) {
+        for (auto &method: *clazz->getMethods()) {
+            if (method.getName() == name) {
+                return &method;
+            }
+        }
+        clazz = clazz->getExtends().empty() ? nullptr : project->getClassByName(clazz->getExtends());
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Lists the subclasses of a class that override a method, the targets a virtual call may reach.
+ * @param project The project being generated
+ * @param className The static type of the receiver
+ * @param name The name of the method
+ * @return The names of the overriding subclasses, in declaration order
+ */
+std::vector<Identifier> get_overriding_classes(Project *project, const Identifier &className, const Identifier &name) {
+    std::vector<Identifier> overriding;
+    for (auto &clazz: *project->getClasses()) {
+        if (clazz.getName() == className || !clazz.containsMethod(name)) {
+            continue;
+        }
+        Class *parent = &clazz;
+        while (parent && !parent->getExtends().empty() && parent->getExtends() != className) {
+            parent = project->getClassByName(parent->getExtends());
+        }
+        if (parent && parent->getExtends() == className) {
+            overriding.push_back(clazz.getName());
+        }
+    }
+    return overriding;
+}
+
+/**
+ * @brief Counts a call of a Mini-Java method and explains why it was or was not devirtualized and inlined.
+ *
+ * Instance methods are always called through their `$_function_` pointer (or the itable of an interface),
+ * so the C compiler can't inline them. Static methods are called by name, the C compiler may inline them
+ * if they are defined in the translation unit of the caller.
+ *
+ * @param gen TAC generator context
+ * @param node MethodCall AST node
+ * @param className The class (or interface) the method is looked up in
+ * @param dispatch How the call is dispatched: `static`, `virtual` or `interface`
+ */
+void report_method_call(
+        ThreeAddressCodeGenerator &gen,
+        MethodCall *node,
+        const Identifier &className,
+        const std::string &dispatch
+) {
+    std::string name = "`" + className + "." + node->methodName + "`";
+    if (dispatch == "static") {
+        gen.stats.directCalls++;
+        gen.remark("passed", "devirtualize", "call of " + name + " is direct, static methods have no receiver");
+        Method *method = find_called_method(gen.project, className, node->methodName);
+        if (method && method->isMemoized()) {
+            gen.remark("missed", "inline", name + " is not inlined, calls of a @Memoize method look up its cache");
+        } else if (className == gen.clazz->getName()) {
+            gen.remark("analysis", "inline", name + " may be inlined by the C compiler, it is defined in " +
+                                             className + ".c with the caller");
+        } else {
+            gen.remark("missed", "inline", name + " is not inlined, it is defined in " + className +
+                                           ".c and the C compiler sees one class at a time");
+        }
+        return;
+    }
+
+    gen.stats.indirectCalls++;
+    if (dispatch == "interface") {
+        gen.remark("missed", "devirtualize", "call of " + name + " is not devirtualized, it is dispatched "
+                                                                  "through the itable of the class of the receiver");
+        gen.remark("missed", "inline", name + " is not inlined, the target of an itable call is unknown");
+        return;
+    }
+    std::vector<Identifier> overriding = get_overriding_classes(gen.project, className, node->methodName);
+    if (overriding.empty()) {
+        gen.remark("missed", "devirtualize", "call of " + name + " is not devirtualized, no subclass overrides it "
+                                             "but instance methods are called through `$_function_" +
+                                             node->methodName + "`");
+    } else {
+        std::string classes;
+        for (auto &clazz: overriding) {
+            classes += (classes.empty() ? "`" : ", `") + clazz + "`";
+        }
+        gen.remark("missed", "devirtualize", "call of " + name + " is not devirtualized, it is overridden by " +
+                                             classes);
+    }
+    gen.remark("missed", "inline", name + " is not inlined, the C compiler can't see through `$_function_" +
+                                   node->methodName + "`");
+}
+
+/**
+ * @brief The C function a hot call site of a profile-guided build may call instead of its dispatch.
+ *
+ * The method is inlined if it fits the budget of the site (see `generate_inline_method`), a copy of it is
+ * defined in the file of the caller. Otherwise, it is called by its C name, the C compiler sees the target
+ * and may still inline it in its own file.
+ *
+ * @param gen TAC generator context
+ * @param owner The class declaring the method
+ * @param method The called method
+ * @param calls The calls of the site in the profile
+ * @param inlined Set to whether the function is the inlined copy
+ * @return The C function to call, or an empty string if the method is built-in
+ */
+std::string get_bound_function(
+        ThreeAddressCodeGenerator &gen,
+        Class *owner,
+        Method *method,
+        uint64_t calls,
+        bool &inlined
+) {
+    if (owner->isBuiltin()) {
+        return "";
+    }
+    std::string inlineName = get_inline_method_name(owner, method);
+    auto found = gen.inlined->find(inlineName);
+    if (found == gen.inlined->end()) {
+        int budget = calls * 100 >= gen.pgo->calls ? PGO_INLINE_BUDGET_HOTTEST : PGO_INLINE_BUDGET;
+        std::string copy = generate_inline_method(gen.project, owner, method, gen.types, gen.strings, budget,
+                                                  gen.lines);
+        found = gen.inlined->insert({inlineName, !copy.empty()}).first;
+        gen.functions += copy;
+    }
+    gen.newObject(owner->getName());
+    inlined = found->second;
+    return inlined ? inlineName : owner->getName() + "_" + method->getName();
+}
+
+/**
+ * @brief Binds a hot call site of a profile-guided build to its target, instead of the dynamic dispatch.
+ *
+ * An instance method is only bound when no subclass of the static type of the receiver overrides it, and its
+ * receiver is checked for `null` (the call through `$_function_` would have faulted). A static method is
+ * already called by its name, it is only bound to its inlined copy.
+ *
+ * @param gen TAC generator context
+ * @param node MethodCall AST node
+ * @param owner The class declaring the called method
+ * @param calls The calls of the site in the profile
+ * @param argumentTemps The receiver (unless static) and the arguments, the receiver gets its `null` check
+ * @return The C function to call, or an empty string if the call keeps its dispatch
+ */
+std::string bind_hot_call(
+        ThreeAddressCodeGenerator &gen,
+        MethodCall *node,
+        const Identifier &owner,
+        uint64_t calls,
+        std::vector<std::string> &argumentTemps
+) {
+    Class *clazz = gen.project->getClassByName(owner);
+    Method *method = find_called_method(gen.project, owner, node->methodName);
+    bool inlined = false;
+    std::string bound = clazz && method ? get_bound_function(gen, clazz, method, calls, inlined) : "";
+    if (bound.empty() || (method->isStatic() && !inlined)) {
+        return "";
+    }
+    std::string name = "`" + owner + "." + node->methodName + "`";
+    std::string count = std::to_string(calls) + " calls in the profile";
+    if (!method->isStatic()) {
+        gen.remark("passed", "devirtualize", "call of " + name + " is direct at a hot call site (" + count +
+                                             "), no subclass overrides it");
+        if (argumentTemps[0] != "super" && argumentTemps[0].find("$_null_check(") == std::string::npos) {
+            argumentTemps[0] = "$_null_check(" + argumentTemps[0] + ")";
+        }
+    }
+    if (inlined) {
+        gen.stats.inlinedCalls++;
+        gen.remark("passed", "inline", name + " is inlined at a hot call site (" + count + ")");
+    } else {
+        gen.stats.directCalls++;
+    }
+    return bound;
+}
+
+/**
+ * @brief Guards a hot call site of a profile-guided build for the most frequent class of its receivers.
+ *
+ * A call dispatched through `$_function_` (or an itable) whose receivers were of one class in
+ * `PGO_GUARD_PERCENT` of its calls tests the class id of the receiver and calls the method of that class
+ * directly (or its inlined copy, see `get_bound_function`), other receivers keep the dispatch. The class hierarchy
+ * may allow many targets while the program only ever calls one. The guard loads the header of the receiver,
+ * a `null` receiver faults there as it would on the call.
+ *
+ * @param gen TAC generator context
+ * @param node MethodCall AST node
+ * @param className The class (or interface) the method is looked up in
+ * @param counts The counts of the site in the profile
+ * @param receiver Set to the class the receiver is tested for
+ * @return The C function to call when the guard holds, or an empty string if the call is not guarded
+ */
+std::string guard_hot_call(
+        ThreeAddressCodeGenerator &gen,
+        MethodCall *node,
+        const Identifier &className,
+        const CallCount &counts,
+        Identifier &receiver
+) {
+    std::string name = "`" + className + "." + node->methodName + "`";
+    uint64_t hits = 0;
+    for (auto &entry: counts.receivers) {
+        if (entry.second > hits) {
+            receiver = entry.first;
+            hits = entry.second;
+        }
+    }
+    if (receiver.empty()) {
+        return "";
+    }
+    std::string rate = std::to_string(hits * 100 / counts.calls) + "% of " + std::to_string(counts.calls) +
+                       " calls in the profile";
+    Class *clazz = gen.project->getClassByName(receiver);
+    Method *method = clazz ? find_called_method(gen.project, receiver, node->methodName) : nullptr;
+    if (hits * 100 < counts.calls * PGO_GUARD_PERCENT || !method) {
+        gen.remark("missed", "speculate", "call of " + name + " is not guarded, its most frequent receiver `" +
+                                          receiver + "` has " + rate);
+        receiver.clear();
+        return "";
+    }
+
+    std::string owner = get_method_reference_name(gen.project, clazz, node->methodName);
+    Class *ownerClass = gen.project->getClassByName(owner.substr(0, owner.size() - node->methodName.size() - 1));
+    bool inlined = false;
+    std::string target = get_bound_function(gen, ownerClass, method, counts.calls, inlined);
+    if (target.empty()) {
+        receiver.clear();
+        return "";
+    }
+    gen.stats.guardedCalls++;
+    gen.stats.guards.push_back({gen.line, receiver, ownerClass->getName() + "." + node->methodName, inlined,
+                                counts.calls, hits});
+    gen.remark("passed", "speculate", "call of " + name + " is guarded for receivers of `" + receiver + "` (" +
+                                      rate + "), `" + ownerClass->getName() + "." + node->methodName + "` is " +
+                                      (inlined ? "inlined" : "called directly") + " when the guard holds");
+    return target;
+}
+
+/**
+ * @brief Emits the C call of a method and stores its result (if any) in a temporary variable.
+ *
+ * If the method can throw (it declares `throws`), the pending exception is tested after the call and
+ * thrown again to the enclosing handler or caller (see `ThreeAddressCodeGenerator::throwNow`):
+ * ```c
+ * int $_t_0 = Parser_parse(super, input);
+ * if ($_exception_pending()) goto try_handler_0;
+ * ```
+ * An instrumented build counts the calls of the call site before the call, and the class of the receiver of a
+ * dispatched call.
+ *
+ * A profile-guided build binds the hot call sites to their target (see `bind_hot_call`), or guards them for
+ * their most frequent receiver (see `guard_hot_call`). The development build keeps the dispatch, a reloaded
+ * class replaces the methods of the running program:
+ * ```c
+ * #ifndef MINIJAVA_HOT_RELOAD
+ *     int $_t_1;
+ *     if (((__object *) shape)->$class == $_class_Square) {
+ *         $_t_1 = $_inline_Square_area(shape, $_t_0);
+ *     } else {
+ *         $_t_1 = shape->$_function_area(shape, $_t_0);
+ *     }
+ * #else
+ *     int $_t_1 = shape->$_function_area(shape, $_t_0);
+ * #endif
+ * ```
+ *
+ * @param gen TAC generator context
+ * @param node MethodCall AST node
+ * @param function The C expression of the function to call
+ * @param argumentTemps The leading arguments (e.g., the receiver), call arguments are appended
+ * @param className The class (or interface) the method is looked up in
+ * @param dispatch How the call is dispatched: `static`, `virtual` or `interface` (see `report_method_call`)
+ * @param owner The class declaring the method if the call may be bound to it (a static method, or an instance
+ *              method no subclass overrides), empty otherwise
+ * @return Temporary variable containing the return value (if any)
+ */
+std::string emitMethodCall(
+        ThreeAddressCodeGenerator &gen,
+        MethodCall *node,
+        const std::string &function,
+        std::vector<std::string> &argumentTemps,
+        const Identifier &className,
+        const std::string &dispatch,
+        const Identifier &owner = ""
+) {
+    for (const auto &arg: node->arguments) {
+        std::string argTemp = generate(gen, arg.get());
+        argumentTemps.push_back(argTemp);
+    }
+
+    if (gen.profile) {
+        int counter = gen.profile->add(gen.method->getName(), "call", node->callerType + "." + node->methodName,
+                                       gen.line);
+        gen.emit(ProfileSites::count(counter));
+        if (dispatch != "static") {
+            // A counter per class the receiver may be of, by class id: the class and its subclasses have
+            // consecutive ids, the classes implementing an interface may have any
+            Class *root = dispatch == "virtual" ? gen.project->getClassByName(className) : nullptr;
+            int first = -1;
+            for (Class *clazz: get_classes_by_id(gen.project, root)) {
+                int counter_ = gen.profile->add(gen.method->getName(), "receiver", clazz->getName(), gen.line);
+                first = first < 0 ? counter_ : first;
+            }
+            std::string offset = "((__object *) " + argumentTemps[0] + ")->$class";
+            if (root) {
+                offset += " - $_class_" + className;
+            }
+            gen.emit(ProfileSites::count(first, offset));
+        }
+    }
+    const CallCount *counts = gen.nextCall();
+
+    if (node == gen.spawnCall) {
+        // The call is spawned as a task, see generate(SpawnStatement*)
+        report_method_call(gen, node, className, dispatch);
+        gen.spawnFunction = function;
+        gen.spawnArguments = argumentTemps;
+        return "";
+    }
+
+    std::vector<std::string> boundTemps = argumentTemps;
+    std::string bound;
+    std::string guarded;
+    Identifier receiver;
+    if (counts && counts->calls >= PGO_HOT_CALLS && !owner.empty()) {
+        bound = bind_hot_call(gen, node, owner, counts->calls, boundTemps);
+    }
+    if (bound.empty()) {
+        report_method_call(gen, node, className, dispatch);
+        if (counts && counts->calls >= PGO_HOT_CALLS && dispatch != "static") {
+            guarded = guard_hot_call(gen, node, className, *counts, receiver);
+        }
+    }
+
+    std::string resultTemp = node->type != "void" ? gen.tempGen.newTemp() : "";
+    auto emitCall = [&](const std::string &target, const std::vector<std::string> &temps, bool declare) {
+        std::string argumentList;
+        for (size_t i = 0; i < temps.size(); ++i) {
+            if (i > 0) argumentList += ", ";
+            argumentList += temps[i];
+        }
+        if (!resultTemp.empty()) {
+            gen.emit((declare ? get_type(node->type) : "") + resultTemp + " = " + target + "(" + argumentList + ")");
+        } else {
+            gen.emit(target + "(" + argumentList + ")");
+        }
+    };
+    if (!bound.empty()) {
+        gen.emitDirective("#ifndef MINIJAVA_HOT_RELOAD");
+        emitCall(bound, boundTemps, true);
+        gen.emitDirective("#else");
+        emitCall(function, argumentTemps, true);
+        gen.emitDirective("#endif");
+    } else if (!guarded.empty()) {
+        gen.emitDirective("#ifndef MINIJAVA_HOT_RELOAD");
+        if (!resultTemp.empty()) {
+            gen.emit(get_type(node->type) + resultTemp);
+        }
+        gen.emitLine("if (((__object *) " + argumentTemps[0] + ")->$class == $_class_" + receiver + ") {");
+        gen.depth++;
+        emitCall(guarded, argumentTemps, false);
+        gen.depth--;
+        gen.emitLine("} else {");
+        gen.depth++;
+        emitCall(function, argumentTemps, false);
+        gen.depth--;
+        gen.emitLine("}");
+        gen.emitDirective("#else");
+        emitCall(function, argumentTemps, true);
+        gen.emitDirective("#endif");
+    } else {
+        emitCall(function, argumentTemps, true);
+    }
+
+    if (node->canThrow) {
+        gen.emitLine("if ($_exception_pending()) {");
+        gen.depth++;
+        gen.throwNow();
+        gen.depth--;
+        gen.emitLine("}");
+    }
+    return resultTemp;
 }
 
 /**
@@ -109,43 +516,215 @@ std::string generateMethodCall(
     }
     argumentTemps.push_back(callerTmpArg);
 
-    for (const auto &arg: node->arguments) {
-        std::string argTemp = generate(gen, arg.get());
-        argumentTemps.push_back(argTemp);
+    // A method no subclass overrides may be bound to its declaration by a profile-guided build
+    std::string owner;
+    Class *callerClass = gen.project->getClassByName(node->callerType);
+    if (gen.pgo && callerClass && get_overriding_classes(gen.project, node->callerType, node->methodName).empty()) {
+        owner = get_method_reference_name(gen.project, callerClass, node->methodName);
+        owner = owner.empty() ? "" : owner.substr(0, owner.size() - node->methodName.size() - 1);
     }
 
-    std::string argumentList;
-    for (size_t i = 0; i < argumentTemps.size(); ++i) {
-        if (i > 0) argumentList += ", ";
-        argumentList += argumentTemps[i];
+    std::string method = callerTmp + (climbed ? "." : "->") + "$_function_" + node->methodName;
+    return emitMethodCall(gen, node, method, argumentTemps, node->callerType, "virtual", owner);
+}
+
+/**
+ * @brief Generates TAC for calls of a method of an interface.
+ *
+ * The implementation is found in the itable of the class of the receiver, indexed by the class id in its
+ * header (see `generate_interface`).
+ *
+ * Example:
+ * ```java
+ * shape.scale(2)
+ * ```
+ * Generated TAC:
+ * ```c
+ * int $_t_0 = $_itable_of_Shape(shape)->scale(shape, 2);
+ * ```
+ *
+ * @param gen TAC generator context
+ * @param node MethodCall AST node
+ * @param caller The C expression of the receiver
+ * @param interfaceName The interface declaring the method
+ * @return Temporary variable containing the return value (if any)
+ */
+std::string generateInterfaceMethodCall(
+        ThreeAddressCodeGenerator &gen,
+        MethodCall *node,
+        const std::string &caller,
+        const Identifier &interfaceName
+) {
+    gen.newObject(interfaceName);
+    std::string callerTmp = caller;
+    if (!isIdentifier(caller)) {
+        callerTmp = gen.tempGen.newTemp();
+        gen.emit(get_type(interfaceName) + callerTmp + " = " + caller);
     }
+    std::vector<std::string> argumentTemps = {callerTmp};
+    std::string method = "$_itable_of_" + interfaceName + "(" + callerTmp + ")->" + node->methodName;
+    return emitMethodCall(gen, node, method, argumentTemps, interfaceName, "interface");
+}
 
-    std::string resultTemp;
-    std::string method = callerTmp + (climbed ? "." : "->") + "$_function_" + node->methodName;
+/**
+ * @brief Generates TAC for static method calls.
+ *
+ * Static methods have no receiver, so they are called directly by their C function name
+ * instead of an indirect call through a `$_function_` pointer.
+ *
+ * Example:
+ * ```java
+ * MathUtil.max(a, b)
+ * ```
+ * Generated TAC:
+ * ```c
+ * int $_t_0 = MathUtil_max(a, b);
+ * ```
+ *
+ * @param gen TAC generator context
+ * @param node MethodCall AST node
+ * @param owner The class declaring the static method
+ * @return Temporary variable containing the return value (if any)
+ */
+std::string generateStaticMethodCall(
+        ThreeAddressCodeGenerator &gen,
+        MethodCall *node,
+        const Identifier &owner
+) {
+    gen.newObject(owner);
+    std::vector<std::string> argumentTemps;
+    return emitMethodCall(gen, node, owner + "_" + node->methodName, argumentTemps, owner, "static", owner);
+}
 
-    if (node->type != "void") {
-        resultTemp = gen.tempGen.newTemp();
-        gen.emit(get_type(node->type) + resultTemp + " = " + method + "(" + argumentList + ")");
-        return resultTemp;
+/**
+ * @brief Generates TAC for the methods of `String`.
+ *
+ * `length()` and `charAt(int)` are compiled inline: the length is stored in the string and
+ * `charAt` reads the flat data directly (a rope is flattened once, on the first access).
+ *
+ * Example:
+ * ```java
+ * s.length()
+ * s.charAt(i)
+ * ```
+ * Generated TAC:
+ * ```c
+ * int $_t_0 = s->length;
+ * int $_t_1 = $_string_char_at(s, i);
+ * ```
+ *
+ * @param gen TAC generator context
+ * @param node MethodCall AST node
+ * @param caller The string reference
+ * @return Temporary variable containing the return value
+ */
+std::string generateStringMethodCall(
+        ThreeAddressCodeGenerator &gen,
+        MethodCall *node,
+        const std::string &caller
+) {
+    gen.stats.inlinedCalls++;
+    gen.remark("passed", "inline", "`String." + node->methodName + "` is inlined" +
+                                   (node->methodName == "length" ? " as a load of the length" : ""));
+    std::string resultTemp = gen.tempGen.newTemp();
+    if (node->methodName == "length") {
+        gen.emit(get_type(node->type) + resultTemp + " = " + caller + "->length");
     } else {
-        gen.emit(method + "(" + argumentList + ")");
+        std::string index = generate(gen, node->arguments[0].get());
+        gen.emit(get_type(node->type) + resultTemp + " = $_string_char_at(" + caller + ", " + index + ")");
+    }
+    return resultTemp;
+}
+
+/**
+ * @brief Generates TAC for the methods of `Channel` and `SpscChannel`.
+ *
+ * `send(int)` and `recv()` are inlined fast paths of the ring buffer, they only call the runtime
+ * when the channel is full or empty (see `write_channel`).
+ *
+ * Example:
+ * ```java
+ * c.send(x)
+ * c.recv()
+ * ```
+ * Generated TAC:
+ * ```c
+ * $_channel_send(c, x);
+ * int $_t_0 = $_channel_recv(c);
+ * ```
+ *
+ * @param gen TAC generator context
+ * @param node MethodCall AST node
+ * @param caller The C expression of the channel
+ * @return Temporary variable containing the received value, or an empty string for `send`
+ */
+std::string generateChannelMethodCall(
+        ThreeAddressCodeGenerator &gen,
+        MethodCall *node,
+        const std::string &caller
+) {
+    gen.stats.inlinedCalls++;
+    gen.remark("passed", "inline", "`Channel." + node->methodName + "` is inlined, its fast path only calls the "
+                                                                     "runtime when the channel is " +
+                                   (node->methodName == "send" ? "full" : "empty"));
+    if (node->methodName == "send") {
+        std::string value = generate(gen, node->arguments[0].get());
+        gen.emit("$_channel_send(" + caller + ", " + value + ")");
         return "";
     }
+    std::string resultTemp = gen.tempGen.newTemp();
+    gen.emit(get_type(node->type) + resultTemp + " = $_channel_recv(" + caller + ")");
+    return resultTemp;
+}
+
+/**
+ * @brief Generates TAC for a method of the `int[]` type.
+ *
+ * `slice(from, to)` creates a view sharing the storage of the array (see `write_int_array`).
+ *
+ * Example:
+ * ```java
+ * arr.slice(0, mid)
+ * ```
+ * Generated TAC:
+ * ```c
+ * __int_array *$_t_0 = $_int_array_slice(arr, 0, mid);
+ * ```
+ *
+ * @param gen TAC generator context
+ * @param node MethodCall AST node
+ * @param caller The C expression of the array
+ * @return Temporary variable containing the result
+ */
+std::string generateIntArrayMethodCall(
+        ThreeAddressCodeGenerator &gen,
+        MethodCall *node,
+        const std::string &caller
+) {
+    std::string from = generate(gen, node->arguments[0].get());
+    std::string to = generate(gen, node->arguments[1].get());
+    gen.stats.directCalls++;
+    std::string resultTemp = gen.tempGen.newTemp();
+    gen.emit(get_type(node->type) + resultTemp + " = $_int_array_slice(" + caller + ", " + from + ", " + to + ")");
+    return resultTemp;
 }
 
 /**
  * @brief Handles System.out.print operations.
  *
  * Special case handler for System.out.print/println/printf operations,
- * converting them to appropriate C printf calls.
+ * converting them to appropriate C printf calls. Strings are written by `$_string_print`,
+ * which writes the characters (or the leaves of a rope) directly without copying them.
  *
  * Example:
  * ```java
  * System.out.println(24)
+ * System.out.println(s)
  * ```
  * Generated TAC:
  * ```java
  * printf("%d\\n", 24);
+ * $_string_print(s, true);
  * ```
  *
  * @param gen TAC generator context
@@ -169,6 +748,12 @@ bool generatePrint(
         return false;
     }
     MethodCall *mc = ((MethodCall *) reference->chain[2].second.get());
+    if (mc->arguments.size() == 1 && mc->arguments[0]->type == "String") {
+        std::string value = generate(gen, &mc->arguments[0]);
+        bool newLine = reference->chain[2].first.lexeme == "println";
+        gen.emit("$_string_print(" + value + ", " + (newLine ? "true" : "false") + ")");
+        return true;
+    }
     if (mc->arguments.size() != 1 || mc->arguments[0]->type != "int") {
         return false;
     }
@@ -191,6 +776,11 @@ bool generatePrint(
  *
  * The function maintains type information throughout the chain and handles:
  * - Inheritance (climbing the class hierarchy)
+ * - Static members (`ClassName.field`, `ClassName.method()`), lowered to C globals and direct calls
+ * - `String` methods (`length()`, `charAt(i)`), compiled inline
+ * - `int[]` views (`slice(from, to)`)
+ * - Channel operations (`send(x)`, `recv()`)
+ * - Methods of interfaces, dispatched through the itable of the receiver
  * - Pointer vs. dot notation in generated code
  * - Special cases like `this` and `System.out.println`
  *
@@ -276,6 +866,7 @@ std::string generate(
 
     for (size_t i = 0; i < reference->chain.size() - (getMethod ? 0 : 1); ++i) {
         const auto &entry = reference->chain[i];
+        gen.at(entry.first);
 
         if (i == 0) {
             if (entry.first.lexeme == "this") {
@@ -291,7 +882,11 @@ std::string generate(
                     currentType = gen.clazz->getName();
                 } else if (entry.second->getType() == ASTType::AST_ArrayCall) {
                     std::string localType = gen.lookup(entry.first.lexeme);
-                    if (localType.empty()) {
+                    Class *owner = localType.empty() ? gen.lookupFieldOwner(entry.first.lexeme) : nullptr;
+                    if (owner && owner->getField(entry.first.lexeme)->isStatic()) {
+                        gen.newObject(owner->getName());
+                        output = get_static_field_name(owner->getName(), entry.first.lexeme);
+                    } else if (localType.empty()) {
                         int nestedCount = gen.lookupClassNestedCount(entry.first.lexeme, currentType);
                         for (int j = 0; j < nestedCount; ++j) {
                             if (j == 0) {
@@ -300,8 +895,10 @@ std::string generate(
                                 output += "super.";
                             }
                         }
+                        output += entry.first.lexeme;
                     } else {
                         currentType = localType;
+                        output += entry.first.lexeme;
                     }
                     ArrayCall *ac = ((ArrayCall *) entry.second.get());
                     output = generateArrayCall(gen, ac, output);
@@ -320,7 +917,17 @@ std::string generate(
                 }
             } else {
                 std::string localType = gen.lookup(entry.first.lexeme);
-                if (localType.empty()) {
+                Class *owner = localType.empty() ? gen.lookupFieldOwner(entry.first.lexeme) : nullptr;
+                if (owner && owner->getField(entry.first.lexeme)->isStatic()) {
+                    gen.newObject(owner->getName());
+                    output = get_static_field_name(owner->getName(), entry.first.lexeme);
+                    currentType = owner->getField(entry.first.lexeme)->getTypeLexeme();
+                } else if (localType.empty() && !owner && gen.project->containsClass(entry.first.lexeme)) {
+                    // `ClassName.member`, the static member is resolved by the next entry
+                    currentType = entry.first.lexeme;
+                    currentTable = SymbolTable::getClassSymbolTable(currentType);
+                    continue;
+                } else if (localType.empty()) {
                     int nestedCount = gen.lookupClassNestedCount(entry.first.lexeme, currentType);
                     for (int j = 0; j < nestedCount; ++j) {
                         if (j == 0) {
@@ -357,6 +964,74 @@ std::string generate(
             continue;
         }
 
+        if (currentType == "int[]" && entry.second && entry.second->getType() == ASTType::AST_MethodCall) {
+            output = generateIntArrayMethodCall(gen, (MethodCall *) entry.second.get(), output);
+            currentType = entry.second->type;
+            currentTable = nullptr;
+            isPointer = true;
+            continue;
+        }
+
+        if (currentType == "String" && entry.second) {
+            output = generateStringMethodCall(gen, (MethodCall *) entry.second.get(), output);
+            currentType = entry.second->type;
+            currentTable = nullptr;
+            isPointer = true;
+            continue;
+        }
+
+        if (SymbolTable::isChannelType(currentType) && entry.second) {
+            output = generateChannelMethodCall(gen, (MethodCall *) entry.second.get(), output);
+            currentType = entry.second->type;
+            currentTable = nullptr;
+            isPointer = true;
+            continue;
+        }
+
+        if (currentTable && currentTable->isInterface() && entry.second) {
+            output = generateInterfaceMethodCall(gen, (MethodCall *) entry.second.get(), output, currentType);
+            currentType = entry.second->type;
+            currentTable = SymbolTable::getClassSymbolTable(currentType);
+            isPointer = true;
+            continue;
+        }
+
+        SymbolTable *ownerTable = currentTable;
+        Symbol *member = nullptr;
+        while (!member && ownerTable) {
+            member = ownerTable->find(fieldOrMethod);
+            if (!member) {
+                ownerTable = ownerTable->getParent();
+            }
+        }
+
+        if (member && member->isStatic) {
+            // Static members are C globals and functions, the receiver is not needed
+            const Identifier &owner = ownerTable->getClassName();
+            gen.newObject(owner);
+            if (!entry.second) {
+                output = get_static_field_name(owner, fieldOrMethod);
+                currentType = member->type;
+            } else if (entry.second->getType() == ASTType::AST_MethodCall) {
+                output = generateStaticMethodCall(gen, (MethodCall *) entry.second.get(), owner);
+                currentType = entry.second->type;
+            } else {
+                ArrayCall *ac = ((ArrayCall *) entry.second.get());
+                output = generateArrayCall(gen, ac, get_static_field_name(owner, fieldOrMethod));
+                currentType = entry.second->type;
+            }
+            isPointer = true;
+            currentTable = SymbolTable::getClassSymbolTable(currentType);
+            continue;
+        }
+
+        if (isPointer && output != "super" && needs_null_check(gen.project, currentType)) {
+            // The member may be beyond the guard page, a fault wouldn't be reported (see `write_null_handler`)
+            gen.remark("analysis", "null-check", "access of `" + fieldOrMethod + "` is null checked, `" +
+                                                 currentType + "` is larger than the guard page");
+            output = "((" + currentType + " *) $_null_check(" + output + "))";
+        }
+
         std::string beforeClimb = output;
         bool climbed = false;
         Symbol *field = nullptr;
@@ -394,7 +1069,7 @@ std::string generate(
             } else if (caller->getType() == ASTType::AST_ArrayCall) {
                 output += isPointer ? "->" : ".";
                 ArrayCall *ac = ((ArrayCall *) caller.get());
-                output = generateArrayCall(gen, ac, output);
+                output = generateArrayCall(gen, ac, output + ac->arrayName);
             } else {
                 output = generate(gen, caller.get());
             }
@@ -1,5 +1,6 @@
 #include "../../internal/generator_tac.h"
 #include "../../../lexer/include/token_matcher.h"
+#include <algorithm>
 
 /**
  * @brief Generates the negated form of a boolean condition.
@@ -28,6 +29,27 @@ std::string not_condition(const std::string &condition) {
     }
 }
 
+/**
+ * @brief Converts a value to a `String`, used by string concatenation.
+ *
+ * Example:
+ * ```c
+ * to_string_value("int", "x") → "$_string_from_int(x)"
+ * ```
+ *
+ * @param type The Mini-Java type of the value (`String`, `int` or `boolean`).
+ * @param value The value to convert.
+ * @return A C expression of type `__string *`.
+ */
+std::string to_string_value(const std::string &type, const std::string &value) {
+    if (type == "int") {
+        return "$_string_from_int(" + value + ")";
+    } else if (type == "boolean") {
+        return "$_string_from_bool(" + value + ")";
+    }
+    return value;
+}
+
 /**
  * @brief Generates TAC for a binary expression (e.g., `x + y`).
  *
@@ -40,6 +62,8 @@ std::string not_condition(const std::string &condition) {
  *
  * Special handling is provided for the unsigned right shift operator (`>>>`),
  * which is translated to C using explicit casting to achieve unsigned behavior.
+ * String concatenation (`+` with a `String` operand) is translated to `$_string_concat`,
+ * which creates a rope node instead of copying both operands.
  *
  * The function:
  * - Recursively generates TAC for the left and right operands.
@@ -56,6 +80,7 @@ std::string not_condition(const std::string &condition) {
  * ```c
  * int temp1 = x + y;
  * int temp2 = (int)((unsigned int)(a) >> b);
+ * __string *temp3 = $_string_concat(s, $_string_from_int(x));
  * ```
  *
  * @param gen The TAC generator context.
@@ -63,10 +88,15 @@ std::string not_condition(const std::string &condition) {
  * @return The name of the temporary variable storing the result.
  */
 std::string generate(ThreeAddressCodeGenerator &gen, BinaryExpression *node) {
+    gen.at(node->op);
     std::string leftTemp = generate(gen, &node->left);
     std::string rightTemp = generate(gen, &node->right);
     std::string result = gen.tempGen.newTemp();
-    if (node->op.lexeme == ">>>") {
+    if (node->type == "String") {
+        gen.emit(get_type(node->type) + result + " = $_string_concat(" +
+                 to_string_value(node->left->type, leftTemp) + ", " +
+                 to_string_value(node->right->type, rightTemp) + ")");
+    } else if (node->op.lexeme == ">>>") {
         gen.emit(get_type(node->type) + result + " = (int) ((unsigned int) (" + leftTemp + ") >> " + rightTemp + ")");
     } else {
         gen.emit(get_type(node->type) + result + " = " + leftTemp + " " + node->op.lexeme + " " + rightTemp);
@@ -137,6 +167,25 @@ std::string generate(ThreeAddressCodeGenerator &gen, BooleanASTNode *node) {
     return node->token.lexeme;
 }
 
+/**
+ * @brief Generates TAC for a string literal.
+ *
+ * The literal is interned into the constant pool of the program, equal literals share the same
+ * pooled `String` and no code is emitted to create it.
+ *
+ * Example:
+ * ```c
+ * "Hello"; // Returned as "$_string_literal(0)"
+ * ```
+ *
+ * @param gen The TAC generator context.
+ * @param node The `StringASTNode` representing the string literal.
+ * @return The reference to the pooled string.
+ */
+std::string generate(ThreeAddressCodeGenerator &gen, StringASTNode *node) {
+    return gen.internString(node->value);
+}
+
 /**
  * @brief Generates TAC for an assignment statement.
  *
@@ -144,6 +193,7 @@ std::string generate(ThreeAddressCodeGenerator &gen, BooleanASTNode *node) {
  * ```java
  * x = expr;    // Simple assignment
  * x += expr;   // Compound assignment
+ * s += expr;   // String append, `s = $_string_concat(s, expr)`
  * ```
  * Example TAC:
  * ```c
@@ -155,9 +205,14 @@ std::string generate(ThreeAddressCodeGenerator &gen, BooleanASTNode *node) {
  * @return The name of the temporary variable storing the assigned value.
  */
 std::string generate(ThreeAddressCodeGenerator &gen, Assignment *node) {
+    gen.at(node->assignmentToken);
     std::string value = generate(gen, &node->expression);
     auto ref = generate(gen, &node->reference);
-    gen.emit(ref + " " + node->assignmentToken.lexeme + " " + value);
+    if (node->reference.type == "String" && node->assignmentToken.lexeme == "+=") {
+        gen.emit(ref + " = $_string_concat(" + ref + ", " + to_string_value(node->expression->type, value) + ")");
+    } else {
+        gen.emit(ref + " " + node->assignmentToken.lexeme + " " + value);
+    }
     return value;
 }
 
@@ -173,15 +228,29 @@ std::string generate(ThreeAddressCodeGenerator &gen, Assignment *node) {
  * return x + y; // Emits `return temp1;`
  * ```
  *
+ * A method spawning calls waits for them (`$_fj_sync`) before the expression is evaluated.
+ * The monitors of the enclosing `synchronized` blocks and method are exited after the expression
+ * is evaluated, innermost first.
+ *
  * @param gen The TAC generator context.
  * @param node The `ReturnStatement` node.
  * @return An empty string as no intermediate result is produced.
  */
 std::string generate(ThreeAddressCodeGenerator &gen, ReturnStatement *node) {
+    if (gen.forkJoin) {
+        gen.emit("$_fj_sync(&$_fj_frame)");
+    }
     if (node->expr) {
         std::string value = generate(gen, &node->expr);
+        if (!gen.monitors.empty()) {
+            std::string temp = gen.tempGen.newTemp();
+            gen.emit(get_type(gen.method->getReturnTypeLexeme()) + temp + " = " + value);
+            gen.exitMonitors(0);
+            value = temp;
+        }
         gen.emit("return " + value);
     } else {
+        gen.exitMonitors(0);
         gen.emit("return");
     }
     return "";
@@ -250,6 +319,7 @@ std::string generate(ThreeAddressCodeGenerator &gen, CodeBlock *node) {
     unsigned long l = node->codes.size();
     for (int i = 0; i < l; i++) {
         auto n = node->codes[i].get();
+        gen.at(n->line);
         generate(gen, n);
 
         if (i != l - 1 &&
@@ -314,6 +384,13 @@ std::string generate(ThreeAddressCodeGenerator &gen, LocalVariableASTNode *node)
  * int temp2 = (int)someValue;
  * ```
  *
+ * Downcasts (e.g., `(ChildClass) parentObj`) are checked at runtime by `$_cast` (see `write_class_table`),
+ * casts to an interface the type doesn't implement are checked by the itable of the interface:
+ * ```c
+ * ChildClass *temp3 = (ChildClass *) $_cast(parentObj, $_class_ChildClass);
+ * Shape *temp4 = (Shape *) $_cast_to_Shape(parentObj);
+ * ```
+ *
  * @param gen The TAC generator context.
  * @param node The CastExpression node containing the target type and expression.
  * @return The name of the temporary variable holding the cast result.
@@ -321,15 +398,190 @@ std::string generate(ThreeAddressCodeGenerator &gen, LocalVariableASTNode *node)
  * Implementation Details:
  * 1. Generates code for the expression being cast
  * 2. Creates a new temporary variable for the result
- * 3. Emits the cast operation with appropriate type information
+ * 3. Emits the cast operation with appropriate type information, checked if it's a downcast
  */
 std::string generate(ThreeAddressCodeGenerator &gen, CastExpression *node) {
     std::string exprTemp = generate(gen, &node->expr);
     std::string resultTemp = gen.tempGen.newTemp();
+    if (SymbolTable::isInterfaceType(node->type) && !SymbolTable::canCast(node->expr->type, node->type)) {
+        gen.newObject(node->type);
+        exprTemp = "$_cast_to_" + node->type + "(" + exprTemp + ")";
+    } else if (SymbolTable::isObjectType(node->type) && !SymbolTable::canCast(node->expr->type, node->type)) {
+        exprTemp = "$_cast(" + exprTemp + ", $_class_" + node->type + ")";
+    }
     gen.emit(get_type(node->type) + resultTemp + " = (" + get_type(node->type) + ") " + exprTemp);
     return resultTemp;
 }
 
+/**
+ * @brief Generates TAC for a runtime type test (`expr instanceof ClassName`).
+ *
+ * If the type of the expression is `ClassName` or one of its subclasses, the test only checks for `null`,
+ * otherwise the class id of the object is checked against the range of `ClassName` (see `write_class_table`).
+ * For an interface, the entry of the class of the object in the itables of the interface is checked.
+ *
+ * Example Mini-Java:
+ * ```java
+ * shape instanceof Circle
+ * ```
+ *
+ * Generated TAC:
+ * ```c
+ * bool temp1 = $_instanceof(shape, $_class_Circle);
+ * ```
+ *
+ * @param gen The TAC generator context.
+ * @param node The InstanceOfExpression node.
+ * @return The name of the temporary variable holding the result of the test.
+ */
+std::string generate(ThreeAddressCodeGenerator &gen, InstanceOfExpression *node) {
+    std::string exprTemp = generate(gen, &node->expr);
+    std::string resultTemp = gen.tempGen.newTemp();
+    if (SymbolTable::canCast(node->expr->type, node->classType.lexeme)) {
+        gen.emit("bool " + resultTemp + " = " + exprTemp + " != NULL");
+    } else if (SymbolTable::isInterfaceType(node->classType.lexeme)) {
+        gen.newObject(node->classType.lexeme);
+        gen.emit("bool " + resultTemp + " = $_instanceof_" + node->classType.lexeme + "(" + exprTemp + ")");
+    } else {
+        gen.emit("bool " + resultTemp + " = $_instanceof(" + exprTemp + ", $_class_" +
+                 node->classType.lexeme + ")");
+    }
+    return resultTemp;
+}
+
+/// The maximum number of operators an arm of `?:` may have to be evaluated speculatively.
+const int MAX_SELECT_COST = 3;
+
+/**
+ * @brief Computes the cost of evaluating an expression speculatively, as an arm of a branch-free select.
+ *
+ * An expression can be speculated if evaluating it has no side effects and can not fail, only literals,
+ * local variables, fields of `this`, and `!`, `~`, `?:` and binary operators (except `/`, `%` and string
+ * concatenation) over them qualify. Method calls, object creation, array accesses and chains such as
+ * `a.b` (`a` may be null) are never speculated.
+ *
+ * @param node The expression to check.
+ * @return The number of operators in the expression, or `-1` if it can not be speculated.
+ */
+int get_select_cost(ASTNode *node) {
+    switch (node->getType()) {
+        case ASTType::AST_NumberASTNode:
+        case ASTType::AST_BooleanASTNode:
+        case ASTType::AST_StringASTNode:
+            return 0;
+        case ASTType::AST_ReferenceASTNode: {
+            auto &reference = ((ReferenceASTNode *) node)->reference;
+            if (reference.chain.size() == 1 && !reference.chain[0].second && !reference.isArrayLength) {
+                return 0;
+            }
+            return -1;
+        }
+        case ASTType::AST_NotExpression: {
+            int cost = get_select_cost(((NotExpression *) node)->expr.get());
+            return cost < 0 ? -1 : cost + 1;
+        }
+        case ASTType::AST_BinaryExpression: {
+            auto binary = (BinaryExpression *) node;
+            if (binary->type == "String" || binary->op.lexeme == "/" || binary->op.lexeme == "%") {
+                return -1;
+            }
+            int left = get_select_cost(binary->left.get());
+            int right = get_select_cost(binary->right.get());
+            return left < 0 || right < 0 ? -1 : left + right + 1;
+        }
+        case ASTType::AST_ConditionalExpression: {
+            auto conditional = (ConditionalExpression *) node;
+            int condition = get_select_cost(conditional->condition.get());
+            int thenCost = get_select_cost(conditional->thenExpr.get());
+            int elseCost = get_select_cost(conditional->elseExpr.get());
+            if (condition < 0 || thenCost < 0 || elseCost < 0) {
+                return -1;
+            }
+            return condition + thenCost + elseCost + 1;
+        }
+        default:
+            return -1;
+    }
+}
+
+/**
+ * @brief Generates TAC for a conditional expression (`condition ? a : b`).
+ *
+ * If both arms are cheap and side-effect-free (see `get_select_cost`), both are evaluated and the
+ * result is selected without a branch, an `int` is selected with a mask, other types with a C select
+ * that compiles to a conditional move:
+ * ```c
+ * bool $_t_0 = a > b;
+ * int $_t_1 = b ^ ((a ^ b) & -(int) ($_t_0)); // a > b ? a : b
+ * ```
+ * Otherwise, only the selected arm is evaluated:
+ * ```c
+ * int $_t_0;
+ * if (!(condition)) goto ternary_else;
+ *     ... // Then arm
+ *     $_t_0 = thenValue;
+ * goto ternary_end;
+ * ternary_else:;
+ *     ... // Else arm
+ *     $_t_0 = elseValue;
+ * ternary_end:;
+ * ```
+ *
+ * @param gen The TAC generator context.
+ * @param node The `ConditionalExpression` node.
+ * @return The name of the temporary variable storing the result.
+ */
+std::string generate(ThreeAddressCodeGenerator &gen, ConditionalExpression *node) {
+    std::string conditionTemp = generate(gen, &node->condition);
+    if (node->type != "int" && node->type != "boolean") {
+        gen.newObject(node->type);
+    }
+
+    // Arms of a subclass type are upcasted to the unified class type
+    auto value = [&node](ASTNode *arm, const std::string &temp) {
+        return arm->type == node->type ? temp : "(" + get_type(node->type) + ") " + temp;
+    };
+
+    int thenCost = get_select_cost(node->thenExpr.get());
+    int elseCost = get_select_cost(node->elseExpr.get());
+    if (thenCost >= 0 && elseCost >= 0 && thenCost <= MAX_SELECT_COST && elseCost <= MAX_SELECT_COST) {
+        gen.remark("passed", "select", std::string("`?:` is a branch-free select, both arms are evaluated and ") +
+                                       (node->type == "int" ? "masked" : "selected by a conditional move"));
+        std::string thenTemp = generate(gen, &node->thenExpr);
+        std::string elseTemp = generate(gen, &node->elseExpr);
+        std::string result = gen.tempGen.newTemp();
+        if (node->type == "int") {
+            gen.emit(get_type(node->type) + result + " = " + elseTemp + " ^ ((" + thenTemp + " ^ " +
+                     elseTemp + ") & -(int) (" + conditionTemp + "))");
+        } else {
+            gen.emit(get_type(node->type) + result + " = " + conditionTemp + " ? " +
+                     value(node->thenExpr.get(), thenTemp) + " : " +
+                     value(node->elseExpr.get(), elseTemp));
+        }
+        return result;
+    }
+
+    gen.remark("missed", "select", thenCost < 0 || elseCost < 0
+                                   ? "`?:` keeps its branch, an arm may have side effects or fail"
+                                   : "`?:` keeps its branch, an arm has more than " +
+                                     std::to_string(MAX_SELECT_COST) + " operators");
+    std::string result = gen.tempGen.newTemp();
+    std::string elseLabel = gen.labelGen.newLabel("ternary_else");
+    std::string endLabel = gen.labelGen.newLabel("ternary_end");
+    gen.emit(get_type(node->type) + result);
+    gen.emitBranch(not_condition(conditionTemp), elseLabel, "?:");
+
+    std::string thenTemp = generate(gen, &node->thenExpr);
+    gen.emit(result + " = " + value(node->thenExpr.get(), thenTemp));
+    gen.emit("goto " + endLabel);
+
+    gen.emitLabel(elseLabel);
+    std::string elseTemp = generate(gen, &node->elseExpr);
+    gen.emit(result + " = " + value(node->elseExpr.get(), elseTemp));
+    gen.emitLabel(endLabel);
+    return result;
+}
+
 /**
  * @brief Generates TAC for an `if` statement, including optional `else` branches.
  *
@@ -352,6 +604,9 @@ std::string generate(ThreeAddressCodeGenerator &gen, CastExpression *node) {
  * if_end:
  * ```
  *
+ * In a profile-guided build, an `else` block that ran more often than the `then` block falls through, the
+ * `then` block is placed after it (`if (condition) goto if_then;`), and a block that never ran is marked cold.
+ *
  * @param gen The TAC generator context.
  * @param node The `IfStatement` node representing the conditional statement.
  * @return An empty string as no intermediate result is produced.
@@ -367,19 +622,50 @@ std::string generate(ThreeAddressCodeGenerator &gen, IfStatement *node) {
         elseLabel = gen.labelGen.newLabel("if_else");
     }
 
+    // The jump of the branch goes to the `else` block (or the end), when the condition is false
+    const BranchCount *counts = gen.peekBranch();
+    bool coldThen = counts && counts->fallthrough == 0;
+    bool coldElse = counts && node->elseBody && counts->taken == 0;
+    if (coldThen || coldElse) {
+        gen.remark("passed", "hot-cold", std::string("`") + (coldThen ? "then" : "else") +
+                                         "` block of `if` never ran in the profile, it is marked cold");
+    }
+
+    if (counts && node->elseBody && counts->taken > counts->fallthrough) {
+        // The `else` block is the hot path, it falls through and the `then` block moves after it. The blocks
+        // are generated in source order, so the sites inside them keep their positions in the profile.
+        gen.remark("passed", "layout", "`if` is laid out `else` block first, its condition was false in " +
+                                       std::to_string(counts->taken) + " of " +
+                                       std::to_string(counts->taken + counts->fallthrough) + " executions");
+        gen.emitBranch(conditionTemp, thenLabel, "if", true);
+        size_t thenStart = gen.code.size();
+        gen.emitLabel(thenLabel, coldThen);
+        generate(gen, node->body.get());
+        std::string thenCode = gen.code.substr(thenStart);
+        gen.code.resize(thenStart);
+
+        gen.emitLabel(elseLabel, coldElse);
+        generate(gen, node->elseBody.get());
+        gen.emit("goto " + endLabel);
+        gen.code += thenCode;
+        gen.markedLine = 0;
+        gen.emitLabel(endLabel);
+        return "";
+    }
+
     if (node->elseBody) {
-        gen.emit("if (" + not_condition(conditionTemp) + ") goto " + elseLabel);
+        gen.emitBranch(not_condition(conditionTemp), elseLabel, "if");
     } else {
-        gen.emit("if (" + not_condition(conditionTemp) + ") goto " + endLabel);
+        gen.emitBranch(not_condition(conditionTemp), endLabel, "if");
     }
 
-    gen.emitLabel(thenLabel);
+    gen.emitLabel(thenLabel, coldThen);
 
     generate(gen, node->body.get());
     gen.emit("goto " + endLabel);
 
     if (node->elseBody) {
-        gen.emitLabel(elseLabel);
+        gen.emitLabel(elseLabel, coldElse);
         generate(gen, node->elseBody.get());
     }
 
@@ -387,6 +673,10 @@ std::string generate(ThreeAddressCodeGenerator &gen, IfStatement *node) {
     return "";
 }
 
+/// The remark of the loops, the TAC keeps one iteration per trip
+const char *const LOOP_NOT_UNROLLED = "loop is not unrolled, the generator emits one iteration per trip and leaves "
+                                      "unrolling to the C compiler";
+
 /**
  * @brief Generates TAC for a `while` or 'do-while' loop.
  *
@@ -420,10 +710,12 @@ std::string generate(ThreeAddressCodeGenerator &gen, WhileStatement *node) {
     if (node->isDoWhile) {
         generate(gen, node->body.get());
         std::string conditionTemp = generate(gen, &node->condition);
-        gen.emit("if (" + not_condition(conditionTemp) + ") goto " + endLabel);
+        gen.remark("missed", "unroll", LOOP_NOT_UNROLLED);
+        gen.emitBranch(not_condition(conditionTemp), endLabel, "do");
     } else {
         std::string conditionTemp = generate(gen, &node->condition);
-        gen.emit("if (" + not_condition(conditionTemp) + ") goto " + endLabel);
+        gen.remark("missed", "unroll", LOOP_NOT_UNROLLED);
+        gen.emitBranch(not_condition(conditionTemp), endLabel, "while");
         generate(gen, node->body.get());
     }
     gen.emit("goto " + startLabel);
@@ -432,6 +724,225 @@ std::string generate(ThreeAddressCodeGenerator &gen, WhileStatement *node) {
     return "";
 }
 
+/**
+ * @brief Checks if generated C code refers to an identifier.
+ *
+ * @param code The generated C code.
+ * @param name The identifier.
+ * @return `true` if the identifier appears in the code as a whole word.
+ */
+bool references_identifier(const std::string &code, const std::string &name) {
+    auto isIdentifierChar = [](char c) {
+        return isalnum((unsigned char) c) || c == '_' || c == '$';
+    };
+    for (size_t pos = code.find(name); pos != std::string::npos; pos = code.find(name, pos + 1)) {
+        size_t end = pos + name.size();
+        if ((pos == 0 || !isIdentifierChar(code[pos - 1])) &&
+            (end >= code.size() || !isIdentifierChar(code[end]))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Returns the C expression of an array named in a method: a local, a static field or a field of `this`.
+ */
+static std::string get_array_variable(ThreeAddressCodeGenerator &gen, const std::string &name) {
+    if (!gen.lookup(name).empty()) {
+        return name;
+    }
+    Class *owner = gen.lookupFieldOwner(name);
+    if (owner && owner->getField(name)->isStatic()) {
+        gen.newObject(owner->getName());
+        return get_static_field_name(owner->getName(), name);
+    }
+    std::string output;
+    Identifier type;
+    int nestedCount = gen.lookupClassNestedCount(name, type);
+    for (int j = 0; j < nestedCount; ++j) {
+        output += j == 0 ? "super->" : "super.";
+    }
+    return output + name;
+}
+
+/**
+ * @brief Generates TAC for a `@Parallel` loop, the iterations are distributed over threads.
+ *
+ * The body is outlined into a function running the iterations `[$from, $to)`. The locals it reads
+ * (read-only, see `ForStatement::analyseParallel`) are passed by value in a context struct, reductions
+ * are computed in private copies (starting from the identity of the reduction) and combined into the
+ * shared local at the end of each chunk. `$_parallel_for` (see `write_parallel`) runs the chunks on
+ * OpenMP or on the built-in thread pool.
+ *
+ * Example Mini-Java:
+ * ```java
+ * @Parallel
+ * for (int i = 0; i < n; i++) {
+ *     sum += a[i];
+ * }
+ * ```
+ *
+ * Generated C:
+ * ```c
+ * typedef struct {
+ *     int $start;
+ *     int $step;
+ *     int *sum;
+ *     __int_array *a;
+ * } $_parallel_Main_run_0_context;
+ *
+ * static void $_parallel_Main_run_0(void *$argument, int $from, int $to) {
+ *     $_parallel_Main_run_0_context *$context = ($_parallel_Main_run_0_context *) $argument;
+ *     int sum = 0;
+ *     __int_array *a = $context->a;
+ *     for (int $k = $from; $k < $to; $k++) {
+ *         int i = (int) ((unsigned int) $context->$start + (unsigned int) $k * $context->$step);
+ *         {
+ *             sum += a->data[i];
+ *         }
+ *         for_update_1:;
+ *     }
+ *     $_parallel_reduce_add($context->sum, sum);
+ * }
+ *
+ * // In the method:
+ * int $_t_0 = (long long) n > 0 ? (int) (((long long) n - 0 + 1 - 1) / 1) : 0;
+ * $_parallel_Main_run_0_context $_t_1 = {0, 1, &sum, a};
+ * $_parallel_for($_parallel_Main_run_0, &$_t_1, $_t_0);
+ * ```
+ *
+ * Arrays that may share storage (see `ParallelOverlap`) are compared first, the chunks run one after
+ * another on the calling thread if they do:
+ * ```c
+ * bool $_t_2 = $_int_array_overlap(arr, b, 1);
+ * if ($_t_2) goto parallel_serial_1;
+ * $_parallel_for($_parallel_Main_run_0, &$_t_1, $_t_0);
+ * goto parallel_end_2;
+ * parallel_serial_1:;
+ * $_parallel_Main_run_0(&$_t_1, 0, $_t_0);
+ * parallel_end_2:;
+ * ```
+ *
+ * @param gen The TAC generator context.
+ * @param node The `ForStatement` node annotated with `@Parallel`.
+ * @return An empty string as for-loops don't produce a value.
+ */
+std::string generate_parallel_for(ThreeAddressCodeGenerator &gen, ForStatement *node) {
+    ParallelLoop *loop = node->parallel.get();
+    std::string name = gen.labelGen.newLabel("$_parallel_" + gen.clazz->getName() + "_" + gen.method->getName());
+    std::string contextType = name + "_context";
+    gen.newObject("__parallel");
+
+    // Outlines the body, the TAC of the method is restored afterward
+    std::string code = std::move(gen.code);
+    int depth = gen.depth;
+    gen.code = "";
+    gen.depth = 2;
+    gen.markedLine = 0;
+    gen.inParallel = true;
+    gen.localVariables.emplace_back();
+    gen.localVariables.back().insert({loop->variable, "int"});
+    std::string updateLabel = gen.labelGen.newLabel("for_update");
+    gen.pushLabel(updateLabel, "");
+    if (node->body) {
+        generate(gen, node->body.get());
+    }
+    gen.emitLabel(updateLabel);
+    gen.popLabel();
+    gen.localVariables.pop_back();
+    gen.inParallel = false;
+    std::string body = std::move(gen.code);
+    gen.code = std::move(code);
+    gen.depth = depth;
+    gen.markedLine = 0;
+
+    // Captures `this` and the locals read by the body
+    std::vector<std::pair<Identifier, Identifier>> captures;
+    if (!gen.method->isStatic() && references_identifier(body, "super")) {
+        captures.emplace_back("super", gen.clazz->getName());
+    }
+    for (auto &reduction: loop->reductions) {
+        captures.emplace_back(reduction.variable, "int");
+    }
+    for (auto &variable: loop->captures) {
+        captures.emplace_back(variable, gen.lookup(variable));
+    }
+
+    std::string fields = "\tint $start;\n\tint $step;\n";
+    std::string locals;
+    std::string reductions;
+    std::string initializer;
+    for (auto &capture: captures) {
+        const Identifier &variable = capture.first;
+        auto reduction = std::find_if(loop->reductions.begin(), loop->reductions.end(),
+                                      [&variable](const ParallelReduction &r) { return r.variable == variable; });
+        if (reduction != loop->reductions.end()) {
+            std::string identity = reduction->op == "+" ? "0" : reduction->op == "min" ? "INT_MAX" : "INT_MIN";
+            std::string function = reduction->op == "+" ? "add" : reduction->op;
+            fields += "\tint *" + variable + ";\n";
+            locals += "\tint " + variable + " = " + identity + ";\n";
+            reductions += "\t$_parallel_reduce_" + function + "($context->" + variable + ", " + variable + ");\n";
+            initializer += ", &" + variable;
+        } else {
+            fields += "\t" + get_type(capture.second) + variable + ";\n";
+            locals += "\t" + get_type(capture.second) + variable + " = $context->" + variable + ";\n";
+            initializer += ", " + variable;
+        }
+    }
+
+    gen.functions += "typedef struct {\n" + fields + "} " + contextType + ";\n\n";
+    gen.functions += "static void " + name + "(void *$argument, int $from, int $to) {\n"
+                     "\t" + contextType + " *$context = (" + contextType + " *) $argument;\n" +
+                     locals +
+                     "\tfor (int $k = $from; $k < $to; $k++) {\n"
+                     "\t\tint " + loop->variable + " = (int) ((unsigned int) $context->$start + "
+                                                   "(unsigned int) $k * $context->$step);\n" +
+                     body +
+                     "\t}\n" +
+                     reductions +
+                     "}\n\n";
+
+    // Runs the iterations [start, bound) on the threads
+    gen.openBlock();
+    std::string start = generate(gen, loop->start);
+    std::string bound = generate(gen, loop->bound);
+    std::string step = std::to_string(loop->step);
+    std::string end = "(long long) " + bound + (loop->inclusive ? " + 1" : "");
+    std::string count = gen.tempGen.newTemp();
+    gen.emit("int " + count + " = " + end + " > " + start + " ? (int) ((" + end + " - " + start + " + " + step +
+             " - 1) / " + step + ") : 0");
+    std::string context = gen.tempGen.newTemp();
+    gen.emit(contextType + " " + context + " = {" + start + ", " + step + initializer + "}");
+    std::string overlap;
+    for (auto &pair: loop->overlaps) {
+        overlap += (overlap.empty() ? "" : " || ") + std::string("$_int_array_overlap(") +
+                   get_array_variable(gen, pair.written) + ", " + get_array_variable(gen, pair.other) + ", " +
+                   (pair.aligned ? "1" : "0") + ")";
+    }
+    std::string serialLabel, endLabel;
+    if (!overlap.empty()) {
+        serialLabel = gen.labelGen.newLabel("parallel_serial");
+        endLabel = gen.labelGen.newLabel("parallel_end");
+        std::string overlaps = gen.tempGen.newTemp();
+        gen.emit("bool " + overlaps + " = " + overlap);
+        gen.emit("if (" + overlaps + ") goto " + serialLabel);
+        gen.remark("analysis", "parallelize", "@Parallel loop runs serially if its arrays share storage, " +
+                                              std::to_string(loop->overlaps.size()) + " pair(s) are compared");
+    }
+    gen.remark("passed", "parallelize", "@Parallel loop is outlined to `" + name + "` and split across the "
+                                                                                   "worker threads");
+    gen.emit("$_parallel_for(" + name + ", &" + context + ", " + count + ")");
+    if (!overlap.empty()) {
+        gen.emit("goto " + endLabel);
+        gen.emitLabel(serialLabel);
+        gen.emit(name + "(&" + context + ", 0, " + count + ")");
+        gen.emitLabel(endLabel);
+    }
+    gen.closeBlock();
+    return "";
+}
+
 /**
  * @brief Generates Three-Address Code (TAC) for a `for` loop statement.
  *
@@ -484,8 +995,13 @@ std::string generate(ThreeAddressCodeGenerator &gen, WhileStatement *node) {
  * - Pushes update/end labels for break/continue statement resolution.
  * - Generates code for each component (init, condition, body, update).
  * - Closes the block scope when done.
+ * - Loops annotated with `@Parallel` are generated by `generate_parallel_for`, unless they are nested
+ *   in another parallel loop.
  */
 std::string generate(ThreeAddressCodeGenerator &gen, ForStatement *node) {
+    if (node->parallel && !gen.inParallel) {
+        return generate_parallel_for(gen, node);
+    }
     gen.openBlock();
     gen.freeze(true);
     if (node->initialization) {
@@ -501,8 +1017,12 @@ std::string generate(ThreeAddressCodeGenerator &gen, ForStatement *node) {
     gen.emitLabel(startLabel);
     if (node->condition) {
         std::string conditionTemp = generate(gen, node->condition.get());;
-        gen.emit("if (" + not_condition(conditionTemp) + ") goto " + endLabel);
+        gen.emitBranch(not_condition(conditionTemp), endLabel, "for");
     }
+    if (node->parallel) {
+        gen.remark("missed", "parallelize", "nested @Parallel loop runs sequentially in the enclosing parallel loop");
+    }
+    gen.remark("missed", "unroll", LOOP_NOT_UNROLLED);
     gen.emitLabel(bodyLabel);
     if (node->body) {
         generate(gen, node->body.get());
@@ -518,6 +1038,508 @@ std::string generate(ThreeAddressCodeGenerator &gen, ForStatement *node) {
     return "";
 }
 
+/**
+ * @brief Checks if the case labels of a `switch` are dense enough for a jump table.
+ *
+ * A `switch` is dense if it has at least 4 case labels and they cover at least half
+ * of the range between the smallest and the largest label.
+ *
+ * @param targets The sorted case labels with their jump targets.
+ * @return `true` if the `switch` should be lowered to a jump table.
+ */
+bool is_dense_switch(const std::vector<std::pair<int, std::string>> &targets) {
+    if (targets.size() < 4) {
+        return false;
+    }
+    long long range = (long long) targets.back().first - targets.front().first + 1;
+    return range <= 2 * (long long) targets.size();
+}
+
+/**
+ * @brief Emits a balanced binary search over sparse case labels.
+ *
+ * The labels are split in halves by comparing against the middle label, ranges of up to 3
+ * labels are compared linearly. Every path ends with a jump to the `default` label.
+ *
+ * Example TAC (labels 1, 10, 100, 1000, 10000):
+ * ```c
+ * if ($_t_0 >= 100) goto switch_search_3;
+ * if ($_t_0 == 1) goto switch_case_0;
+ * if ($_t_0 == 10) goto switch_case_1;
+ * goto switch_end_5;
+ * switch_search_3:;
+ * if ($_t_0 == 100) goto switch_case_2;
+ * ...
+ * ```
+ *
+ * @param gen The TAC generator context.
+ * @param value The temporary variable holding the switched value.
+ * @param targets The sorted case labels with their jump targets.
+ * @param begin First label of the range to search.
+ * @param end End of the range to search (exclusive).
+ * @param defaultLabel Jump target if no label matches.
+ */
+void emit_switch_search(
+        ThreeAddressCodeGenerator &gen,
+        const std::string &value,
+        const std::vector<std::pair<int, std::string>> &targets,
+        size_t begin,
+        size_t end,
+        const std::string &defaultLabel
+) {
+    if (end - begin <= 3) {
+        for (size_t i = begin; i < end; i++) {
+            gen.emit("if (" + value + " == " + std::to_string(targets[i].first) + ") goto " + targets[i].second);
+        }
+        gen.emit("goto " + defaultLabel);
+        return;
+    }
+
+    size_t middle = (begin + end) / 2;
+    std::string upperLabel = gen.labelGen.newLabel("switch_search");
+    gen.emit("if (" + value + " >= " + std::to_string(targets[middle].first) + ") goto " + upperLabel);
+    emit_switch_search(gen, value, targets, begin, middle, defaultLabel);
+    gen.emitLabel(upperLabel);
+    emit_switch_search(gen, value, targets, middle, end, defaultLabel);
+}
+
+/**
+ * @brief Generates Three-Address Code (TAC) for a `switch` statement.
+ *
+ * The switched value is dispatched to the label of its case, then the bodies of the cases are
+ * emitted in source order, so execution falls through from a case to the next one unless it
+ * breaks. The dispatch depends on the density of the case labels:
+ * - **Dense** labels are lowered to a C `switch` of jumps, compiled to a jump table by the C compiler.
+ * - **Sparse** labels are lowered to a balanced binary search (see `emit_switch_search`).
+ *
+ * Example Mini-Java:
+ * ```java
+ * switch (x) {
+ *     case 1: y = 10; break;
+ *     case 2: y = 20;
+ *     default: y++;
+ * }
+ * ```
+ *
+ * Generated TAC (sparse, 2 labels):
+ * ```c
+ * int $_t_0 = x;
+ * if ($_t_0 == 1) goto switch_case_1;
+ * if ($_t_0 == 2) goto switch_case_2;
+ * goto switch_default_3;
+ * switch_case_1:;
+ *     y = 10;
+ *     goto switch_end_0;
+ * switch_case_2:;
+ *     y = 20;
+ * switch_default_3:;
+ *     y += 1;
+ * switch_end_0:;
+ * ```
+ *
+ * Generated dispatch (dense):
+ * ```c
+ * switch ($_t_0) {
+ * case 1: goto switch_case_1;
+ * case 2: goto switch_case_2;
+ * ...
+ * default: goto switch_default_3;
+ * }
+ * ```
+ *
+ * `break` jumps to the end label, `continue` jumps to the continue label of the enclosing loop.
+ *
+ * @param gen The TAC generator context.
+ * @param node The `SwitchStatement` node.
+ * @return An empty string as no intermediate result is produced.
+ */
+std::string generate(ThreeAddressCodeGenerator &gen, SwitchStatement *node) {
+    std::string conditionTemp = generate(gen, &node->condition);
+    std::string value = gen.tempGen.newTemp();
+    gen.emit("int " + value + " = " + conditionTemp);
+
+    std::string endLabel = gen.labelGen.newLabel("switch_end");
+    std::string defaultLabel = endLabel;
+    std::vector<std::string> labels;
+    std::vector<std::pair<int, std::string>> targets;
+    for (auto &switchCase: node->cases) {
+        labels.push_back(gen.labelGen.newLabel(switchCase.isDefault ? "switch_default" : "switch_case"));
+        if (switchCase.isDefault) {
+            defaultLabel = labels.back();
+        } else {
+            targets.emplace_back(switchCase.value, labels.back());
+        }
+    }
+    std::sort(targets.begin(), targets.end());
+
+    std::string labelCount = std::to_string(targets.size()) + (targets.size() == 1 ? " case label" : " case labels");
+    if (is_dense_switch(targets)) {
+        gen.remark("passed", "switch", "`switch` of " + labelCount + " is lowered to a jump table");
+        gen.emitLine("switch (" + value + ") {");
+        for (auto &target: targets) {
+            gen.emitLine("case " + std::to_string(target.first) + ": goto " + target.second + ";");
+        }
+        gen.emitLine("default: goto " + defaultLabel + ";");
+        gen.emitLine("}");
+    } else {
+        gen.remark("missed", "switch", "`switch` of " + labelCount + " is lowered to a binary search, " +
+                                       (targets.size() < 4 ? "a jump table needs 4 labels"
+                                                           : "the labels are too sparse for a jump table"));
+        emit_switch_search(gen, value, targets, 0, targets.size(), defaultLabel);
+    }
+
+    gen.pushLabel(gen.labelStack.empty() ? "" : gen.labelStack.top().first, endLabel, true);
+    for (size_t i = 0; i < node->cases.size(); i++) {
+        gen.emitLabel(labels[i]);
+        generate(gen, node->cases[i].body.get());
+    }
+    gen.emitLabel(endLabel);
+    gen.popLabel();
+    return "";
+}
+
+/**
+ * @brief Generates TAC for a `synchronized` block.
+ *
+ * The lock is evaluated once into a temporary, its monitor is entered before the body and exited after it.
+ * `break`, `continue` and `return` statements leaving the block exit the monitor before jumping
+ * (see `ThreeAddressCodeGenerator::exitMonitors`).
+ *
+ * Example:
+ * ```java
+ * synchronized (this.lock) { count = count + 1; }
+ * ```
+ *
+ * Generated TAC:
+ * ```c
+ * Lock *$_t_0 = super->lock;
+ * $_monitor_enter($_t_0);
+ * {
+ *     count = count + 1;
+ * }
+ * $_monitor_exit($_t_0);
+ * ```
+ *
+ * @param gen The TAC generator context.
+ * @param node The `SynchronizedStatement` node.
+ * @return An empty string as synchronized blocks don't produce a value.
+ */
+std::string generate(ThreeAddressCodeGenerator &gen, SynchronizedStatement *node) {
+    std::string lock = generate(gen, &node->lock);
+    std::string temp = gen.tempGen.newTemp();
+    gen.emit(get_type(node->lock->type) + temp + " = " + lock);
+    gen.emit("$_monitor_enter(" + temp + ")");
+    gen.monitors.push_back(temp);
+    generate(gen, node->body.get());
+    gen.monitors.pop_back();
+    gen.emit("$_monitor_exit(" + temp + ")");
+    return "";
+}
+
+/**
+ * @brief Generates TAC for a `try` statement and its `catch` clauses.
+ *
+ * The body runs with a handler label pushed (see `ThreeAddressCodeGenerator::throwNow`), the non-throwing
+ * path only jumps over the handler. The handler tests the class of the pending exception against each
+ * clause in order, the matching clause clears the exception and binds it to its local. If no clause
+ * matches, the exception is still pending and is thrown to the enclosing handler or caller.
+ *
+ * Example:
+ * ```java
+ * try { x = p.parse(s); } catch (ParseError e) { x = 0; }
+ * ```
+ *
+ * Generated TAC:
+ * ```c
+ * {
+ *     int $_t_0 = p->$_function_parse(p, s);
+ *     if ($_exception_pending()) {
+ *         goto try_handler_0;
+ *     }
+ *     x = $_t_0;
+ * }
+ * goto try_end_1;
+ * try_handler_0:;
+ * void *$_t_1 = $_exception;
+ * if (!$_instanceof($_t_1, $_class_ParseError)) goto catch_2;
+ * {
+ *     $_exception = NULL;
+ *     ParseError *e = (ParseError *) $_t_1;
+ *     x = 0;
+ * }
+ * goto try_end_1;
+ * catch_2:;
+ * return 0;
+ * try_end_1:;
+ * ```
+ *
+ * @param gen The TAC generator context.
+ * @param node The `TryStatement` node.
+ * @return An empty string as try statements don't produce a value.
+ */
+std::string generate(ThreeAddressCodeGenerator &gen, TryStatement *node) {
+    std::string handler = gen.labelGen.newLabel("try_handler");
+    std::string end = gen.labelGen.newLabel("try_end");
+
+    gen.handlers.emplace_back(handler, gen.monitors.size());
+    generate(gen, node->body.get());
+    gen.handlers.pop_back();
+    gen.emit("goto " + end);
+
+    gen.emitLabel(handler);
+    std::string exception = gen.tempGen.newTemp();
+    gen.emit("void *" + exception + " = $_exception");
+    for (auto &clause: node->catches) {
+        const Identifier &type = clause.classType.lexeme;
+        gen.newObject(type);
+        std::string next = gen.labelGen.newLabel("catch");
+        std::string test = SymbolTable::isInterfaceType(type) ? "$_instanceof_" + type + "(" + exception + ")"
+                                                              : "$_instanceof(" + exception + ", $_class_" + type + ")";
+        gen.emit("if (!" + test + ") goto " + next);
+        gen.emitLine("{");
+        gen.depth++;
+        gen.emit("$_exception = NULL");
+        gen.emit(get_type(type) + clause.name.lexeme + " = (" + get_type(type) + ") " + exception);
+        gen.addVariable(clause.name.lexeme, type);
+        generate(gen, clause.body.get());
+        gen.depth--;
+        gen.emitLine("}");
+        gen.emit("goto " + end);
+        gen.emitLabel(next);
+    }
+    gen.throwNow();
+    gen.emitLabel(end);
+    return "";
+}
+
+/**
+ * @brief Generates TAC for a `throw` statement.
+ *
+ * Example:
+ * ```java
+ * throw new ParseError();
+ * ```
+ *
+ * Generated TAC:
+ * ```c
+ * ParseError *$_t_0 = $_new_ParseError();
+ * $_throw($_t_0);
+ * goto try_handler_0;
+ * ```
+ *
+ * @param gen The TAC generator context.
+ * @param node The `ThrowStatement` node.
+ * @return An empty string as throw statements don't produce a value.
+ */
+std::string generate(ThreeAddressCodeGenerator &gen, ThrowStatement *node) {
+    std::string exception = generate(gen, &node->expr);
+    gen.emit("$_throw(" + exception + ")");
+    gen.throwNow();
+    return "";
+}
+
+/**
+ * @brief Checks if a statement contains a `spawn`, the method then needs a fork/join frame.
+ *
+ * @param node The statement to check.
+ * @return `true` if a call is spawned in the statement.
+ */
+bool contains_spawn(ASTNode *node) {
+    if (!node) {
+        return false;
+    }
+    switch (node->getType()) {
+        case ASTType::AST_SpawnStatement:
+            return true;
+        case ASTType::AST_CodeBlock:
+            for (auto &code: ((CodeBlock *) node)->codes) {
+                if (contains_spawn(code.get())) {
+                    return true;
+                }
+            }
+            return false;
+        case ASTType::AST_IfStatement:
+            return contains_spawn(((IfStatement *) node)->body.get()) ||
+                   contains_spawn(((IfStatement *) node)->elseBody.get());
+        case ASTType::AST_WhileStatement:
+            return contains_spawn(((WhileStatement *) node)->body.get());
+        case ASTType::AST_ForStatement:
+            return contains_spawn(((ForStatement *) node)->initialization.get()) ||
+                   contains_spawn(((ForStatement *) node)->update.get()) ||
+                   contains_spawn(((ForStatement *) node)->body.get());
+        case ASTType::AST_SwitchStatement:
+            for (auto &switchCase: ((SwitchStatement *) node)->cases) {
+                if (contains_spawn(switchCase.body.get())) {
+                    return true;
+                }
+            }
+            return false;
+        case ASTType::AST_SynchronizedStatement:
+            return contains_spawn(((SynchronizedStatement *) node)->body.get());
+        case ASTType::AST_TryStatement:
+            for (auto &clause: ((TryStatement *) node)->catches) {
+                if (contains_spawn(clause.body.get())) {
+                    return true;
+                }
+            }
+            return contains_spawn(((TryStatement *) node)->body.get());
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Finds the declaration of a method, starting from a class and climbing its superclasses.
+ *
+ * @param project The project containing the classes.
+ * @param className The class to start from.
+ * @param name The name of the method.
+ * @return The nearest declaration of the method, or `nullptr` if not found.
+ */
+Method *find_method(Project *project, const Identifier &className, const Identifier &name) {
+    Class *clazz = project->getClassByName(className);
+    while (clazz) {
+        for (auto &method: *clazz->getMethods()) {
+            if (method.getName() == name) {
+                return &method;
+            }
+        }
+        if (clazz->getExtends().empty()) {
+            break;
+        }
+        clazz = project->getClassByName(clazz->getExtends());
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Generates C code for a spawned method call (`spawn`).
+ *
+ * The receiver and the arguments are evaluated by the caller, then the call is packed into a task with a
+ * trampoline running it, the task is pushed to the deque of the worker (see `write_forkjoin`) and may be
+ * stolen by an idle worker. The result is written to the target local when the task runs, `$_fj_frame`
+ * of the method counts the pending tasks until `sync`.
+ *
+ * If the worker already has enough queued tasks (`$_fj_should_spawn()` is false), the call runs
+ * immediately as a normal call. This is the sequential cutoff, deep recursions do not create a task per
+ * call, only while there are idle workers to steal them.
+ *
+ * Example Mini-Java:
+ * ```java
+ * int x;
+ * x = spawn this.fib(n - 1);
+ * ```
+ *
+ * Generated C:
+ * ```c
+ * typedef struct {
+ *     __fj_task $task;
+ *     int (*$function)(void *, int);
+ *     void *$this;
+ *     int n;
+ *     int *$result;
+ * } $_spawn_Fib_fib_0;
+ *
+ * static void $_spawn_Fib_fib_0_run(__fj_task *$task) {
+ *     $_spawn_Fib_fib_0 *$spawn = ($_spawn_Fib_fib_0 *) $task;
+ *     *$spawn->$result = $spawn->$function($spawn->$this, $spawn->n);
+ * }
+ *
+ * // In the method:
+ * int $_t_0 = n - 1;
+ * if ($_fj_should_spawn()) {
+ *     $_spawn_Fib_fib_0 *$_t_1 = ($_spawn_Fib_fib_0 *) malloc(sizeof($_spawn_Fib_fib_0));
+ *     $_t_1->$function = super->$_function_fib;
+ *     $_t_1->$this = super;
+ *     $_t_1->n = $_t_0;
+ *     $_t_1->$result = &x;
+ *     $_fj_spawn(&$_fj_frame, &$_t_1->$task, $_spawn_Fib_fib_0_run);
+ * } else {
+ *     x = super->$_function_fib(super, $_t_0);
+ * }
+ * ```
+ *
+ * @param gen The TAC generator context.
+ * @param node The `SpawnStatement` node.
+ * @return An empty string as spawns don't produce a value.
+ */
+std::string generate(ThreeAddressCodeGenerator &gen, SpawnStatement *node) {
+    auto call = (MethodCall *) node->call.chain.back().second.get();
+    gen.newObject("__forkjoin");
+
+    // Evaluates the receiver and the arguments, the call itself is captured by `emitMethodCall`
+    gen.spawnCall = call;
+    generate(gen, &node->call);
+    gen.spawnCall = nullptr;
+    std::string function = gen.spawnFunction;
+    std::vector<std::string> arguments = gen.spawnArguments;
+
+    Method *method = find_method(gen.project, call->callerType, call->methodName);
+    if (!method) {
+        error("Failed to spawn '" + call->methodName + "', method not found in '" + call->callerType + "'",
+              &node->spawnToken);
+    }
+    std::string name = gen.labelGen.newLabel("$_spawn_" + gen.clazz->getName() + "_" + call->methodName);
+
+    std::string signature = call->isStatic ? "(" : "(void *";
+    std::string fields;
+    std::string callArguments = call->isStatic ? "" : "$spawn->$this";
+    for (auto &param: *method->getParams()) {
+        signature += std::string(signature.size() > 1 ? ", " : "") + get_type(&param);
+        fields += "\t" + get_type(&param) + param.getName() + ";\n";
+        callArguments += std::string(callArguments.empty() ? "" : ", ") + "$spawn->" + param.getName();
+    }
+    signature += signature.size() > 1 ? ")" : "void)";
+
+    std::string targetType;
+    std::string cast;
+    if (!node->target.lexeme.empty()) {
+        targetType = gen.lookup(node->target.lexeme);
+        cast = targetType != call->type ? "(" + get_type(targetType) + ") " : "";
+        fields += "\t" + get_type(targetType) + "*$result;\n";
+    }
+
+    gen.functions += "typedef struct {\n"
+                     "\t__fj_task $task;\n"
+                     "\t" + get_type(method->getReturnTypeLexeme()) + "(*$function)" + signature + ";\n" +
+                     (call->isStatic ? "" : "\tvoid *$this;\n") +
+                     fields +
+                     "} " + name + ";\n\n";
+    gen.functions += "static void " + name + "_run(__fj_task *$task) {\n"
+                     "\t" + name + " *$spawn = (" + name + " *) $task;\n"
+                     "\t" + (targetType.empty() ? "" : "*$spawn->$result = " + cast) +
+                     "$spawn->$function(" + callArguments + ");\n"
+                     "}\n\n";
+
+    std::string task = gen.tempGen.newTemp();
+    std::string argumentList;
+    gen.emitLine("if ($_fj_should_spawn()) {");
+    gen.depth++;
+    gen.emit(name + " *" + task + " = (" + name + " *) malloc(sizeof(" + name + "))");
+    gen.emit(task + "->$function = " + function);
+    size_t index = 0;
+    if (!call->isStatic) {
+        gen.emit(task + "->$this = " + arguments[index++]);
+    }
+    for (auto &param: *method->getParams()) {
+        gen.emit(task + "->" + param.getName() + " = " + arguments[index++]);
+    }
+    if (!targetType.empty()) {
+        gen.emit(task + "->$result = &" + node->target.lexeme);
+    }
+    gen.emit("$_fj_spawn(&$_fj_frame, &" + task + "->$task, " + name + "_run)");
+    gen.depth--;
+    gen.emitLine("} else {");
+    gen.depth++;
+    for (size_t i = 0; i < arguments.size(); i++) {
+        argumentList += (i > 0 ? ", " : "") + arguments[i];
+    }
+    gen.emit((targetType.empty() ? "" : node->target.lexeme + " = " + cast) + function + "(" + argumentList + ")");
+    gen.depth--;
+    gen.emitLine("}");
+    return "";
+}
+
 /**
  * @brief Handles generic dispatch for generating TAC from various AST nodes.
  *
@@ -546,10 +1568,16 @@ std::string generate(ThreeAddressCodeGenerator &gen, ASTNode *node) {
             return generate(gen, (NotExpression *) node);
         case ASTType::AST_CastExpression:
             return generate(gen, (CastExpression *) node);
+        case ASTType::AST_InstanceOfExpression:
+            return generate(gen, (InstanceOfExpression *) node);
+        case ASTType::AST_ConditionalExpression:
+            return generate(gen, (ConditionalExpression *) node);
         case ASTType::AST_ReferenceASTNode:
             return generate(gen, (ReferenceASTNode *) node);
         case ASTType::AST_BooleanASTNode:
             return generate(gen, (BooleanASTNode *) node);
+        case ASTType::AST_StringASTNode:
+            return generate(gen, (StringASTNode *) node);
         case ASTType::AST_LocalVariableASTNode:
             return generate(gen, (LocalVariableASTNode *) node);
         case ASTType::AST_IfStatement:
@@ -558,6 +1586,8 @@ std::string generate(ThreeAddressCodeGenerator &gen, ASTNode *node) {
             return generate(gen, (WhileStatement *) node);
         case ASTType::AST_ForStatement:
             return generate(gen, (ForStatement *) node);
+        case ASTType::AST_SwitchStatement:
+            return generate(gen, (SwitchStatement *) node);
         case ASTType::AST_ReturnStatement:
             return generate(gen, (ReturnStatement *) node);
         case ASTType::AST_BreakStatement:
@@ -566,6 +1596,20 @@ std::string generate(ThreeAddressCodeGenerator &gen, ASTNode *node) {
         case ASTType::AST_ContinueStatement:
             gen.continueNow();
             return "";
+        case ASTType::AST_SpawnStatement:
+            return generate(gen, (SpawnStatement *) node);
+        case ASTType::AST_SyncStatement:
+            // A method without `spawn` has no fork/join frame and nothing to wait for
+            if (gen.forkJoin) {
+                gen.emit("$_fj_sync(&$_fj_frame)");
+            }
+            return "";
+        case ASTType::AST_SynchronizedStatement:
+            return generate(gen, (SynchronizedStatement *) node);
+        case ASTType::AST_TryStatement:
+            return generate(gen, (TryStatement *) node);
+        case ASTType::AST_ThrowStatement:
+            return generate(gen, (ThrowStatement *) node);
         case ASTType::AST_MethodCall:
         case ASTType::AST_ArrayCall:
         case ASTType::AST_NewObject:
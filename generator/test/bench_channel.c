@@ -0,0 +1,99 @@
+/**
+ * Throughput benchmark of the channels (`__channel.h`).
+ *
+ * Compile any program first, the runtime is written to the `compile` directory, then:
+ * ```
+ * cc -std=c11 -O2 -Icompile generator/test/bench_channel.c compile/__channel.c compile/__monitor.c \
+ *     -o bench_channel -lpthread
+ * ./bench_channel [capacity] [messages]
+ * ```
+ *
+ * It reports the operations per second of:
+ * - A `SpscChannel` with one producer and one consumer.
+ * - A `Channel` with one producer and one consumer, and with two producers and two consumers.
+ */
+#define _POSIX_C_SOURCE 199309L
+
+#include "__channel.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+typedef struct {
+    __channel *channel;
+    long count;
+    long sum;
+} Worker;
+
+static double now(void) {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (double) time.tv_sec + (double) time.tv_nsec / 1e9;
+}
+
+static void *producer(void *argument) {
+    Worker *worker = (Worker *) argument;
+    for (long i = 1; i <= worker->count; i++) {
+        $_channel_send(worker->channel, (int) (i & 0xFFFF));
+    }
+    return NULL;
+}
+
+static void *consumer(void *argument) {
+    Worker *worker = (Worker *) argument;
+    for (long i = 0; i < worker->count; i++) {
+        worker->sum += $_channel_recv(worker->channel);
+    }
+    return NULL;
+}
+
+static int run(const char *name, int capacity, bool spsc, int pairs, long messages) {
+    __channel *channel = $_new___channel(capacity, spsc);
+    pthread_t producers[pairs], consumers[pairs];
+    Worker produced[pairs], consumed[pairs];
+    long count = messages / pairs;
+
+    double start = now();
+    for (int i = 0; i < pairs; i++) {
+        produced[i] = (Worker) {channel, count, 0};
+        consumed[i] = (Worker) {channel, count, 0};
+        pthread_create(&consumers[i], NULL, consumer, &consumed[i]);
+        pthread_create(&producers[i], NULL, producer, &produced[i]);
+    }
+    long sum = 0;
+    for (int i = 0; i < pairs; i++) {
+        pthread_join(producers[i], NULL);
+        pthread_join(consumers[i], NULL);
+        sum += consumed[i].sum;
+    }
+    double elapsed = now() - start;
+
+    long expected = 0;
+    for (long i = 1; i <= count; i++) {
+        expected += i & 0xFFFF;
+    }
+    expected *= pairs;
+    printf("%-28s %8.2f M ops/s\n", name, (double) count * pairs / elapsed / 1e6);
+    if (sum != expected) {
+        fprintf(stderr, "%s: lost messages, sum %ld (expected %ld)\n", name, sum, expected);
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    int capacity = argc > 1 ? atoi(argv[1]) : 1024;
+    long messages = argc > 2 ? atol(argv[2]) : 10000000;
+    if (capacity < 1 || messages < 4) {
+        fprintf(stderr, "usage: %s [capacity] [messages]\n", argv[0]);
+        return 1;
+    }
+
+    int failed = 0;
+    failed |= run("SpscChannel (1P/1C)", capacity, true, 1, messages);
+    failed |= run("Channel (1P/1C)", capacity, false, 1, messages);
+    failed |= run("Channel (2P/2C)", capacity, false, 2, messages);
+    return failed;
+}
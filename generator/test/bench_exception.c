@@ -0,0 +1,124 @@
+/**
+ * Benchmark of the cost of exceptions on the path that doesn't throw, on the layout of the generated code.
+ *
+ * Calls of methods that can't throw are generated as before, calls of methods declaring `throws` are
+ * followed by a test of the thread-local pending exception (see `write_exception`). For reference, it
+ * also measures a `setjmp` per `try`, the common way to implement exceptions in C.
+ *
+ * It doesn't need the runtime of a compiled program:
+ * ```
+ * cc -std=c11 -O2 generator/test/bench_exception.c -o bench_exception
+ * ./bench_exception [iterations]
+ * ```
+ */
+#define _POSIX_C_SOURCE 199309L
+
+#include <setjmp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define $_exception_pending() __builtin_expect($_exception != 0, 0)
+
+_Thread_local void *$_exception = NULL;
+
+static _Thread_local jmp_buf *handler;
+
+static int error;
+
+__attribute__((noinline)) static int divide(int a, int b) {
+    return b == 0 ? 0 : a / b;
+}
+
+__attribute__((noinline)) static int checked_divide(int a, int b) {
+    if (b == 0) {
+        $_exception = &error;
+        return 0;
+    }
+    return a / b;
+}
+
+__attribute__((noinline)) static int jump_divide(int a, int b) {
+    if (b == 0) {
+        longjmp(*handler, 1);
+    }
+    return a / b;
+}
+
+static double now(void) {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (double) time.tv_sec * 1e9 + (double) time.tv_nsec;
+}
+
+static long plain_calls(long iterations) {
+    long sum = 0;
+    for (long i = 0; i < iterations; i++) {
+        sum += divide((int) i, (int) (i & 7) + 1);
+    }
+    return sum;
+}
+
+static long flag_calls(long iterations) {
+    long sum = 0;
+    for (long i = 0; i < iterations; i++) {
+        int $_t_0 = checked_divide((int) i, (int) (i & 7) + 1);
+        if ($_exception_pending()) {
+            goto try_handler_0;
+        }
+        sum += $_t_0;
+        continue;
+        try_handler_0:;
+        $_exception = NULL;
+        sum -= 1;
+    }
+    return sum;
+}
+
+// One try per call, `i` is not modified between `setjmp` and a `longjmp` to it
+static long setjmp_call(long i) {
+    jmp_buf buffer;
+    jmp_buf *outer = handler;
+    long result;
+    handler = &buffer;
+    if (setjmp(buffer) == 0) {
+        result = jump_divide((int) i, (int) (i & 7) + 1);
+    } else {
+        result = -1;
+    }
+    handler = outer;
+    return result;
+}
+
+static long setjmp_calls(long iterations) {
+    long sum = 0;
+    for (long i = 0; i < iterations; i++) {
+        sum += setjmp_call(i);
+    }
+    return sum;
+}
+
+int main(int argc, char **argv) {
+    long iterations = argc > 1 ? atol(argv[1]) : 100000000;
+    if (iterations < 1) {
+        fprintf(stderr, "usage: %s [iterations]\n", argv[0]);
+        return 1;
+    }
+
+    long (*benchmarks[])(long) = {plain_calls, flag_calls, setjmp_calls};
+    const char *labels[] = {"call (no throws)", "call + pending exception test", "call in setjmp try"};
+    long expected = 0;
+    for (int b = 0; b < 3; b++) {
+        double start = now();
+        long sum = benchmarks[b](iterations);
+        double elapsed = now() - start;
+        printf("%-30s %6.2f ns/call\n", labels[b], elapsed / (double) iterations);
+        if (b == 0) {
+            expected = sum;
+        } else if (sum != expected) {
+            fprintf(stderr, "%s: wrong result %ld (expected %ld)\n", labels[b], sum, expected);
+            return 1;
+        }
+    }
+    return 0;
+}
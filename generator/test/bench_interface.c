@@ -0,0 +1,167 @@
+/**
+ * Benchmark of interface calls against virtual calls, on the layout of the generated code.
+ *
+ * The objects have the header of every object (a monitor and a class id, see `write_class_table`) and a
+ * function pointer per method (virtual calls, `obj->$_function_area(obj)`), interfaces have itables indexed
+ * by the class id (`$_itable_of_Shape(obj)->area(obj)`, see `generate_interface`). For reference, it also
+ * measures an itable found by a linear search of the interfaces of the class, the common alternative.
+ *
+ * It doesn't need the runtime of a compiled program:
+ * ```
+ * cc -std=c11 -O2 generator/test/bench_interface.c -o bench_interface
+ * ./bench_interface [iterations]
+ * ```
+ *
+ * Every call site is measured monomorphic (a single class) and megamorphic (4 classes in turn).
+ */
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define CLASSES 4
+#define INTERFACES 3
+#define OBJECTS 1024
+
+typedef struct Shape Shape;
+
+typedef struct $_itable_Shape {
+    int (*area)(void *);
+} $_itable_Shape;
+
+typedef struct __object {
+    uintptr_t $monitor;
+    int $class;
+} __object;
+
+struct Shape {
+    __object header;
+    int side;
+    int (*$_function_area)(void *);
+};
+
+typedef struct {
+    int id;
+    const void *itable;
+} InterfaceEntry;
+
+typedef struct {
+    InterfaceEntry interfaces[INTERFACES];
+} ClassInfo;
+
+__attribute__((noinline)) static int area0(void *self) { return ((Shape *) self)->side; }
+
+__attribute__((noinline)) static int area1(void *self) { return ((Shape *) self)->side * 2; }
+
+__attribute__((noinline)) static int area2(void *self) { return ((Shape *) self)->side * 3; }
+
+__attribute__((noinline)) static int area3(void *self) { return ((Shape *) self)->side * 4; }
+
+static int (*const areas[CLASSES])(void *) = {area0, area1, area2, area3};
+
+static const $_itable_Shape itables[CLASSES] = {{area0}, {area1}, {area2}, {area3}};
+
+static const $_itable_Shape *const $_itables_Shape[CLASSES] = {
+        &itables[0], &itables[1], &itables[2], &itables[3]
+};
+
+// `Shape` is the last interface of every class, the worst case of the search
+static ClassInfo classInfos[CLASSES];
+
+static inline const $_itable_Shape *$_itable_of_Shape(void *object) {
+    return $_itables_Shape[((__object *) object)->$class];
+}
+
+static inline const $_itable_Shape *search_itable(void *object, int id) {
+    const ClassInfo *info = &classInfos[((__object *) object)->$class];
+    for (int i = 0; i < INTERFACES; i++) {
+        if (info->interfaces[i].id == id) {
+            return (const $_itable_Shape *) info->interfaces[i].itable;
+        }
+    }
+    return NULL;
+}
+
+static double now(void) {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (double) time.tv_sec * 1e9 + (double) time.tv_nsec;
+}
+
+static long virtual_calls(Shape **objects, long iterations) {
+    long sum = 0;
+    for (long i = 0; i < iterations; i++) {
+        Shape *shape = objects[i & (OBJECTS - 1)];
+        sum += shape->$_function_area(shape);
+    }
+    return sum;
+}
+
+static long interface_calls(Shape **objects, long iterations) {
+    long sum = 0;
+    for (long i = 0; i < iterations; i++) {
+        void *shape = objects[i & (OBJECTS - 1)];
+        sum += $_itable_of_Shape(shape)->area(shape);
+    }
+    return sum;
+}
+
+static long search_calls(Shape **objects, long iterations) {
+    long sum = 0;
+    for (long i = 0; i < iterations; i++) {
+        void *shape = objects[i & (OBJECTS - 1)];
+        sum += search_itable(shape, INTERFACES - 1)->area(shape);
+    }
+    return sum;
+}
+
+static int run(const char *name, Shape **objects, long iterations) {
+    long (*benchmarks[])(Shape **, long) = {virtual_calls, interface_calls, search_calls};
+    const char *labels[] = {"virtual call", "interface call (itable)", "interface call (search)"};
+    long expected = 0;
+    for (int b = 0; b < 3; b++) {
+        double start = now();
+        long sum = benchmarks[b](objects, iterations);
+        double elapsed = now() - start;
+        printf("%-12s %-26s %6.2f ns/call\n", name, labels[b], elapsed / (double) iterations);
+        if (b == 0) {
+            expected = sum;
+        } else if (sum != expected) {
+            fprintf(stderr, "%s: wrong result %ld (expected %ld)\n", labels[b], sum, expected);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    long iterations = argc > 1 ? atol(argv[1]) : 100000000;
+    if (iterations < 1) {
+        fprintf(stderr, "usage: %s [iterations]\n", argv[0]);
+        return 1;
+    }
+
+    for (int c = 0; c < CLASSES; c++) {
+        for (int i = 0; i < INTERFACES; i++) {
+            classInfos[c].interfaces[i] = (InterfaceEntry) {i, i == INTERFACES - 1 ? &itables[c] : NULL};
+        }
+    }
+
+    Shape *monomorphic[OBJECTS];
+    Shape *megamorphic[OBJECTS];
+    for (int i = 0; i < OBJECTS; i++) {
+        for (int m = 0; m < 2; m++) {
+            int id = m == 0 ? 0 : i % CLASSES;
+            Shape *shape = (Shape *) malloc(sizeof(Shape));
+            *shape = (Shape) {{0, id}, i, areas[id]};
+            (m == 0 ? monomorphic : megamorphic)[i] = shape;
+        }
+    }
+
+    int failed = 0;
+    failed |= run("monomorphic", monomorphic, iterations);
+    failed |= run("megamorphic", megamorphic, iterations);
+    return failed;
+}
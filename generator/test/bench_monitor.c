@@ -0,0 +1,119 @@
+/**
+ * Contended-counter benchmark of the monitors of `synchronized` (`__monitor.h`).
+ *
+ * Compile any program first, the runtime is written to the `compile` directory, then:
+ * ```
+ * cc -std=c11 -O2 -Icompile generator/test/bench_monitor.c compile/__monitor.c -o bench_monitor -lpthread
+ * ./bench_monitor [threads] [iterations]
+ * ```
+ *
+ * It reports the cost per operation of:
+ * - A bare atomic CAS and release store (the lower bound of a lock).
+ * - An uncontended monitor enter/exit (thin lock), and a recursive one.
+ * - A counter incremented by all the threads under a monitor, and under a pthread mutex.
+ */
+#define _POSIX_C_SOURCE 199309L
+
+#include "__monitor.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+typedef struct {
+    __monitor monitor;
+    long value;
+} Counter;
+
+static Counter counter;
+static pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+static long mutexValue;
+static long iterations;
+
+static double now(void) {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (double) time.tv_sec * 1e9 + (double) time.tv_nsec;
+}
+
+static void *monitor_worker(void *argument) {
+    (void) argument;
+    for (long i = 0; i < iterations; i++) {
+        $_monitor_enter(&counter);
+        counter.value++;
+        $_monitor_exit(&counter);
+    }
+    return NULL;
+}
+
+static void *mutex_worker(void *argument) {
+    (void) argument;
+    for (long i = 0; i < iterations; i++) {
+        pthread_mutex_lock(&mutex);
+        mutexValue++;
+        pthread_mutex_unlock(&mutex);
+    }
+    return NULL;
+}
+
+static double contended(void *(*worker)(void *), int threads) {
+    pthread_t ids[threads];
+    double start = now();
+    for (int i = 0; i < threads; i++) {
+        pthread_create(&ids[i], NULL, worker, NULL);
+    }
+    for (int i = 0; i < threads; i++) {
+        pthread_join(ids[i], NULL);
+    }
+    return (now() - start) / ((double) iterations * threads);
+}
+
+int main(int argc, char **argv) {
+    int threads = argc > 1 ? atoi(argv[1]) : 4;
+    iterations = argc > 2 ? atol(argv[2]) : 10000000;
+    if (threads < 1 || iterations < 1) {
+        fprintf(stderr, "usage: %s [threads] [iterations]\n", argv[0]);
+        return 1;
+    }
+
+    atomic_uintptr_t word = 0;
+    double start = now();
+    for (long i = 0; i < iterations; i++) {
+        uintptr_t expected = 0;
+        atomic_compare_exchange_strong_explicit(&word, &expected, 256, memory_order_acquire, memory_order_relaxed);
+        atomic_store_explicit(&word, 0, memory_order_release);
+    }
+    printf("atomic CAS + store:          %6.2f ns/op\n", (now() - start) / (double) iterations);
+
+    $_monitor_init(&counter);
+    start = now();
+    for (long i = 0; i < iterations; i++) {
+        $_monitor_enter(&counter);
+        counter.value++;
+        $_monitor_exit(&counter);
+    }
+    printf("uncontended monitor:         %6.2f ns/op\n", (now() - start) / (double) iterations);
+
+    $_monitor_enter(&counter);
+    start = now();
+    for (long i = 0; i < iterations; i++) {
+        $_monitor_enter(&counter);
+        counter.value++;
+        $_monitor_exit(&counter);
+    }
+    printf("recursive monitor:           %6.2f ns/op\n", (now() - start) / (double) iterations);
+    $_monitor_exit(&counter);
+
+    counter.value = 0;
+    double monitorCost = contended(monitor_worker, threads);
+    double mutexCost = contended(mutex_worker, threads);
+    printf("contended monitor (%d thr):  %6.2f ns/op\n", threads, monitorCost);
+    printf("contended mutex (%d thr):    %6.2f ns/op\n", threads, mutexCost);
+
+    if (counter.value != iterations * threads || mutexValue != iterations * threads) {
+        fprintf(stderr, "lost updates: %ld, %ld (expected %ld)\n", counter.value, mutexValue, iterations * threads);
+        return 1;
+    }
+    return 0;
+}
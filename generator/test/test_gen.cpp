@@ -1,8 +1,79 @@
+#include <cstring>
 #include <iostream>
+#include <stdexcept>
+#include "../../common/include/profiler.h"
 #include "../../parser/include/parser.h"
+#include "../include/codegen_report.h"
 #include "../include/generator.h"
 
-int main() {
+/**
+ * Options:
+ * - `--time-report`: prints the time spent in every phase of the compiler.
+ * - `--trace out.json`: writes the phases as Chrome trace events (`chrome://tracing`, Perfetto).
+ * - `--mem-report`: prints the memory allocated and retained by every phase and data structure.
+ * - `--codegen-report out.json`: writes the statistics and optimization remarks of every generated method.
+ * - `--remarks`, `--remarks=inline,devirtualize`: prints the optimization remarks (of the given passes).
+ * - `--instrument`: generates a profiling build, the program writes `minijava.profile` when it exits.
+ * - `--profile-use minijava.profile`: generates a build laid out, inlined and placed by the profile.
+ * - `--line-directives`: emits `#line` directives, debuggers and profilers show the lines of the Mini-Java source.
+ * - `--source-map map.json`: writes the lines of the generated C files mapped to the Mini-Java source.
+ * - `--source Main.java`: the path of the Mini-Java source named by the directives and the source map.
+ * - `--run`: compiles the program to machine code in memory and runs it (`run_jit`), no C file is written.
+ * - `--interpret`: compiles the program to bytecode and interprets it (`run_vm`), no C file is written.
+ *
+ * `--run` and `--interpret` support the language subset of the assembly backend, a program outside of it
+ * (e.g., the `spawn` of the demo) is reported and the exit status is 1.
+ */
+int main(int argc, char **argv) {
+    bool timeReport = false;
+    bool memReport = false;
+    std::string tracePath;
+    std::string reportPath;
+    bool remarks = false;
+    std::string remarkPasses;
+    bool run = false;
+    bool interpret = false;
+    GenerateOptions options;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--time-report") == 0) {
+            timeReport = true;
+        } else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            tracePath = argv[++i];
+        } else if (strcmp(argv[i], "--mem-report") == 0) {
+            memReport = true;
+        } else if (strcmp(argv[i], "--codegen-report") == 0 && i + 1 < argc) {
+            reportPath = argv[++i];
+        } else if (strcmp(argv[i], "--remarks") == 0) {
+            remarks = true;
+        } else if (strncmp(argv[i], "--remarks=", 10) == 0) {
+            remarks = true;
+            remarkPasses = argv[i] + 10;
+        } else if (strcmp(argv[i], "--instrument") == 0) {
+            options.instrument = true;
+        } else if (strcmp(argv[i], "--profile-use") == 0 && i + 1 < argc) {
+            options.profile = argv[++i];
+        } else if (strcmp(argv[i], "--line-directives") == 0) {
+            options.lineDirectives = true;
+        } else if (strcmp(argv[i], "--source-map") == 0 && i + 1 < argc) {
+            options.sourceMap = argv[++i];
+        } else if (strcmp(argv[i], "--source") == 0 && i + 1 < argc) {
+            options.sourcePath = argv[++i];
+        } else if (strcmp(argv[i], "--run") == 0) {
+            run = true;
+        } else if (strcmp(argv[i], "--interpret") == 0) {
+            interpret = true;
+        }
+    }
+    if (memReport) {
+        memory::enable();
+    }
+    if (timeReport || !tracePath.empty()) {
+        profiler::enable();
+    }
+    if (remarks || !reportPath.empty()) {
+        codegen_report::enable();
+    }
+
     std::string source_code = R"(
 
 class MergeSortExample {
@@ -12,6 +83,9 @@ class MergeSortExample {
         do x--; while(x > 0);
 
         for(int i = 0; i < 10; i++) System.out.println(i);
+
+        // Nothing was spawned, there is nothing to wait for
+        sync;
     }
 
     public static void main(String[] args) {
@@ -99,29 +173,17 @@ class MergeSort extends Merger {
         int[] left;
         int[] right;
 
-        left = this.subArray(arr, 0, mid);
-        right = this.subArray(arr, mid, arr.length);
+        left = arr.slice(0, mid);
+        right = arr.slice(mid, arr.length);
 
-        // Recursive sorting
-        left = this.sort(left);
+        // Recursive sorting, the left half may be sorted by another worker
+        left = spawn this.sort(left);
         right = this.sort(right);
+        sync;
 
         // Merge the sorted halves
         return this.merge(left, right);
     }
-
-    public int[] subArray(int[] arr, int start, int end) {
-        int[] subArr;
-        int i;
-
-        subArr = new int[end - start];
-        i = 0;
-        while (i < subArr.length) {
-            subArr[i] = arr[start + i];
-            i = i + 1;
-        }
-        return subArr;
-    }
 }
     )";
 
@@ -142,7 +204,32 @@ class MergeSort extends Merger {
     printf("-------\n");
 
     /// Code Generator
-    generate(&project);
+    int status = 0;
+    if (run || interpret) {
+        try {
+            status = run ? run_jit(&project) : run_vm(&project);
+        } catch (const std::runtime_error &e) {
+            std::cerr << "Error: " << e.what() << std::endl;
+            status = 1;
+        }
+    } else {
+        generate(&project, options);
+    }
 
-    return 0;
+    if (timeReport) {
+        profiler::print_time_report(std::cout);
+    }
+    if (!tracePath.empty()) {
+        profiler::write_trace(tracePath);
+    }
+    if (memReport) {
+        memory::print_memory_report(std::cout);
+    }
+    if (!reportPath.empty()) {
+        codegen_report::write_report(reportPath);
+    }
+    if (remarks) {
+        codegen_report::print_remarks(std::cout, remarkPasses);
+    }
+    return status;
 }
@@ -2,6 +2,7 @@
 #include "../include/lexer.h"
 #include "../include/token_matcher.h"
 #include "../include/number_helper.h"
+#include "../../common/include/profiler.h"
 
 /**
  * Enum representing the possible states of the tokenizer during lexical analysis.
@@ -552,6 +553,8 @@ bool consumeHexAndBinary(
  * @return A vector of tokens representing the lexical elements of the source code.
  */
 std::vector<Token> tokenize(const std::string &source) {
+    ScopedTimer timer("tokenize");
+    MemoryCategory category("tokens");
     struct Position blockCommentPositionSaver{};
     struct NumberInfo numberInfo{};
     struct Position position = {
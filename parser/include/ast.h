@@ -17,6 +17,7 @@ enum ASTType {
     AST_BinaryExpression,
     AST_NotExpression,
     AST_CastExpression,
+    AST_ConditionalExpression,
     AST_ReturnStatement,
     AST_BreakStatement,
     AST_ContinueStatement,
@@ -24,6 +25,7 @@ enum ASTType {
     AST_ReferenceASTNode,
     AST_NumberASTNode,
     AST_BooleanASTNode,
+    AST_StringASTNode,
     AST_LocalVariableASTNode,
     AST_Assignment,
     AST_MethodCall,
@@ -31,6 +33,13 @@ enum ASTType {
     AST_IfStatement,
     AST_WhileStatement,
     AST_ForStatement,
+    AST_SwitchStatement,
+    AST_SpawnStatement,
+    AST_SyncStatement,
+    AST_SynchronizedStatement,
+    AST_InstanceOfExpression,
+    AST_TryStatement,
+    AST_ThrowStatement,
 };
 
 /**
@@ -44,6 +53,9 @@ struct ASTNode {
     /// Type of node, resolves after the semantic analysis phase.
     std::string type;
 
+    /// Line of the statement in the Mini-Java source, `0` for expressions and for nodes made by the compiler.
+    int line = 0;
+
     virtual ~ASTNode() = default;
 
     /**
@@ -112,6 +124,12 @@ struct MethodCall : public ASTNode {
     /// Sets by ReferenceChain, before calling analyseSemantics() on this node.
     /// Can be used to determine the scope of the field.
     std::string callerType;
+    /// True if the called method is `static`, resolves after the semantic analysis phase.
+    /// Static methods are called directly, without a receiver.
+    bool isStatic = false;
+    /// True if the called method declares `throws`, resolves after the semantic analysis phase.
+    /// The pending exception is only checked after such calls.
+    bool canThrow = false;
 
     explicit MethodCall(std::string methodName_);
 
@@ -219,6 +237,8 @@ struct ReferenceChain {
      * - Method return types are checked and propagated.
      * - Object creation (`new`) is validated against class declarations.
      * - Special cases, like array `length` references, are resolved appropriately.
+     * - `ClassName.member` references are resolved to static members of `ClassName`,
+     *   and `this` or instance members are rejected inside static methods.
      */
     void analyseSemantics(SymbolTable &symbolTable);
 };
@@ -226,6 +246,9 @@ struct ReferenceChain {
 /**
  * @struct BinaryExpression
  * @brief Represents a binary operation (e.g., `x + y`, `a && b`).
+ *
+ * `+` is also the string concatenation operator: if either operand is a `String`,
+ * the other operand may be a `String`, an `int` or a `boolean` and the result is a `String`.
  */
 struct BinaryExpression : public ASTNode {
     /// Operator node representing the binary operator (e.g., `+`, `&&`).
@@ -333,6 +356,80 @@ struct CastExpression : public ASTNode {
     }
 };
 
+/**
+ * @struct ConditionalExpression
+ * @brief Represents a ternary conditional expression (`condition ? a : b`) in Mini-Java.
+ *
+ * The conditional operator has the lowest precedence of all expressions and is right-associative:
+ * ```java
+ * max = a > b ? a : b;
+ * sign = x > 0 ? 1 : x < 0 ? -1 : 0;  // x > 0 ? 1 : (x < 0 ? -1 : 0)
+ * ```
+ *
+ * Semantic analysis ensures that:
+ * - The condition is of type `boolean`.
+ * - Both arms have the same type, or both are classes with a common superclass,
+ *   which becomes the type of the expression (e.g., `flag ? new B() : new C()` is an `A`
+ *   if `B` and `C` extend `A`).
+ */
+struct ConditionalExpression : public ASTNode {
+    /// The condition selecting the arm, must evaluate to `boolean`.
+    std::unique_ptr<ASTNode> condition;
+
+    /// The value of the expression if the condition is `true`.
+    std::unique_ptr<ASTNode> thenExpr;
+
+    /// The value of the expression if the condition is `false`.
+    std::unique_ptr<ASTNode> elseExpr;
+
+    ConditionalExpression(std::unique_ptr<ASTNode> condition_,
+                          std::unique_ptr<ASTNode> then_,
+                          std::unique_ptr<ASTNode> else_);
+
+    void print(std::ostream &strm, int depth = 0) const override;
+
+    void analyseSemantics(SymbolTable &symbolTable) override;
+
+    ASTType getType() const override {
+        return ASTType::AST_ConditionalExpression;
+    }
+};
+
+/**
+ * @struct InstanceOfExpression
+ * @brief Represents a runtime type test (`expr instanceof ClassName`) in Mini-Java.
+ *
+ * `instanceof` has the precedence of the relational operators, and is `false` if the object is `null`:
+ * ```java
+ * if (shape instanceof Circle) { ... }
+ * ```
+ *
+ * Semantic analysis ensures that:
+ * - The operand is an object and `ClassName` is a class.
+ * - The type of the operand and `ClassName` are related (one extends the other), otherwise the test
+ *   could never be `true`.
+ */
+struct InstanceOfExpression : public ASTNode {
+    /// The `instanceof` token.
+    Token op;
+
+    /// The object being tested.
+    std::unique_ptr<ASTNode> expr;
+
+    /// The class the object is tested against.
+    Token classType;
+
+    InstanceOfExpression(Token op_, std::unique_ptr<ASTNode> expr_, Token classType_);
+
+    void print(std::ostream &strm, int depth = 0) const override;
+
+    void analyseSemantics(SymbolTable &symbolTable) override;
+
+    ASTType getType() const override {
+        return ASTType::AST_InstanceOfExpression;
+    }
+};
+
 /**
  * @struct ReturnStatement
  * @brief Represents a `return` statement in a function or method in Mini-Java.
@@ -447,6 +544,7 @@ struct ContinueStatement : public ASTNode {
  * A `NewObject` node is used to model expressions like:
  * - `new ClassName()` - Instantiation of a class.
  * - `new int[arraySize]` - Instantiation of an array of int with a size `arraySize`.
+ * - `new Channel(capacity)` - Instantiation of a built-in channel holding up to `capacity` values.
  *
  * This AST node is commonly used as part of a `ReferenceChain` to model nested calls following the initialization
  * of an object. For example:
@@ -459,6 +557,7 @@ struct ContinueStatement : public ASTNode {
  * Semantic analysis ensures that:
  * - The `classType` exists in the symbol table.
  * - If `arraySize` is specified, its type is `int` (only integers are valid for specifying array size).
+ * - Channels are created with a `capacity` of type `int`.
  */
 struct NewObject : public ASTNode {
     /// The type (class name) of the object or array being created.
@@ -467,7 +566,10 @@ struct NewObject : public ASTNode {
     /// The expression defining the size of the array, or `nullptr` if not creating an array.
     std::unique_ptr<ASTNode> arraySize;
 
-    NewObject(Token classType_, std::unique_ptr<ASTNode> array_size_);
+    /// The expression defining the capacity of a channel, or `nullptr` if not creating a channel.
+    std::unique_ptr<ASTNode> capacity;
+
+    NewObject(Token classType_, std::unique_ptr<ASTNode> array_size_, std::unique_ptr<ASTNode> capacity_ = nullptr);
 
     void print(std::ostream &strm, int depth = 0) const override;
 
@@ -592,6 +694,31 @@ struct BooleanASTNode : public ASTNode {
     }
 };
 
+/**
+ * @struct StringASTNode
+ * @brief Represents a string literal (e.g., `"Hello"`) in the Abstract Syntax Tree (AST).
+ *
+ * The type of this node is always `String`. Java escape sequences (`\n`, `\t`, `\"`, `\\`, ...)
+ * are decoded during semantic analysis, the decoded `value` is interned by the code generator
+ * into the constant pool of the program, so equal literals share the same `String` object.
+ */
+struct StringASTNode : public ASTNode {
+    Token token;
+    /// The content of the literal without quotes and with escape sequences decoded.
+    /// Resolves after the semantic analysis phase.
+    std::string value;
+
+    explicit StringASTNode(Token token_);
+
+    void print(std::ostream &strm, int depth = 0) const override;
+
+    void analyseSemantics(SymbolTable &symbolTable) override;
+
+    ASTType getType() const override {
+        return ASTType::AST_StringASTNode;
+    }
+};
+
 /**
  * @struct LocalVariableASTNode
  * @brief Represents the declaration of a local variable inside a method body in Mini-Java.
@@ -662,6 +789,7 @@ struct LocalVariableASTNode : public ASTNode {
  * - An object creation and property: `new Object().field ^= value`.
  *
  * The RHS is any expression or value that results in a compatible type for the LHS.
+ * `+=` also appends a `String`, `int` or `boolean` to a `String` (e.g., `log += i`).
  *
  * During semantic analysis:
  * - Validates that the LHS can legally be assigned to.
@@ -835,6 +963,85 @@ struct WhileStatement : public ASTNode {
     }
 };
 
+/**
+ * @struct ParallelReduction
+ * @brief A local updated by every iteration of a `@Parallel` loop with an associative operation.
+ *
+ * Recognized reductions:
+ * ```java
+ * sum += a[i];                  // "+" (also `-=`)
+ * if (a[i] > max) max = a[i];   // "max"
+ * min = a[i] < min ? a[i] : min; // "min"
+ * ```
+ */
+struct ParallelReduction {
+    /// The name of the local.
+    std::string variable;
+
+    /// The operation combining the partial results of the threads: `+`, `min` or `max`.
+    std::string op;
+};
+
+/**
+ * @struct ParallelOverlap
+ * @brief Two arrays of a `@Parallel` loop that must not share storage for its iterations to run concurrently.
+ *
+ * Arrays are references, and views (`slice`) share the storage of their array, so two names may denote
+ * overlapping elements:
+ * ```java
+ * int[] b = arr.slice(1, n + 1);
+ * @Parallel
+ * for (int i = 0; i < n; i++) arr[i] = b[i] + 1; // b[i] is arr[i + 1], written by the next iteration
+ * ```
+ * The storage of the arrays is compared before the loop runs, the iterations run one after another if it overlaps.
+ */
+struct ParallelOverlap {
+    /// The name of an array written by the body.
+    std::string written;
+
+    /// The name of another array read or written by the body.
+    std::string other;
+
+    /// True if `other` is only accessed at the loop variable, the arrays may then be the same one.
+    bool aligned = true;
+};
+
+/**
+ * @struct ParallelLoop
+ * @brief The canonical form of a `for` loop annotated with `@Parallel`, resolved during semantic analysis.
+ *
+ * A parallel loop must be of the form `for (int i = start; i < bound; i += step)` (or `i <= bound`, `i++`),
+ * `bound` is evaluated once, before the iterations run concurrently.
+ */
+struct ParallelLoop {
+    /// The `@Parallel` annotation.
+    Token annotation;
+
+    /// The name of the loop variable.
+    std::string variable;
+
+    /// The initial value of the loop variable.
+    ASTNode *start = nullptr;
+
+    /// The bound of the loop variable.
+    ASTNode *bound = nullptr;
+
+    /// True if the bound is inclusive (`i <= bound`).
+    bool inclusive = false;
+
+    /// The constant increment of the loop variable.
+    int step = 1;
+
+    /// The reductions of the loop.
+    std::vector<ParallelReduction> reductions;
+
+    /// The locals declared outside the loop and read by its body (excluding reductions).
+    std::vector<std::string> captures;
+
+    /// The arrays whose storage is compared before the loop runs.
+    std::vector<ParallelOverlap> overlaps;
+};
+
 /**
  * @struct ForStatement
  * @brief Represents a `for` loop in Mini-Java.
@@ -865,10 +1072,20 @@ struct WhileStatement : public ASTNode {
  *   }
  *   ```
  *
+ * - Parallel for loop, iterations are distributed over threads:
+ *   ```java
+ *   @Parallel
+ *   for (int i = 0; i < a.length; i++) {
+ *       a[i] = a[i] * a[i];
+ *       sum += a[i];
+ *   }
+ *   ```
+ *
  * During semantic analysis:
  * - The initialization, condition, and update parts are validated.
  * - The condition must evaluate to a `boolean`.
  * - Validates the body for correct expressions and/or statements.
+ * - A `@Parallel` loop must be in canonical form and free of loop-carried dependencies (see `analyseParallel`).
  */
 struct ForStatement : public ASTNode {
     /// The initialization block, executed once before the loop starts.
@@ -887,6 +1104,9 @@ struct ForStatement : public ASTNode {
     /// Can be a `CodeBlock` or a single statement.
     std::unique_ptr<CodeBlock> body;
 
+    /// The canonical form of the loop if it is annotated with `@Parallel`, otherwise `nullptr`.
+    std::unique_ptr<ParallelLoop> parallel;
+
     ForStatement(
             std::unique_ptr<CodeBlock> initialization_,
             std::unique_ptr<ASTNode> condition_,
@@ -912,9 +1132,347 @@ struct ForStatement : public ASTNode {
      */
     void analyseSemantics(SymbolTable &symbolTable) override;
 
+    /**
+     * @brief Validates a `@Parallel` loop and resolves its canonical form and reductions.
+     * @param scopeTable The symbol table of the loop, containing the loop variable.
+     *
+     * Iterations of a parallel loop run concurrently in an unspecified order, so the body must not carry
+     * dependencies between iterations:
+     * - Locals declared outside the loop are read-only, except for `+=`/`-=` and min/max reductions.
+     * - Fields can not be assigned.
+     * - Arrays can only be written at the index of the loop variable, and arrays written by the loop can only
+     *   be read at that index. Other arrays may share storage with a written one (e.g., views made by
+     *   `slice`), they are compared at runtime (see `ParallelOverlap`), and arrays declared in the body can
+     *   only be assigned new arrays.
+     * - Method calls (except `String` and `int[]` intrinsics), `return` and `break` are not allowed.
+     *
+     * Example Errors:
+     * ```java
+     * @Parallel for (int i = 1; i < n; i++) a[i] = a[i - 1]; // Error: Loop-carried dependency on array 'a'
+     * @Parallel for (int i = 0; i < n; i++) last = a[i];     // Error: Loop-carried dependency on 'last'
+     * ```
+     */
+    void analyseParallel(SymbolTable &scopeTable);
+
     ASTType getType() const override {
         return ASTType::AST_ForStatement;
     }
 };
 
+/**
+ * @struct SwitchCase
+ * @brief Represents a `case` or `default` label of a `switch` statement and the statements following it.
+ *
+ * The statements of a case run until a `break` (or `return`, `continue`), otherwise execution
+ * falls through to the statements of the next case, as in Java. Consecutive labels are cases
+ * with empty bodies:
+ * ```java
+ * case 1:      // Empty body, falls through to `case 2`
+ * case 2:
+ *     x = 12;
+ *     break;
+ * ```
+ */
+struct SwitchCase {
+    /// The constant of the label (e.g., `42`, `-1`, `0x10`) or the `default` keyword.
+    Token label;
+
+    /// True if this is the `default` label.
+    bool isDefault;
+
+    /// The value of the constant, resolves after the semantic analysis phase.
+    int value = 0;
+
+    /// The statements following the label, up to the next label.
+    std::unique_ptr<CodeBlock> body;
+};
+
+/**
+ * @struct SwitchStatement
+ * @brief Represents a `switch` statement on an `int` value in Mini-Java.
+ *
+ * The `SwitchStatement` node consists of:
+ * - A **condition**: An `int` expression selecting the case to execute.
+ * - A list of **cases**: Constant `case` labels and an optional `default` label, in source order.
+ *
+ * Example Mini-Java Code:
+ * ```java
+ * switch (state) {
+ *     case 0:
+ *         state = 1;
+ *         break;
+ *     case 1:
+ *     case 2:
+ *         state = 0;
+ *         break;
+ *     default:
+ *         state = -1;
+ * }
+ * ```
+ *
+ * Each case has its own scope, a variable declared in a case is not visible in the next ones.
+ * `break` leaves the `switch`, `continue` targets the enclosing loop.
+ */
+struct SwitchStatement : public ASTNode {
+    /// The value being switched on, must evaluate to an `int`.
+    std::unique_ptr<ASTNode> condition;
+
+    /// The cases of the `switch`, in source order.
+    std::vector<SwitchCase> cases;
+
+    SwitchStatement(std::unique_ptr<ASTNode> condition_, std::vector<SwitchCase> cases_);
+
+    void print(std::ostream &strm, int depth = 0) const override;
+
+    /**
+     * @brief Resolves the types and validates the `SwitchStatement` during semantic analysis.
+     * @param symbolTable The symbol table used for resolving variable declarations and types.
+     *
+     * During resolution:
+     * - Ensures the condition is of type `int`.
+     * - Resolves the constant of each `case` label, case constants must be unique `int` literals.
+     * - Ensures there is at most one `default` label.
+     * - Resolves the type to the return type of the method if every path returns, that is a `default`
+     *   label exists, the last case returns and no `break` leaves the `switch`.
+     *
+     * Example Errors:
+     * ```java
+     * switch (flag) { }               // Error: Condition must be int
+     * switch (x) { case 1: case 1: }  // Error: Duplicate case label
+     * ```
+     */
+    void analyseSemantics(SymbolTable &symbolTable) override;
+
+    ASTType getType() const override {
+        return ASTType::AST_SwitchStatement;
+    }
+};
+
+/**
+ * @struct SpawnStatement
+ * @brief Represents a `spawn` of a method call in Mini-Java, the call may run in parallel with the caller.
+ *
+ * The `SpawnStatement` node consists of:
+ * - A **call**: A reference chain ending in a method call (e.g., `this.sort(a)`, `tree.left.sum()`).
+ * - An optional **target**: The local variable receiving the result of the call.
+ *
+ * Example Mini-Java Code:
+ * ```java
+ * int x = spawn this.fib(n - 1);
+ * int y = this.fib(n - 2);
+ * sync;
+ * return x + y;
+ * ```
+ *
+ * The receiver and the arguments are evaluated by the caller, the call itself is a task that may be
+ * stolen by another worker. The target acts as the handle of the task, its value is defined after the
+ * next `sync` of the method. A method waits for its spawned calls before it returns.
+ */
+struct SpawnStatement : public ASTNode {
+    /// The `spawn` keyword, used for error reporting.
+    Token spawnToken;
+
+    /// The local variable receiving the result, its lexeme is empty if the result is discarded.
+    Token target;
+
+    /// The spawned call.
+    ReferenceChain call;
+
+    SpawnStatement(Token spawnToken_, Token target_, ReferenceChain call_);
+
+    void print(std::ostream &strm, int depth = 0) const override;
+
+    /**
+     * @brief Resolves the types and validates the `SpawnStatement` during semantic analysis.
+     * @param symbolTable The symbol table used for resolving variable declarations and types.
+     *
+     * During resolution:
+     * - Ensures the call is a method of a class (`System`, `String` and `int[]` methods can not be spawned).
+     * - Ensures the target is a local variable and the type of the call can be assigned to it.
+     *
+     * Example Errors:
+     * ```java
+     * int x = spawn a.length;         // Error: Only method calls can be spawned
+     * this.count = spawn this.f();    // Error: The target must be a local variable
+     * int y = spawn this.print();     // Error: void method
+     * ```
+     */
+    void analyseSemantics(SymbolTable &symbolTable) override;
+
+    ASTType getType() const override {
+        return ASTType::AST_SpawnStatement;
+    }
+};
+
+/**
+ * @struct SyncStatement
+ * @brief Represents a `sync` in Mini-Java, waits for all the calls spawned by the current method.
+ *
+ * While waiting, the thread runs its own spawned calls or steals the calls spawned by other threads.
+ */
+struct SyncStatement : public ASTNode {
+
+    SyncStatement() = default;
+
+    void print(std::ostream &strm, int depth = 0) const override;
+
+    void analyseSemantics(SymbolTable &symbolTable) override;
+
+    ASTType getType() const override {
+        return ASTType::AST_SyncStatement;
+    }
+};
+
+/**
+ * @struct SynchronizedStatement
+ * @brief Represents a `synchronized` block in Mini-Java, the body runs while holding the monitor of an object.
+ *
+ * The `SynchronizedStatement` node consists of:
+ * - A **lock**: An expression evaluating to an object, its monitor is entered before the body.
+ * - A **body**: The statements protected by the monitor.
+ *
+ * Example Mini-Java Code:
+ * ```java
+ * synchronized (account) {
+ *     account.balance = account.balance + amount;
+ * }
+ * ```
+ *
+ * Monitors are reentrant. The monitor is exited however the body is left (`return`, `break`, `continue`).
+ */
+struct SynchronizedStatement : public ASTNode {
+    /// The `synchronized` keyword, used for error reporting.
+    Token keyword;
+
+    /// The object whose monitor is held.
+    std::unique_ptr<ASTNode> lock;
+
+    /// The statements protected by the monitor.
+    std::unique_ptr<CodeBlock> body;
+
+    SynchronizedStatement(Token keyword_, std::unique_ptr<ASTNode> lock_, std::unique_ptr<CodeBlock> body_);
+
+    void print(std::ostream &strm, int depth = 0) const override;
+
+    /**
+     * @brief Resolves the types and validates the `SynchronizedStatement` during semantic analysis.
+     * @param symbolTable The symbol table used for resolving variable declarations and types.
+     *
+     * During resolution:
+     * - Ensures the lock is an object of a class (`int`, `boolean`, `int[]` and `String` have no monitor).
+     * - Resolves the type to the return type of the method if the body always returns.
+     */
+    void analyseSemantics(SymbolTable &symbolTable) override;
+
+    ASTType getType() const override {
+        return ASTType::AST_SynchronizedStatement;
+    }
+};
+
+/**
+ * @struct CatchClause
+ * @brief Represents a `catch` clause of a `try` statement.
+ *
+ * Example Mini-Java Code:
+ * ```java
+ * catch (ParseError e) {
+ *     return -1;
+ * }
+ * ```
+ */
+struct CatchClause {
+    /// The class (or interface) of the exceptions caught by the clause.
+    Token classType;
+
+    /// The name of the local holding the caught exception.
+    Token name;
+
+    /// The statements handling the exception.
+    std::unique_ptr<CodeBlock> body;
+};
+
+/**
+ * @struct TryStatement
+ * @brief Represents a `try` statement in Mini-Java, with one or more `catch` clauses.
+ *
+ * The `TryStatement` node consists of:
+ * - A **body**: The statements that may throw.
+ * - **Catch clauses**: Tested in order, the first clause whose class matches the exception handles it.
+ *
+ * Example Mini-Java Code:
+ * ```java
+ * try {
+ *     value = parser.parse(input);
+ * } catch (ParseError e) {
+ *     value = e.position;
+ * }
+ * ```
+ *
+ * An exception no clause matches propagates to the enclosing `try`, or out of the method.
+ */
+struct TryStatement : public ASTNode {
+    /// The `try` keyword, used for error reporting.
+    Token keyword;
+
+    /// The statements that may throw.
+    std::unique_ptr<CodeBlock> body;
+
+    /// The `catch` clauses, in the order of the declaration.
+    std::vector<CatchClause> catches;
+
+    TryStatement(Token keyword_, std::unique_ptr<CodeBlock> body_, std::vector<CatchClause> catches_);
+
+    void print(std::ostream &strm, int depth = 0) const override;
+
+    /**
+     * @brief Resolves the types and validates the `TryStatement` during semantic analysis.
+     * @param symbolTable The symbol table used for resolving variable declarations and types.
+     *
+     * During resolution:
+     * - Analyses the body in a scope where exceptions may be thrown.
+     * - Ensures the class of every clause is an object type, and declares its local in the clause.
+     * - Resolves the type to the return type of the method if the body and all the clauses always return.
+     */
+    void analyseSemantics(SymbolTable &symbolTable) override;
+
+    ASTType getType() const override {
+        return ASTType::AST_TryStatement;
+    }
+};
+
+/**
+ * @struct ThrowStatement
+ * @brief Represents a `throw` statement in Mini-Java, any object can be thrown.
+ *
+ * Example Mini-Java Code:
+ * ```java
+ * throw new ParseError();
+ * ```
+ *
+ * A `throw` must be inside a `try` or in a method declaring `throws`.
+ */
+struct ThrowStatement : public ASTNode {
+    /// The `throw` keyword, used for error reporting.
+    Token keyword;
+
+    /// The thrown object.
+    std::unique_ptr<ASTNode> expr;
+
+    ThrowStatement(Token keyword_, std::unique_ptr<ASTNode> expr_);
+
+    void print(std::ostream &strm, int depth = 0) const override;
+
+    /**
+     * @brief Resolves the types and validates the `ThrowStatement` during semantic analysis.
+     * @param symbolTable The symbol table used for resolving variable declarations and types.
+     *
+     * The type resolves to the return type of the method, like a `return`, the statement never completes.
+     */
+    void analyseSemantics(SymbolTable &symbolTable) override;
+
+    ASTType getType() const override {
+        return ASTType::AST_ThrowStatement;
+    }
+};
+
 #endif // SIMPLEMINIJAVACOMPILERTOC_AST_H
\ No newline at end of file
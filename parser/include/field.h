@@ -11,6 +11,7 @@
  * - `MiniJavaType_INT`: Represents the `int` type.
  * - `MiniJavaType_BOOLEAN`: Represents the `boolean` type.
  * - `MiniJavaType_INT_ARRAY`: Represents an array of integers `int[]`.
+ * - `MiniJavaType_STRING`: Represents the built-in immutable `String` type.
  * - `MiniJavaType_CLASS`: Represents a user-defined class type.
  * - `MiniJavaType_VOID`: Represents a `void` type (used for methods without return values).
  */
@@ -18,6 +19,7 @@ enum MiniJavaType {
     MiniJavaType_INT,
     MiniJavaType_BOOLEAN,
     MiniJavaType_INT_ARRAY,
+    MiniJavaType_STRING,
     MiniJavaType_CLASS,
     MiniJavaType_VOID,
 };
@@ -42,6 +44,7 @@ enum MiniJavaType {
  * int x;          // Field with type `MiniJavaType_INT` and name `x`.
  * boolean flag;   // Field with type `MiniJavaType_BOOLEAN` and name `flag`.
  * int[] arr;      // Field with type `MiniJavaType_INT_ARRAY` and name `arr`.
+ * String s;       // Field with type `MiniJavaType_STRING` and name `s`.
  * MyClass obj;    // Field with type `MiniJavaType_CLASS` and name `obj`.
  * ```
  */
@@ -54,19 +57,23 @@ class Field {
 
     /// The name of the field (as an `Identifier`).
     Identifier name;
+
+    /// A flag to indicate if this field is declared `static` (a class field rather than an instance field).
+    bool static_ = false;
 public:
     /**
      * @brief Constructs a new `Field` object.
      * @param type The MiniJava type of the field.
      * @param type_lexeme The string representation of the type (as an `Identifier`).
      * @param name The name of the field (as an `Identifier`).
+     * @param isStatic Whether the field is declared `static` (only valid for class fields).
      *
      * Example Usage:
      * ```cpp
      * Field field(MiniJavaType_INT, Identifier("int"), Identifier("x"));
      * ```
      */
-    Field(MiniJavaType type, Identifier type_lexeme, Identifier name);
+    Field(MiniJavaType type, Identifier type_lexeme, Identifier name, bool isStatic = false);
 
     /**
      * @brief Retrieves the name of the field.
@@ -106,6 +113,14 @@ public:
      */
     Identifier getTypeLexeme();
 
+    /**
+     * @brief Checks if the field is declared `static`.
+     * @return `true` if the field belongs to the class itself, otherwise `false`.
+     *
+     * Static fields are not part of the object layout, they are lowered to C globals.
+     */
+    bool isStatic();
+
     friend std::ostream &operator<<(std::ostream &strm, const Field &field) {
         return strm << "Field{Name: " << field.name
                     << ", Type: " << field.type_lexeme
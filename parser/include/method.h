@@ -13,7 +13,10 @@
  * - **Name**: The name identifier for the method.
  * - **Parameters**: A list of `Field` objects representing the method's parameters, including their names and types.
  * - **Body**: The method's implementation, represented as a `CodeBlock`.
+ * - **Static Indicator**: A flag indicating if the method is a `static` (class) method.
  * - **Main Method Indicator**: A flag indicating if the method is the special `main` entry point in Mini-Java.
+ * - **Synchronized Indicator**: A flag indicating if the method is `synchronized`.
+ * - **Throws Clause**: The classes of the exceptions the method declares it can throw (`throws`).
  * ```
  */
 class Method {
@@ -32,12 +35,36 @@ class Method {
     /// The body of the method, represented as a `CodeBlock`.
     CodeBlock code;
 
+    /// A flag to indicate if this method is declared `static`.
+    bool static_ = false;
+
     /// A flag to indicate if this method is the `main` method of the program.
     bool main = false;
+
+    /// A flag to indicate if this method is declared `synchronized`.
+    bool synchronized_ = false;
+
+    /// The classes of the exceptions declared by the `throws` clause, empty if the method can't throw.
+    std::vector<Identifier> throws;
+
+    /// The line of the declaration in the source code, used by the runtime to report errors.
+    int line = 0;
+
+    /// A flag to indicate if this method is annotated with `@Memoize`, its results are cached by arguments.
+    bool memoized = false;
 public:
     Method(const Method&) = delete;
     Method(Method&&) = default;
-    Method(MiniJavaType type, Identifier type_lexeme, Identifier name, bool main);
+
+    /**
+     * @brief Constructs a new `Method`.
+     * @param type The return type of the method.
+     * @param type_lexeme The string representation of the return type.
+     * @param name The name of the method.
+     * @param isStatic Whether the method is declared `static`.
+     *  A `static void main` method is the entry point of the program.
+     */
+    Method(MiniJavaType type, Identifier type_lexeme, Identifier name, bool isStatic);
 
     /**
      * @brief Adds a parameter to the method's parameter list.
@@ -88,6 +115,70 @@ public:
      */
     bool isMain();
 
+    /**
+     * @brief Checks if the method is declared `static`.
+     * @return `true` if the method has no receiver (`$this`), otherwise `false`.
+     *
+     * Static methods are called directly by their C function name instead of
+     * being dispatched through the `$_function_` pointers of an object.
+     */
+    bool isStatic();
+
+    /**
+     * @brief Marks the method as `synchronized`.
+     * @param isSynchronized Whether the method holds the monitor of its receiver (or of its class, if static).
+     */
+    void setSynchronized(bool isSynchronized);
+
+    /**
+     * @brief Checks if the method is declared `synchronized`.
+     * @return `true` if the body runs while holding the monitor of the receiver, or of the class if the
+     *  method is static.
+     */
+    bool isSynchronized();
+
+    /**
+     * @brief Adds a class to the `throws` clause of the method.
+     * @param className The class of the exceptions the method can throw.
+     */
+    void addThrows(const Identifier &className);
+
+    /**
+     * @brief Retrieves the `throws` clause of the method.
+     * @return A pointer to the vector of the declared exception classes.
+     */
+    std::vector<Identifier> *getThrows();
+
+    /**
+     * @brief Checks if the method declares a `throws` clause.
+     * @return `true` if an exception may propagate out of the method, its callers check for it after the call.
+     */
+    bool canThrow();
+
+    /**
+     * @brief Sets the line of the declaration of the method.
+     * @param declarationLine The 1-based line in the source code.
+     */
+    void setLine(int declarationLine);
+
+    /**
+     * @brief Retrieves the line of the declaration of the method.
+     * @return The 1-based line in the source code, or 0 if unknown.
+     */
+    int getLine();
+
+    /**
+     * @brief Marks the method with `@Memoize`.
+     * @param isMemoized Whether the results of the method are cached by arguments.
+     */
+    void setMemoized(bool isMemoized);
+
+    /**
+     * @brief Checks if the method is annotated with `@Memoize`.
+     * @return `true` if the results of the method are cached by arguments.
+     */
+    bool isMemoized();
+
     friend std::ostream &operator<<(std::ostream &strm, const Method &method) {
         strm << "Method{Name: " << method.name
              << ", Type: " << method.type_lexeme
@@ -55,6 +55,15 @@ private:
 
     /// Maps method names to their positions in the `methods` vector for fast lookups.
     std::map<Identifier, int> methodsMap;
+
+    /// True if the class is provided by the compiler (e.g., `Thread`), its native methods are generated.
+    bool builtin = false;
+
+    /// True if this is an interface, its methods are declarations without a body.
+    bool interfaceClass = false;
+
+    /// The interfaces implemented by the class (`implements`), in the order of the declaration.
+    std::vector<Identifier> interfaces;
 public:
     /**
      * @brief Constructs a `Class` object.
@@ -131,6 +140,42 @@ public:
      */
     Identifier getExtends();
 
+    /**
+     * @brief Marks the class as provided by the compiler.
+     * @param isBuiltin Whether the class is built-in.
+     */
+    void setBuiltin(bool isBuiltin);
+
+    /**
+     * @brief Checks if the class is provided by the compiler (e.g., `Thread`).
+     * @return `true` if the class is built-in, otherwise `false`.
+     */
+    bool isBuiltin();
+
+    /**
+     * @brief Marks the class as an interface.
+     * @param isInterface Whether the class is an interface.
+     */
+    void setInterface(bool isInterface);
+
+    /**
+     * @brief Checks if the class is an interface (declared with `interface`).
+     * @return `true` if the class is an interface, otherwise `false`.
+     */
+    bool isInterface();
+
+    /**
+     * @brief Adds an interface implemented by the class.
+     * @param interfaceName The name of the interface.
+     */
+    void addInterface(const Identifier &interfaceName);
+
+    /**
+     * @brief Retrieves the interfaces the class declares in its `implements` clause.
+     * @return A pointer to the vector of interface names, inherited interfaces are not included.
+     */
+    std::vector<Identifier> *getInterfaces();
+
     friend std::ostream &operator<<(std::ostream &strm, const Class &clazz) {
         strm << "Class{" << std::endl << "\tName: " << clazz.name << std::endl
              << "\tExtends: " << clazz.extends << std::endl
@@ -18,6 +18,8 @@
  * - **isMethod**: Whether the symbol represents a method.
  * - **Parameters**: For methods, the list of parameter types.
  * - **Return Type**: For methods, the method's return type.
+ * - **isStatic**: Whether the symbol is a `static` member of its class.
+ * - **throws**: For methods, whether the method declares a `throws` clause.
  *
  * Example Symbol Usage:
  * - Variable: `int x;` → `{name: "x", type: "int", isMethod: false}`
@@ -30,6 +32,9 @@ struct Symbol {
     bool isMethod = false;      ///< A flag indicating whether this symbol represents a method.
     std::vector<std::string> params; ///< List of parameter types (applicable for methods).
     std::string returnType;     ///< For methods, the return type of the method (e.g., "int", "void").
+    bool isStatic = false;      ///< A flag indicating whether this symbol is a static field or method.
+    bool throws = false;        ///< A flag indicating whether this method can throw an exception.
+    bool memoized = false;      ///< A flag indicating whether this method is annotated with `@Memoize`.
 
     /**
      * @brief Constructor for a non-method symbol.
@@ -82,6 +87,18 @@ private:
     /// The return type of the current method, if applicable (empty if not inside a method scope).
     std::string returnType;
 
+    /// True if this class scope is the static view of a class (the scope of a static method).
+    bool staticContext = false;
+
+    /// True if exceptions thrown in this scope are caught (a `try` body) or declared (a method with `throws`).
+    bool exceptionsHandled = false;
+
+    /// True if this class scope is an interface, it only contains method declarations.
+    bool interfaceScope = false;
+
+    /// The interfaces implemented by the class of this scope (not including the ones of its superclasses).
+    std::vector<std::string> interfaces;
+
     /// A global registry of class-level symbol tables for managing inheritance and classes.
     static std::unordered_map<std::string, std::shared_ptr<SymbolTable>> classSymbolTables;
 
@@ -151,6 +168,37 @@ public:
      */
     static bool canCast(const std::string &from, const std::string &to);
 
+    /**
+     * @brief Checks if a value of one type may be an instance of another type at runtime, i.e. a cast
+     * between them may succeed (an upcast, a downcast, or a cast from or to an interface).
+     * @param from The source type.
+     * @param to The target type.
+     * @return `true` if the cast is allowed, it may need a check at runtime.
+     */
+    static bool isCastable(const std::string &from, const std::string &to);
+
+    /**
+     * @brief Checks if a type is an interface of the program.
+     * @param type The type to check.
+     * @return `true` if the type is an interface.
+     */
+    static bool isInterfaceType(const std::string &type);
+
+    /**
+     * @brief Checks if a type is one of the built-in channel types (`Channel` or `SpscChannel`).
+     * @param type The type to check.
+     * @return `true` if the type is a channel.
+     */
+    static bool isChannelType(const std::string &type);
+
+    /**
+     * @brief Checks if a type is a class of the program, whose instances are objects with a header
+     * (a monitor and a class id), unlike `String`, `int[]`, channels and `System`.
+     * @param type The type to check.
+     * @return `true` if the type is an object type.
+     */
+    static bool isObjectType(const std::string &type);
+
     /**
      * @brief Checks if this scope represents a class-level scope.
      * @return `true` if it's a class scope, otherwise `false`.
@@ -175,6 +223,48 @@ public:
      */
     std::string getReturnType() const { return returnType; }
 
+    /**
+     * @brief Marks this class scope as a static context, i.e. a scope without `this`.
+     * @param staticContext_ `true` if only static members of the class are visible.
+     */
+    void setStaticContext(bool staticContext_) { staticContext = staticContext_; }
+
+    /**
+     * @brief Marks this scope as a scope where exceptions may be thrown.
+     * @param exceptionsHandled_ `true` for the body of a `try`, or the scope of a method declaring `throws`.
+     */
+    void setExceptionsHandled(bool exceptionsHandled_) { exceptionsHandled = exceptionsHandled_; }
+
+    /**
+     * @brief Checks if an exception thrown in this scope is caught or declared by an enclosing scope.
+     * @return `true` if `throw` and calls of methods that can throw are allowed in this scope.
+     */
+    bool areExceptionsHandled();
+
+    /**
+     * @brief Marks this class scope as an interface.
+     * @param interfaceScope_ `true` if the scope is an interface.
+     */
+    void setInterface(bool interfaceScope_) { interfaceScope = interfaceScope_; }
+
+    /**
+     * @brief Checks if this class scope is an interface.
+     * @return `true` if the scope is an interface, otherwise `false`.
+     */
+    bool isInterface() const { return interfaceScope; }
+
+    /**
+     * @brief Adds an interface implemented by the class of this scope, used by `canCast`.
+     * @param interfaceName The name of the interface.
+     */
+    void addInterface(const std::string &interfaceName) { interfaces.push_back(interfaceName); }
+
+    /**
+     * @brief Checks if this scope is nested inside a static context (e.g., a static method).
+     * @return `true` if the nearest class scope is a static view of the class, otherwise `false`.
+     */
+    bool isStaticContext();
+
     /**
      * @brief Retrieves the symbol table for the current class scope.
      * @return A pointer to the current class's symbol table, or `nullptr` if not in a class scope.
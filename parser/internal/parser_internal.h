@@ -2,11 +2,13 @@
 #define SIMPLEMINIJAVACOMPILERTOC_PARSER_INTERNAL_H
 
 #include "../../common/include/error_handler.h"
+#include "../../common/include/profiler.h"
 #include "../include/project.h"
 #include "streamer.h"
 
 struct ParamSignature {
     bool isStatic;
+    bool isSynchronized;
     bool isField;
     MiniJavaType type;
     std::string type_lexeme;
@@ -39,6 +41,12 @@ void parseMethodParams(
         TokenStreamer &streamer
 );
 
+void parseMethodThrows(
+        Method *method,
+        Project &project,
+        TokenStreamer &streamer
+);
+
 void parseMethodBody(
         Method *method,
         Project &project,
@@ -105,11 +113,65 @@ std::unique_ptr<ASTNode> parseForStatement(
         TokenStreamer &streamer
 );
 
+std::unique_ptr<ASTNode> parseSwitchStatement(
+        Project &project,
+        TokenStreamer &streamer
+);
+
+std::unique_ptr<ASTNode> parseSynchronizedStatement(
+        Token *keyword,
+        Project &project,
+        TokenStreamer &streamer
+);
+
+std::unique_ptr<ASTNode> parseTryStatement(
+        Token *keyword,
+        Project &project,
+        TokenStreamer &streamer
+);
+
+std::unique_ptr<ASTNode> parseThrowStatement(
+        Token *keyword,
+        Project &project,
+        TokenStreamer &streamer
+);
+
+std::unique_ptr<ASTNode> parseAnnotatedStatement(
+        Token *annotation,
+        Project &project,
+        TokenStreamer &streamer
+);
+
+ReferenceChain parseReferenceChain(
+        Project &project,
+        TokenStreamer &streamer,
+        Token *reference
+);
+
+bool isSpawn(
+        Token *token,
+        TokenStreamer &streamer
+);
+
+void parseSpawn(
+        CodeBlock *codeBlock,
+        Token *spawnToken,
+        Token *target,
+        Project &project,
+        TokenStreamer &streamer
+);
+
 std::unique_ptr<ASTNode> parseExpression(
         Project &project,
         TokenStreamer &streamer
 );
 
+void markStatementLines(
+        CodeBlock *codeBlock,
+        size_t first,
+        const Token *token
+);
+
 void parseSimpleStatement(
         CodeBlock *codeBlock,
         Token *token,
@@ -130,4 +192,10 @@ std::unique_ptr<CodeBlock> parseCodeBlockOrStatement(
         TokenStreamer &streamer
 );
 
+void analyseMemoize(
+        Project &project,
+        Class *clazz,
+        Method *method
+);
+
 #endif //SIMPLEMINIJAVACOMPILERTOC_PARSER_INTERNAL_H
@@ -103,6 +103,20 @@ public:
         return current < tokens.size();
     }
 
+    /**
+     * @brief Checks if an identifier occurs anywhere in the token list, whatever the current position.
+     * @param lexeme The identifier to search for.
+     * @return `true` if an identifier token has the lexeme, `false` otherwise.
+     */
+    bool containsIdentifier(const std::string &lexeme) const {
+        for (const Token &token: tokens) {
+            if (token.type == TokenType::IDENTIFIER && token.lexeme == lexeme) {
+                return true;
+            }
+        }
+        return false;
+    }
+
     /**
      * @brief Moves the token pointer one step backward.
      *
@@ -29,7 +29,11 @@ void Assignment::analyseSemantics(SymbolTable &symbolTable) {
     expression->analyseSemantics(symbolTable);
     std::string rhsType = expression->type;
 
-    if (assignmentToken.lexeme == "+=" ||
+    if (assignmentToken.lexeme == "+=" && lhsType == "String") {
+        if (rhsType != "String" && rhsType != "int" && rhsType != "boolean") {
+            error("Invalid compound assignment: Cannot append value of type '" + rhsType + "' to 'String'");
+        }
+    } else if (assignmentToken.lexeme == "+=" ||
         assignmentToken.lexeme == "-=" ||
         assignmentToken.lexeme == "*=" ||
         assignmentToken.lexeme == "/=" ||
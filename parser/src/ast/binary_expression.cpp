@@ -19,6 +19,16 @@ void BinaryExpression::analyseSemantics(SymbolTable &symbolTable) {
     left->analyseSemantics(symbolTable);
     right->analyseSemantics(symbolTable);
 
+    if (op.lexeme == "+" && (left->type == "String" || right->type == "String")) {
+        for (auto &operand: {left->type, right->type}) {
+            if (operand != "String" && operand != "int" && operand != "boolean") {
+                error("String concatenation requires 'String', 'int' or 'boolean', found '" + operand + "'");
+            }
+        }
+        type = "String";
+        return;
+    }
+
     if (left->type != right->type) {
         error("Type mismatch in BinaryExpression: '" + left->type + "' and '" + right->type + "'");
     }
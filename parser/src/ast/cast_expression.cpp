@@ -30,8 +30,7 @@ void CastExpression::analyseSemantics(SymbolTable &symbolTable) {
     bool lhsPrimitive = cast.lexeme == "int" || cast.lexeme == "int[]" || cast.lexeme == "boolean";
     if (rhsPrimitive ||
         lhsPrimitive ||
-        (!SymbolTable::canCast(cast.lexeme, expr->type) &&
-         !SymbolTable::canCast(expr->type, cast.lexeme))) {
+        !SymbolTable::isCastable(expr->type, cast.lexeme)) {
         error("Cannot cast type '" + expr->type + "' to type '" + cast.lexeme + "'");
     }
 }
\ No newline at end of file
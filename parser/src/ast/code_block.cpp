@@ -29,7 +29,12 @@ void CodeBlock::analyseSemantics(SymbolTable &symbolTable) {
                     type = "return-void";
                 }
                 returns = true;
-            } else if (code->getType() == AST_IfStatement && code->type != "void") {
+            } else if ((code->getType() == AST_IfStatement ||
+                        code->getType() == AST_SwitchStatement ||
+                        code->getType() == AST_SynchronizedStatement ||
+                        code->getType() == AST_TryStatement ||
+                        code->getType() == AST_ThrowStatement) &&
+                       code->type != "void") {
                 type = code->type;
                 returns = true;
             }
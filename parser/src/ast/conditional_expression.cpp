@@ -0,0 +1,47 @@
+#include "../../include/ast.h"
+
+ConditionalExpression::ConditionalExpression(
+        std::unique_ptr<ASTNode> condition_,
+        std::unique_ptr<ASTNode> then_,
+        std::unique_ptr<ASTNode> else_
+) : condition(std::move(condition_)),
+    thenExpr(std::move(then_)),
+    elseExpr(std::move(else_)) {}
+
+void ConditionalExpression::print(std::ostream &strm, int depth) const {
+    strm << std::string(depth, '\t') << "ConditionalExpression" << " (Type:" << type << ")" << std::endl;
+    strm << std::string(depth + 1, '\t') << "Condition:" << std::endl;
+    condition->print(strm, depth + 2);
+    strm << std::string(depth + 1, '\t') << "Then:" << std::endl;
+    thenExpr->print(strm, depth + 2);
+    strm << std::string(depth + 1, '\t') << "Else:" << std::endl;
+    elseExpr->print(strm, depth + 2);
+}
+
+void ConditionalExpression::analyseSemantics(SymbolTable &symbolTable) {
+    condition->analyseSemantics(symbolTable);
+    if (condition->type != "boolean") {
+        error("Condition of '?:' must be of type 'boolean', but got '" + condition->type + "'.");
+    }
+    thenExpr->analyseSemantics(symbolTable);
+    elseExpr->analyseSemantics(symbolTable);
+
+    if (thenExpr->type == "void" || elseExpr->type == "void") {
+        error("Operands of '?:' can not be of type void");
+    }
+    if (thenExpr->type == elseExpr->type) {
+        type = thenExpr->type;
+        return;
+    }
+
+    // Unifies class types to their nearest common superclass
+    SymbolTable *table = SymbolTable::getClassSymbolTable(thenExpr->type);
+    while (table) {
+        if (SymbolTable::canCast(elseExpr->type, table->getClassName())) {
+            type = table->getClassName();
+            return;
+        }
+        table = table->getParent();
+    }
+    error("Type mismatch in '?:': Incompatible types '" + thenExpr->type + "' and '" + elseExpr->type + "'");
+}
@@ -11,7 +11,7 @@ ForStatement::ForStatement(
     body(std::move(body_)) {}
 
 void ForStatement::print(std::ostream &strm, int depth) const {
-    strm << std::string(depth, '\t') << "ForStatement:" << std::endl;
+    strm << std::string(depth, '\t') << "ForStatement:" << (parallel ? " @Parallel" : "") << std::endl;
 
     if (initialization) {
         strm << std::string(depth + 1, '\t') << "Initialization:" << std::endl;
@@ -48,5 +48,8 @@ void ForStatement::analyseSemantics(SymbolTable &symbolTable) {
     if (body) {
         body->analyseSemantics(scopeTable);
     }
+    if (parallel) {
+        analyseParallel(scopeTable);
+    }
     type = "void";
 }
\ No newline at end of file
@@ -0,0 +1,30 @@
+#include "../../include/ast.h"
+
+InstanceOfExpression::InstanceOfExpression(
+        Token op_,
+        std::unique_ptr<ASTNode> expr_,
+        Token classType_
+) : op(std::move(op_)),
+    expr(std::move(expr_)),
+    classType(std::move(classType_)) {}
+
+void InstanceOfExpression::print(std::ostream &strm, int depth) const {
+    strm << std::string(depth, '\t') << "InstanceOfExpression (" + classType.lexeme + ")"
+         << " (Type:" << type << ")" << std::endl;
+    expr->print(strm, depth + 1);
+}
+
+void InstanceOfExpression::analyseSemantics(SymbolTable &symbolTable) {
+    expr->analyseSemantics(symbolTable);
+    if (!SymbolTable::isObjectType(classType.lexeme)) {
+        error("Undefined class in 'instanceof': '" + classType.lexeme + "'", &classType);
+    }
+    if (!SymbolTable::isObjectType(expr->type)) {
+        error("Operand of 'instanceof' must be an object, but got '" + expr->type + "'", &op);
+    }
+    if (!SymbolTable::isCastable(expr->type, classType.lexeme)) {
+        error("Incompatible types in 'instanceof': '" + expr->type + "' can never be a '" +
+              classType.lexeme + "'", &op);
+    }
+    type = "boolean";
+}
@@ -41,12 +41,24 @@ void MethodCall::analyseSemantics(SymbolTable &symbolTable) {
 
     for (size_t i = 0; i < arguments.size(); ++i) {
         arguments[i]->analyseSemantics(symbolTable);
-        if (arguments[i]->type != expectedParams[i]) {
+        // Printing methods of `System.out` are overloaded for `String`
+        if (callerType == "System" && arguments[i]->type == "String") {
+            continue;
+        }
+        // An object may be passed as one of its superclasses or interfaces
+        if (!SymbolTable::canCast(arguments[i]->type, expectedParams[i])) {
             error("Type mismatch for argument " + std::to_string(i + 1) +
                   " in method call to '" + methodName + "': expected '" +
                   expectedParams[i] + "', but got '" + arguments[i]->type + "'.");
         }
     }
 
+    if (methodSymbol->throws && !symbolTable.areExceptionsHandled()) {
+        error("Unreported exception: '" + methodName + "' can throw, it must be called in 'try' "
+              "or the method must declare 'throws'.");
+    }
+
+    isStatic = methodSymbol->isStatic;
+    canThrow = methodSymbol->throws;
     type = methodSymbol->returnType;
 }
\ No newline at end of file
@@ -4,9 +4,11 @@
 
 NewObject::NewObject(
         Token classType_,
-        std::unique_ptr<ASTNode> array_size_
+        std::unique_ptr<ASTNode> array_size_,
+        std::unique_ptr<ASTNode> capacity_
 ) : classType(std::move(classType_)),
-    arraySize(std::move(array_size_)) {}
+    arraySize(std::move(array_size_)),
+    capacity(std::move(capacity_)) {}
 
 void NewObject::print(std::ostream &strm, int depth) const {
     strm << std::string(depth, '\t') << "NewObject (" + classType.lexeme + ")"
@@ -15,6 +17,10 @@ void NewObject::print(std::ostream &strm, int depth) const {
         strm << std::string(depth + 1, '\t') << "Array:" << std::endl;
         arraySize->print(strm, depth + 2);
     }
+    if (capacity) {
+        strm << std::string(depth + 1, '\t') << "Capacity:" << std::endl;
+        capacity->print(strm, depth + 2);
+    }
 }
 
 void NewObject::analyseSemantics(SymbolTable &symbolTable) {
@@ -24,11 +30,23 @@ void NewObject::analyseSemantics(SymbolTable &symbolTable) {
             error("Array size must be type of 'int' but got '" + arraySize->type + "'");
         }
         type = "int[]";
+    } else if (SymbolTable::isChannelType(classType.lexeme)) {
+        if (!capacity) {
+            error("Channel must be created with a capacity, e.g. 'new " + classType.lexeme + "(16)'", &classType);
+        }
+        capacity->analyseSemantics(symbolTable);
+        if (capacity->type != "int") {
+            error("Channel capacity must be type of 'int' but got '" + capacity->type + "'", &classType);
+        }
+        type = classType.lexeme;
     } else {
         auto symbol = SymbolTable::getClassSymbolTable(classType.lexeme);
         if (!symbol) {
             error("Undefined class type in NewObject: '" + classType.lexeme + "'");
         }
+        if (symbol->isInterface()) {
+            error("Interface '" + classType.lexeme + "' can not be instantiated", &classType);
+        }
         type = classType.lexeme;
     }
 }
\ No newline at end of file
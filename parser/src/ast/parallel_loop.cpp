@@ -0,0 +1,555 @@
+#include "../../include/ast.h"
+#include <set>
+#include <sstream>
+
+/**
+ * @brief Returns the structure of an expression, two expressions with the same structure compute the same value.
+ */
+std::string getExpressionKey(ASTNode *node) {
+    std::ostringstream strm;
+    node->print(strm);
+    return strm.str();
+}
+
+/**
+ * @brief Returns the name of a reference to a plain variable (e.g., `x`), or an empty string for any other node.
+ */
+std::string getVariableName(ASTNode *node) {
+    if (!node || node->getType() != ASTType::AST_ReferenceASTNode) {
+        return "";
+    }
+    auto &chain = ((ReferenceASTNode *) node)->reference.chain;
+    if (chain.size() != 1 || chain[0].second) {
+        return "";
+    }
+    return chain[0].first.lexeme;
+}
+
+/**
+ * @brief Checks if an expression creates a new array (e.g., `new int[n]`).
+ */
+bool isNewArray(ASTNode *node) {
+    if (!node || node->getType() != ASTType::AST_ReferenceASTNode) {
+        return false;
+    }
+    auto &chain = ((ReferenceASTNode *) node)->reference.chain;
+    return chain.size() == 1 && chain[0].second && chain[0].second->getType() == ASTType::AST_NewObject;
+}
+
+/**
+ * @brief Checks if an expression reads a variable.
+ */
+bool referencesVariable(ASTNode *node, const std::string &name) {
+    if (!node) {
+        return false;
+    }
+    switch (node->getType()) {
+        case ASTType::AST_BinaryExpression:
+            return referencesVariable(((BinaryExpression *) node)->left.get(), name) ||
+                   referencesVariable(((BinaryExpression *) node)->right.get(), name);
+        case ASTType::AST_NotExpression:
+            return referencesVariable(((NotExpression *) node)->expr.get(), name);
+        case ASTType::AST_CastExpression:
+            return referencesVariable(((CastExpression *) node)->expr.get(), name);
+        case ASTType::AST_InstanceOfExpression:
+            return referencesVariable(((InstanceOfExpression *) node)->expr.get(), name);
+        case ASTType::AST_ConditionalExpression:
+            return referencesVariable(((ConditionalExpression *) node)->condition.get(), name) ||
+                   referencesVariable(((ConditionalExpression *) node)->thenExpr.get(), name) ||
+                   referencesVariable(((ConditionalExpression *) node)->elseExpr.get(), name);
+        case ASTType::AST_ReferenceASTNode: {
+            auto &chain = ((ReferenceASTNode *) node)->reference.chain;
+            for (size_t i = 0; i < chain.size(); ++i) {
+                if (i == 0 && chain[i].first.lexeme == name && !chain[i].second) {
+                    return true;
+                }
+                ASTNode *entry = chain[i].second.get();
+                if (!entry) {
+                    continue;
+                }
+                if (entry->getType() == ASTType::AST_MethodCall) {
+                    for (auto &argument: ((MethodCall *) entry)->arguments) {
+                        if (referencesVariable(argument.get(), name)) {
+                            return true;
+                        }
+                    }
+                } else if (entry->getType() == ASTType::AST_ArrayCall) {
+                    if ((i == 0 && chain[i].first.lexeme == name) ||
+                        referencesVariable(((ArrayCall *) entry)->bracket.get(), name)) {
+                        return true;
+                    }
+                } else if (entry->getType() == ASTType::AST_NewObject) {
+                    if (referencesVariable(((NewObject *) entry)->arraySize.get(), name) ||
+                        referencesVariable(((NewObject *) entry)->capacity.get(), name)) {
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Resolves a comparison `x op e` (or `e op x`) used by a min/max reduction of `x`.
+ *
+ * @param condition The comparison.
+ * @param variable The reduction variable `x`.
+ * @param other Set to the other operand `e`.
+ * @param variableIsGreater Set to `true` if the comparison holds when `x` is the greater operand.
+ * @return `true` if the condition is a comparison between `x` and an expression not reading `x`.
+ */
+bool resolveMinMaxCondition(ASTNode *condition, const std::string &variable,
+                            ASTNode *&other, bool &variableIsGreater) {
+    if (condition->getType() != ASTType::AST_BinaryExpression) {
+        return false;
+    }
+    auto binary = (BinaryExpression *) condition;
+    const std::string &op = binary->op.lexeme;
+    if (op != "<" && op != "<=" && op != ">" && op != ">=") {
+        return false;
+    }
+    bool leftIsGreater = op == ">" || op == ">=";
+    if (getVariableName(binary->left.get()) == variable) {
+        other = binary->right.get();
+        variableIsGreater = leftIsGreater;
+    } else if (getVariableName(binary->right.get()) == variable) {
+        other = binary->left.get();
+        variableIsGreater = !leftIsGreater;
+    } else {
+        return false;
+    }
+    return !referencesVariable(other, variable);
+}
+
+/**
+ * @struct ParallelLoopChecker
+ * @brief Walks the body of a `@Parallel` loop to find loop-carried dependencies and reductions.
+ */
+struct ParallelLoopChecker {
+    /// The loop being checked.
+    ParallelLoop *loop;
+
+    /// The symbol table of the loop, used to tell locals declared outside the loop from fields.
+    SymbolTable &scopeTable;
+
+    /// Locals declared inside the body, private to each iteration.
+    std::set<std::string> declared;
+
+    /// Variables read outside of their reduction statements.
+    std::set<std::string> reads;
+
+    /// Arrays written by the body.
+    std::set<std::string> writtenArrays;
+
+    /// An element of an array read by the body.
+    struct ArrayRead {
+        /// The name of the array, or of the member holding it.
+        std::string name;
+
+        /// The token of the access.
+        Token token;
+
+        /// True if the element is read at the loop variable.
+        bool aligned;
+
+        /// True if the array is a variable (e.g., `a[i]`), not a member of an object (e.g., `o.a[i]`).
+        bool named;
+    };
+
+    /// The elements of arrays read by the body.
+    std::vector<ArrayRead> arrayReads;
+
+    /// Depth of the loops and switches nested in the body, `break` is only allowed inside them.
+    int nestedDepth = 0;
+
+    bool isLoopVariable(ASTNode *node) const {
+        return getVariableName(node) == loop->variable;
+    }
+
+    bool isLocal(const std::string &name) {
+        for (SymbolTable *table = &scopeTable; table && !table->isClassScope(); table = table->getParent()) {
+            if (table->find(name)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void addReduction(const std::string &variable, const std::string &op, Token &token) {
+        for (auto &reduction: loop->reductions) {
+            if (reduction.variable == variable) {
+                if (reduction.op != op) {
+                    error("Reduction variable '" + variable + "' is updated with different operations "
+                                                              "in a @Parallel loop", &token);
+                }
+                return;
+            }
+        }
+        loop->reductions.push_back({variable, op});
+    }
+
+    void visitChain(ReferenceChain &reference) {
+        auto &chain = reference.chain;
+        for (size_t i = 0; i < chain.size(); ++i) {
+            auto &entry = chain[i];
+            if (!entry.second) {
+                if (i == 0) {
+                    reads.insert(entry.first.lexeme);
+                }
+                continue;
+            }
+            switch (entry.second->getType()) {
+                case ASTType::AST_MethodCall: {
+                    auto methodCall = (MethodCall *) entry.second.get();
+                    if (i == 0 || (methodCall->callerType != "String" && methodCall->callerType != "int[]")) {
+                        error("Method calls are not allowed in a @Parallel loop, they may have side effects",
+                              &entry.first);
+                    }
+                    for (auto &argument: methodCall->arguments) {
+                        visit(argument.get());
+                    }
+                    break;
+                }
+                case ASTType::AST_ArrayCall: {
+                    auto arrayCall = (ArrayCall *) entry.second.get();
+                    if (i == 0) {
+                        reads.insert(entry.first.lexeme);
+                    }
+                    arrayReads.push_back({entry.first.lexeme, entry.first,
+                                          isLoopVariable(arrayCall->bracket.get()), i == 0});
+                    visit(arrayCall->bracket.get());
+                    break;
+                }
+                case ASTType::AST_NewObject:
+                    visit(((NewObject *) entry.second.get())->arraySize.get());
+                    visit(((NewObject *) entry.second.get())->capacity.get());
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+
+    /**
+     * @brief Resolves `x += e`, `x -= e` and `x = cond ? x : e` reductions, visiting `e`.
+     * @return `true` if the assignment is a reduction.
+     */
+    bool visitReduction(Assignment *assignment, const std::string &variable, Token &token) {
+        if (assignment->reference.type != "int") {
+            return false;
+        }
+        const std::string &op = assignment->assignmentToken.lexeme;
+        if (op == "+=" || op == "-=") {
+            if (referencesVariable(assignment->expression.get(), variable)) {
+                return false;
+            }
+            addReduction(variable, "+", token);
+            visit(assignment->expression.get());
+            return true;
+        }
+        if (op != "=" || assignment->expression->getType() != ASTType::AST_ConditionalExpression) {
+            return false;
+        }
+
+        auto conditional = (ConditionalExpression *) assignment->expression.get();
+        ASTNode *other = nullptr;
+        bool variableIsGreater = false;
+        if (!resolveMinMaxCondition(conditional->condition.get(), variable, other, variableIsGreater)) {
+            return false;
+        }
+        std::string otherKey = getExpressionKey(other);
+        bool thenIsVariable = getVariableName(conditional->thenExpr.get()) == variable &&
+                              getExpressionKey(conditional->elseExpr.get()) == otherKey;
+        bool elseIsVariable = getVariableName(conditional->elseExpr.get()) == variable &&
+                              getExpressionKey(conditional->thenExpr.get()) == otherKey;
+        if (!thenIsVariable && !elseIsVariable) {
+            return false;
+        }
+        // The greater operand is selected if the condition holds when it is the greater one
+        addReduction(variable, thenIsVariable == variableIsGreater ? "max" : "min", token);
+        visit(other);
+        return true;
+    }
+
+    /**
+     * @brief Resolves `if (e > x) x = e;` (and the other comparisons) reductions, visiting `e`.
+     * @return `true` if the statement is a reduction.
+     */
+    bool visitReduction(IfStatement *statement) {
+        if (statement->elseBody || statement->body->codes.size() != 1 ||
+            statement->body->codes[0]->getType() != ASTType::AST_Assignment) {
+            return false;
+        }
+        auto assignment = (Assignment *) statement->body->codes[0].get();
+        auto &chain = assignment->reference.chain;
+        if (assignment->assignmentToken.lexeme != "=" || chain.size() != 1 || chain[0].second ||
+            assignment->reference.type != "int") {
+            return false;
+        }
+        const std::string &variable = chain[0].first.lexeme;
+        if (variable == loop->variable || declared.contains(variable) || !isLocal(variable)) {
+            return false;
+        }
+
+        ASTNode *other = nullptr;
+        bool variableIsGreater = false;
+        if (!resolveMinMaxCondition(statement->condition.get(), variable, other, variableIsGreater) ||
+            getExpressionKey(other) != getExpressionKey(assignment->expression.get())) {
+            return false;
+        }
+        // `x` is replaced if the condition holds when it is the smaller operand
+        addReduction(variable, variableIsGreater ? "min" : "max", chain[0].first);
+        visit(other);
+        return true;
+    }
+
+    void visitAssignment(Assignment *assignment) {
+        auto &chain = assignment->reference.chain;
+        Token &target = chain[0].first;
+        const std::string &name = target.lexeme;
+
+        if (chain.size() == 1 && !chain[0].second) {
+            if (name == loop->variable) {
+                error("The loop variable of a @Parallel loop can not be modified", &target);
+            }
+            if (!declared.contains(name)) {
+                if (!isLocal(name)) {
+                    error("Field '" + name + "' can not be assigned in a @Parallel loop, "
+                                             "iterations run concurrently", &target);
+                }
+                if (!visitReduction(assignment, name, target)) {
+                    error("Loop-carried dependency on '" + name + "', only '+=' and min/max reductions "
+                                                                  "of locals are allowed in a @Parallel loop", &target);
+                }
+                return;
+            }
+            // An array of an iteration must not share the storage of the arrays of the others
+            if (assignment->reference.type == "int[]" && !isNewArray(assignment->expression.get())) {
+                error("Array '" + name + "' is declared in a @Parallel loop, it can only be assigned "
+                                         "a new array", &target);
+            }
+        } else if (chain.size() == 1 && chain[0].second->getType() == ASTType::AST_ArrayCall) {
+            auto arrayCall = (ArrayCall *) chain[0].second.get();
+            if (!declared.contains(name)) {
+                if (!isLoopVariable(arrayCall->bracket.get())) {
+                    error("Loop-carried dependency on array '" + name + "', it can only be written at index '" +
+                          loop->variable + "' in a @Parallel loop", &target);
+                }
+                writtenArrays.insert(name);
+            }
+            reads.insert(name);
+            visit(arrayCall->bracket.get());
+        } else {
+            error("Only locals and array elements can be assigned in a @Parallel loop", &target);
+        }
+        if (assignment->assignmentToken.lexeme != "=") {
+            reads.insert(name);
+        }
+        visit(assignment->expression.get());
+    }
+
+    void visit(ASTNode *node) {
+        if (!node) {
+            return;
+        }
+        switch (node->getType()) {
+            case ASTType::AST_BinaryExpression:
+                visit(((BinaryExpression *) node)->left.get());
+                visit(((BinaryExpression *) node)->right.get());
+                break;
+            case ASTType::AST_NotExpression:
+                visit(((NotExpression *) node)->expr.get());
+                break;
+            case ASTType::AST_CastExpression:
+                visit(((CastExpression *) node)->expr.get());
+                break;
+            case ASTType::AST_InstanceOfExpression:
+                visit(((InstanceOfExpression *) node)->expr.get());
+                break;
+            case ASTType::AST_ConditionalExpression:
+                visit(((ConditionalExpression *) node)->condition.get());
+                visit(((ConditionalExpression *) node)->thenExpr.get());
+                visit(((ConditionalExpression *) node)->elseExpr.get());
+                break;
+            case ASTType::AST_ReferenceASTNode:
+                visitChain(((ReferenceASTNode *) node)->reference);
+                break;
+            case ASTType::AST_LocalVariableASTNode:
+                declared.insert(((LocalVariableASTNode *) node)->field.getName());
+                break;
+            case ASTType::AST_Assignment:
+                visitAssignment((Assignment *) node);
+                break;
+            case ASTType::AST_CodeBlock:
+                for (auto &code: ((CodeBlock *) node)->codes) {
+                    visit(code.get());
+                }
+                break;
+            case ASTType::AST_IfStatement:
+                if (!visitReduction((IfStatement *) node)) {
+                    visit(((IfStatement *) node)->condition.get());
+                    visit(((IfStatement *) node)->body.get());
+                    visit(((IfStatement *) node)->elseBody.get());
+                }
+                break;
+            case ASTType::AST_WhileStatement:
+                nestedDepth++;
+                visit(((WhileStatement *) node)->condition.get());
+                visit(((WhileStatement *) node)->body.get());
+                nestedDepth--;
+                break;
+            case ASTType::AST_ForStatement:
+                nestedDepth++;
+                visit(((ForStatement *) node)->initialization.get());
+                visit(((ForStatement *) node)->condition.get());
+                visit(((ForStatement *) node)->update.get());
+                visit(((ForStatement *) node)->body.get());
+                nestedDepth--;
+                break;
+            case ASTType::AST_SwitchStatement:
+                nestedDepth++;
+                visit(((SwitchStatement *) node)->condition.get());
+                for (auto &switchCase: ((SwitchStatement *) node)->cases) {
+                    visit(switchCase.body.get());
+                }
+                nestedDepth--;
+                break;
+            case ASTType::AST_ReturnStatement:
+                error("A @Parallel loop can not return", &loop->annotation);
+                break;
+            case ASTType::AST_SpawnStatement:
+                error("Method calls can not be spawned in a @Parallel loop",
+                      &((SpawnStatement *) node)->spawnToken);
+                break;
+            case ASTType::AST_SyncStatement:
+                error("A @Parallel loop can not sync", &loop->annotation);
+                break;
+            case ASTType::AST_SynchronizedStatement:
+                error("A @Parallel loop can not synchronize, use a reduction instead",
+                      &((SynchronizedStatement *) node)->keyword);
+                break;
+            case ASTType::AST_TryStatement:
+                error("A @Parallel loop can not catch exceptions", &((TryStatement *) node)->keyword);
+                break;
+            case ASTType::AST_ThrowStatement:
+                error("A @Parallel loop can not throw", &((ThrowStatement *) node)->keyword);
+                break;
+            case ASTType::AST_BreakStatement:
+                if (nestedDepth == 0) {
+                    error("A @Parallel loop can not break, all of its iterations run", &loop->annotation);
+                }
+                break;
+            default:
+                break;
+        }
+    }
+};
+
+void ForStatement::analyseParallel(SymbolTable &scopeTable) {
+    Token *annotation = &parallel->annotation;
+
+    // for (int i = start; ...)
+    if (!initialization || initialization->codes.size() != 2 ||
+        initialization->codes[0]->getType() != ASTType::AST_LocalVariableASTNode ||
+        initialization->codes[1]->getType() != ASTType::AST_Assignment) {
+        error("A @Parallel loop must declare its loop variable, e.g. 'for (int i = 0; i < n; i++)'", annotation);
+    }
+    auto variable = (LocalVariableASTNode *) initialization->codes[0].get();
+    auto start = (Assignment *) initialization->codes[1].get();
+    if (variable->field.getTypeLexeme() != "int" || start->assignmentToken.lexeme != "=") {
+        error("The loop variable of a @Parallel loop must be an 'int'", annotation);
+    }
+    parallel->variable = variable->field.getName();
+    parallel->start = start->expression.get();
+
+    // ...; i < bound; ...
+    if (!condition || condition->getType() != ASTType::AST_BinaryExpression ||
+        getVariableName(((BinaryExpression *) condition.get())->left.get()) != parallel->variable ||
+        (((BinaryExpression *) condition.get())->op.lexeme != "<" &&
+         ((BinaryExpression *) condition.get())->op.lexeme != "<=")) {
+        error("The condition of a @Parallel loop must be '" + parallel->variable + " < bound' or '" +
+              parallel->variable + " <= bound'", annotation);
+    }
+    auto binary = (BinaryExpression *) condition.get();
+    parallel->bound = binary->right.get();
+    parallel->inclusive = binary->op.lexeme == "<=";
+    if (referencesVariable(parallel->bound, parallel->variable)) {
+        error("The bound of a @Parallel loop can not depend on the loop variable", annotation);
+    }
+
+    // ...; i += step)
+    Assignment *update_ = nullptr;
+    if (update && update->codes.size() == 1 && update->codes[0]->getType() == ASTType::AST_Assignment) {
+        update_ = (Assignment *) update->codes[0].get();
+    }
+    if (!update_ || update_->reference.chain.size() != 1 ||
+        update_->reference.chain[0].first.lexeme != parallel->variable ||
+        update_->assignmentToken.lexeme != "+=" ||
+        update_->expression->getType() != ASTType::AST_NumberASTNode) {
+        error("The update of a @Parallel loop must be '" + parallel->variable + "++' or '" +
+              parallel->variable + " += step'", annotation);
+    }
+    const std::string &step = ((NumberASTNode *) update_->expression.get())->token.lexeme;
+    if (step.find_first_not_of("0123456789") != std::string::npos || step.size() > 9 || std::stoi(step) <= 0) {
+        error("The step of a @Parallel loop must be a positive decimal constant", annotation);
+    }
+    parallel->step = std::stoi(step);
+
+    ParallelLoopChecker checker{parallel.get(), scopeTable};
+    checker.visit(body.get());
+
+    for (auto &name: checker.reads) {
+        if (name != parallel->variable && !checker.declared.contains(name) && checker.isLocal(name)) {
+            parallel->captures.push_back(name);
+        }
+    }
+    for (auto &reduction: parallel->reductions) {
+        if (checker.reads.contains(reduction.variable)) {
+            error("Reduction variable '" + reduction.variable + "' can only be updated by its reduction "
+                                                                "in a @Parallel loop", annotation);
+        }
+        if (referencesVariable(parallel->bound, reduction.variable)) {
+            error("The bound of a @Parallel loop can not depend on the reduction variable '" +
+                  reduction.variable + "'", annotation);
+        }
+    }
+
+    // Views and references may share the storage of a written array under another name
+    auto addOverlap = [&](const std::string &written, const std::string &other, bool aligned) {
+        for (auto &overlap: parallel->overlaps) {
+            if (overlap.written == written && overlap.other == other) {
+                overlap.aligned = overlap.aligned && aligned;
+                return;
+            }
+        }
+        parallel->overlaps.push_back({written, other, aligned});
+    };
+    for (auto &access: checker.arrayReads) {
+        if (checker.writtenArrays.empty() || (access.named && checker.declared.contains(access.name))) {
+            continue;
+        }
+        if (!access.named) {
+            error("Array '" + access.name + "' may share the storage of an array written by the @Parallel "
+                                            "loop, copy it to a local before the loop", &access.token);
+        }
+        if (checker.writtenArrays.contains(access.name)) {
+            if (!access.aligned) {
+                error("Loop-carried dependency on array '" + access.name + "', it is written by the loop, "
+                                                                           "so it can only be read at index '" +
+                      parallel->variable + "'", &access.token);
+            }
+            continue;
+        }
+        for (auto &written: checker.writtenArrays) {
+            addOverlap(written, access.name, access.aligned);
+        }
+    }
+    for (auto it = checker.writtenArrays.begin(); it != checker.writtenArrays.end(); ++it) {
+        for (auto other = std::next(it); other != checker.writtenArrays.end(); ++other) {
+            addOverlap(*it, *other, true);
+        }
+    }
+}
@@ -41,18 +41,32 @@ void ReferenceChain::analyseSemantics(SymbolTable &symbolTable) {
     auto &front = chain.front();
     const std::string &name = front.first.lexeme;
 
+    bool staticAccess = false;
     if (name == "this" || front.second) {
         SymbolTable *table = symbolTable.getCurrentClassSymbolTable();
         if (!table) {
             error("Failed to get current class symbol table");
         }
+        if (name == "this" && symbolTable.isStaticContext()) {
+            error("Cannot use 'this' in a static context");
+        }
+        if (front.second && front.second->getType() == ASTType::AST_MethodCall &&
+            symbolTable.isStaticContext() && !table->lookup(name)) {
+            error("Non-static method '" + name + "' cannot be referenced from a static context");
+        }
         type = table->getClassName();
     } else {
         currentSymbol = symbolTable.lookup(name);
-        if (!currentSymbol) {
-            error("Undefined reference: '" + name + "'");
+        if (!currentSymbol && chain.size() > 1 && name != "int[]" && SymbolTable::getClassSymbolTable(name)) {
+            // `ClassName.member`, a reference to a static member
+            staticAccess = true;
+            type = name;
+        } else {
+            if (!currentSymbol) {
+                error("Undefined reference: '" + name + "'");
+            }
+            type = currentSymbol->type;
         }
-        type = currentSymbol->type;
     }
 
     if (front.second) {
@@ -68,6 +82,12 @@ void ReferenceChain::analyseSemantics(SymbolTable &symbolTable) {
     for (size_t i = 1; i < chain.size(); ++i) {
         auto &entry = chain[i];
         const std::string &member = entry.first.lexeme;
+        if (i == 1 && staticAccess) {
+            Symbol *memberSymbol = SymbolTable::getClassSymbolTable(type)->lookup(member);
+            if (memberSymbol && !memberSymbol->isStatic) {
+                error("Non-static member '" + member + "' cannot be referenced from a static context");
+            }
+        }
         if (entry.second) {
             if (entry.second->getType() == ASTType::AST_MethodCall) {
                 ((MethodCall *) entry.second.get())->callerType = type;
@@ -0,0 +1,75 @@
+#include "../../include/ast.h"
+
+SpawnStatement::SpawnStatement(
+        Token spawnToken_,
+        Token target_,
+        ReferenceChain call_
+) : spawnToken(std::move(spawnToken_)),
+    target(std::move(target_)),
+    call(std::move(call_)) {}
+
+void SpawnStatement::print(std::ostream &strm, int depth) const {
+    strm << std::string(depth, '\t') << "Spawn";
+    if (!target.lexeme.empty()) {
+        strm << " (Target: " << target.lexeme << ")";
+    }
+    strm << std::endl;
+    call.print(strm, depth + 1);
+}
+
+void SpawnStatement::analyseSemantics(SymbolTable &symbolTable) {
+    call.analyseSemantics(symbolTable);
+
+    auto &last = call.chain.back();
+    if (!last.second || last.second->getType() != ASTType::AST_MethodCall) {
+        error("Only method calls can be spawned", &last.first);
+    }
+    auto methodCall = (MethodCall *) last.second.get();
+    if (methodCall->callerType == "System" ||
+        methodCall->callerType == "String" ||
+        methodCall->callerType == "int[]" ||
+        SymbolTable::isChannelType(methodCall->callerType)) {
+        error("Only methods of classes can be spawned", &last.first);
+    }
+    if (methodCall->canThrow) {
+        error("Method '" + methodCall->methodName + "' can throw, it can not be spawned", &last.first);
+    }
+
+    type = "void";
+    if (target.lexeme.empty()) {
+        return;
+    }
+
+    Symbol *local = nullptr;
+    for (SymbolTable *table = &symbolTable; table && !table->isClassScope(); table = table->getParent()) {
+        if ((local = table->find(target.lexeme))) {
+            break;
+        }
+    }
+    if (!local || local->isMethod) {
+        error("The result of a spawned call can only be assigned to a local variable", &target);
+    }
+
+    if (methodCall->type == "void") {
+        error("Spawned method '" + methodCall->methodName + "' returns 'void', "
+              "its result can not be assigned", &target);
+    }
+    if (local->type != methodCall->type) {
+        if (local->type == "int" ||
+            local->type == "int[]" ||
+            local->type == "boolean" ||
+            local->type == "String" ||
+            !SymbolTable::canCast(methodCall->type, local->type)) {
+            error("Type mismatch in spawn: Cannot assign value of type '" + methodCall->type +
+                  "' to variable of type '" + local->type + "'", &target);
+        }
+    }
+}
+
+void SyncStatement::print(std::ostream &strm, int depth) const {
+    strm << std::string(depth, '\t') << "Sync" << std::endl;
+}
+
+void SyncStatement::analyseSemantics(SymbolTable &symbolTable) {
+    type = "void";
+}
@@ -0,0 +1,50 @@
+#include "../../include/ast.h"
+
+StringASTNode::StringASTNode(Token token_) :
+        token(std::move(token_)) {}
+
+void StringASTNode::print(std::ostream &strm, int depth) const {
+    strm << std::string(depth, '\t') << "String: " << token.lexeme << std::endl;
+}
+
+void StringASTNode::analyseSemantics(SymbolTable &symbolTable) {
+    const std::string &lexeme = token.lexeme;
+    value.clear();
+    for (size_t i = 1; i + 1 < lexeme.size(); i++) {
+        if (lexeme[i] != '\\') {
+            value += lexeme[i];
+            continue;
+        }
+        if (i + 2 >= lexeme.size()) {
+            error("Invalid escape sequence in string literal", &token);
+        }
+        switch (lexeme[++i]) {
+            case 'n':
+                value += '\n';
+                break;
+            case 't':
+                value += '\t';
+                break;
+            case 'r':
+                value += '\r';
+                break;
+            case 'b':
+                value += '\b';
+                break;
+            case 'f':
+                value += '\f';
+                break;
+            case '0':
+                value += '\0';
+                break;
+            case '"':
+            case '\'':
+            case '\\':
+                value += lexeme[i];
+                break;
+            default:
+                error("Invalid escape sequence '\\" + std::string(1, lexeme[i]) + "' in string literal", &token);
+        }
+    }
+    type = "String";
+}
@@ -0,0 +1,148 @@
+#include "../../include/ast.h"
+#include <algorithm>
+#include <set>
+
+SwitchStatement::SwitchStatement(
+        std::unique_ptr<ASTNode> condition_,
+        std::vector<SwitchCase> cases_
+) : condition(std::move(condition_)),
+    cases(std::move(cases_)) {}
+
+void SwitchStatement::print(std::ostream &strm, int depth) const {
+    strm << std::string(depth, '\t') << "SwitchStatement" << " (Type:" << type << ")" << std::endl;
+    strm << std::string(depth + 1, '\t') << "Condition:" << std::endl;
+    condition->print(strm, depth + 2);
+    for (auto &switchCase: cases) {
+        strm << std::string(depth + 1, '\t')
+             << (switchCase.isDefault ? "Default:" : "Case " + switchCase.label.lexeme + ":") << std::endl;
+        switchCase.body->print(strm, depth + 2);
+    }
+}
+
+/**
+ * @brief Resolves the value of an integer literal used as a `case` label.
+ *
+ * Supports decimal, octal, hexadecimal and binary literals with underscores, hexadecimal,
+ * octal and binary literals may use all 32 bits (e.g., `0xFFFFFFFF` is `-1`).
+ *
+ * @param label The label token, its lexeme may start with `-`.
+ * @return The value of the literal as an `int`.
+ */
+int resolveCaseValue(Token &label) {
+    std::string literal = label.lexeme;
+    literal.erase(std::remove(literal.begin(), literal.end(), '_'), literal.end());
+    bool negative = literal[0] == '-';
+    if (negative) {
+        literal = literal.substr(1);
+    }
+
+    int base = 10;
+    if (literal.size() > 1 && literal[0] == '0') {
+        if (literal[1] == 'x' || literal[1] == 'X') {
+            base = 16;
+        } else if (literal[1] == 'b' || literal[1] == 'B') {
+            base = 2;
+        } else {
+            base = 8;
+        }
+        literal = literal.substr(base == 8 ? 1 : 2);
+    }
+
+    unsigned long long value = 0;
+    for (char c: literal) {
+        int digit = isdigit(c) ? c - '0' : tolower(c) - 'a' + 10;
+        if (digit < 0 || digit >= base) {
+            error("Invalid integer constant in case label", &label);
+        }
+        value = value * base + digit;
+        if (value > 0xFFFFFFFFULL) {
+            error("Integer constant in case label is too large", &label);
+        }
+    }
+    if (base == 10 && value > 2147483647ULL + (negative ? 1 : 0)) {
+        error("Integer constant in case label is too large", &label);
+    }
+
+    auto result = (int) (unsigned int) value;
+    return negative ? (int) (0U - (unsigned int) result) : result;
+}
+
+/**
+ * @brief Checks if a statement contains a `break` that leaves the enclosing `switch`.
+ *
+ * Nested loops and switches are skipped, their `break` statements target themselves.
+ *
+ * @param node The statement to check.
+ * @return `true` if the statement may break out of the enclosing `switch`.
+ */
+bool containsSwitchBreak(ASTNode *node) {
+    if (!node) {
+        return false;
+    }
+    switch (node->getType()) {
+        case AST_BreakStatement:
+            return true;
+        case AST_CodeBlock:
+            for (auto &code: ((CodeBlock *) node)->codes) {
+                if (containsSwitchBreak(code.get())) {
+                    return true;
+                }
+            }
+            return false;
+        case AST_IfStatement:
+            return containsSwitchBreak(((IfStatement *) node)->body.get()) ||
+                   containsSwitchBreak(((IfStatement *) node)->elseBody.get());
+        case AST_SynchronizedStatement:
+            return containsSwitchBreak(((SynchronizedStatement *) node)->body.get());
+        case AST_TryStatement:
+            if (containsSwitchBreak(((TryStatement *) node)->body.get())) {
+                return true;
+            }
+            for (auto &clause: ((TryStatement *) node)->catches) {
+                if (containsSwitchBreak(clause.body.get())) {
+                    return true;
+                }
+            }
+            return false;
+        default:
+            return false;
+    }
+}
+
+void SwitchStatement::analyseSemantics(SymbolTable &symbolTable) {
+    condition->analyseSemantics(symbolTable);
+    if (condition->type != "int") {
+        error("Condition in 'switch' statement must be of type 'int', "
+              "but got '" + condition->type + "'.");
+    }
+
+    std::string returnType = symbolTable.getReturnType();
+    if (returnType == "void") {
+        returnType = "return-void";
+    }
+
+    std::set<int> values;
+    bool hasDefault = false;
+    bool breaks = false;
+    for (auto &switchCase: cases) {
+        if (switchCase.isDefault) {
+            if (hasDefault) {
+                error("Duplicate default label in 'switch' statement", &switchCase.label);
+            }
+            hasDefault = true;
+        } else {
+            switchCase.value = resolveCaseValue(switchCase.label);
+            if (!values.insert(switchCase.value).second) {
+                error("Duplicate case label in 'switch' statement", &switchCase.label);
+            }
+        }
+        switchCase.body->analyseSemantics(symbolTable);
+        breaks |= containsSwitchBreak(switchCase.body.get());
+    }
+
+    if (hasDefault && !breaks && cases.back().body->type == returnType) {
+        type = returnType;
+    } else {
+        type = "void";
+    }
+}
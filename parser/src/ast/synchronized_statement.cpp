@@ -0,0 +1,26 @@
+#include "../../include/ast.h"
+
+SynchronizedStatement::SynchronizedStatement(
+        Token keyword_,
+        std::unique_ptr<ASTNode> lock_,
+        std::unique_ptr<CodeBlock> body_
+) : keyword(std::move(keyword_)),
+    lock(std::move(lock_)),
+    body(std::move(body_)) {}
+
+void SynchronizedStatement::print(std::ostream &strm, int depth) const {
+    strm << std::string(depth, '\t') << "SynchronizedStatement" << " (Type:" << type << ")" << std::endl;
+    strm << std::string(depth + 1, '\t') << "Lock:" << " (Type:" << lock->type << ")" << std::endl;
+    lock->print(strm, depth + 2);
+    strm << std::string(depth + 1, '\t') << "Body:" << std::endl;
+    body->print(strm, depth + 2);
+}
+
+void SynchronizedStatement::analyseSemantics(SymbolTable &symbolTable) {
+    lock->analyseSemantics(symbolTable);
+    if (!SymbolTable::isObjectType(lock->type)) {
+        error("Lock of 'synchronized' must be an object, but got '" + lock->type + "'", &keyword);
+    }
+    body->analyseSemantics(symbolTable);
+    type = body->type;
+}
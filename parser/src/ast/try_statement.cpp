@@ -0,0 +1,75 @@
+#include "../../include/ast.h"
+
+TryStatement::TryStatement(
+        Token keyword_,
+        std::unique_ptr<CodeBlock> body_,
+        std::vector<CatchClause> catches_
+) : keyword(std::move(keyword_)),
+    body(std::move(body_)),
+    catches(std::move(catches_)) {}
+
+void TryStatement::print(std::ostream &strm, int depth) const {
+    strm << std::string(depth, '\t') << "TryStatement" << " (Type:" << type << ")" << std::endl;
+    body->print(strm, depth + 1);
+    for (auto &clause: catches) {
+        strm << std::string(depth + 1, '\t') << "Catch (" << clause.classType.lexeme << " "
+             << clause.name.lexeme << "):" << std::endl;
+        clause.body->print(strm, depth + 2);
+    }
+}
+
+void TryStatement::analyseSemantics(SymbolTable &symbolTable) {
+    auto tryScope = SymbolTable(&symbolTable, symbolTable.getReturnType());
+    tryScope.setExceptionsHandled(true);
+    body->analyseSemantics(tryScope);
+
+    std::string returnType = symbolTable.getReturnType();
+    if (returnType == "void") {
+        returnType = "return-void";
+    }
+    bool returns = body->type == returnType;
+
+    for (size_t i = 0; i < catches.size(); i++) {
+        auto &clause = catches[i];
+        if (!SymbolTable::isObjectType(clause.classType.lexeme)) {
+            error("Undefined class in 'catch': '" + clause.classType.lexeme + "'", &clause.classType);
+        }
+        for (size_t j = 0; j < i; j++) {
+            if (SymbolTable::canCast(clause.classType.lexeme, catches[j].classType.lexeme)) {
+                error("Unreachable catch clause: '" + clause.classType.lexeme + "' is already caught by '" +
+                      catches[j].classType.lexeme + "'", &clause.classType);
+            }
+        }
+        auto catchScope = SymbolTable(&symbolTable, symbolTable.getReturnType());
+        catchScope.addSymbol(clause.name.lexeme, Symbol(clause.name.lexeme, clause.classType.lexeme));
+        clause.body->analyseSemantics(catchScope);
+        returns = returns && clause.body->type == returnType;
+    }
+    type = returns ? returnType : "void";
+}
+
+ThrowStatement::ThrowStatement(
+        Token keyword_,
+        std::unique_ptr<ASTNode> expr_
+) : keyword(std::move(keyword_)),
+    expr(std::move(expr_)) {}
+
+void ThrowStatement::print(std::ostream &strm, int depth) const {
+    strm << std::string(depth, '\t') << "ThrowStatement" << " (Type:" << type << ")" << std::endl;
+    expr->print(strm, depth + 1);
+}
+
+void ThrowStatement::analyseSemantics(SymbolTable &symbolTable) {
+    expr->analyseSemantics(symbolTable);
+    if (!SymbolTable::isObjectType(expr->type)) {
+        error("Only objects can be thrown, but got '" + expr->type + "'", &keyword);
+    }
+    if (!symbolTable.areExceptionsHandled()) {
+        error("Unreported exception '" + expr->type + "', it must be caught or the method must declare 'throws'",
+              &keyword);
+    }
+    type = symbolTable.getReturnType();
+    if (type == "void") {
+        type = "return-void";
+    }
+}
\ No newline at end of file
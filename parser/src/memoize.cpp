@@ -0,0 +1,204 @@
+#include "../internal/parser_internal.h"
+#include <set>
+
+/**
+ * @struct MemoizeChecker
+ * @brief Walks the body of a `@Memoize` method to verify that its result only depends on its arguments.
+ */
+struct MemoizeChecker {
+    /// The method being checked.
+    Method *method;
+
+    /// The parameters and the locals of the method.
+    std::set<std::string> locals;
+
+    void impure(const std::string &reason, Token *token = nullptr) const {
+        error("@Memoize method '" + method->getName() + "' must be pure, " + reason, token);
+    }
+
+    void visitCall(MethodCall *call, Token &token) {
+        SymbolTable *table = SymbolTable::getClassSymbolTable(call->callerType);
+        Symbol *symbol = table ? table->lookup(call->methodName) : nullptr;
+        if (!symbol || !symbol->memoized) {
+            impure("it can only call @Memoize methods, but calls '" + call->methodName + "'", &token);
+        }
+        for (auto &argument: call->arguments) {
+            visit(argument.get());
+        }
+    }
+
+    void visitChain(ReferenceChain &reference) {
+        auto &chain = reference.chain;
+        Token &first = chain[0].first;
+        if (chain[0].second) {
+            if (chain[0].second->getType() == ASTType::AST_NewObject) {
+                impure("it can not create objects", &first);
+            }
+            if (chain.size() != 1 || chain[0].second->getType() != ASTType::AST_MethodCall) {
+                impure("it can only read its parameters and locals", &first);
+            }
+            visitCall((MethodCall *) chain[0].second.get(), first);
+            return;
+        }
+        if (chain.size() == 1) {
+            if (!locals.contains(first.lexeme)) {
+                impure("it can not read field '" + first.lexeme + "'", &first);
+            }
+            return;
+        }
+        if (first.lexeme == "System") {
+            impure("it can not print", &first);
+        }
+        // `this.m(...)` or `ClassName.m(...)`
+        bool isReceiver = first.lexeme == "this" || SymbolTable::getClassSymbolTable(first.lexeme) != nullptr;
+        if (chain.size() != 2 || !isReceiver || locals.contains(first.lexeme) ||
+            !chain[1].second || chain[1].second->getType() != ASTType::AST_MethodCall) {
+            impure("it can only read its parameters and locals", &first);
+        }
+        visitCall((MethodCall *) chain[1].second.get(), chain[1].first);
+    }
+
+    void visit(ASTNode *node) {
+        if (!node) {
+            return;
+        }
+        switch (node->getType()) {
+            case ASTType::AST_NumberASTNode:
+            case ASTType::AST_BooleanASTNode:
+            case ASTType::AST_BreakStatement:
+            case ASTType::AST_ContinueStatement:
+                break;
+            case ASTType::AST_BinaryExpression:
+                visit(((BinaryExpression *) node)->left.get());
+                visit(((BinaryExpression *) node)->right.get());
+                break;
+            case ASTType::AST_NotExpression:
+                visit(((NotExpression *) node)->expr.get());
+                break;
+            case ASTType::AST_ConditionalExpression:
+                visit(((ConditionalExpression *) node)->condition.get());
+                visit(((ConditionalExpression *) node)->thenExpr.get());
+                visit(((ConditionalExpression *) node)->elseExpr.get());
+                break;
+            case ASTType::AST_ReferenceASTNode:
+                visitChain(((ReferenceASTNode *) node)->reference);
+                break;
+            case ASTType::AST_LocalVariableASTNode: {
+                Field &field = ((LocalVariableASTNode *) node)->field;
+                if (field.getTypeLexeme() != "int" && field.getTypeLexeme() != "boolean") {
+                    impure("its locals must be 'int' or 'boolean', but '" + field.getName() + "' is '" +
+                           field.getTypeLexeme() + "'");
+                }
+                locals.insert(field.getName());
+                break;
+            }
+            case ASTType::AST_Assignment: {
+                auto assignment = (Assignment *) node;
+                auto &chain = assignment->reference.chain;
+                if (chain.size() != 1 || chain[0].second || !locals.contains(chain[0].first.lexeme)) {
+                    impure("it can only assign its parameters and locals", &chain[0].first);
+                }
+                visit(assignment->expression.get());
+                break;
+            }
+            case ASTType::AST_CodeBlock:
+                for (auto &code: ((CodeBlock *) node)->codes) {
+                    visit(code.get());
+                }
+                break;
+            case ASTType::AST_IfStatement:
+                visit(((IfStatement *) node)->condition.get());
+                visit(((IfStatement *) node)->body.get());
+                visit(((IfStatement *) node)->elseBody.get());
+                break;
+            case ASTType::AST_WhileStatement:
+                visit(((WhileStatement *) node)->condition.get());
+                visit(((WhileStatement *) node)->body.get());
+                break;
+            case ASTType::AST_ForStatement:
+                if (((ForStatement *) node)->parallel) {
+                    impure("it can not run a @Parallel loop", &((ForStatement *) node)->parallel->annotation);
+                }
+                visit(((ForStatement *) node)->initialization.get());
+                visit(((ForStatement *) node)->condition.get());
+                visit(((ForStatement *) node)->update.get());
+                visit(((ForStatement *) node)->body.get());
+                break;
+            case ASTType::AST_SwitchStatement:
+                visit(((SwitchStatement *) node)->condition.get());
+                for (auto &switchCase: ((SwitchStatement *) node)->cases) {
+                    visit(switchCase.body.get());
+                }
+                break;
+            case ASTType::AST_ReturnStatement:
+                visit(((ReturnStatement *) node)->expr.get());
+                break;
+            case ASTType::AST_SpawnStatement:
+                impure("it can not spawn calls", &((SpawnStatement *) node)->spawnToken);
+                break;
+            case ASTType::AST_SynchronizedStatement:
+                impure("it can not synchronize", &((SynchronizedStatement *) node)->keyword);
+                break;
+            case ASTType::AST_TryStatement:
+                impure("it can not catch exceptions", &((TryStatement *) node)->keyword);
+                break;
+            case ASTType::AST_ThrowStatement:
+                impure("it can not throw", &((ThrowStatement *) node)->keyword);
+                break;
+            default:
+                impure("it can only compute with 'int' and 'boolean' values");
+                break;
+        }
+    }
+};
+
+/**
+ * @brief Checks that a `@Memoize` method can be cached by its arguments.
+ *
+ * The generator caches the results of the method in a table keyed by its arguments (see
+ * `write_memo`), so the method must be pure:
+ * - Its parameters are `int` and it returns an `int` or a `boolean`.
+ * - It is not `synchronized` and doesn't declare `throws`.
+ * - Its body only reads and writes its parameters and its `int` or `boolean` locals, and only calls
+ *   `@Memoize` methods (including itself), which are pure by the same rules.
+ * - It doesn't create objects, spawn calls, synchronize or print.
+ *
+ * `@Memoize` methods can't be overridden (see `semanticAnalysis`), so a call on `this` always runs the
+ * checked body.
+ *
+ * Example:
+ * ```java
+ * @Memoize
+ * public int paths(int row, int column) {
+ *     if (row == 0 || column == 0) return 1;
+ *     return this.paths(row - 1, column) + this.paths(row, column - 1);
+ * }
+ * ```
+ *
+ * @param project The parsed project.
+ * @param clazz The class declaring the method.
+ * @param method The `@Memoize` method, after its semantic analysis.
+ */
+void analyseMemoize(Project &project, Class *clazz, Method *method) {
+    MemoizeChecker checker = {method};
+    if (method->getReturnTypeLexeme() != "int" && method->getReturnTypeLexeme() != "boolean") {
+        checker.impure("it must return 'int' or 'boolean'");
+    }
+    if (method->getParams()->empty()) {
+        checker.impure("it must have parameters, its results are cached by arguments");
+    }
+    for (auto &param: *method->getParams()) {
+        if (param.getTypeLexeme() != "int") {
+            checker.impure("its parameters must be 'int', but '" + param.getName() + "' is '" +
+                           param.getTypeLexeme() + "'");
+        }
+        checker.locals.insert(param.getName());
+    }
+    if (method->isSynchronized()) {
+        checker.impure("it can not be synchronized");
+    }
+    if (method->canThrow()) {
+        checker.impure("it can not declare 'throws'");
+    }
+    checker.visit(method->getCodeBlock());
+}
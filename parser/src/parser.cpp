@@ -1,16 +1,29 @@
 #include "../include/parser.h"
 #include "../internal/streamer.h"
 #include "../internal/parser_internal.h"
+#include <set>
 
 /**
  * @brief Adds built-in Java system classes and their methods/fields to the global symbol table.
  *
- * This function registers two built-in entities in the symbol table:
+ * This function registers four built-in entities in the symbol table:
  * 1. The `System` class, including:
  *    - `out`: Represents the standard output (e.g., `System.out`).
- *    - `println(int)`, `print(int)`, and `printf(int)`: Built-in methods for printing integers.
+ *    - `println(int)`, `print(int)`, and `printf(int)`: Built-in methods for printing integers,
+ *      also accepting a `String` (see `MethodCall::analyseSemantics`).
  * 2. The `int[]` type, which represents arrays, including:
  *    - `length`: A field representing the size of the array.
+ *    - `slice(int, int)`: A view of the elements in `[from, to)`, sharing the storage of the array.
+ * 3. The `String` type, which represents immutable strings, including:
+ *    - `length()`: The number of characters of the string.
+ *    - `charAt(int)`: The character at the given index, as an `int`.
+ * 4. The `Channel` and `SpscChannel` types, bounded channels of `int` between threads created with
+ *    `new Channel(capacity)` (see `write_channel`), including:
+ *    - `send(int)`: Sends a value, blocks while the channel is full.
+ *    - `recv()`: Receives the oldest value, blocks while the channel is empty.
+ *
+ *    A `Channel` may be shared by any number of threads, a `SpscChannel` must only be sent to by a single
+ *    thread and received from by a single thread.
  *
  * These system classes must be included before semantic analysis to allow references like `System.out.println()` or `array.length`.
  *
@@ -31,7 +44,141 @@ void addJavaSystemToSymbolTable() {
 
     SymbolTable intArray = SymbolTable("int[]");
     intArray.addSymbol("length", Symbol("length", "int"));
+    intArray.addSymbol("slice", Symbol("slice", "int[]", true, {"int", "int"}, "int[]"));
     SymbolTable::addClassSymbolTable("int[]", intArray);
+
+    SymbolTable string = SymbolTable("String");
+    string.addSymbol("length", Symbol("length", "int", true, {}, "int"));
+    string.addSymbol("charAt", Symbol("charAt", "int", true, {"int"}, "int"));
+    SymbolTable::addClassSymbolTable("String", string);
+
+    for (const char *type: {"Channel", "SpscChannel"}) {
+        SymbolTable channel = SymbolTable(type);
+        channel.addSymbol("send", Symbol("send", "void", true, {"int"}, "void"));
+        channel.addSymbol("recv", Symbol("recv", "int", true, {}, "int"));
+        SymbolTable::addClassSymbolTable(type, channel);
+    }
+}
+
+/**
+ * @brief Builds the scope of a static method, a view of the class that only contains its static members.
+ *
+ * Static methods have no `this`, so unqualified names inside them may only resolve to static fields
+ * and static methods of the class (or its superclasses). Members are collected from the class up to
+ * the root of its hierarchy; a member hides the members with the same name in its superclasses, even if
+ * it is not static itself.
+ *
+ * Example:
+ * ```java
+ * class A {
+ *     static int count;
+ *     int x;
+ *     static void inc() {
+ *         count = count + 1; // OK: `count` is static
+ *         x = 2;             // Error: `x` is undefined in a static context
+ *     }
+ * }
+ * ```
+ *
+ * @param project The parsed `Project`.
+ * @param clazz The class declaring the static method.
+ * @return A class-level `SymbolTable` marked as a static context.
+ */
+SymbolTable createStaticScope(Project &project, Class *clazz) {
+    SymbolTable staticScope = SymbolTable(clazz->getName());
+    staticScope.setStaticContext(true);
+    staticScope.addSymbol("System", Symbol("System", "System"));
+
+    std::set<Identifier> hidden;
+    Class *current = clazz;
+    while (current) {
+        SymbolTable *classTable = SymbolTable::getClassSymbolTable(current->getName());
+        for (auto &field: *current->getFields()) {
+            if (hidden.insert(field.getName()).second && field.isStatic()) {
+                staticScope.addSymbol(field.getName(), *classTable->find(field.getName()));
+            }
+        }
+        for (auto &method: *current->getMethods()) {
+            if (hidden.insert(method.getName()).second && method.isStatic() && !method.isMain()) {
+                staticScope.addSymbol(method.getName(), *classTable->find(method.getName()));
+            }
+        }
+        current = current->getExtends().empty() ? nullptr : project.getClassByName(current->getExtends());
+    }
+    return staticScope;
+}
+
+/**
+ * @brief Builds the scope of an interface, the symbols of its method declarations.
+ *
+ * @param interfaceClass The interface.
+ * @return A class-level `SymbolTable` marked as an interface.
+ */
+SymbolTable createInterfaceScope(Class *interfaceClass) {
+    SymbolTable interfaceScope = SymbolTable(interfaceClass->getName());
+    interfaceScope.setInterface(true);
+    for (auto &method: *interfaceClass->getMethods()) {
+        std::vector<std::string> params;
+        for (auto &param: *method.getParams()) {
+            params.push_back(param.getTypeLexeme());
+        }
+        Symbol symbol = Symbol(
+                method.getName(),
+                method.getReturnTypeLexeme(),
+                true,
+                params,
+                method.getReturnTypeLexeme()
+        );
+        symbol.throws = method.canThrow();
+        interfaceScope.addSymbol(method.getName(), symbol);
+    }
+    return interfaceScope;
+}
+
+/**
+ * @brief Checks that a class implements every method of the interfaces it declares.
+ *
+ * A method of an interface may be implemented by the class or inherited from one of its superclasses.
+ * The implementation must be an instance method with the same parameter types and return type.
+ *
+ * Example:
+ * ```java
+ * interface Shape { int area(); }
+ * class Square implements Shape {
+ *     int side;
+ *     public int area() { return side * side; } // OK
+ * }
+ * class Circle implements Shape { }            // Error: Circle must implement area() of Shape
+ * ```
+ *
+ * @param project The parsed `Project`.
+ * @param clazz The class to check, its symbol table and the ones of its superclasses must be registered.
+ */
+void checkImplementedInterfaces(Project &project, Class *clazz) {
+    SymbolTable *classTable = SymbolTable::getClassSymbolTable(clazz->getName());
+    for (auto &interfaceName: *clazz->getInterfaces()) {
+        if (!project.containsClass(interfaceName) || !project.getClassByName(interfaceName)->isInterface()) {
+            error("Class " + clazz->getName() + " implements '" + interfaceName + "', which is not an interface");
+        }
+        SymbolTable *interfaceTable = SymbolTable::getClassSymbolTable(interfaceName);
+        for (auto &method: *project.getClassByName(interfaceName)->getMethods()) {
+            Symbol *declaration = interfaceTable->find(method.getName());
+            Symbol *implementation = classTable->lookup(method.getName());
+            if (!implementation || !implementation->isMethod || implementation->isStatic) {
+                error("Class " + clazz->getName() + " must implement method " + method.getName() +
+                      " of interface " + interfaceName);
+            }
+            if (implementation->params != declaration->params ||
+                implementation->returnType != declaration->returnType) {
+                error("Method " + method.getName() + " of class " + clazz->getName() +
+                      " does not match its declaration in interface " + interfaceName);
+            }
+            if (implementation->throws && !declaration->throws) {
+                error("Method " + method.getName() + " of class " + clazz->getName() +
+                      " can not throw, its declaration in interface " + interfaceName + " doesn't declare 'throws'");
+            }
+        }
+    }
 }
 
 /**
@@ -43,20 +190,41 @@ void addJavaSystemToSymbolTable() {
  * 3. Validate method bodies and ensure that all variables and types are resolved correctly in the respective scopes.
  *
  * **Steps**:
- * - Register all classes into the global symbol table.
+ * - Register all interfaces, then all classes into the global symbol table, and check that the classes
+ *   implement the methods of their interfaces (see `checkImplementedInterfaces`). A method overriding (or
+ *   implementing) a method that doesn't declare `throws` can't declare it either, so the callers of any
+ *   implementation check for exceptions if the method they call statically can throw.
  * - For each method, validate its `CodeBlock` by resolving symbols in the appropriate scope (class scope or method scope).
+ *   Static methods are resolved in a static view of their class (see `createStaticScope`).
+ * - Check that `@Memoize` methods are pure (see `analyseMemoize`), they can't be overridden.
  *
  * @param project The parsed `Project` containing classes, fields, and methods to analyze.
  */
 void semanticAnalysis(Project &project) {
+    ScopedTimer timer("semanticAnalysis");
     auto sortedClasses = project.getTopologicalSort();
     addJavaSystemToSymbolTable();
 
+    for (auto &clazz: *project.getClasses()) {
+        if (clazz.isInterface()) {
+            SymbolTable::addClassSymbolTable(clazz.getName(), createInterfaceScope(&clazz));
+        }
+    }
+
     for (auto &className: sortedClasses) {
         auto clazz = project.getClassByName(className);
+        if (clazz->isInterface()) {
+            continue;
+        }
+        if (!clazz->getExtends().empty() && project.getClassByName(clazz->getExtends())->isInterface()) {
+            error("Class " + clazz->getName() + " can not extend interface " + clazz->getExtends() +
+                  ", use implements");
+        }
         SymbolTable classTable = SymbolTable(clazz->getName(), SymbolTable::getClassSymbolTable(clazz->getExtends()));
         for (auto &field: *clazz->getFields()) {
-            classTable.addSymbol(field.getName(), Symbol(field.getName(), field.getTypeLexeme()));
+            Symbol symbol = Symbol(field.getName(), field.getTypeLexeme());
+            symbol.isStatic = field.isStatic();
+            classTable.addSymbol(field.getName(), symbol);
         }
         classTable.addSymbol("System", Symbol("System", "System"));
 
@@ -65,29 +233,61 @@ void semanticAnalysis(Project &project) {
             for (auto &param: *method.getParams()) {
                 params.push_back(param.getTypeLexeme());
             }
-            classTable.addSymbol(method.getName(), Symbol(
+            Symbol symbol = Symbol(
                     method.getName(),
                     method.getReturnTypeLexeme(),
                     true,
                     params,
                     method.getReturnTypeLexeme()
-            ));
+            );
+            symbol.isStatic = method.isStatic();
+            symbol.throws = method.canThrow();
+            symbol.memoized = method.isMemoized();
+            Symbol *overridden = classTable.getParent() ? classTable.getParent()->lookup(method.getName()) : nullptr;
+            if (symbol.throws && overridden && overridden->isMethod && !overridden->throws) {
+                error("Method " + method.getName() + " of class " + clazz->getName() +
+                      " can not throw, the method it overrides doesn't declare 'throws'");
+            }
+            if (overridden && overridden->isMethod && overridden->memoized) {
+                error("Method " + method.getName() + " of class " + clazz->getName() +
+                      " can not override a @Memoize method, its results are cached by arguments only");
+            }
+            classTable.addSymbol(method.getName(), symbol);
+        }
+        for (auto &interfaceName: *clazz->getInterfaces()) {
+            classTable.addInterface(interfaceName);
         }
         SymbolTable::addClassSymbolTable(clazz->getName(), classTable);
+        checkImplementedInterfaces(project, clazz);
     }
 
     for (auto &className: sortedClasses) {
         auto clazz = project.getClassByName(className);
+        if (clazz->isInterface()) {
+            continue;
+        }
         auto classScope = SymbolTable::getClassSymbolTable(clazz->getName());
         for (auto &method: *clazz->getMethods()) {
+            ScopedTimer methodTimer("analyseSemantics", clazz->getName(), method.getName());
+            for (auto &exceptionClass: *method.getThrows()) {
+                if (!SymbolTable::isObjectType(exceptionClass)) {
+                    error("Undefined class in 'throws' of method " + method.getName() + ": '" + exceptionClass + "'");
+                }
+            }
             if (method.isMain()) {
-                SymbolTable globalScope = SymbolTable("System");
-                globalScope.addSymbol("System", Symbol("System", "System"));
+                if (method.isMemoized()) {
+                    error("Method main can not be @Memoize");
+                }
+                SymbolTable globalScope = createStaticScope(project, clazz);
+                globalScope.setExceptionsHandled(method.canThrow());
                 method.getCodeBlock()->analyseSemantics(globalScope);
                 continue;
             }
 
-            auto methodScope = SymbolTable(classScope, method.getReturnTypeLexeme());
+            SymbolTable staticScope = method.isStatic() ? createStaticScope(project, clazz) : SymbolTable();
+            auto methodScope = SymbolTable(method.isStatic() ? &staticScope : classScope,
+                                           method.getReturnTypeLexeme());
+            methodScope.setExceptionsHandled(method.canThrow());
             for (auto &param: *method.getParams()) {
                 methodScope.addSymbol(param.getName(), Symbol(param.getName(), param.getTypeLexeme()));
             }
@@ -96,10 +296,46 @@ void semanticAnalysis(Project &project) {
                 method.getReturnTypeLexeme() != "void") {
                 error("Missing return statement: " + method.getName() + " (" + method.getReturnTypeLexeme() + ")");
             }
+            if (method.isMemoized()) {
+                analyseMemoize(project, clazz, &method);
+            }
         }
     }
 }
 
+/**
+ * @brief The source of the built-in `Thread` class.
+ *
+ * Programs create threads by extending `Thread` and overriding `run()`, `start()` runs `run()` on a new
+ * thread and `join()` waits for it to finish. The bodies of `start()` and `join()` are native, they are
+ * generated by the code generator (see `write_monitor`).
+ */
+const char *THREAD_SOURCE = R"(
+class Thread {
+    public void run() {
+    }
+
+    public void start() {
+    }
+
+    public void join() {
+    }
+}
+)";
+
+/**
+ * @brief Checks if the program refers to the built-in `Thread` class.
+ *
+ * The tokens the program was parsed from are searched, the source is not tokenized again.
+ *
+ * @param project The parsed `Project`.
+ * @param streamer The streamer the program was parsed from.
+ * @return `true` if `Thread` is used as a name and the program does not declare its own `Thread` class.
+ */
+bool usesBuiltinThread(Project &project, const TokenStreamer &streamer) {
+    return !project.containsClass("Thread") && streamer.containsIdentifier("Thread");
+}
+
 /**
  * @brief Parses Mini-Java source code and performs semantic analysis.
  *
@@ -109,9 +345,11 @@ void semanticAnalysis(Project &project) {
  * **Steps**:
  * - Tokenize the input source code using a `TokenStreamer`.
  * - Parse the class definitions into a `Project` object.
+ * - Add the built-in classes used by the program (`Thread`).
  * - Perform semantic analysis using `semanticAnalysis` to resolve types and validate symbols.
  */
 Project parse(const std::string &source) {
+    ScopedTimer timer("parse");
     Project project = Project();
 
     TokenStreamer streamer = TokenStreamer(source);
@@ -120,6 +358,12 @@ Project parse(const std::string &source) {
             break;
         }
     }
+
+    if (usesBuiltinThread(project, streamer)) {
+        TokenStreamer threadStreamer = TokenStreamer(THREAD_SOURCE);
+        parseClass(project, threadStreamer);
+        project.getClassByName("Thread")->setBuiltin(true);
+    }
     semanticAnalysis(project);
     return project;
 }
\ No newline at end of file
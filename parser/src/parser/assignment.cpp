@@ -1,17 +1,17 @@
 #include "../../internal/parser_internal.h"
 
 std::vector<std::vector<std::string>> operatorPrecedence = {
-        {"||"},                   /// Logical OR (Lowest precedence)
-        {"&&"},                   /// Logical AND
-        {"|"},                    /// Bitwise OR
-        {"^"},                    /// Bitwise XOR
-        {"&"},                    /// Bitwise AND
-        {"==", "!="},             /// Equality Operators
-        {"<",  "<=", ">", ">="},  /// Relational Operators
-        {"<<", ">>", ">>>"},      /// Shift
-        {"+",  "-"},              /// Addition, Subtraction
-        {"*",  "/",  "%"},        /// Multiplication, Division, Modulus
-        {"!",  "~"}               /// Logical NOT, Bitwise NOT (Highest precedence)
+        {"||"},                                /// Logical OR (Lowest precedence)
+        {"&&"},                                /// Logical AND
+        {"|"},                                 /// Bitwise OR
+        {"^"},                                 /// Bitwise XOR
+        {"&"},                                 /// Bitwise AND
+        {"==", "!="},                          /// Equality Operators
+        {"<",  "<=", ">", ">=", "instanceof"}, /// Relational Operators, Type Test
+        {"<<", ">>", ">>>"},                   /// Shift
+        {"+",  "-"},                           /// Addition, Subtraction
+        {"*",  "/",  "%"},                     /// Multiplication, Division, Modulus
+        {"!",  "~"}                            /// Logical NOT, Bitwise NOT (Highest precedence)
 };
 
 bool isAssignment(Token *token) {
@@ -40,6 +40,7 @@ bool isAssignment(Token *token) {
  * object.field.method(); // Chained method call
  * new MyClass();         // New object
  * new int[10];           // New integer array
+ * new Channel(16);       // New channel with a capacity
  * ```
  *
  * @param project The `Project` context containing parsed data.
@@ -59,6 +60,7 @@ ReferenceChain parseReferenceChain(
         Token *type = streamer.read();
         Token *next;
         std::unique_ptr<ASTNode> array_size = nullptr;
+        std::unique_ptr<ASTNode> capacity = nullptr;
 
         if (type != nullptr && type->lexeme == "int") {
             next = streamer.read();
@@ -78,6 +80,9 @@ ReferenceChain parseReferenceChain(
             if (next == nullptr || next->lexeme != "(") {
                 error("Failed to parse new object, Expected '('", next);
             }
+            if (SymbolTable::isChannelType(type->lexeme) && streamer.peek() && streamer.peek()->lexeme != ")") {
+                capacity = parseExpression(project, streamer);
+            }
             next = streamer.read();
             if (next == nullptr || next->lexeme != ")") {
                 error("Failed to parse new object, Expected ')'", next);
@@ -86,7 +91,7 @@ ReferenceChain parseReferenceChain(
         if (streamer.peek() == nullptr) {
             error("Failed to parse new object, Expected ';'", next);
         }
-        referenceChain.addNode(*tokenToAdd, std::make_unique<NewObject>(std::move(*type), std::move(array_size)));
+        referenceChain.addNode(*tokenToAdd, std::make_unique<NewObject>(std::move(*type), std::move(array_size), std::move(capacity)));
         tokenToAdd = nullptr;
         if (streamer.peek()->lexeme == ";") {
             return referenceChain;
@@ -152,7 +157,7 @@ ReferenceChain parseReferenceChain(
  * @brief Parses a **primary expression** (e.g., literals, identifiers, reference chains).
  *
  * This function handles basic expressions, including:
- * - Literals (`NumberASTNode`, `BooleanASTNode`)
+ * - Literals (`NumberASTNode`, `BooleanASTNode`, `StringASTNode`)
  * - Identifiers, `this`, and `new` for object/array creation (via `ReferenceChain`).
  * - Parenthesized expressions `(expr)` for grouping.
  *
@@ -160,6 +165,7 @@ ReferenceChain parseReferenceChain(
  * ```java
  * 42;         // Number literal
  * true;       // Boolean literal
+ * "Hi";       // String literal
  * this;       // Reference to the current object
  * (x + y);    // Parenthesized expression
  * new MyClass(); // Object creation
@@ -184,6 +190,8 @@ std::unique_ptr<ASTNode> parsePrimary(
         return std::make_unique<NumberASTNode>(*token);
     } else if (token->lexeme == "true" || token->lexeme == "false") {
         return std::make_unique<BooleanASTNode>(*token);
+    } else if (token->type == TokenType::STRING) {
+        return std::make_unique<StringASTNode>(*token);
     } else if (token->type == TokenType::IDENTIFIER || token->lexeme == "this"
                || token->lexeme == "new") {
         auto n = parseReferenceChain(project, streamer, token);
@@ -204,6 +212,11 @@ std::unique_ptr<ASTNode> parsePrimary(
     throw std::runtime_error("Expected a primary expression");
 }
 
+std::unique_ptr<ASTNode> parsePrefixExpression(
+        Project &project,
+        TokenStreamer &streamer
+);
+
 /**
  * @brief Parses type cast expressions in Mini-Java.
  *
@@ -274,8 +287,11 @@ std::unique_ptr<ASTNode> parseCast(
             if (streamer.peek() != nullptr && streamer.peek()->lexeme == ")") {
                 streamer.read();
                 if (streamer.peek() != nullptr && streamer.peek()->type != TokenType::OPERATOR &&
-                    streamer.peek()->lexeme != ";") {
-                    return std::make_unique<CastExpression>(std::move(*castTo), parseExpression(project, streamer));
+                    streamer.peek()->lexeme != ";" &&
+                    streamer.peek()->lexeme != "instanceof" &&
+                    streamer.peek()->lexeme != "?" &&
+                    streamer.peek()->lexeme != ":") {
+                    return std::make_unique<CastExpression>(std::move(*castTo), parsePrefixExpression(project, streamer));
                 }
             }
         }
@@ -284,6 +300,38 @@ std::unique_ptr<ASTNode> parseCast(
     return nullptr;
 }
 
+/**
+ * @brief Parses an expression at the precedence of the unary operators: `!`, `~`, a cast or a primary expression.
+ *
+ * The operand of a unary operator or a cast is itself parsed at this precedence, so the binary operators and
+ * `?:` after it apply to the whole unary expression, as in Java:
+ * ```java
+ * !b ? 1 : 2;      // ConditionalExpression(!b, 1, 2)
+ * !a && b;         // BinaryExpression(&&, !a, b)
+ * (int) x + 1;     // BinaryExpression(+, (int) x, 1)
+ * ```
+ *
+ * @param project The `Project` context containing parsed data.
+ * @param streamer The `TokenStreamer` used for sequential tokenization.
+ * @return A `NotExpression`, a `CastExpression` or the primary expression.
+ */
+std::unique_ptr<ASTNode> parsePrefixExpression(
+        Project &project,
+        TokenStreamer &streamer
+) {
+    if (streamer.peek() != nullptr &&
+        (streamer.peek()->lexeme == "!" || streamer.peek()->lexeme == "~")) {
+        Token *op = streamer.read();
+        return std::make_unique<NotExpression>(*op, parsePrefixExpression(project, streamer));
+    }
+
+    auto cast = parseCast(project, streamer);
+    if (cast) {
+        return cast;
+    }
+    return parsePrimary(project, streamer);
+}
+
 /**
  * @brief Parses an expression while respecting operator precedence.
  *
@@ -295,6 +343,7 @@ std::unique_ptr<ASTNode> parseCast(
  * x + y * z;       // Resolves based on precedence (+ is lower than *)
  * a > b && b < c;  // Logical AND has lower precedence than comparisons
  * !(x == 42);      // Logical NOT has the highest precedence
+ * s instanceof Circle && r > 0; // `instanceof` is relational, its right side is a class name
  * ```
  *
  * Operator precedence is defined in the `operatorPrecedence` vector.
@@ -310,17 +359,7 @@ std::unique_ptr<ASTNode> parseExpressionWithPrecedence(
         size_t precedenceLevel = 0
 ) {
     if (precedenceLevel == operatorPrecedence.size() - 1) {
-        if (streamer.peek() != nullptr &&
-            (streamer.peek()->lexeme == "!" || streamer.peek()->lexeme == "~")) {
-            Token *op = streamer.read();
-            return std::make_unique<NotExpression>(*op, parseExpression(project, streamer));
-        }
-
-        auto cast = parseCast(project, streamer);
-        if (cast) {
-            return cast;
-        }
-        return parsePrimary(project, streamer);
+        return parsePrefixExpression(project, streamer);
     }
 
     auto left = parseExpressionWithPrecedence(project, streamer, precedenceLevel + 1);
@@ -330,25 +369,72 @@ std::unique_ptr<ASTNode> parseExpressionWithPrecedence(
                      operatorPrecedence[precedenceLevel].end(),
                      streamer.peek()->lexeme) != operatorPrecedence[precedenceLevel].end()) {
         auto op = *streamer.read();
+        if (op.lexeme == "instanceof") {
+            Token *classType = streamer.read();
+            if (classType == nullptr || classType->type != TokenType::IDENTIFIER) {
+                error("Failed to parse instanceof, Expected class name", classType == nullptr ? &op : classType);
+            }
+            left = std::make_unique<InstanceOfExpression>(op, std::move(left), *classType);
+            continue;
+        }
         auto right = parseExpressionWithPrecedence(project, streamer, precedenceLevel + 1);
         left = std::make_unique<BinaryExpression>(op, std::move(left), std::move(right));
     }
     return left;
 }
 
+/**
+ * @brief Parses the arms of a **conditional expression** (`condition ? a : b`), if there is one.
+ *
+ * The conditional operator has a lower precedence than all binary operators and is right-associative,
+ * so the arms are parsed with `parseExpression` and the else-arm may be another conditional expression.
+ *
+ * Examples:
+ * ```java
+ * a > b ? a : b;             // ConditionalExpression(a > b, a, b)
+ * x > 0 ? 1 : x < 0 ? 2 : 3; // ConditionalExpression(x > 0, 1, ConditionalExpression(x < 0, 2, 3))
+ * ```
+ *
+ * @param project The `Project` context containing parsed data.
+ * @param streamer The `TokenStreamer` used for sequential tokenization.
+ * @param condition The already parsed expression before `?`.
+ * @return A `ConditionalExpression` if the next token is `?`, otherwise the `condition` itself.
+ */
+std::unique_ptr<ASTNode> parseConditional(
+        Project &project,
+        TokenStreamer &streamer,
+        std::unique_ptr<ASTNode> condition
+) {
+    if (streamer.peek() == nullptr || streamer.peek()->lexeme != "?") {
+        return condition;
+    }
+    Token *question = streamer.read();
+    auto thenExpr = parseExpression(project, streamer);
+
+    Token *colon = streamer.read();
+    if (colon == nullptr) {
+        error("Failed to parse conditional expression, Expected ':'", question);
+    } else if (colon->lexeme != ":") {
+        error("Failed to parse conditional expression, Expected ':'", colon);
+    }
+    auto elseExpr = parseExpression(project, streamer);
+    return std::make_unique<ConditionalExpression>(std::move(condition), std::move(thenExpr), std::move(elseExpr));
+}
+
 /**
  * @brief Parses an expression and resolves casting, unary operators, and precedence.
  *
  * This function works as the entry point for parsing expressions. It handles:
- * - Unary operators (`!`, `~`)
- * - Casting expressions (e.g., `(Type) value`)
- * - Delegates sub-expression parsing to `parseExpressionWithPrecedence`.
+ * - Delegates sub-expression parsing to `parseExpressionWithPrecedence`, down to the unary operators
+ *   (`!`, `~`) and casts (e.g., `(Type) value`) of `parsePrefixExpression`.
+ * - Conditional expressions (`condition ? a : b`) via `parseConditional`, the loosest binding operator.
  *
  * Examples:
  * ```java
  * (int) x;   // Cast expression
  * !flag;     // Logical NOT
  * x + y * z; // Delegates precedence parsing to `parseExpressionWithPrecedence`
+ * x > y ? x : y; // Conditional expression
  * ```
  *
  * @param project The `Project` context containing parsed data.
@@ -363,17 +449,7 @@ std::unique_ptr<ASTNode> parseExpression(
         error("Failed to parse, Expected expression but got null");
     }
 
-    if (streamer.peek()->lexeme == "!" || streamer.peek()->lexeme == "~") {
-        Token *op = streamer.read();
-        return std::make_unique<NotExpression>(*op, parseExpression(project, streamer));
-    }
-
-    auto cast = parseCast(project, streamer);
-    if (cast) {
-        return cast;
-    }
-
-    return parseExpressionWithPrecedence(project, streamer);
+    return parseConditional(project, streamer, parseExpressionWithPrecedence(project, streamer));
 }
 
 /**
@@ -423,6 +499,43 @@ void parseUnary(
     }
 }
 
+/**
+ * @brief Parses the right side of an assignment if it is a spawned call (e.g., `x = spawn this.fib(n)`).
+ *
+ * The result of a spawned call can only be assigned to a local variable with `=`.
+ *
+ * @param codeBlock The `CodeBlock` to which the parsed statement is added.
+ * @param referenceChain The left side of the assignment.
+ * @param assignmentToken The token representing the assignment operator.
+ * @param project The `Project` context containing parsed data.
+ * @param streamer The `TokenStreamer` positioned after the assignment operator.
+ * @return `true` if a spawned call was parsed, otherwise nothing is read.
+ */
+bool parseSpawnAssignment(
+        CodeBlock *codeBlock,
+        ReferenceChain &referenceChain,
+        Token *assignmentToken,
+        Project &project,
+        TokenStreamer &streamer
+) {
+    streamer.save();
+    Token *spawnToken = streamer.read();
+    if (!isSpawn(spawnToken, streamer)) {
+        streamer.restore();
+        return false;
+    }
+
+    if (assignmentToken->lexeme != "=") {
+        error("The result of a spawned call can only be assigned with '='", assignmentToken);
+    }
+    auto &target = referenceChain.chain.front();
+    if (referenceChain.chain.size() != 1 || target.second) {
+        error("The result of a spawned call can only be assigned to a local variable", &target.first);
+    }
+    parseSpawn(codeBlock, spawnToken, &target.first, project, streamer);
+    return true;
+}
+
 /**
  * @brief Parses an assignment or method call statement.
  *
@@ -456,6 +569,9 @@ void parseAssignment(
     }
 
     if (isAssignment(next)) {
+        if (parseSpawnAssignment(codeBlock, referenceChain, next, project, streamer)) {
+            return;
+        }
 
         auto expression = parseExpression(project, streamer);
         std::unique_ptr<ASTNode> node = std::make_unique<Assignment>(
@@ -496,6 +612,9 @@ void parseAssignmentForLocalVariable(
 ) {
     ReferenceChain referenceChain = {};
     referenceChain.addField(*fieldNameToken);
+    if (parseSpawnAssignment(codeBlock, referenceChain, assignmentToken, project, streamer)) {
+        return;
+    }
 
     auto expression = parseExpression(project, streamer);
     std::unique_ptr<ASTNode> node = std::make_unique<Assignment>(
@@ -7,6 +7,7 @@
  * - Fields and methods are unique within the class.
  * - Fields are validated and added to the class.
  * - Methods are parsed, including their parameters and body, and then added to the class.
+ * - Methods may be annotated with `@Memoize` (see `analyseMemoize`).
  *
  * The class body is terminated by a closing brace `}`.
  *
@@ -39,22 +40,40 @@ void parseClassScope(Project &project, Class &clazz, TokenStreamer &streamer) {
         } else if (nextToken->lexeme == "}") {
             return; // end of class
         }
-        streamer.unread();
+        Token *annotation = nullptr;
+        if (nextToken->type == TokenType::ANNOTATION) {
+            if (nextToken->lexeme != "@Memoize") {
+                error("Unknown method annotation", nextToken);
+            }
+            annotation = nextToken;
+        } else {
+            streamer.unread();
+        }
 
         ParamSignature sign = {};
         parseFieldOrMethod(&sign, project, streamer);
         if (sign.isField) {
+            if (annotation) {
+                error("@Memoize can only be applied to methods", annotation);
+            }
             if (clazz.containsField(sign.name)) {
                 error("Field " + sign.name + " already exists in " + clazz.getName(), nextToken);
             }
-            Field field = Field(sign.type, sign.type_lexeme, sign.name);
+            if (sign.isSynchronized) {
+                error("Field " + sign.name + " can not be synchronized", nextToken);
+            }
+            Field field = Field(sign.type, sign.type_lexeme, sign.name, sign.isStatic);
             clazz.addField(field);
         } else {
             if (clazz.containsMethod(sign.name)) {
                 error("Method " + sign.name + " already exists in " + clazz.getName(), nextToken);
             }
             Method method = Method(sign.type, sign.type_lexeme, sign.name, sign.isStatic);
+            method.setSynchronized(sign.isSynchronized);
+            method.setLine(nextToken->position.line);
+            method.setMemoized(annotation != nullptr);
             parseMethodParams(&method, project, streamer);
+            parseMethodThrows(&method, project, streamer);
             parseMethodBody(&method, project, streamer);
             clazz.addMethod(method);
         }
@@ -62,18 +81,73 @@ void parseClassScope(Project &project, Class &clazz, TokenStreamer &streamer) {
 }
 
 /**
- * @brief Parses a class declaration, including its name, optional superclass, and body.
+ * @brief Parses the body of an interface, a list of method declarations.
+ *
+ * Every method of an interface is public and abstract: it has no body and ends with `;`. Interfaces
+ * have no fields, static methods or synchronized methods.
+ *
+ * Example Input:
+ * ```java
+ * interface Shape {
+ *     int area();
+ *     int scale(int factor);
+ * }
+ * ```
+ *
+ * @param project The `Project` object containing the parsed program.
+ * @param clazz The `Class` object of the interface to populate with methods.
+ * @param streamer The `TokenStreamer` used to read tokens sequentially.
+ */
+void parseInterfaceScope(Project &project, Class &clazz, TokenStreamer &streamer) {
+    while (true) {
+        Token *nextToken = streamer.read();
+        if (nextToken == nullptr) {
+            error("Failed to parse interface body of " + clazz.getName() + ", Expected interface body but got null");
+        } else if (nextToken->lexeme == "}") {
+            return; // end of interface
+        }
+        streamer.unread();
+
+        ParamSignature sign = {};
+        parseFieldOrMethod(&sign, project, streamer);
+        if (sign.isField) {
+            error("Interface " + clazz.getName() + " can not declare field " + sign.name, nextToken);
+        }
+        if (sign.isStatic || sign.isSynchronized) {
+            error("Method " + sign.name + " of interface " + clazz.getName() +
+                  " can not be static or synchronized", nextToken);
+        }
+        if (clazz.containsMethod(sign.name)) {
+            error("Method " + sign.name + " already exists in " + clazz.getName(), nextToken);
+        }
+        Method method = Method(sign.type, sign.type_lexeme, sign.name, false);
+        parseMethodParams(&method, project, streamer);
+        parseMethodThrows(&method, project, streamer);
+        Token *end = streamer.read();
+        if (end == nullptr || end->lexeme != ";") {
+            error("Failed to parse method " + sign.name + " of interface " + clazz.getName() +
+                  ", Expected ;", end);
+        }
+        clazz.addMethod(method);
+    }
+}
+
+/**
+ * @brief Parses a class or interface declaration, including its name, optional superclass, implemented
+ * interfaces and body.
  *
  * This function identifies and processes a class definition. It:
- * - Validates the `class` keyword.
+ * - Validates the `class` (or `interface`) keyword.
  * - Parses the class name.
  * - Handles the optional `extends` keyword and validates the superclass name.
  * - Ensures the class does not extend itself.
- * - Parses the class body (fields and methods) using `parseClassScope`.
+ * - Handles the optional `implements` keyword followed by a list of interfaces.
+ * - Parses the class body (fields and methods) using `parseClassScope`, or the body of an interface
+ *   using `parseInterfaceScope`.
  *
  * Example Input:
  * ```java
- * class MyClass extends ParentClass {
+ * class MyClass extends ParentClass implements Shape, Comparable {
  *     int x;
  *     void foo() {
  *         x = 42;
@@ -82,12 +156,13 @@ void parseClassScope(Project &project, Class &clazz, TokenStreamer &streamer) {
  * ```
  *
  * Example Behavior:
- * - Parses the class `MyClass` with superclass `ParentClass`.
+ * - Parses the class `MyClass` with superclass `ParentClass`, implementing `Shape` and `Comparable`.
  * - Processes its fields and methods through `parseClassScope`.
  *
  * Validations:
  * - Ensures the class name is unique.
  * - Ensures the class body opens with `{`.
+ * - Ensures an interface is not implemented twice.
  *
  * Returns:
  * - `true` if the class is successfully parsed.
@@ -101,22 +176,44 @@ void parseClassScope(Project &project, Class &clazz, TokenStreamer &streamer) {
  * @return `true` if a class is successfully parsed, otherwise `false`.
  */
 bool parseClass(Project &project, TokenStreamer &streamer) {
-    if (streamer.readUntil("class") == nullptr) {
+    ScopedTimer timer("parseClass");
+    MemoryCategory category("AST");
+    Token *keyword = nullptr;
+    while (streamer.hasToken() && keyword == nullptr) {
+        Token *token = streamer.read();
+        if (token != nullptr && (token->lexeme == "class" || token->lexeme == "interface")) {
+            keyword = token;
+        }
+    }
+    if (keyword == nullptr) {
         return false;
     }
+    bool isInterface = keyword->lexeme == "interface";
 
     Token *className = streamer.read();
     if (className == nullptr || className->type != TokenType::IDENTIFIER) {
-        error("Failed to parse class name, Expected identifier", className);
+        error("Failed to parse " + keyword->lexeme + " name, Expected identifier", className);
     }
+    timer.describe(className->lexeme);
     if (project.containsClass(className->lexeme)) {
         error("Class " + className->lexeme + " already exists!", className);
     }
 
-    Token *extends = streamer.read();
-    bool scopeStarted = false;
+    if (isInterface) {
+        Token *scopeStart = streamer.read();
+        if (scopeStart == nullptr || scopeStart->lexeme != "{") {
+            error("Failed to parse interface " + className->lexeme + ", Expected {", scopeStart);
+        }
+        Class interfaceClass = Class(className->lexeme, "");
+        interfaceClass.setInterface(true);
+        parseInterfaceScope(project, interfaceClass, streamer);
+        project.addClass(interfaceClass);
+        return true;
+    }
 
-    if (extends != nullptr && extends->lexeme == "extends") {
+    Token *token = streamer.read();
+    Token *extends = nullptr;
+    if (token != nullptr && token->lexeme == "extends") {
         extends = streamer.read();
         if (extends == nullptr || extends->type != TokenType::IDENTIFIER) {
             error("Failed to parse class " + className->lexeme + " extends, Expected identifier", extends);
@@ -124,23 +221,31 @@ bool parseClass(Project &project, TokenStreamer &streamer) {
         if (extends->lexeme == className->lexeme) {
             error("Failed to parse class, class can not extend itself", extends);
         }
+        token = streamer.read();
+    }
 
-        Token *scopeStart = streamer.read();
-        if (scopeStart != nullptr && scopeStart->lexeme == "{") {
-            scopeStarted = true;
-        } else {
-            extends = scopeStart; // only for reporting error
-        }
-    } else if (extends != nullptr && extends->lexeme == "{") {
-        extends = nullptr;
-        scopeStarted = true;
+    Class clazz = Class(className->lexeme, extends == nullptr ? "" : extends->lexeme);
+    if (token != nullptr && token->lexeme == "implements") {
+        do {
+            Token *interfaceName = streamer.read();
+            if (interfaceName == nullptr || interfaceName->type != TokenType::IDENTIFIER) {
+                error("Failed to parse class " + className->lexeme + " implements, Expected identifier",
+                      interfaceName);
+            }
+            auto *interfaces = clazz.getInterfaces();
+            if (std::find(interfaces->begin(), interfaces->end(), interfaceName->lexeme) != interfaces->end()) {
+                error("Interface " + interfaceName->lexeme + " is already implemented by " + className->lexeme,
+                      interfaceName);
+            }
+            clazz.addInterface(interfaceName->lexeme);
+            token = streamer.read();
+        } while (token != nullptr && token->lexeme == ",");
     }
 
-    if (!scopeStarted) {
-        error("Failed to parse class " + className->lexeme + ", Expected {", extends);
+    if (token == nullptr || token->lexeme != "{") {
+        error("Failed to parse class " + className->lexeme + ", Expected {", token);
     }
 
-    Class clazz = Class(className->lexeme, extends == nullptr ? "" : extends->lexeme);
     parseClassScope(project, clazz, streamer);
     project.addClass(clazz);
     return true;
@@ -154,6 +154,100 @@ void parseContinue(
     }
 }
 
+/**
+ * @brief Checks if a token is the `spawn` keyword.
+ *
+ * `spawn` and `sync` are contextual keywords, so they can still be used as names. `spawn` is a keyword
+ * only when it is followed by the reference chain of a call (`this`, `new`, or an identifier followed by
+ * `.` or `(`).
+ *
+ * @param token The token to check.
+ * @param streamer The `TokenStreamer` positioned after the token.
+ * @return `true` if the token starts a spawned call.
+ */
+bool isSpawn(
+        Token *token,
+        TokenStreamer &streamer
+) {
+    if (token == nullptr || token->type != TokenType::IDENTIFIER || token->lexeme != "spawn") {
+        return false;
+    }
+    Token *next = streamer.peek();
+    if (next == nullptr) {
+        return false;
+    }
+    if (next->lexeme == "this" || next->lexeme == "new") {
+        return true;
+    }
+    if (next->type != TokenType::IDENTIFIER) {
+        return false;
+    }
+
+    // `spawn a.f();` or `spawn f();`, not the declaration of a local of type `spawn`
+    streamer.read();
+    Token *after = streamer.peek();
+    streamer.unread();
+    return after != nullptr && (after->lexeme == "." || after->lexeme == "(");
+}
+
+/**
+ * @brief Parses a spawned call, the part after the `spawn` keyword.
+ *
+ * Example:
+ * ```java
+ * spawn this.sort(left);             // The result is discarded
+ * x = spawn this.fib(n - 1);         // The result is assigned to `x` after `sync`
+ * int y = spawn tree.right.sum();
+ * ```
+ *
+ * The parsed `SpawnStatement` is added to the current code block.
+ *
+ * @param codeBlock The `CodeBlock` to which the parsed statement will be added.
+ * @param spawnToken The `spawn` keyword.
+ * @param target The local variable receiving the result, or `nullptr` if the result is discarded.
+ * @param project The `Project` context being parsed.
+ * @param streamer The `TokenStreamer` used to process tokens sequentially.
+ */
+void parseSpawn(
+        CodeBlock *codeBlock,
+        Token *spawnToken,
+        Token *target,
+        Project &project,
+        TokenStreamer &streamer
+) {
+    ReferenceChain call = parseReferenceChain(project, streamer, streamer.read());
+    if (streamer.peek() == nullptr || streamer.peek()->lexeme != ";") {
+        error("Failed to parse spawn, Expected ';'", streamer.peek());
+    }
+
+    Token targetToken = target ? *target : Token(TokenType::IDENTIFIER, "");
+    std::unique_ptr<ASTNode> node = std::make_unique<SpawnStatement>(
+            *spawnToken, targetToken, std::move(call));
+    codeBlock->addCode(node);
+}
+
+/**
+ * @brief Sets the line of the statements parsed into a code block to the line of their first token.
+ *
+ * A statement may add more than one node (e.g., `int x = 1;` adds the declaration and the assignment), they
+ * all get the line. The generator carries it to the code of the statements (see `ThreeAddressCodeGenerator::at`).
+ *
+ * @param codeBlock The `CodeBlock` the statements were added to.
+ * @param first The number of nodes of the code block before the statements.
+ * @param token The first token of the statements.
+ */
+void markStatementLines(
+        CodeBlock *codeBlock,
+        size_t first,
+        const Token *token
+) {
+    for (size_t i = first; i < codeBlock->codes.size(); i++) {
+        if (codeBlock->codes[i]->line == 0) {
+            codeBlock->codes[i]->line = token->position.line;
+        }
+    }
+}
+
 /**
  * @brief Parses a simple statement (e.g., a local variable declaration or an assignment).
  *
@@ -209,7 +303,11 @@ void parseSimpleStatement(
  * @brief Parses a generic Java statement, including control flow constructs and expressions.
  *
  * This function handles:
- * - Control flow statements: `if`, `while`, `for`.
+ * - Control flow statements: `if`, `while`, `for`, `switch`.
+ * - Synchronized blocks: `synchronized (object) { ... }`.
+ * - Exceptions: `try { ... } catch (Error e) { ... }` and `throw`.
+ * - Annotated statements: `@Parallel for`.
+ * - Fork/join statements: `spawn` and `sync`.
  * - Local variable declarations.
  * - Block statements: `{ ... }`.
  * - Return and jump statements: `return`, `break`, `continue`.
@@ -235,11 +333,17 @@ void parseStatement(
         Project &project,
         TokenStreamer &streamer
 ) {
+    size_t first = codeBlock->codes.size();
     if (token->lexeme == "--" || token->lexeme == "++") {
         parseUnary(token, nullptr, codeBlock, project, streamer);
         goto read_semicolon;
     }
 
+    if (isSpawn(token, streamer)) {
+        parseSpawn(codeBlock, token, nullptr, project, streamer);
+        goto read_semicolon;
+    }
+
     if (isValidType(token, false)) {
         streamer.save();
         if (streamer.peek() != nullptr) {
@@ -266,6 +370,24 @@ void parseStatement(
     } else if (token->lexeme == "for") {
         auto node = parseForStatement(project, streamer);
         codeBlock->addCode(node);
+    } else if (token->lexeme == "switch") {
+        auto node = parseSwitchStatement(project, streamer);
+        codeBlock->addCode(node);
+    } else if (token->lexeme == "synchronized") {
+        auto node = parseSynchronizedStatement(token, project, streamer);
+        codeBlock->addCode(node);
+    } else if (token->lexeme == "try") {
+        auto node = parseTryStatement(token, project, streamer);
+        codeBlock->addCode(node);
+    } else if (token->lexeme == "throw") {
+        auto node = parseThrowStatement(token, project, streamer);
+        codeBlock->addCode(node);
+    } else if (token->type == TokenType::ANNOTATION) {
+        auto node = parseAnnotatedStatement(token, project, streamer);
+        codeBlock->addCode(node);
+    } else if (token->lexeme == "sync" && streamer.peek() != nullptr && streamer.peek()->lexeme == ";") {
+        std::unique_ptr<ASTNode> astNode = std::make_unique<SyncStatement>();
+        codeBlock->addCode(astNode);
     } else if (token->type == TokenType::IDENTIFIER || token->lexeme == "this" || token->lexeme == "new") {
         parseAssignment(codeBlock, token, project, streamer);
     } else if (token->lexeme == "{") {
@@ -284,6 +406,7 @@ void parseStatement(
     }
 
     read_semicolon:
+    markStatementLines(codeBlock, first, token);
     if (streamer.peek()->lexeme == ";") streamer.read();
 }
 
@@ -230,6 +230,7 @@ std::unique_ptr<ASTNode> parseForStatement(
     } else if (token->lexeme != ";") {
         CodeBlock cb = {};
         parseSimpleStatement(&cb, token, project, streamer);
+        markStatementLines(&cb, 0, token);
         initialization = std::make_unique<CodeBlock>(std::move(cb));
     }
 
@@ -261,6 +262,7 @@ std::unique_ptr<ASTNode> parseForStatement(
     } else if (token->lexeme != ")") {
         CodeBlock cb = {};
         parseAssignment(&cb, token, project, streamer);
+        markStatementLines(&cb, 0, token);
         update = std::make_unique<CodeBlock>(std::move(cb));
     }
 
@@ -285,4 +287,300 @@ std::unique_ptr<ASTNode> parseForStatement(
             std::move(body)
     );
     return node;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Parses a statement preceded by an annotation.
+ *
+ * The only statement annotation is `@Parallel`, which marks a `for` loop whose iterations
+ * may run concurrently (see `ForStatement::analyseParallel`).
+ *
+ * Example:
+ * ```java
+ * @Parallel
+ * for (int i = 0; i < a.length; i++) {
+ *     a[i] = a[i] * 2;
+ * }
+ * ```
+ *
+ * @param annotation The annotation token (e.g., `@Parallel`).
+ * @param project The `Project` containing the source being parsed.
+ * @param streamer The `TokenStreamer` used to process tokens sequentially.
+ * @return A `std::unique_ptr` to the annotated AST node.
+ */
+std::unique_ptr<ASTNode> parseAnnotatedStatement(
+        Token *annotation,
+        Project &project,
+        TokenStreamer &streamer
+) {
+    if (annotation->lexeme != "@Parallel") {
+        error("Unknown statement annotation", annotation);
+    }
+    Token *token = streamer.read();
+    if (token == nullptr || token->lexeme != "for") {
+        error("@Parallel can only be applied to a 'for' statement", token ? token : annotation);
+    }
+
+    auto node = parseForStatement(project, streamer);
+    ((ForStatement *) node.get())->parallel = std::make_unique<ParallelLoop>(ParallelLoop{*annotation});
+    return node;
+}
+
+/**
+ * @brief Parses a `switch` statement and its `case` and `default` labels.
+ *
+ * The `switch` statement consists of:
+ * - A mandatory value enclosed in parentheses `()`.
+ * - A body enclosed in braces `{}`, made of labels followed by statements:
+ *   - `case` followed by an integer literal (optionally negative) and `:`.
+ *   - `default` followed by `:`.
+ *
+ * Every label starts a new `SwitchCase`, the statements following a label (up to the next label)
+ * are the body of that case.
+ *
+ * Example:
+ * ```java
+ * switch (x) {
+ *     case 1:
+ *     case 2:
+ *         y = 12;
+ *         break;
+ *     case -1:
+ *         y = 0;
+ *     default:
+ *         y++;
+ * }
+ * ```
+ *
+ * @param project The `Project` containing the source being parsed.
+ * @param streamer The `TokenStreamer` used to process tokens sequentially.
+ * @return A `std::unique_ptr` to the `SwitchStatement` AST node.
+ */
+std::unique_ptr<ASTNode> parseSwitchStatement(
+        Project &project,
+        TokenStreamer &streamer
+) {
+    Token *token = streamer.read();
+    if (token == nullptr || token->lexeme != "(") {
+        error("Failed to parse switch-statement, expected '('", token);
+    }
+    auto condition = parseExpression(project, streamer);
+    token = streamer.read();
+    if (token == nullptr || token->lexeme != ")") {
+        error("Failed to parse switch-statement, expected ')'", token);
+    }
+    token = streamer.read();
+    if (token == nullptr || token->lexeme != "{") {
+        error("Failed to parse switch-statement, expected '{'", token);
+    }
+
+    std::vector<SwitchCase> cases;
+    while (true) {
+        token = streamer.read();
+        if (token == nullptr) {
+            error("Failed to parse switch-statement, Expected } but got null");
+        }
+        if (token->lexeme == "}") {
+            break;
+        }
+        if (token->lexeme == ";") {
+            continue;
+        }
+
+        if (token->lexeme == "case" || token->lexeme == "default") {
+            SwitchCase switchCase = {*token, token->lexeme == "default"};
+            if (!switchCase.isDefault) {
+                Token *label = streamer.read();
+                bool negative = label != nullptr && label->lexeme == "-";
+                if (negative) {
+                    label = streamer.read();
+                }
+                if (label == nullptr ||
+                    (label->type != TokenType::NUMBER &&
+                     label->type != TokenType::HEX_NUMBER &&
+                     label->type != TokenType::BINARY_NUMBER)) {
+                    error("Failed to parse case, Expected an integer constant", label);
+                }
+                switchCase.label = *label;
+                if (negative) {
+                    switchCase.label.lexeme = "-" + label->lexeme;
+                }
+            }
+            token = streamer.read();
+            if (token == nullptr || token->lexeme != ":") {
+                error("Failed to parse case, Expected ':'", token);
+            }
+            switchCase.body = std::make_unique<CodeBlock>();
+            cases.push_back(std::move(switchCase));
+            continue;
+        }
+
+        if (cases.empty()) {
+            error("Failed to parse switch-statement, Expected case or default", token);
+        }
+        parseStatement(cases.back().body.get(), token, project, streamer);
+    }
+
+    std::unique_ptr<ASTNode> node = std::make_unique<SwitchStatement>(
+            std::move(condition),
+            std::move(cases)
+    );
+    return node;
+}
+
+/**
+ * @brief Parses a `synchronized` block and its associated body.
+ *
+ * The `synchronized` block consists of:
+ * - A mandatory object enclosed in parentheses `()`, whose monitor is held while the body runs.
+ * - A body enclosed in braces `{}`.
+ *
+ * Example:
+ * ```java
+ * synchronized (counter) {
+ *     counter.value = counter.value + 1;
+ * }
+ * ```
+ *
+ * @param keyword The `synchronized` keyword.
+ * @param project The `Project` containing the source being parsed.
+ * @param streamer The `TokenStreamer` used to process tokens sequentially.
+ * @return A `std::unique_ptr` to the `SynchronizedStatement` AST node.
+ */
+std::unique_ptr<ASTNode> parseSynchronizedStatement(
+        Token *keyword,
+        Project &project,
+        TokenStreamer &streamer
+) {
+    Token *token = streamer.read();
+    if (token == nullptr || token->lexeme != "(") {
+        error("Failed to parse synchronized-statement, expected '('", token);
+    }
+    auto lock = parseExpression(project, streamer);
+    token = streamer.read();
+    if (token == nullptr || token->lexeme != ")") {
+        error("Failed to parse synchronized-statement, expected ')'", token);
+    }
+
+    token = streamer.read();
+    if (token == nullptr || token->lexeme != "{") {
+        error("Failed to parse synchronized-statement, expected '{'", token);
+    }
+
+    std::unique_ptr<ASTNode> node = std::make_unique<SynchronizedStatement>(
+            *keyword,
+            std::move(lock),
+            parseCodeBlockOrStatement(token, project, streamer)
+    );
+    return node;
+}
+
+/**
+ * @brief Parses a `try` block and its `catch` clauses.
+ *
+ * The `try` statement consists of:
+ * - A body enclosed in braces `{}`.
+ * - One or more `catch` clauses, each with the class of the exceptions it catches, the name of the caught
+ *   exception and a body enclosed in braces `{}`.
+ *
+ * `finally` is not supported.
+ *
+ * Example:
+ * ```java
+ * try {
+ *     x = parser.parse(input);
+ * } catch (ParseError e) {
+ *     x = e.position();
+ * }
+ * ```
+ *
+ * @param keyword The `try` keyword.
+ * @param project The `Project` context being parsed.
+ * @param streamer The `TokenStreamer` used to process tokens sequentially.
+ * @return A `std::unique_ptr` to the `TryStatement` AST node.
+ */
+std::unique_ptr<ASTNode> parseTryStatement(
+        Token *keyword,
+        Project &project,
+        TokenStreamer &streamer
+) {
+    Token *token = streamer.read();
+    if (token == nullptr || token->lexeme != "{") {
+        error("Failed to parse try-statement, expected '{'", token);
+    }
+    auto body = std::make_unique<CodeBlock>();
+    parseCodeBlock(body.get(), project, streamer);
+
+    std::vector<CatchClause> catches;
+    while (streamer.peek() != nullptr && streamer.peek()->lexeme == "catch") {
+        streamer.read();
+        token = streamer.read();
+        if (token == nullptr || token->lexeme != "(") {
+            error("Failed to parse catch-clause, expected '('", token);
+        }
+        Token *classType = streamer.read();
+        if (classType == nullptr || classType->type != TokenType::IDENTIFIER) {
+            error("Failed to parse catch-clause, expected class name", classType);
+        }
+        Token *name = streamer.read();
+        if (name == nullptr || name->type != TokenType::IDENTIFIER) {
+            error("Failed to parse catch-clause, expected identifier", name);
+        }
+        token = streamer.read();
+        if (token == nullptr || token->lexeme != ")") {
+            error("Failed to parse catch-clause, expected ')'", token);
+        }
+        token = streamer.read();
+        if (token == nullptr || token->lexeme != "{") {
+            error("Failed to parse catch-clause, expected '{'", token);
+        }
+        auto catchBody = std::make_unique<CodeBlock>();
+        parseCodeBlock(catchBody.get(), project, streamer);
+        catches.push_back(CatchClause{*classType, *name, std::move(catchBody)});
+    }
+
+    if (streamer.peek() != nullptr && streamer.peek()->lexeme == "finally") {
+        error("Failed to parse try-statement, 'finally' is not supported", streamer.peek());
+    }
+    if (catches.empty()) {
+        error("Failed to parse try-statement, expected 'catch'", keyword);
+    }
+
+    std::unique_ptr<ASTNode> node = std::make_unique<TryStatement>(
+            *keyword,
+            std::move(body),
+            std::move(catches)
+    );
+    return node;
+}
+
+/**
+ * @brief Parses a `throw` statement.
+ *
+ * Example:
+ * ```java
+ * throw new ParseError().at(position);
+ * ```
+ *
+ * @param keyword The `throw` keyword.
+ * @param project The `Project` context being parsed.
+ * @param streamer The `TokenStreamer` used to process tokens sequentially.
+ * @return A `std::unique_ptr` to the `ThrowStatement` AST node.
+ */
+std::unique_ptr<ASTNode> parseThrowStatement(
+        Token *keyword,
+        Project &project,
+        TokenStreamer &streamer
+) {
+    auto exception = parseExpression(project, streamer);
+    Token *token = streamer.peek();
+    if (token == nullptr || token->lexeme != ";") {
+        error("Failed to parse throw-statement, expected ';'", token);
+    }
+
+    std::unique_ptr<ASTNode> node = std::make_unique<ThrowStatement>(
+            *keyword,
+            std::move(exception)
+    );
+    return node;
+}
@@ -23,16 +23,17 @@ bool isValidType(Token *token, bool canBeVoid) {
 /**
  * @brief Parses and validates the type of a parameter, field, or method return value.
  *
- * This function accepts optional modifiers (`public`, `static`) and supports the following types:
+ * This function accepts optional modifiers (`public`, `static`, `synchronized`) and supports the following types:
  * - Primitive types: `int`, `boolean`
  * - Arrays: `int[]`
+ * - Strings: `String`
  * - Void return types (for methods)
  * - Custom class types (identifiers)
  *
  * @param sign The `ParamSignature` object to store the parsed type information.
  * @param project The `Project` context being parsed.
  * @param streamer The `TokenStreamer` for sequential token processing.
- * @param canHaveModifier Whether the type may have `public` or `static` modifiers.
+ * @param canHaveModifier Whether the type may have `public`, `static` or `synchronized` modifiers.
  * @param canBeVoid Whether the type may be `void`.
  */
 void parseType(
@@ -49,9 +50,15 @@ void parseType(
             startToken = streamer.read();
         }
 
-        if (startToken->type == KEYWORD && startToken->lexeme == "static") {
+        // `static` and `synchronized` in any order
+        while (startToken->type == KEYWORD &&
+               (startToken->lexeme == "static" || startToken->lexeme == "synchronized")) {
+            if (startToken->lexeme == "static") {
+                sign->isStatic = true;
+            } else {
+                sign->isSynchronized = true;
+            }
             startToken = streamer.read();
-            sign->isStatic = true;
         }
     }
 
@@ -78,6 +85,8 @@ void parseType(
         sign->type = MiniJavaType_BOOLEAN;
     } else if (startToken->lexeme == "void") {
         sign->type = MiniJavaType_VOID;
+    } else if (startToken->lexeme == "String") {
+        sign->type = MiniJavaType_STRING;
     } else {
         sign->type = MiniJavaType_CLASS;
     }
@@ -125,9 +134,8 @@ Token *parseParam(
  * @brief Parses a field or method declaration and determines its type and modifiers.
  *
  * Differentiates between a field (`;`) and a method (`(`) based on the token following the identifier.
- * Validates optional modifiers (`public`, `static`) and ensures:
- * - Static fields are not allowed.
- * - Only the `main` method can be declared as `static`.
+ * Accepts optional modifiers (`public`, `static`, `synchronized`), both fields and methods may be `static`,
+ * only methods may be `synchronized`.
  *
  * @param sign The `ParamSignature` object to store parsed field or method information.
  * @param project The `Project` context being parsed.
@@ -139,6 +147,7 @@ void parseFieldOrMethod(
         TokenStreamer &streamer
 ) {
     sign->isStatic = false;
+    sign->isSynchronized = false;
     parseType(sign, project, streamer, true, true);
 
     Token *token = streamer.read();
@@ -152,14 +161,6 @@ void parseFieldOrMethod(
         error("Failed to parse field, Expected ;", token);
     }
     sign->isField = token->lexeme == ";";
-
-    if (sign->isStatic) {
-        if (sign->isField) {
-            error("Failed to parse field, Field can not be static", token);
-        } else if (sign->type != MiniJavaType_VOID || sign->name != "main") {
-            error("Failed to parse method, Only main method can be static", token);
-        }
-    }
 }
 
 /**
@@ -196,4 +197,38 @@ void parseMethodParams(
     if (token == nullptr || token->lexeme != ")") {
         error("Failed to parse method, expected , or )", token);
     }
+}
+/**
+ * @brief Parses the optional `throws` clause of a method, after its parameter list.
+ *
+ * Example:
+ * ```java
+ * int parse(int[] input) throws ParseError, RangeError
+ * ```
+ *
+ * @param method The `Method` object to populate with the declared exception classes.
+ * @param project The `Project` context being parsed.
+ * @param streamer The `TokenStreamer` for sequential token processing.
+ */
+void parseMethodThrows(
+        Method *method,
+        Project &project,
+        TokenStreamer &streamer
+) {
+    Token *token = streamer.peek();
+    if (token == nullptr || token->lexeme != "throws") {
+        return;
+    }
+    streamer.read();
+    while (true) {
+        token = streamer.read();
+        if (token == nullptr || token->type != IDENTIFIER) {
+            error("Failed to parse throws of method " + method->getName() + ", Expected identifier", token);
+        }
+        method->addThrows(token->lexeme);
+        if (streamer.peek() == nullptr || streamer.peek()->lexeme != ",") {
+            return;
+        }
+        streamer.read();
+    }
 }
\ No newline at end of file
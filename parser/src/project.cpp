@@ -1,4 +1,5 @@
 #include "../include/project.h"
+#include "../../common/include/profiler.h"
 
 #include <queue>
 #include <set>
@@ -22,6 +23,7 @@ bool Project::containsClass(const Identifier &className) {
 }
 
 std::vector<Identifier> Project::getTopologicalSort() {
+    ScopedTimer timer("getTopologicalSort");
     std::map<Identifier, std::set<Identifier>> adjList;
     std::map<Identifier, int> inDegree;
 
@@ -1,7 +1,7 @@
 #include "../include/scope.h"
 
-Field::Field(MiniJavaType type, Identifier type_lexeme, Identifier name) :
-        type(type), type_lexeme(std::move(type_lexeme)), name(std::move(name)) {}
+Field::Field(MiniJavaType type, Identifier type_lexeme, Identifier name, bool isStatic) :
+        type(type), type_lexeme(std::move(type_lexeme)), name(std::move(name)), static_(isStatic) {}
 
 Identifier Field::getName() {
     return name;
@@ -15,8 +15,14 @@ Identifier Field::getTypeLexeme() {
     return type_lexeme;
 }
 
-Method::Method(MiniJavaType type, Identifier type_lexeme, Identifier name, bool main) :
-        type(type), type_lexeme(std::move(type_lexeme)), name(std::move(name)), main(main) {}
+bool Field::isStatic() {
+    return static_;
+}
+
+Method::Method(MiniJavaType type, Identifier type_lexeme, Identifier name, bool isStatic) :
+        type(type), type_lexeme(std::move(type_lexeme)), name(std::move(name)), static_(isStatic) {
+    main = isStatic && type == MiniJavaType_VOID && this->name == "main";
+}
 
 void Method::addParam(const Field &field) {
     params.push_back(field);
@@ -43,6 +49,46 @@ bool Method::isMain() {
     return main;
 }
 
+bool Method::isStatic() {
+    return static_;
+}
+
+void Method::setSynchronized(bool isSynchronized) {
+    synchronized_ = isSynchronized;
+}
+
+bool Method::isSynchronized() {
+    return synchronized_;
+}
+
+void Method::addThrows(const Identifier &className) {
+    throws.push_back(className);
+}
+
+std::vector<Identifier> *Method::getThrows() {
+    return &throws;
+}
+
+bool Method::canThrow() {
+    return !throws.empty();
+}
+
+void Method::setLine(int declarationLine) {
+    line = declarationLine;
+}
+
+int Method::getLine() {
+    return line;
+}
+
+void Method::setMemoized(bool isMemoized) {
+    memoized = isMemoized;
+}
+
+bool Method::isMemoized() {
+    return memoized;
+}
+
 Identifier Method::getName() {
     return name;
 }
@@ -96,4 +142,28 @@ Identifier Class::getName() {
 
 Identifier Class::getExtends() {
     return extends;
+}
+
+void Class::setBuiltin(bool isBuiltin) {
+    builtin = isBuiltin;
+}
+
+bool Class::isBuiltin() {
+    return builtin;
+}
+
+void Class::setInterface(bool isInterface) {
+    interfaceClass = isInterface;
+}
+
+bool Class::isInterface() {
+    return interfaceClass;
+}
+
+void Class::addInterface(const Identifier &interfaceName) {
+    interfaces.push_back(interfaceName);
+}
+
+std::vector<Identifier> *Class::getInterfaces() {
+    return &interfaces;
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include <utility>
 
 #include "../include/symbol_table.h"
+#include "../../common/include/memory_tracker.h"
 
 std::unordered_map<std::string, std::shared_ptr<SymbolTable>> SymbolTable::classSymbolTables;
 
@@ -14,6 +15,7 @@ SymbolTable::SymbolTable(std::string className_, SymbolTable *parent)
         : parentScope(parent), className(std::move(className_)) {}
 
 void SymbolTable::addSymbol(const std::string &name, const Symbol &symbol) {
+    MemoryCategory category("symbol tables");
     if (symbols.find(name) != symbols.end()) {
         error("Symbol '" + name + "' is already declared in this scope.");
     }
@@ -40,6 +42,7 @@ Symbol *SymbolTable::find(const std::string &name) {
 }
 
 void SymbolTable::addClassSymbolTable(const std::string &className, const SymbolTable &table) {
+    MemoryCategory category("symbol tables");
     if (classSymbolTables.find(className) != classSymbolTables.end()) {
         error("Class '" + className + "' is already declared.");
     }
@@ -63,11 +66,44 @@ bool SymbolTable::canCast(const std::string &from, const std::string &to) {
         if (table->getClassName() == to) {
             return true;
         }
+        for (auto &interfaceName: table->interfaces) {
+            if (interfaceName == to) {
+                return true;
+            }
+        }
         table = table->getParent();
     }
     return false;
 }
 
+bool SymbolTable::isCastable(const std::string &from, const std::string &to) {
+    if (canCast(from, to) || canCast(to, from)) {
+        return true;
+    }
+    // Any class may have a subclass implementing the interface
+    return isObjectType(from) && isObjectType(to) && (isInterfaceType(from) || isInterfaceType(to));
+}
+
+bool SymbolTable::isInterfaceType(const std::string &type) {
+    SymbolTable *table = getClassSymbolTable(type);
+    return table && table->isInterface();
+}
+
+bool SymbolTable::isChannelType(const std::string &type) {
+    return type == "Channel" || type == "SpscChannel";
+}
+
+bool SymbolTable::isObjectType(const std::string &type) {
+    return type != "int" &&
+           type != "boolean" &&
+           type != "int[]" &&
+           type != "String" &&
+           type != "void" &&
+           type != "System" &&
+           !isChannelType(type) &&
+           getClassSymbolTable(type) != nullptr;
+}
+
 SymbolTable *SymbolTable::getCurrentClassSymbolTable() {
     SymbolTable *current = this;
     while (current) {
@@ -77,4 +113,18 @@ SymbolTable *SymbolTable::getCurrentClassSymbolTable() {
         current = current->parentScope;
     }
     return nullptr;
+}
+
+bool SymbolTable::areExceptionsHandled() {
+    for (SymbolTable *current = this; current; current = current->parentScope) {
+        if (current->exceptionsHandled) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool SymbolTable::isStaticContext() {
+    SymbolTable *table = getCurrentClassSymbolTable();
+    return table && table->staticContext;
 }
\ No newline at end of file